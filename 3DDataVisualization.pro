@@ -1,6 +1,6 @@
 QT += core gui widgets opengl openglwidgets
 
-CONFIG += c++17
+CONFIG += c++17 thread
 
 TARGET = 3DDataVisualization
 TEMPLATE = app
@@ -16,7 +16,21 @@ SOURCES += \
     src/ModelAnalyzer.cpp \
     src/ColorMapper.cpp \
     src/FileImporter.cpp \
-    src/TransformTool.cpp
+    src/TransformTool.cpp \
+    src/MeshSimplifier.cpp \
+    src/MeshOptimizer.cpp \
+    src/BVH.cpp \
+    src/KdTree.cpp \
+    src/ICPRegistration.cpp \
+    src/AttributeChannel.cpp \
+    src/MeshTopology.cpp \
+    src/RansacDetector.cpp \
+    src/CurvatureEstimator.cpp \
+    src/SurfaceReconstructor.cpp \
+    src/ScreenSelection.cpp \
+    src/PagedVertexStore.cpp \
+    src/QuantizedPoints.cpp \
+    src/ModelCompressor.cpp
 
 # 头文件
 HEADERS += \
@@ -30,7 +44,28 @@ HEADERS += \
     include/ModelAnalyzer.h \
     include/ColorMapper.h \
     include/FileImporter.h \
-    include/TransformTool.h
+    include/TransformTool.h \
+    include/OpenHashMap.h \
+    include/Parallel.h \
+    include/MeshSimplifier.h \
+    include/MeshOptimizer.h \
+    include/Morton.h \
+    include/BVH.h \
+    include/KdTree.h \
+    include/ICPRegistration.h \
+    include/SymmetricEigen.h \
+    include/AttributeChannel.h \
+    include/MeshTopology.h \
+    include/UnionFind.h \
+    include/RansacDetector.h \
+    include/CurvatureEstimator.h \
+    include/SurfaceReconstructor.h \
+    include/BitMask.h \
+    include/ScreenSelection.h \
+    include/PagedVertexStore.h \
+    include/QuantizedPoints.h \
+    include/RangeCoder.h \
+    include/ModelCompressor.h
 
 # OpenGL库
 LIBS += -lopengl32
@@ -0,0 +1,50 @@
+#include "ModelAnalyzer.h"
+#include "PointCloud.h"
+#include <QElapsedTimer>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <random>
+
+// 欧氏聚类基准：合成点云由 clusterCount 个边长 1 m 的均匀点块组成，块中心在间距 10 m 的网格上。
+// 聚类半径取块内平均点距的 2 倍（每次半径查询约 30 个近邻，与常见扫描数据相当），
+// 远小于块间距，因此期望恰好得到 clusterCount 个聚类。
+// 用法：ClusteringBenchmark [点数，默认 50000000] [聚类数，默认 1000]
+int main(int argc, char* argv[]) {
+    const size_t pointCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000000;
+    const size_t clusterCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+    if (pointCount == 0 || clusterCount == 0 || pointCount / clusterCount < 1000) {
+        std::printf("点数至少为聚类数的 1000 倍\n");
+        return 2;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int side = 1;
+    while (size_t(side) * side * side < clusterCount) ++side;
+    std::vector<Vertex> points(pointCount);
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> offset(0.0f, 1.0f);
+    for (size_t i = 0; i < pointCount; ++i) {
+        const size_t c = i % clusterCount;
+        const QVector3D center(float(c % side) * 10.0f, float(c / side % side) * 10.0f, float(c / side / side) * 10.0f);
+        points[i].position = center + QVector3D(offset(rng), offset(rng), offset(rng));
+    }
+    auto cloud = std::make_shared<PointCloud>("benchmark");
+    cloud->setPoints(std::move(points));
+    std::printf("生成 %zu 个点（%zu 个点块）: %lld ms\n", pointCount, clusterCount, static_cast<long long>(timer.elapsed()));
+
+    timer.restart();
+    const float spacing = std::cbrt(1.0f / float(pointCount / clusterCount));
+    std::vector<uint32_t> labels;
+    const auto clusters = ModelAnalyzer::computeEuclideanClusters(cloud, 2.0f * spacing, pointCount / clusterCount / 2, pointCount, labels);
+    const qint64 elapsed = timer.elapsed();
+    std::printf("欧氏聚类（半径 %.4f m）: %zu 个聚类, 耗时 %lld ms, %.2f M 点/s\n", 2.0f * spacing, clusters.size(), static_cast<long long>(elapsed),
+                elapsed > 0 ? pointCount / 1000.0 / elapsed : 0.0);
+
+    if (clusters.size() != clusterCount) {
+        std::printf("失败: 期望 %zu 个聚类\n", clusterCount);
+        return 1;
+    }
+    return 0;
+}
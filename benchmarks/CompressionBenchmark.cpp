@@ -0,0 +1,157 @@
+#include "ModelCompressor.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QDir>
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// 压缩存档往返测试与基准：合成起伏网格（side × side 个顶点），写出后读回并校验：
+// 每轴坐标误差不超过半个量化步长、颜色完全一致、法线偏差很小、三角形集合（含绕序）不变；
+// 截断的文件必须被拒绝。顶点颜色编码原始顶点编号，用于把按 Morton 序重排后的顶点对应回原顶点。
+// 用法：CompressionBenchmark [每边顶点数，默认 2000] [每轴量化位数，默认 18]
+int main(int argc, char* argv[]) {
+    const size_t side = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+    const int positionBits = argc > 2 ? std::atoi(argv[2]) : 18;
+    if (side < 2 || side * side > (size_t(1) << 24) || positionBits < 8 || positionBits > 21) {
+        std::printf("每边顶点数须在 [2, 4096]，量化位数须在 [8, 21]\n");
+        return 2;
+    }
+
+    // 1. 合成网格：100 m × 100 m 的起伏曲面，平移到远离原点处以检验大坐标
+    const size_t n = side * side;
+    std::vector<Vertex> vertices(n);
+    const float spacing = 100.0f / float(side - 1);
+    for (size_t i = 0; i < n; ++i) {
+        const float x = float(i % side) * spacing;
+        const float y = float(i / side) * spacing;
+        const float z = 2.0f * std::sin(x * 0.2f) * std::cos(y * 0.15f);
+        const QVector3D normal = QVector3D(-0.4f * std::cos(x * 0.2f) * std::cos(y * 0.15f),
+                                           0.3f * std::sin(x * 0.2f) * std::sin(y * 0.15f), 1.0f).normalized();
+        vertices[i] = Vertex(QVector3D(500.0f + x, 200.0f + y, 10.0f + z), normal,
+                             QColor(int(i & 0xff), int((i >> 8) & 0xff), int((i >> 16) & 0xff)));
+    }
+    std::vector<unsigned int> triangles;
+    triangles.reserve((side - 1) * (side - 1) * 6);
+    for (size_t r = 0; r + 1 < side; ++r) {
+        for (size_t c = 0; c + 1 < side; ++c) {
+            const unsigned int a = static_cast<unsigned int>(r * side + c);
+            const unsigned int b = a + 1;
+            const unsigned int d = a + static_cast<unsigned int>(side);
+            triangles.insert(triangles.end(), { a, b, d + 1, a, d + 1, d });
+        }
+    }
+    float minimum[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float maximum[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (const Vertex& vertex : vertices) {
+        for (int k = 0; k < 3; ++k) {
+            minimum[k] = std::min(minimum[k], vertex.position[k]);
+            maximum[k] = std::max(maximum[k], vertex.position[k]);
+        }
+    }
+
+    // 2. 写出与读回
+    const QString path = QDir(QDir::tempPath()).filePath("CompressionBenchmark.3dvz");
+    const QString truncatedPath = QDir(QDir::tempPath()).filePath("CompressionBenchmark_truncated.3dvz");
+    ModelCompressor::Options options;
+    options.positionBits = positionBits;
+    ModelCompressor::Stats writeStats;
+    if (!ModelCompressor::write(path, vertices, triangles, options, &writeStats)) {
+        std::printf("失败: 写出压缩文件\n");
+        return 1;
+    }
+    std::printf("写出 %zu 个顶点, %zu 个三角形: %lld -> %lld 字节, 压缩比 %.2f, 耗时 %lld ms, %.1f MB/s\n",
+                writeStats.vertexCount, writeStats.triangleCount, static_cast<long long>(writeStats.rawBytes),
+                static_cast<long long>(writeStats.compressedBytes), writeStats.ratio(),
+                static_cast<long long>(writeStats.elapsedMs), writeStats.throughput());
+
+    std::vector<Vertex> decoded;
+    std::vector<unsigned int> decodedTriangles;
+    ModelCompressor::Stats readStats;
+    if (!ModelCompressor::read(path, decoded, decodedTriangles, &readStats)) {
+        std::printf("失败: 读回压缩文件\n");
+        return 1;
+    }
+    std::printf("读回: 耗时 %lld ms, %.1f MB/s\n", static_cast<long long>(readStats.elapsedMs), readStats.throughput());
+
+    // 3. 校验顶点：颜色还原出原编号，须恰好覆盖每个原顶点一次
+    int failures = 0;
+    if (decoded.size() != n || decodedTriangles.size() != triangles.size()) {
+        std::printf("失败: 读回 %zu 个顶点 / %zu 个三角形\n", decoded.size(), decodedTriangles.size() / 3);
+        return 1;
+    }
+    const uint32_t levels = (1u << positionBits) - 1;
+    std::vector<uint32_t> originalIndex(n);
+    std::vector<uint8_t> seen(n, 0);
+    double worstRatio = 0.0;
+    float worstNormal = 1.0f;
+    for (size_t i = 0; i < n; ++i) {
+        const QColor& color = decoded[i].color;
+        const size_t index = size_t(color.red()) | (size_t(color.green()) << 8) | (size_t(color.blue()) << 16);
+        if (index >= n || seen[index]) {
+            if (failures++ < 5) std::printf("失败: 顶点 %zu 的颜色与原顶点不一致\n", i);
+            continue;
+        }
+        seen[index] = 1;
+        originalIndex[i] = static_cast<uint32_t>(index);
+        for (int k = 0; k < 3; ++k) {
+            const double step = (double(maximum[k]) - double(minimum[k])) / levels;
+            const double error = std::fabs(double(decoded[i].position[k]) - double(vertices[index].position[k]));
+            // 解码坐标回到 float 时另有一次舍入
+            const double tolerance = 0.5 * step + 2.0 * FLT_EPSILON * std::fabs(double(vertices[index].position[k]));
+            if (error > tolerance && failures++ < 5) {
+                std::printf("失败: 顶点 %zu 第 %d 轴误差 %.3g m，超过半步长 %.3g m\n", index, k, error, 0.5 * step);
+            }
+            if (step > 0.0) worstRatio = std::max(worstRatio, error / step);
+        }
+        worstNormal = std::min(worstNormal, QVector3D::dotProduct(decoded[i].normal, vertices[index].normal));
+    }
+    if (worstNormal < 0.999f && failures++ < 5) std::printf("失败: 法线最大偏差 cos = %.5f\n", worstNormal);
+    std::printf("坐标最大误差 %.3f 步长, 法线最小夹角余弦 %.5f\n", worstRatio, worstNormal);
+
+    // 4. 校验三角形：映射回原编号并把最小编号轮换到首位（保持绕序）后比较集合
+    auto canonical = [](const unsigned int* t) {
+        const int r = t[1] < t[0] ? (t[2] < t[1] ? 2 : 1) : (t[2] < t[0] ? 2 : 0);
+        return std::array<unsigned int, 3>{ t[r], t[(r + 1) % 3], t[(r + 2) % 3] };
+    };
+    const size_t triangleCount = triangles.size() / 3;
+    std::vector<std::array<unsigned int, 3>> expected(triangleCount), actual(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        unsigned int mapped[3];
+        for (int k = 0; k < 3; ++k) mapped[k] = originalIndex[decodedTriangles[t * 3 + k]];
+        expected[t] = canonical(&triangles[t * 3]);
+        actual[t] = canonical(mapped);
+    }
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    if (expected != actual && failures++ < 5) std::printf("失败: 三角形集合不一致\n");
+
+    // 5. 截断的文件（只保留头部 / 缺最后一个块的尾部）必须被拒绝
+    QFile file(path);
+    file.open(QIODevice::ReadOnly);
+    const QByteArray bytes = file.readAll();
+    file.close();
+    for (qint64 keep : { qint64(32), qint64(bytes.size()) - 1, qint64(bytes.size()) / 2 }) {
+        QFile truncated(truncatedPath);
+        truncated.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        truncated.write(bytes.constData(), keep);
+        truncated.close();
+        std::vector<Vertex> partialVertices;
+        std::vector<unsigned int> partialTriangles;
+        if (ModelCompressor::read(truncatedPath, partialVertices, partialTriangles) && failures++ < 5) {
+            std::printf("失败: 截断到 %lld 字节的文件未被拒绝\n", static_cast<long long>(keep));
+        }
+    }
+    QFile::remove(path);
+    QFile::remove(truncatedPath);
+
+    if (failures > 0) {
+        std::printf("共 %d 项校验失败\n", failures);
+        return 1;
+    }
+    std::printf("往返校验通过\n");
+    return 0;
+}
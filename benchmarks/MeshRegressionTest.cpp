@@ -0,0 +1,133 @@
+#include "Mesh.h"
+#include "FileImporter.h"
+#include "MeshOptimizer.h"
+#include <QDir>
+#include <QFile>
+#include <QtEndian>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+// 网格处理回归测试：每项检查一个曾出错的边界情况，失败时打印原因并以非 0 退出。
+// 用法：MeshRegressionTest
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+    if (!condition) {
+        std::printf("失败: %s\n", message);
+        ++failures;
+    }
+}
+
+// side × side 个顶点的平面网格，三角形随机打乱，使顶点缓存优化与重编号确实会移动顶点
+std::shared_ptr<Mesh> makeGrid(size_t side) {
+    std::vector<Vertex> vertices(side * side);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        vertices[i].position = QVector3D(float(i % side), float(i / side), 0.0f);
+    }
+    std::vector<std::array<unsigned int, 3>> faces;
+    for (size_t r = 0; r + 1 < side; ++r) {
+        for (size_t c = 0; c + 1 < side; ++c) {
+            const unsigned int a = static_cast<unsigned int>(r * side + c);
+            const unsigned int d = a + static_cast<unsigned int>(side);
+            faces.push_back({ a, a + 1, d + 1 });
+            faces.push_back({ a, d + 1, d });
+        }
+    }
+    std::shuffle(faces.begin(), faces.end(), std::mt19937(7));
+    std::vector<unsigned int> triangles;
+    for (const auto& face : faces) triangles.insert(triangles.end(), face.begin(), face.end());
+    auto mesh = std::make_shared<Mesh>("grid");
+    mesh->setGeometry(std::move(vertices), std::move(triangles));
+    return mesh;
+}
+
+// 没有属性通道的网格经索引优化（顶点重编号）后，选择图层仍跟随原来的顶点
+void testOptimizeKeepsSelection() {
+    auto mesh = makeGrid(64);
+    expect(mesh->getAttributes().empty(), "测试网格不应带属性通道");
+    BitMask& selection = mesh->selection();
+    for (size_t i = 0; i < mesh->getVertexCount(); ++i) {
+        const QVector3D& p = mesh->getVertices()[i].position;
+        if (p.x() < 20.0f && p.y() > 30.0f) selection.set(i);
+    }
+    const size_t selected = mesh->getSelectedCount();
+    MeshOptimizer::optimize(*mesh);
+
+    size_t mismatched = 0;
+    const BitMask& after = mesh->getSelection();
+    for (size_t i = 0; i < mesh->getVertexCount(); ++i) {
+        const QVector3D& p = mesh->getVertices()[i].position;
+        if (after.size() != mesh->getVertexCount() || after.test(i) != (p.x() < 20.0f && p.y() > 30.0f)) ++mismatched;
+    }
+    expect(mesh->getSelectedCount() == selected && mismatched == 0, "索引优化后选中的顶点与优化前不一致");
+}
+
+// 指定的缓存容量同时用于重排与 ACMR 统计：报告值与按该容量重新统计的结果一致
+void testOptimizeHonoursCacheSize() {
+    for (unsigned int cacheSize : { 8u, 16u, 24u }) {
+        auto mesh = makeGrid(128);
+        const MeshOptimizer::Report report = MeshOptimizer::optimize(*mesh, cacheSize);
+        const float acmr = MeshOptimizer::computeACMR(mesh->getTriangles(), mesh->getVertexCount(), cacheSize);
+        expect(std::fabs(report.acmrAfter - acmr) < 1e-6f, "报告的 ACMR 与按同一缓存容量统计的结果不一致");
+        expect(report.acmrAfter < report.acmrBefore, "指定缓存容量的索引优化没有降低 ACMR");
+    }
+}
+
+// 焊接压缩顶点后，原本越界的索引不得落入新编号范围指向无关顶点：含越界索引的面被删除并计数
+void testWeldDropsOutOfRangeTriangles() {
+    std::vector<Vertex> vertices(6);
+    const QVector3D corners[6] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 } };
+    for (int i = 0; i < 6; ++i) vertices[i].position = corners[i];
+    // 顶点 3、4 与 0、1 重合，焊接后只剩 4 个顶点；索引 5 之外的 6 在焊接前就越界
+    auto mesh = std::make_shared<Mesh>("weld");
+    mesh->setGeometry(std::move(vertices), { 0, 1, 2, 4, 5, 3, 0, 2, 6 });
+    const Mesh::WeldStats stats = mesh->weldVertices(0.0f);
+    expect(stats.mergedVertices == 2, "焊接应合并 2 个顶点");
+    expect(stats.removedTriangles == 1 && mesh->getTriangleCount() == 2, "含越界索引的三角形应被删除并计入 removedTriangles");
+    for (unsigned int index : mesh->getTriangles()) {
+        expect(index < mesh->getVertexCount(), "焊接后的三角形索引越界");
+    }
+}
+
+// 导出 STL 时跳过含越界索引的三角形，文件头的三角形数等于实际写出的记录数
+void testStlExportSkipsOutOfRangeTriangles() {
+    std::vector<Vertex> vertices(4);
+    vertices[1].position = QVector3D(1, 0, 0);
+    vertices[2].position = QVector3D(0, 1, 0);
+    vertices[3].position = QVector3D(1, 1, 0);
+    auto mesh = std::make_shared<Mesh>("stl");
+    mesh->setGeometry(std::move(vertices), { 0, 1, 2, 1, 3, 9, 2, 1, 3 });
+    const QString path = QDir(QDir::tempPath()).filePath("MeshRegressionTest.stl");
+    expect(FileImporter::exportFile(mesh, path), "导出 STL 失败");
+    QFile file(path);
+    file.open(QIODevice::ReadOnly);
+    const QByteArray bytes = file.readAll();
+    file.close();
+    QFile::remove(path);
+    uint32_t declared = 0;
+    if (bytes.size() >= 84) std::memcpy(&declared, bytes.constData() + 80, sizeof(declared));
+    expect(qFromLittleEndian(declared) == 2 && bytes.size() == 84 + 2 * 50, "STL 应只写出 2 个有效三角形");
+}
+
+}  // namespace
+
+int main() {
+    testOptimizeKeepsSelection();
+    testOptimizeHonoursCacheSize();
+    testWeldDropsOutOfRangeTriangles();
+    testStlExportSkipsOutOfRangeTriangles();
+
+    if (failures > 0) {
+        std::printf("共 %d 项校验失败\n", failures);
+        return 1;
+    }
+    std::printf("网格回归测试通过\n");
+    return 0;
+}
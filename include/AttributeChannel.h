@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QString>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// 逐顶点属性通道（强度、分类、GPS 时间、置信度等）。
+// 列式存储：一个通道只保存一种标量类型，数据是按顶点顺序排列的连续字节数组，
+// 只在第一次写入时分配，未写入的通道读出为 0。
+class AttributeChannel {
+public:
+    enum Type {
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Float32,
+        Float64
+    };
+
+    AttributeChannel(const QString& name, Type type, size_t count = 0);
+
+    const QString& name() const { return name_; }
+    Type type() const { return type_; }
+    size_t size() const { return count_; }
+    bool isAllocated() const { return !bytes_.empty(); }
+    size_t byteSize() const { return bytes_.size(); }
+
+    static size_t typeSize(Type type);
+    static QString typeName(Type type);
+
+    // 改变元素个数；已分配的数据按需扩展（新元素为 0）
+    void resize(size_t count);
+
+    // 原始数据：只读访问不分配（未分配时返回 nullptr），可写访问会分配
+    const uint8_t* data() const { return bytes_.empty() ? nullptr : bytes_.data(); }
+    uint8_t* mutableData();
+
+    // 按类型的连续数组视图，T 必须与通道类型一致
+    template <typename T>
+    T* values() { return reinterpret_cast<T*>(mutableData()); }
+    template <typename T>
+    const T* values() const { return reinterpret_cast<const T*>(data()); }
+
+    double valueAt(size_t index) const;
+    void setValue(size_t index, double value);
+
+    // 数值范围（缓存，写访问后失效），NaN / 无穷不计入；空通道或没有有限值时返回 false 且范围为 [0, 0]
+    bool range(double& minValue, double& maxValue) const;
+
+    // 伪彩色显示范围：未设置时等于数值范围。用于压制少数极端值（如曲率尖点）对色带的占用，
+    // 不改变数据本身，写访问后仍保留
+    void setDisplayRange(double minValue, double maxValue);
+    void clearDisplayRange() { displayRangeSet_ = false; }
+    bool hasDisplayRange() const { return displayRangeSet_; }
+    bool displayRange(double& minValue, double& maxValue) const;
+
+    // 按 newToOld（新编号 -> 旧编号）重排或筛选元素，结果长度为 newToOld.size()
+    void gather(const std::vector<uint32_t>& newToOld);
+    // 同上，但结果写入新通道（用于拆分模型，不复制整个源通道）
+    AttributeChannel gathered(const std::vector<uint32_t>& newToOld) const;
+
+private:
+    void invalidateRange() { rangeValid_ = false; }
+
+    QString name_;
+    Type type_;
+    size_t count_;
+    std::vector<uint8_t> bytes_;
+
+    mutable bool rangeValid_ = false;
+    mutable bool rangeFound_ = false;
+    mutable double minValue_ = 0.0;
+    mutable double maxValue_ = 0.0;
+
+    bool displayRangeSet_ = false;
+    double displayMin_ = 0.0;
+    double displayMax_ = 0.0;
+};
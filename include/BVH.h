@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QVector3D>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cfloat>
+#include "AABB.h"
+#include "Vertex.h"
+
+// 三角形包围体层次（BVH）：分桶 SAH 构建，节点按深度优先展平存放
+// （左子节点紧跟父节点，右子节点存偏移），上层子树并行构建。
+// 用于射线拾取、最近点查询与平面剖切。坐标单位与网格顶点一致（米）。
+class BVH {
+public:
+    struct RayHit {
+        float t = FLT_MAX;          // 射线参数：交点 = origin + t * direction
+        uint32_t triangle = 0;      // 原网格中的三角形编号
+        float u = 0.0f;             // 重心坐标（交点 = (1-u-v)*v0 + u*v1 + v*v2）
+        float v = 0.0f;
+    };
+
+    struct ClosestHit {
+        float distanceSquared = FLT_MAX;
+        uint32_t triangle = 0;
+        QVector3D point;            // 三角形上的最近点
+    };
+
+    // 由顶点与三角形索引构建（越界索引的三角形被忽略）
+    void build(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& triangles);
+
+    bool empty() const { return nodes_.empty(); }
+    size_t nodeCount() const { return nodes_.size(); }
+    AABB bounds() const { return nodes_.empty() ? AABB() : nodes_[0].bounds; }
+
+    // 射线求交：返回 [0, tMax] 内最近的交点（direction 不要求单位长度）
+    bool intersect(const QVector3D& origin, const QVector3D& direction, RayHit& hit,
+                   float tMax = FLT_MAX) const;
+
+    // 最近点查询：只在距离不超过 maxDistance 的范围内搜索
+    bool closestPoint(const QVector3D& point, ClosestHit& hit, float maxDistance = FLT_MAX) const;
+
+    // 平面查询：包围盒与平面 normal·p = offset 相交的叶子中的三角形编号追加到 triangles。
+    // 只按包围盒筛选，调用方须再按顶点精确判断三角形是否跨越平面
+    void queryPlane(const QVector3D& normal, float offset, std::vector<uint32_t>& triangles) const;
+
+private:
+    struct Node {
+        AABB bounds;
+        uint32_t offset = 0;   // 叶子：首个三角形在 triangles_ 中的位置；内部节点：右子节点编号
+        uint32_t count = 0;    // 叶子三角形数；内部节点为 0
+        uint32_t axis = 0;     // 内部节点的划分轴，遍历时据此先访问近侧子节点
+    };
+
+    // 按叶子顺序存放的三角形（预先计算边向量以加速求交）
+    struct Triangle {
+        QVector3D v0;
+        QVector3D e1;          // v1 - v0
+        QVector3D e2;          // v2 - v0
+        uint32_t index = 0;
+    };
+
+    friend class BVHBuilder;
+
+    std::vector<Node> nodes_;
+    std::vector<Triangle> triangles_;
+};
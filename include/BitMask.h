@@ -0,0 +1,163 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include "Parallel.h"
+
+// 紧凑位掩码：每个元素 1 位，按 64 位字存放（1 亿个点约 12 MB）。
+// 字内位 i 对应元素 word * 64 + i；最后一个字中超出 size() 的位始终为 0。
+// 并行写入时按 64 的整数倍划分区间，各线程只写自己的字，无需原子操作。
+class BitMask {
+public:
+    static constexpr size_t kWordBits = 64;
+
+    BitMask() = default;
+    explicit BitMask(size_t size, bool value = false) { resize(size, value); }
+
+    // 调整长度，所有位置为 value
+    void resize(size_t size, bool value = false) {
+        size_ = size;
+        words_.assign((size + kWordBits - 1) / kWordBits, value ? ~uint64_t(0) : 0);
+        clearTail();
+    }
+    void clear() {
+        size_ = 0;
+        words_.clear();
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t wordCount() const { return words_.size(); }
+    uint64_t* words() { return words_.data(); }
+    const uint64_t* words() const { return words_.data(); }
+
+    bool test(size_t i) const { return (words_[i / kWordBits] >> (i % kWordBits)) & 1u; }
+    void set(size_t i) { words_[i / kWordBits] |= uint64_t(1) << (i % kWordBits); }
+    void reset(size_t i) { words_[i / kWordBits] &= ~(uint64_t(1) << (i % kWordBits)); }
+    void assign(size_t i, bool value) { value ? set(i) : reset(i); }
+
+    // [begin, end) 内的位统一置为 value
+    void assignRange(size_t begin, size_t end, bool value) {
+        while (begin < end && begin % kWordBits != 0) assign(begin++, value);
+        for (; begin + kWordBits <= end; begin += kWordBits) words_[begin / kWordBits] = value ? ~uint64_t(0) : 0;
+        while (begin < end) assign(begin++, value);
+    }
+
+    void fill(bool value) {
+        Parallel::forEach(0, words_.size(), [&](size_t w) { words_[w] = value ? ~uint64_t(0) : 0; });
+        clearTail();
+    }
+    void invert() {
+        Parallel::forEach(0, words_.size(), [&](size_t w) { words_[w] = ~words_[w]; });
+        clearTail();
+    }
+
+    // 与长度相同的掩码按位合并（并行）；长度不一致时不做任何修改
+    void unite(const BitMask& other) {
+        if (other.size_ != size_) return;
+        Parallel::forEach(0, words_.size(), [&](size_t w) { words_[w] |= other.words_[w]; });
+    }
+    void intersect(const BitMask& other) {
+        if (other.size_ != size_) return;
+        Parallel::forEach(0, words_.size(), [&](size_t w) { words_[w] &= other.words_[w]; });
+    }
+    void subtract(const BitMask& other) {
+        if (other.size_ != size_) return;
+        Parallel::forEach(0, words_.size(), [&](size_t w) { words_[w] &= ~other.words_[w]; });
+    }
+
+    // 置位数（按字并行统计）
+    size_t count() const {
+        const size_t chunks = Parallel::chunkCount(words_.size());
+        std::vector<size_t> partial(chunks, 0);
+        Parallel::forChunks(words_.size(), chunks, [&](size_t c, size_t b, size_t e) {
+            size_t sum = 0;
+            for (size_t w = b; w < e; ++w) sum += popcount(words_[w]);
+            partial[c] = sum;
+        });
+        size_t total = 0;
+        for (size_t sum : partial) total += sum;
+        return total;
+    }
+    bool any() const {
+        for (uint64_t word : words_) {
+            if (word) return true;
+        }
+        return false;
+    }
+
+    // 值为 value 的元素编号（升序）：按字分块统计、前缀和后并行写出
+    std::vector<uint32_t> indices(bool value = true) const {
+        const size_t chunks = Parallel::chunkCount(words_.size(), 1024);
+        std::vector<size_t> offsets(chunks + 1, 0);
+        auto wordAt = [&](size_t w) {
+            const uint64_t word = value ? words_[w] : ~words_[w];
+            // 取反后尾部的无效位须重新清零
+            if (!value && w + 1 == words_.size() && size_ % kWordBits != 0) {
+                return word & ((uint64_t(1) << (size_ % kWordBits)) - 1);
+            }
+            return word;
+        };
+        Parallel::forChunks(words_.size(), chunks, [&](size_t c, size_t b, size_t e) {
+            size_t sum = 0;
+            for (size_t w = b; w < e; ++w) sum += popcount(wordAt(w));
+            offsets[c + 1] = sum;
+        });
+        for (size_t c = 0; c < chunks; ++c) offsets[c + 1] += offsets[c];
+        std::vector<uint32_t> result(offsets[chunks]);
+        Parallel::forChunks(words_.size(), chunks, [&](size_t c, size_t b, size_t e) {
+            size_t out = offsets[c];
+            for (size_t w = b; w < e; ++w) {
+                for (uint64_t word = wordAt(w); word; word &= word - 1) {
+                    result[out++] = static_cast<uint32_t>(w * kWordBits + countTrailingZeros(word));
+                }
+            }
+        });
+        return result;
+    }
+
+    // 按 newToOld（新编号 -> 旧编号）重排，与 Model::remapAttributes 的约定一致；越界的旧编号视为 0
+    BitMask gathered(const std::vector<uint32_t>& newToOld) const {
+        BitMask result(newToOld.size());
+        Parallel::forEach(0, result.words_.size(), [&](size_t w) {
+            uint64_t word = 0;
+            const size_t begin = w * kWordBits;
+            const size_t end = std::min(begin + kWordBits, newToOld.size());
+            for (size_t i = begin; i < end; ++i) {
+                if (newToOld[i] < size_ && test(newToOld[i])) word |= uint64_t(1) << (i - begin);
+            }
+            result.words_[w] = word;
+        }, 1024);
+        return result;
+    }
+
+    static int popcount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(word);
+#else
+        int bits = 0;
+        for (; word; word &= word - 1) ++bits;
+        return bits;
+#endif
+    }
+
+    static int countTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int bits = 0;
+        for (; !(word & 1u); word >>= 1) ++bits;
+        return bits;
+#endif
+    }
+
+private:
+    void clearTail() {
+        if (size_ % kWordBits != 0) words_.back() &= (uint64_t(1) << (size_ % kWordBits)) - 1;
+    }
+
+    size_t size_ = 0;
+    std::vector<uint64_t> words_;
+};
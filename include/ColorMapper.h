@@ -9,6 +9,8 @@ public:
     static QColor mapByCoordinate(const QVector3D& position, int axis);
     static QColor mapByHeight(float height, float minHeight, float maxHeight);
     static QColor mapByDistance(const QVector3D& position, const QVector3D& reference);
+    // 有符号偏差着色：[-maxDistance, maxDistance] 映射为 蓝 -> 绿 -> 红，超出范围截断
+    static QColor mapByDistance(float distance, float maxDistance);
     
     // HSV颜色空间转换
     static QColor hsvToRgb(float hue, float saturation, float value);
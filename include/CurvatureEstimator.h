@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+class Model;
+class Mesh;
+
+// 逐顶点曲率估计（单位 1/米），结果可存为属性通道用伪彩色显示。
+// 网格：离散余切 Laplace 求平均曲率、角亏求高斯曲率，面积取 Meyer 混合 Voronoi 面积；
+// 每个顶点只沿网格拓扑的出边表读取相邻三角形，按顶点并行且无需原子操作。
+// 点云：k 近邻协方差的表面变化度 λ0 / (λ0 + λ1 + λ2)（0 为平面，1/3 为各向同性）。
+class CurvatureEstimator {
+public:
+    struct MeshCurvature {
+        std::vector<float> mean;       // 平均曲率 H（凸处为正，方向由三角形环绕顺序决定）
+        std::vector<float> gaussian;   // 高斯曲率 K
+        size_t boundaryVertices = 0;   // 边界顶点：离散曲率无定义，记为 0
+        size_t isolatedVertices = 0;   // 未被三角形引用的顶点，记为 0
+    };
+
+    static MeshCurvature computeMeshCurvature(const Mesh& mesh);
+
+    static std::vector<float> computeSurfaceVariation(const Model& model, size_t neighbours);
+
+    // 采样估计的分位数范围 [P(percent), P(100 - percent)]，作为伪彩色显示范围
+    static void percentileRange(const std::vector<float>& values, double percent, double& lo, double& hi);
+};
@@ -8,6 +8,28 @@ class Model;
 class PointCloud;
 class Mesh;
 
+// 导入后处理选项
+struct ImportOptions {
+    bool weldVertices = false;      // 导入后焊接重合顶点（仅对 Mesh 生效）
+    float weldTolerance = 1e-6f;    // 焊接容差（文件原始单位）
+    bool optimizeIndices = false;   // 导入后优化三角形与顶点顺序（顶点缓存友好，仅对 Mesh 生效）
+    bool spatialSortPoints = false; // 导入后按 Morton 码对点排序（仅对 PointCloud 生效）
+    // 外存导入：文件大于此字节数时（0 表示不启用），点云写入 outOfCoreCacheDir（为空时用系统临时目录）下的
+    // 分块外存文件，内存中只保留 previewPoints 个抽样点。适用于 XYZ、LAS 与无面片的 PLY；
+    // 外存模式只保存坐标、法线与颜色，其余 PLY / LAS 属性不导入
+    qint64 outOfCoreThreshold = 0;
+    QString outOfCoreCacheDir;
+    size_t previewPoints = 2000000;
+    // LAS 抽样步长：每 lasStride 个点读取一个（1 为全部），用于快速预览大文件；外存导入同样生效
+    size_t lasStride = 1;
+};
+
+// 导出选项
+struct ExportOptions {
+    int compressedPositionBits = 18;    // 压缩格式（.3dvz）每轴坐标量化位数，[8, 21]
+    bool binaryPly = false;             // PLY 写为 binary_little_endian（否则 ASCII）
+};
+
 class FileImporter {
 public:
     // 支持的文件格式
@@ -15,26 +37,42 @@ public:
         PLY,
         OBJ,
         XYZ,
+        STL,            // 二进制 / ASCII STL
+        LAS,            // LAS 1.0–1.4 点云（点记录格式 0–10，仅导入）
+        COMPRESSED,     // .3dvz 压缩存档（见 ModelCompressor）
         UNKNOWN
     };
     
     // 导入文件
-    static std::shared_ptr<Model> importFile(const QString& filePath);
+    static std::shared_ptr<Model> importFile(const QString& filePath,
+                                             const ImportOptions& options = ImportOptions());
     
-    // 导出文件
-    static bool exportFile(std::shared_ptr<Model> model, const QString& filePath);
+    // 导出文件（模型的过滤/裁切图层隐藏的顶点不导出）
+    static bool exportFile(std::shared_ptr<Model> model, const QString& filePath,
+                           const ExportOptions& options = ExportOptions());
     
 private:
     // 文件格式检测
     static FileFormat detectFormat(const QString& filePath);
     
+    // 导入后处理（焊接等）
+    static void postProcess(const std::shared_ptr<Model>& model, const ImportOptions& options);
+    
     // 具体格式的导入器
     static std::shared_ptr<Model> importPLY(const QString& filePath);
     static std::shared_ptr<Model> importOBJ(const QString& filePath);
     static std::shared_ptr<Model> importXYZ(const QString& filePath);
+    static std::shared_ptr<Model> importSTL(const QString& filePath);
+    static std::shared_ptr<Model> importLAS(const QString& filePath, size_t stride);
+    static std::shared_ptr<Model> importCompressed(const QString& filePath);
+    // 外存导入：边解析边写入分块外存文件，不在内存中保留全部顶点。不适用（如 PLY 含面片）时返回空
+    static std::shared_ptr<Model> importPointCloudPaged(const QString& filePath, FileFormat format,
+                                                        const ImportOptions& options);
     
-    // 具体格式的导出器
-    static bool exportPLY(std::shared_ptr<Model> model, const QString& filePath);
+    // 具体格式的导出器：文本按批并行格式化后顺序写出
+    static bool exportPLY(std::shared_ptr<Model> model, const QString& filePath, bool binary);
     static bool exportOBJ(std::shared_ptr<Model> model, const QString& filePath);
     static bool exportXYZ(std::shared_ptr<Model> model, const QString& filePath);
+    static bool exportSTL(std::shared_ptr<Model> model, const QString& filePath);       // 二进制 STL
+    static bool exportCompressed(std::shared_ptr<Model> model, const QString& filePath, const ExportOptions& options);
 };
\ No newline at end of file
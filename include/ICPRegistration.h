@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QMatrix4x4>
+#include <QtGlobal>
+#include <vector>
+#include <cstddef>
+
+class Model;
+
+// 点到面 ICP 刚体配准：估计把 source 对齐到 target 的变换。
+// 目标点采样后建 k-d 树并以 PCA 估计法线；源点按由粗到细的采样金字塔迭代，
+// 每次迭代并行搜索对应点并累加 6x6 法方程，线性化求解小角度增量。
+class ICPRegistration {
+public:
+    struct Options {
+        int levels = 3;                          // 金字塔层数（由粗到细，每层采样数 ×4）
+        size_t finestSampleCount = 100000;       // 最细层源点采样数
+        size_t targetSampleCount = 500000;       // 目标点采样上限（用于建树与估计法线）
+        int maxIterationsPerLevel = 30;
+        float maxCorrespondenceDistance = 0.0f;  // 初始对应点距离上限（米），0 表示取目标包围盒对角线的 10%
+        float convergenceAngle = 1e-5f;          // 旋转增量（弧度）与平移增量（× 包围盒对角线）
+        float convergenceTranslation = 1e-6f;    // 同时低于阈值时认为该层收敛
+    };
+
+    struct Result {
+        QMatrix4x4 transform;                    // 作用于 source 顶点的刚体变换
+        bool converged = false;                  // 最细层是否收敛
+        int iterations = 0;                      // 各层迭代总数
+        size_t correspondences = 0;              // 最后一次迭代的有效对应点数
+        float initialRms = 0.0f;                 // 点到面残差 RMS（米）
+        float finalRms = 0.0f;
+        std::vector<float> rmsHistory;           // 每次迭代的残差 RMS
+        qint64 elapsedMs = 0;
+    };
+
+    static Result align(const Model& source, const Model& target, const Options& options);
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QVector3D>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cfloat>
+#include "Vertex.h"
+
+// 点的 k-d 树：沿包围盒最长轴按中位数划分，叶子至多 kLeafSize 个点。
+// 节点与点都按深度优先顺序连续存放（点坐标单独紧凑存储），上层子树并行构建。
+// 坐标单位与输入顶点一致（米）。
+class KdTree {
+public:
+    // 由顶点坐标构建（只读取 position）
+    void build(const std::vector<Vertex>& points);
+
+    bool empty() const { return nodes_.empty(); }
+    size_t size() const { return indices_.size(); }
+
+    // 最近邻查询。index / distanceSquared 输入为已知候选（无候选时 distanceSquared 取 FLT_MAX），
+    // 仅当找到更近的点时更新并返回 true；index 为构建时的原始点编号
+    bool nearest(const QVector3D& query, uint32_t& index, float& distanceSquared) const;
+
+    // k 近邻：结果按距离升序写入 indices / distancesSquared（点数不足 k 时为实际数量）
+    void kNearest(const QVector3D& query, size_t k, std::vector<uint32_t>& indices,
+                  std::vector<float>& distancesSquared) const;
+
+    // 半径查询：距离不超过 radius 的所有点的原始编号写入 indices（不排序，含查询点自身）
+    void radiusSearch(const QVector3D& query, float radius, std::vector<uint32_t>& indices) const;
+
+private:
+    struct Point {
+        float xyz[3];
+    };
+
+    struct Node {
+        float split = 0.0f;    // 内部节点的划分坐标
+        uint32_t axis = 0;     // 0..2 为划分轴；kLeafAxis 表示叶子
+        uint32_t offset = 0;   // 叶子：首个点在 points_ 中的位置；内部节点：右子节点编号（左子节点紧随其后）
+        uint32_t count = 0;    // 叶子点数
+    };
+
+    static constexpr uint32_t kLeafAxis = 3;
+    static constexpr size_t kLeafSize = 16;
+
+    friend class KdTreeBuilder;
+
+    std::vector<Node> nodes_;
+    std::vector<Point> points_;     // 按叶子顺序存放的坐标
+    std::vector<uint32_t> indices_; // points_[i] 对应的原始点编号
+};
@@ -4,6 +4,7 @@
 #include <QTimer>
 #include <memory>
 #include <vector>
+#include "ModelAnalyzer.h"
 
 QT_BEGIN_NAMESPACE
 class QSlider;
@@ -14,10 +15,13 @@ class QGroupBox;
 class QTextEdit;
 class QDoubleSpinBox;
 class QComboBox;
+class QCheckBox;
+class QAction;
 QT_END_NAMESPACE
 
 class OpenGLWidget;
 class Model;
+class QVector3D;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -32,6 +36,8 @@ private slots:
     void onDeleteModel();
     void onModelSelectionChanged();
     void onColorChanged();
+    void onRestoreColor();
+    void onBakeColor();
     void onTransformChanged();
     void onPositionChanged();
     void onResetPosition();
@@ -39,7 +45,37 @@ private slots:
     void onPseudoColorToggled(bool checked);
     void onCoordinateChanged(int value);
     void onColorMapChanged(int index);
+    void onAttributeChanged(int index);
     void onImportUnitChanged(int index);
+    void onWeldVertices();
+    void onSimplifyMesh();
+    void onOptimizeMesh();
+    void onSortPointCloud();
+    void onCompactStorage();
+    void onBakePagedStore();
+    void onCloudToMeshDistance();
+    void onCloudToCloudDistance();
+    void onRegisterICP();
+    void onMeshComponents();
+    void onEuclideanClusters();
+    void onDetectShapes();
+    void onEstimateCurvature();
+    void onReconstructSurface();
+    void onSectionChanged();
+    void onBatchSections();
+    void onSelectionToolChanged(int tool);
+    void onSelectionChanged();
+    void onClearSelection();
+    void onInvertSelection();
+    void onDeleteSelected();
+    void onCropSelected();
+    void onExportSelected();
+    void onHideSelected(bool keepSelected);
+    void onFilterByAttributeRange();
+    void onClipBySection();
+    void onShowAll();
+    void onCompactVisible();
+    void onModelPicked(int modelIndex, int triangleIndex, int vertexIndex, const QVector3D& pointCm);
 
 private:
     void setupUI();
@@ -48,6 +84,13 @@ private:
     void createDockWindows();
     void updateModelList();
     void updatePropertyPanel();
+    void updateAttributeList();
+    static QString formatDistanceStats(const ModelAnalyzer::DistanceStats& stats);
+    bool sectionPlane(QVector3D& normal, float& minOffset, float& maxOffset) const;
+    std::shared_ptr<Model> modelWithSelection();   // 当前模型有选中顶点时返回，否则提示并返回空
+    void onVisibilityChanged();
+    static QString formatComponentStats(const std::vector<ModelAnalyzer::ComponentStats>& components,
+                                        const QString& elementName, size_t maxRows);
     
     // UI组件
     OpenGLWidget* openGLWidget_;
@@ -62,8 +105,14 @@ private:
     QSlider* colorSliderG_;
     QSlider* colorSliderB_;
     QSlider* coordinateSlider_;
+    QLabel* coordinateValueLabel_;
     QComboBox* colorMapCombo_;
+    QComboBox* attributeCombo_;
     QComboBox* unitCombo_;
+    QCheckBox* weldOnImportCheck_;
+    QCheckBox* optimizeOnImportCheck_;
+    QCheckBox* sortOnImportCheck_;
+    QCheckBox* outOfCoreOnImportCheck_;
     
     // 位置控制
     QDoubleSpinBox* posXSpinBox_;
@@ -79,6 +128,17 @@ private:
     QGroupBox* colorGroup_;
     QGroupBox* analysisGroup_;
     
+    // 剖切
+    QGroupBox* sectionGroup_;
+    QComboBox* sectionAxisCombo_;
+    QSlider* sectionSlider_;
+    QDoubleSpinBox* sectionThicknessSpinBox_;
+    QLabel* sectionInfoLabel_;
+    
+    // 屏幕选择工具（互斥的两个可勾选菜单项）
+    QAction* rectSelectAction_;
+    QAction* lassoSelectAction_;
+    
     // 数据
     std::vector<std::shared_ptr<Model>> models_;
     int currentModelIndex_;
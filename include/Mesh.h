@@ -1,6 +1,12 @@
 #pragma once
 
 #include "Model.h"
+#include <QVector2D>
+#include <cstdint>
+#include <memory>
+
+class BVH;
+class MeshTopology;
 
 class Mesh : public Model {
 public:
@@ -12,6 +18,54 @@ public:
     void addTriangle(unsigned int i1, unsigned int i2, unsigned int i3);
     void clear();
     
+    // 批量设置几何数据（导入器使用，避免逐个 push_back）
+    // texCoords 可为空；非空时须与 vertices 一一对应
+    void setGeometry(std::vector<Vertex>&& vertices,
+                     std::vector<unsigned int>&& triangles,
+                     std::vector<QVector2D>&& texCoords = {});
+    
+    // 纹理坐标（可选，与顶点一一对应）
+    const std::vector<QVector2D>& getTexCoords() const { return texCoords_; }
+    bool hasTexCoords() const { return !texCoords_.empty(); }
+    
+    // 顶点焊接：合并距离不超过 tolerance 的顶点（网格分桶）；tolerance <= 0 时仅合并坐标完全相同的顶点
+    // （-0 与 +0 视为相同），按坐标位模式哈希分桶查重，适合 STL 等三角形汤的千万级角点。
+    // 重映射三角形并删除退化面与含越界索引的面。被合并顶点保留编号最小者的法线/颜色/纹理坐标，保留的顶点保持原有先后顺序。
+    struct WeldStats {
+        size_t mergedVertices = 0;     // 被合并掉的顶点数
+        size_t removedTriangles = 0;   // 删除的退化 / 含越界索引的三角形数
+    };
+    WeldStats weldVertices(float tolerance);
+    
+    // 按面积加权重算顶点法线（无有效邻面的顶点为 (0, 0, 1)）
+    void computeVertexNormals();
+    
+    // 按 旧编号 -> 新编号 的双射重排顶点（连同纹理坐标），并同步改写三角形索引
+    void permuteVertices(const std::vector<uint32_t>& oldToNew);
+    
+    // 按三角形标签拆分为 labelCount 个新网格（标签越界的三角形被丢弃）。
+    // 每个新网格只含被引用的顶点，保留颜色/法线/纹理坐标/属性通道；无三角形的标签得到空网格
+    std::vector<std::shared_ptr<Mesh>> splitByFaceLabels(const std::vector<uint32_t>& faceLabels,
+                                                         size_t labelCount) const;
+    
+    // 按掩码提取顶点与三个顶点都被提取的三角形（顶点保持原顺序，三角形分块并行筛选并压缩）
+    std::shared_ptr<Model> extractVertices(const BitMask& keep, const QString& name) const override;
+    
+    // 直接替换三角形索引（顶点不变），用于索引重排类优化
+    void setTriangles(std::vector<unsigned int>&& triangles);
+    
+    // 三角形 BVH（首次调用时构建，几何变化后自动失效重建）
+    const BVH& getBVH() const;
+    
+    // 有向边拓扑（邻接、边界、流形性查询；首次调用时构建，三角形或顶点数变化后失效）
+    const MeshTopology& getTopology() const;
+    
+    // 变换操作（顶点坐标改变，需使缓存失效）
+    void translate(const QVector3D& offset) override;
+    void translateTo(const QVector3D& position) override;
+    void scale(const QVector3D& factors) override;
+    void applyTransform(const QMatrix4x4& matrix) override;
+    
     // 统计信息
     size_t getFaceCount() const { return getTriangleCount(); }
     
@@ -28,4 +82,12 @@ public:
     
 private:
     static int meshCount_;
+    
+    void markDirty() const;
+    // 三角形索引或顶点数改变：拓扑与几何缓存都失效
+    void markTopologyDirty() const;
+    
+    std::vector<QVector2D> texCoords_;
+    mutable std::shared_ptr<BVH> bvh_;
+    mutable std::shared_ptr<MeshTopology> topology_;
 };
\ No newline at end of file
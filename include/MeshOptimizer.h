@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QtGlobal>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class Mesh;
+
+// 索引缓冲优化：三角形重排（Forsyth 顶点缓存算法）与顶点按首次使用顺序重编号。
+// ACMR（平均每三角形缓存未命中数）用 FIFO 顶点缓存模拟，越接近 0.5 越好，最差为 3。
+class MeshOptimizer {
+public:
+    // 模拟的顶点缓存容量范围（超出时限幅）
+    static constexpr unsigned int kMinCacheSize = 4;
+    static constexpr unsigned int kMaxCacheSize = 64;
+
+    struct Report {
+        float acmrBefore = 0.0f;
+        float acmrAfter = 0.0f;
+        size_t triangleCount = 0;
+        qint64 elapsedMs = 0;
+    };
+
+    // 对网格依次执行顶点缓存优化与顶点读取顺序优化，返回前后 ACMR（重排与统计使用同一缓存容量）
+    static Report optimize(Mesh& mesh, unsigned int cacheSize = 32);
+
+    // FIFO 缓存模拟的 ACMR
+    static float computeACMR(const std::vector<unsigned int>& triangles, size_t vertexCount,
+                             unsigned int cacheSize = 32);
+
+    // 原地重排三角形顺序以提高顶点后变换缓存命中率；按 cacheSize 个条目的 LRU 缓存评分
+    static void optimizeVertexCache(std::vector<unsigned int>& triangles, size_t vertexCount,
+                                    unsigned int cacheSize = 32);
+
+    // 把缓存容量限制在 [kMinCacheSize, kMaxCacheSize]
+    static unsigned int clampCacheSize(unsigned int cacheSize);
+
+    // 计算顶点按首次被三角形引用的顺序的新编号（未被引用的顶点排在最后），返回 旧编号 -> 新编号
+    static std::vector<uint32_t> computeVertexFetchRemap(const std::vector<unsigned int>& triangles,
+                                                         size_t vertexCount);
+};
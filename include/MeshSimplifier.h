@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cfloat>
+
+class Mesh;
+
+// 基于二次误差度量（Garland-Heckbert QEM）的边折叠网格简化。
+// 按误差从小到大用堆依次折叠边，直到达到目标面数或误差上限。
+class MeshSimplifier {
+public:
+    struct Options {
+        size_t targetTriangleCount = 0;    // 目标三角形数（0 表示只受误差上限约束）
+        float maxError = FLT_MAX;          // 允许的最大几何误差（模型单位，米）
+        bool preserveBoundary = true;      // 锁定开放边界上的顶点，保持轮廓不变
+    };
+
+    struct Result {
+        size_t originalTriangles = 0;
+        size_t resultTriangles = 0;
+        size_t originalVertices = 0;
+        size_t resultVertices = 0;
+    };
+
+    // 串行简化（直接修改 mesh）
+    static Result simplify(Mesh& mesh, const Options& options);
+
+    // 分区并行简化：按空间切分为若干块并行简化，跨块共享的顶点被锁定；
+    // 各块完成后只对接缝顶点及其 1 环做串行收尾，沿用各块累积的二次型，误差上限对整个过程有效
+    // （有目标面数且已达到时跳过）。partitions=0 时按线程数决定
+    static Result simplifyParallel(Mesh& mesh, const Options& options, size_t partitions = 0);
+};
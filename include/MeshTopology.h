@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+// 有向边（directed-edge）网格拓扑：三角形 f 的第 k 条半边编号为 3f+k，
+// 由 tri[3f+k] 指向 tri[3f+(k+1)%3]，next/prev/face 都由编号直接算出。
+// 对边表与顶点出边表（CSR）都是扁平数组：构建时按起点对半边键做并行基数排序，
+// 再在终点的出边中查找反向半边得到对边，无需哈希表。
+class MeshTopology {
+public:
+    // opposite() 的特殊值
+    static constexpr uint32_t kBoundary = 0xffffffffu;     // 边界边：没有对边
+    static constexpr uint32_t kNonManifold = 0xfffffffeu;  // 非流形边：3 个以上面片共享，或两面片同向
+    static constexpr uint32_t kIgnored = 0xfffffffdu;      // 所在三角形退化或索引越界，不参与拓扑
+    static constexpr uint32_t kInvalid = 0xffffffffu;      // 查询结果中的“无”
+
+    struct Stats {
+        size_t vertexCount = 0;
+        size_t faceCount = 0;
+        size_t ignoredFaceCount = 0;       // 退化/越界三角形
+        size_t edgeCount = 0;              // 无向边数
+        size_t boundaryEdgeCount = 0;
+        size_t nonManifoldEdgeCount = 0;
+        size_t nonManifoldVertexCount = 0; // 邻接面片不构成单个扇形的顶点
+        size_t isolatedVertexCount = 0;    // 未被任何三角形引用
+        size_t boundaryLoopCount = 0;
+        long long eulerCharacteristic = 0; // V - E + F（不计孤立顶点与忽略的面）
+        bool closed = false;               // 无边界边且无非流形边
+        bool manifold = false;             // 无非流形边且无非流形顶点
+    };
+
+    // 顶点出边列表（半边编号）
+    struct HalfEdgeRange {
+        const uint32_t* first = nullptr;
+        const uint32_t* last = nullptr;
+        const uint32_t* begin() const { return first; }
+        const uint32_t* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+    };
+
+    void build(size_t vertexCount, const std::vector<unsigned int>& triangles);
+
+    bool empty() const { return triangles_.empty(); }
+    size_t vertexCount() const { return stats_.vertexCount; }
+    size_t faceCount() const { return stats_.faceCount; }
+    size_t halfEdgeCount() const { return triangles_.size(); }
+    const Stats& stats() const { return stats_; }
+
+    // 半边导航，均为 O(1)
+    static uint32_t face(uint32_t h) { return h / 3; }
+    static uint32_t next(uint32_t h) { return h % 3 == 2 ? h - 2 : h + 1; }
+    static uint32_t prev(uint32_t h) { return h % 3 == 0 ? h + 2 : h - 1; }
+    uint32_t source(uint32_t h) const { return triangles_[h]; }
+    uint32_t target(uint32_t h) const { return triangles_[next(h)]; }
+    uint32_t opposite(uint32_t h) const { return opposite_[h]; }
+    bool hasOpposite(uint32_t h) const { return opposite_[h] < kIgnored; }
+    bool isBoundaryEdge(uint32_t h) const { return opposite_[h] == kBoundary; }
+
+    // 顶点的出边：O(1) 定位，O(k) 遍历
+    HalfEdgeRange outgoing(uint32_t v) const {
+        return { outgoing_.data() + vertexOffsets_[v], outgoing_.data() + vertexOffsets_[v + 1] };
+    }
+    size_t valence(uint32_t v) const { return vertexOffsets_[v + 1] - vertexOffsets_[v]; }
+    bool isBoundaryVertex(uint32_t v) const;
+
+    // 一环邻域顶点（升序、去重），O(k log k)
+    void vertexRing(uint32_t v, std::vector<uint32_t>& ring) const;
+
+    // 面片三条边对面的邻面，边界/非流形边处为 kInvalid，O(1)
+    void faceNeighbors(uint32_t f, uint32_t neighbors[3]) const;
+
+    // 边界环（每个环为首尾相接的顶点序列）与非流形边（顶点对，小编号在前）
+    const std::vector<std::vector<uint32_t>>& boundaryLoops() const { return boundaryLoops_; }
+    const std::vector<std::pair<uint32_t, uint32_t>>& nonManifoldEdges() const { return nonManifoldEdges_; }
+
+private:
+    void buildVertexIndex(int vertexBits);
+    void buildEdges();
+    void classifyVertices();
+    void traceBoundaryLoops();
+
+    std::vector<uint32_t> triangles_;      // 三角形顶点（半边 h 的起点为 triangles_[h]）
+    std::vector<uint32_t> opposite_;       // 每条半边的对边或特殊值
+    std::vector<uint32_t> vertexOffsets_;  // 顶点 v 的出边位于 outgoing_[offsets[v], offsets[v+1])
+    std::vector<uint32_t> outgoing_;
+    std::vector<std::vector<uint32_t>> boundaryLoops_;
+    std::vector<std::pair<uint32_t, uint32_t>> nonManifoldEdges_;
+    Stats stats_;
+};
@@ -3,10 +3,13 @@
 #include <QString>
 #include <QVector3D>
 #include <QColor>
+#include <QMatrix4x4>
 #include <vector>
 #include <memory>
 #include "Vertex.h"
 #include "AABB.h"
+#include "AttributeChannel.h"
+#include "BitMask.h"
 
 class Model {
 public:
@@ -20,10 +23,14 @@ public:
     size_t getVertexCount() const { return vertices_.size(); }
     size_t getTriangleCount() const { return triangles_.size() / 3; }
     
-    // 颜色属性
+    // 颜色属性：color_ 为模型整体覆盖色，只在渲染时生效，逐顶点颜色保持不变
     QColor getColor() const { return color_; }
-    void setColor(const QColor& color);
-    void updateVertexColors(const QColor& color);
+    void setColor(const QColor& color);           // O(1)：设置覆盖色并启用覆盖
+    bool hasColorOverride() const { return colorOverride_; }
+    void clearColorOverride() { colorOverride_ = false; }
+    // 按需把覆盖色写入所有顶点颜色，随后关闭覆盖
+    void bakeColor();
+    virtual void updateVertexColors(const QColor& color);
     
     // 变换操作
     virtual void translate(const QVector3D& offset);
@@ -33,6 +40,8 @@ public:
     virtual void translateToCm(const QVector3D& positionCm);
     virtual void rotate(const QVector3D& axis, float angle);
     virtual void scale(const QVector3D& factors);
+    // 刚体变换（如配准结果）：变换所有顶点坐标，法线按旋转部分变换
+    virtual void applyTransform(const QMatrix4x4& matrix);
     
     // 核心计算
     // 注意：以下返回值单位调整为厘米（cm）
@@ -43,6 +52,59 @@ public:
     const std::vector<Vertex>& getVertices() const { return vertices_; }
     const std::vector<unsigned int>& getTriangles() const { return triangles_; }
     
+    // 逐顶点属性通道（列式存储），长度与顶点数一致，顶点重排/合并/增删时同步调整。
+    // 返回的指针在下一次 addAttribute/removeAttribute 前有效
+    AttributeChannel* addAttribute(const QString& name, AttributeChannel::Type type);
+    AttributeChannel* addAttribute(AttributeChannel&& channel);   // 长度须与顶点数一致
+    AttributeChannel* findAttribute(const QString& name);
+    const AttributeChannel* findAttribute(const QString& name) const;
+    void removeAttribute(const QString& name);
+    void clearAttributes();
+    const std::vector<AttributeChannel>& getAttributes() const { return attributes_; }
+    // 按 newToOld（新编号 -> 旧编号）重排/筛选所有通道，供改变顶点顺序的算法调用
+    void remapAttributes(const std::vector<uint32_t>& newToOld);
+    
+    // 伪彩色“属性”模式使用的通道；名称为空或通道不存在时不着色
+    void setActiveAttribute(const QString& name) { activeAttribute_ = name; }
+    QString getActiveAttributeName() const { return activeAttribute_; }
+    const AttributeChannel* getActiveAttribute() const;
+    
+    // 逐顶点标量（如偏差距离）：写入同名 float32 通道并设为当前着色通道
+    void setScalarField(const QString& name, std::vector<float>&& values);
+    
+    // 逐顶点位掩码图层（每顶点 1 位）：长度与顶点数一致时有效，顶点重排/合并时与属性通道同步调整。
+    // 过滤、裁切图层中置位的顶点被隐藏（渲染、导出、统计都跳过，网格中含隐藏顶点的三角形不绘制），
+    // 选择图层只用于高亮和编辑。隐藏只需每顶点 1 位，不复制顶点数据；需要真正去掉时用 compactVisible 显式压缩
+    enum MaskLayer {
+        FilterLayer,        // 按条件过滤掉的顶点
+        SelectionLayer,     // 选中的顶点
+        ClipLayer,          // 被剖切面等裁掉的顶点
+        MaskLayerCount
+    };
+    const BitMask& getMask(MaskLayer layer) const { return masks_[layer]; }
+    BitMask& mask(MaskLayer layer);       // 长度与顶点数不一致时先重置为全 0
+    bool hasMask(MaskLayer layer) const { return masks_[layer].size() == vertices_.size() && masks_[layer].any(); }
+    size_t getMaskCount(MaskLayer layer) const;
+    void clearMask(MaskLayer layer) { masks_[layer].clear(); }
+    
+    // 可见 = 未被过滤且未被裁切
+    bool hasHiddenVertices() const { return hasMask(FilterLayer) || hasMask(ClipLayer); }
+    BitMask visibleMask() const;          // 按字并行合成
+    size_t getVisibleCount() const;
+    
+    // 选择图层的便捷接口
+    const BitMask& getSelection() const { return masks_[SelectionLayer]; }
+    BitMask& selection() { return mask(SelectionLayer); }
+    bool hasSelection() const { return hasMask(SelectionLayer); }
+    size_t getSelectedCount() const { return getMaskCount(SelectionLayer); }
+    void clearSelection() { clearMask(SelectionLayer); }
+    
+    // 按掩码提取顶点为新模型（并行拷贝顶点、颜色与属性通道，不带掩码图层）；
+    // 网格只保留三个顶点都被提取的三角形。keep 长度须与顶点数一致，否则得到空模型
+    virtual std::shared_ptr<Model> extractVertices(const BitMask& keep, const QString& name) const = 0;
+    // 显式压缩：只含可见顶点的新模型
+    std::shared_ptr<Model> compactVisible(const QString& name) const { return extractVertices(visibleMask(), name); }
+    
     // 虚函数 - 子类必须实现
     virtual void update() = 0;
     virtual void render() = 0;
@@ -54,11 +116,21 @@ public:
 protected:
     QString name_;
     QColor color_;
+    bool colorOverride_ = false;
     std::vector<Vertex> vertices_;
     std::vector<unsigned int> triangles_;
     QVector3D position_;
     QVector3D rotation_;
     QVector3D scale_;
     
+    // 顶点数变化后（追加顶点）把各通道长度对齐到顶点数
+    void syncAttributeSizes();
+    // 整体替换顶点后丢弃长度与顶点数不一致的通道
+    void dropMismatchedAttributes();
+    
+    std::vector<AttributeChannel> attributes_;
+    QString activeAttribute_;
+    BitMask masks_[MaskLayerCount];
+    
     static int totalModelCount_;
 };
\ No newline at end of file
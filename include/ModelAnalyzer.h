@@ -4,16 +4,111 @@
 #include <QVector3D>
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include "AABB.h"
+#include "PointCloud.h"
 
 class Model;
-class PointCloud;
 class Mesh;
 
 class ModelAnalyzer {
 public:
+    // 距离/偏差统计（单位与输入一致）；百分位数基于绝对值
+    struct DistanceStats {
+        size_t count = 0;
+        float mean = 0.0f;         // 平均值（有符号）
+        float meanAbs = 0.0f;      // 平均绝对值
+        float rms = 0.0f;
+        float minValue = 0.0f;
+        float maxValue = 0.0f;
+        float p50 = 0.0f;
+        float p90 = 0.0f;
+        float p95 = 0.0f;
+        float p99 = 0.0f;
+    };
+    
+    // 连通分量 / 聚类统计（长度单位米，面积 m²）
+    struct ComponentStats {
+        size_t elementCount = 0;   // 三角形数（网格分量）或点数（点云聚类）
+        size_t vertexCount = 0;
+        double area = 0.0;         // 网格分量的表面积；点云聚类为 0
+        QVector3D centroid;        // 顶点重心
+        AABB bounds;
+    };
+    static constexpr uint32_t kNoComponent = 0xffffffffu;
+    
+    // 平面剖切结果（米）：平面为 normal·p = offset，normal 为单位向量
+    struct Section {
+        std::vector<std::vector<QVector3D>> polylines;   // 截线折线；闭合折线不重复首点
+        std::vector<uint8_t> closed;                     // 对应折线是否闭合（1 为闭合）
+        double length = 0.0;                             // 截线总长
+        size_t segmentCount = 0;                         // 被平面切到的三角形数
+    };
+
+    // 分析报告；模型有隐藏（过滤/裁切）的顶点时计数、重心、包围盒（网格另含面积与拓扑）只统计可见部分，
+    // 有选中的顶点时附带选中部分的统计
     static QString analyzePointCloud(std::shared_ptr<PointCloud> pointCloud);
     static QString analyzeMesh(std::shared_ptr<Mesh> mesh);
     
+    // 掩码子集统计（按 64 位字分块并行）：vertexCount 为置位顶点数，
+    // 网格另统计三个顶点都在子集内的三角形数（elementCount）与其面积；点云 elementCount 即点数
+    static ComponentStats computeMaskedStats(const Model& model, const BitMask& mask);
+    
+    // 图层掩码构造（按 64 位字并行，每个字只由一个线程写出）；mask 被重置为对应长度。
+    // 平面正侧（normal·p > offset）的顶点置位，用作裁切图层
+    static void markAbovePlane(const Model& model, const QVector3D& normal, float offset, BitMask& mask);
+    // 通道值不在 [minValue, maxValue] 内（含 NaN）的元素置位，用作过滤图层
+    static void markOutsideRange(const AttributeChannel& channel, double minValue, double maxValue, BitMask& mask);
+    
+    // 点云到参考网格的逐点距离（米，并行计算，使用网格的 BVH）。
+    // signedDistance 为 true 时按最近点处的角度加权伪法线取符号（法线一侧为正），最近点落在共享边/顶点上时符号也一致。
+    // 点云有过滤/裁切图层时隐藏点不计算，距离为 NaN
+    static std::vector<float> computeCloudToMeshDistances(std::shared_ptr<PointCloud> pointCloud,
+                                                          std::shared_ptr<Mesh> mesh,
+                                                          bool signedDistance = true);
+    
+    // 点云到点云偏差：对 compared 中每个点在 reference 中求最近点（k-d 树，并行），
+    // 距离（米）写入 compared 的属性通道，返回统计（compared 中隐藏点的距离为 NaN，不计入统计）
+    static DistanceStats computeCloudToCloudDistances(std::shared_ptr<PointCloud> compared,
+                                                      std::shared_ptr<PointCloud> reference);
+    
+    // NaN 视为缺失值，不计入 count 与各项统计
+    static DistanceStats computeStatistics(const std::vector<float>& values);
+    
+    // 网格连通分量：共享顶点的三角形属于同一分量（并发并查集，按三角形并行合并）。
+    // 分量按三角形数降序编号，faceLabels 为每个三角形的分量编号（索引越界的三角形为 kNoComponent）
+    static std::vector<ComponentStats> computeMeshComponents(std::shared_ptr<Mesh> mesh,
+                                                             std::vector<uint32_t>& faceLabels);
+    
+    // 点云欧氏聚类：距离不超过 radius（米）的点属于同一聚类（k-d 树半径查询 + 并发并查集，按点并行）。
+    // 点数不在 [minSize, maxSize] 内的聚类被丢弃；保留的聚类按点数降序编号，
+    // pointLabels 为每个点的聚类编号（被丢弃的点为 kNoComponent）。被过滤/裁切图层隐藏的点不参与聚类，也为 kNoComponent
+    static std::vector<ComponentStats> computeEuclideanClusters(std::shared_ptr<PointCloud> pointCloud,
+                                                                float radius, size_t minSize, size_t maxSize,
+                                                                std::vector<uint32_t>& pointLabels);
+    
+    // 网格平面剖切：用网格的 BVH 只访问与平面相交的节点，截线段按所在网格棱拼接为折线
+    // （流形网格上的截线为闭合环，开放边界处为开放折线）
+    static Section computeMeshSection(std::shared_ptr<Mesh> mesh, const QVector3D& normal, float offset);
+    
+    // 批量剖切：offset 在 [firstOffset, lastOffset] 上等距取 count 个平面，按平面并行
+    static std::vector<Section> computeMeshSections(std::shared_ptr<Mesh> mesh, const QVector3D& normal,
+                                                    float firstOffset, float lastOffset, int count);
+    
+    // 点云薄片：|normal·p - offset| <= halfThickness 的点编号（升序）。
+    // chunks 为点云的区间划分（通常取 PointCloud::getChunks() 的缓存），拖动剖切面时重复使用；
+    // 包围盒完全在薄片内的区间整段收录，与薄片相离的区间直接跳过
+    static std::vector<uint32_t> extractPointSlab(std::shared_ptr<PointCloud> pointCloud,
+                                                  const std::vector<PointCloud::PointChunk>& chunks,
+                                                  const QVector3D& normal, float offset, float halfThickness);
+    
+    // 批量薄片：与 computeMeshSections 取相同的 count 个平面，逐点并行标记所属薄片编号
+    // （距离最近的平面在 halfThickness 内时为该平面序号，否则为 kNoComponent），可直接用于 splitByLabels
+    static std::vector<uint32_t> computePointSlabLabels(std::shared_ptr<PointCloud> pointCloud, const QVector3D& normal,
+                                                        float firstOffset, float lastOffset, int count,
+                                                        float halfThickness);
+    
 private:
     static QString formatVector3D(const QVector3D& vec);
+    static QString formatMaskedStats(const Model& model, bool mesh);
 };
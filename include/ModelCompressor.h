@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QString>
+#include <QVector3D>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Vertex.h"
+
+// 压缩存档格式（.3dvz）：顶点按量化坐标的 Morton 码排序后，Morton 码、法线与颜色做相邻差分，
+// 三角形把最小索引轮换到首位（保持绕序）并按首索引排序后做差分，全部残差用自包含的区间编码器熵编码。
+// 顶点与三角形各自按固定数量分块，块之间上下文独立，编码与解码都按块并行。
+// 坐标为有损（每轴 positionBits 位，误差不超过半个量化步长），法线以八面体映射量化为每分量 10 位，颜色无损。
+// 文件布局：Header | 各块字节数（先顶点块后三角形块，uint64） | 各块数据
+class ModelCompressor {
+public:
+    struct Options {
+        int positionBits = 18;              // 每轴量化位数，[8, 21]
+        size_t blockVertices = 65536;
+        size_t blockTriangles = 65536;
+    };
+
+    // rawBytes 为同样内容的二进制 PLY 数据量（float 坐标 / 法线、uchar 颜色、uchar + 3 * int 面），用于计算压缩比
+    struct Stats {
+        size_t vertexCount = 0;
+        size_t triangleCount = 0;
+        qint64 rawBytes = 0;
+        qint64 compressedBytes = 0;
+        QVector3D maxError;                 // 每轴坐标误差上界（米）
+        qint64 elapsedMs = 0;
+        double ratio() const { return compressedBytes > 0 ? double(rawBytes) / double(compressedBytes) : 0.0; }
+        // 按未压缩数据量计的吞吐（MB/s）
+        double throughput() const { return elapsedMs > 0 ? rawBytes / 1048576.0 / (elapsedMs / 1000.0) : 0.0; }
+    };
+
+    // 写出压缩文件。顶点经排列下标按 Morton 序读取，输入不被修改，可直接传入模型自身的数组；
+    // triangles 为空时作为点云
+    static bool write(const QString& path, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& triangles,
+                      const Options& options, Stats* stats = nullptr);
+
+    // 读取压缩文件；数据损坏或不完整时返回 false
+    static bool read(const QString& path, std::vector<Vertex>& vertices, std::vector<unsigned int>& triangles,
+                     Stats* stats = nullptr);
+};
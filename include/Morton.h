@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QVector3D>
+#include <cstdint>
+#include "AABB.h"
+
+// Morton（Z 曲线）编码：把三个 21 位整数坐标按位交织成 63 位键。
+// 键相近的点在空间上也相近，按键排序即可获得较好的空间局部性。
+namespace Morton {
+
+constexpr int kBitsPerAxis = 21;
+constexpr uint32_t kMaxCoord = (1u << kBitsPerAxis) - 1;
+
+// 把 21 位整数的每一位之间插入两个 0
+inline uint64_t expandBits(uint32_t v) {
+    uint64_t x = v & 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffffULL;
+    x = (x | x << 16) & 0x1f0000ff0000ffULL;
+    x = (x | x << 8)  & 0x100f00f00f00f00fULL;
+    x = (x | x << 4)  & 0x10c30c30c30c30c3ULL;
+    x = (x | x << 2)  & 0x1249249249249249ULL;
+    return x;
+}
+
+inline uint64_t encode(uint32_t x, uint32_t y, uint32_t z) {
+    return expandBits(x) | (expandBits(y) << 1) | (expandBits(z) << 2);
+}
+
+// expandBits 的逆：取出每隔两位的位，还原 21 位整数
+inline uint32_t compactBits(uint64_t x) {
+    x &= 0x1249249249249249ULL;
+    x = (x | x >> 2)  & 0x10c30c30c30c30c3ULL;
+    x = (x | x >> 4)  & 0x100f00f00f00f00fULL;
+    x = (x | x >> 8)  & 0x1f0000ff0000ffULL;
+    x = (x | x >> 16) & 0x1f00000000ffffULL;
+    x = (x | x >> 32) & 0x1fffff;
+    return static_cast<uint32_t>(x);
+}
+
+inline void decode(uint64_t key, uint32_t& x, uint32_t& y, uint32_t& z) {
+    x = compactBits(key);
+    y = compactBits(key >> 1);
+    z = compactBits(key >> 2);
+}
+
+// 将点在包围盒内量化到 [0, 2^21) 后编码
+inline uint64_t encode(const QVector3D& p, const AABB& box) {
+    const QVector3D extent = box.size();
+    auto quantize = [](float v, float lo, float len) -> uint32_t {
+        if (len <= 0.0f) return 0;
+        float t = (v - lo) / len;
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+        return static_cast<uint32_t>(t * static_cast<float>(kMaxCoord));
+    };
+    return encode(quantize(p.x(), box.min.x(), extent.x()),
+                  quantize(p.y(), box.min.y(), extent.y()),
+                  quantize(p.z(), box.min.z(), extent.z()));
+}
+
+} // namespace Morton
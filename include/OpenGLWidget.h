@@ -4,6 +4,7 @@
 #include <QOpenGLFunctions>
 #include <QMatrix4x4>
 #include <QVector3D>
+#include <QPointF>
 #include <memory>
 #include <vector>
 
@@ -21,6 +22,8 @@ public:
     void clearModels();
     
     void setPseudoColorEnabled(bool enabled) { pseudoColorEnabled_ = enabled; update(); }
+    // 伪彩色依据：0=X, 1=Y, 2=Z, kAttributeAxis=模型当前着色的属性通道
+    static constexpr int kAttributeAxis = 3;
     void setCoordinateAxis(int axis) { coordinateAxis_ = axis; update(); }
     // 设置伪彩色坐标尺度（影响归一化范围：[-scale, scale]）
     
@@ -35,6 +38,26 @@ public:
     
     void resetCamera();
     
+    // 剖切结果叠加显示（米）：lineVertices 每两个点为一条线段，points 为高亮点，始终绘制在最上层
+    void setSectionOverlay(std::vector<QVector3D>&& lineVertices, std::vector<QVector3D>&& points);
+    void clearSectionOverlay();
+    
+    // 屏幕选择工具：启用后左键拖动绘制矩形 / 套索，松开时选择当前模型（未选模型时为全部模型）
+    // 投影在区域内的顶点；按住 Shift 并入已有选择，按住 Ctrl 从中去掉。右键平移、滚轮缩放不受影响
+    enum SelectionTool {
+        NoSelectionTool,
+        RectangleSelection,
+        LassoSelection
+    };
+    void setSelectionTool(SelectionTool tool);
+    SelectionTool selectionTool() const { return selectionTool_; }
+    
+signals:
+    // 单击拾取到网格：模型序号、三角形编号、最近顶点编号、拾取点（cm）
+    void modelPicked(int modelIndex, int triangleIndex, int vertexIndex, const QVector3D& pointCm);
+    // 屏幕选择完成：受影响模型的序号（全部模型时为 -1）
+    void selectionChanged(int modelIndex);
+    
 protected:
     void initializeGL() override;
     void resizeGL(int w, int h) override;
@@ -53,6 +76,12 @@ private:
     void drawModels();
     void updateProjection();
     void computePseudoColor(float t, float& r, float& g, float& b) const;
+    // 由屏幕坐标生成射线（世界坐标，cm）并与各网格的 BVH 求交
+    void pickAt(const QPoint& pos);
+    void drawPickMarker();
+    void drawSectionOverlay();
+    void applySelection(Qt::KeyboardModifiers modifiers);
+    void drawSelectionOutline();
     // 已弃用的 mapCoordToT 移除，采用帧内局部快速映射（见 drawModels）
     
     // 相机参数
@@ -69,6 +98,7 @@ private:
     
     // 鼠标交互
     QPoint lastMousePos_;
+    QPoint pressMousePos_;   // 按下位置：松开时移动很小则视为单击拾取
     bool mousePressed_;
     Qt::MouseButton mouseButton_;
     
@@ -76,11 +106,24 @@ private:
     std::vector<std::shared_ptr<Model>> models_;
     int selectedModelIndex_;
     
+    // 拾取结果
+    bool hasPickedPoint_ = false;
+    QVector3D pickedPointCm_;
+    
+    // 剖切叠加层（米）
+    std::vector<QVector3D> sectionLines_;
+    std::vector<QVector3D> sectionPoints_;
+    
+    // 屏幕选择
+    SelectionTool selectionTool_ = NoSelectionTool;
+    bool selecting_ = false;
+    std::vector<QPointF> selectionPath_;   // 矩形为起点与当前点，套索为鼠标轨迹（像素）
+    
     // 可视化选项
     bool showGrid_;
     bool showAxes_;
     bool pseudoColorEnabled_;
-    int coordinateAxis_; // 0=X, 1=Y, 2=Z
+    int coordinateAxis_; // 0=X, 1=Y, 2=Z, 3=属性通道
     int colorMapMode_; // 0=Rainbow, 1=Viridis, 2=Red-Blue
     
     // 单位换算：内部几何按米(m)存储，显示/伪彩色统一用厘米(cm)
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+
+// 开放寻址（线性探测）哈希表：键值分开连续存储，容量为 2 的幂。
+// 只支持插入与查找（导入/焊接等一次性构建场景不需要删除），
+// 相比 std::unordered_map 没有逐节点分配，适合千万级条目。
+template <typename Key, typename Value, typename Hash>
+class OpenHashMap {
+public:
+    explicit OpenHashMap(size_t expectedCount = 0) { reserve(expectedCount); }
+
+    // 预留至少能容纳 expectedCount 个条目的容量（装载因子 <= 0.5）
+    void reserve(size_t expectedCount) {
+        size_t capacity = 16;
+        while (capacity < expectedCount * 2) capacity <<= 1;
+        if (capacity > keys_.size()) rehash(capacity);
+    }
+
+    // 插入键；若已存在则返回已有值。返回 (值指针, 是否为新插入)
+    std::pair<Value*, bool> insert(const Key& key, const Value& value) {
+        if ((size_ + 1) * 2 > keys_.size()) rehash(keys_.size() * 2);
+        size_t mask = keys_.size() - 1;
+        size_t slot = hash_(key) & mask;
+        while (used_[slot]) {
+            if (keys_[slot] == key) return { &values_[slot], false };
+            slot = (slot + 1) & mask;
+        }
+        used_[slot] = 1;
+        keys_[slot] = key;
+        values_[slot] = value;
+        ++size_;
+        return { &values_[slot], true };
+    }
+
+    const Value* find(const Key& key) const {
+        if (size_ == 0) return nullptr;
+        size_t mask = keys_.size() - 1;
+        size_t slot = hash_(key) & mask;
+        while (used_[slot]) {
+            if (keys_[slot] == key) return &values_[slot];
+            slot = (slot + 1) & mask;
+        }
+        return nullptr;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void clear() {
+        std::fill(used_.begin(), used_.end(), 0);
+        size_ = 0;
+    }
+
+    // 遍历所有条目：func(const Key&, Value&)
+    template <typename Func>
+    void forEach(Func&& func) {
+        for (size_t i = 0; i < keys_.size(); ++i) {
+            if (used_[i]) func(keys_[i], values_[i]);
+        }
+    }
+
+private:
+    void rehash(size_t newCapacity) {
+        std::vector<Key> oldKeys;
+        std::vector<Value> oldValues;
+        std::vector<uint8_t> oldUsed;
+        oldKeys.swap(keys_);
+        oldValues.swap(values_);
+        oldUsed.swap(used_);
+
+        keys_.resize(newCapacity);
+        values_.resize(newCapacity);
+        used_.assign(newCapacity, 0);
+        size_ = 0;
+
+        size_t mask = newCapacity - 1;
+        for (size_t i = 0; i < oldKeys.size(); ++i) {
+            if (!oldUsed[i]) continue;
+            size_t slot = hash_(oldKeys[i]) & mask;
+            while (used_[slot]) slot = (slot + 1) & mask;
+            used_[slot] = 1;
+            keys_[slot] = oldKeys[i];
+            values_[slot] = oldValues[i];
+            ++size_;
+        }
+    }
+
+    std::vector<Key> keys_;
+    std::vector<Value> values_;
+    std::vector<uint8_t> used_;
+    size_t size_ = 0;
+    Hash hash_;
+};
+
+// 64 位整数混洗（splitmix64 末段），供各处组合键哈希使用
+inline uint64_t hashMix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
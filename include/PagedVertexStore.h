@@ -0,0 +1,144 @@
+#pragma once
+
+#include <QString>
+#include <QFile>
+#include <QColor>
+#include <QMatrix4x4>
+#include <vector>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include "Vertex.h"
+#include "AABB.h"
+
+// 外存顶点存储：顶点以定长记录按固定点数分块写入磁盘文件，读取时按块用 QFile::map 映射，
+// 同时映射的块总字节数受工作集上限约束，超出时按最近最少使用（LRU）解除映射，物理内存由操作系统按需换页。
+// 文件尾部的块目录记录每块的包围盒与坐标和，包围盒 / 重心无需读取顶点数据。
+// 变换与整体着色为 O(1)：只记录待应用的矩阵与颜色，读取顶点时（decode / sample）即时应用，
+// 包围盒与重心由块目录推得；bake 才把它们写回文件。
+// 文件布局：Header | 块 0 | 块 1 | ... | 块目录（每块一个 ChunkInfo）
+class PagedVertexStore {
+public:
+    // 磁盘上的顶点记录（28 字节，按主机字节序）
+    struct Record {
+        float position[3];
+        float normal[3];
+        uint8_t color[4];
+    };
+
+    // 块目录项
+    struct ChunkInfo {
+        uint64_t begin = 0;                 // 首个顶点编号
+        uint64_t count = 0;
+        float min[3] = {0.0f, 0.0f, 0.0f};
+        float max[3] = {0.0f, 0.0f, 0.0f};
+        double sum[3] = {0.0, 0.0, 0.0};    // 坐标和，用于重心
+    };
+
+    // 已映射的块；持有 ChunkRef 期间该块不会被解除映射
+    struct Chunk {
+        size_t index = 0;
+        Record* records = nullptr;          // 只读打开时不可写入
+        size_t count = 0;
+    };
+    using ChunkRef = std::shared_ptr<const Chunk>;
+
+    static constexpr size_t kDefaultChunkPoints = size_t(1) << 20;             // 每块 1M 点（28 MB）
+    static constexpr size_t kDefaultWorkingSetBytes = size_t(2) << 30;         // 2 GB
+
+    ~PagedVertexStore();
+    PagedVertexStore(const PagedVertexStore&) = delete;
+    PagedVertexStore& operator=(const PagedVertexStore&) = delete;
+
+    // 新建存储文件并进入写入阶段：append 顺序追加顶点，finish 写出目录后才可读取。失败时返回空
+    static std::shared_ptr<PagedVertexStore> create(const QString& path, size_t chunkPoints = kDefaultChunkPoints);
+    bool append(const Vertex* vertices, size_t count);
+    bool append(const Record* records, size_t count);
+    bool finish();
+
+    // 打开已有的存储文件（可写失败时以只读方式打开）。失败时返回空
+    static std::shared_ptr<PagedVertexStore> open(const QString& path);
+
+    // 析构时删除文件（导入时生成的临时缓存使用）
+    void setRemoveOnClose(bool remove) { removeOnClose_ = remove; }
+    QString path() const { return file_.fileName(); }
+    bool isWritable() const { return writable_; }
+
+    size_t size() const { return pointCount_; }
+    size_t chunkPoints() const { return chunkPoints_; }
+    size_t chunkCount() const { return directory_.size(); }
+    const ChunkInfo& chunkInfo(size_t chunk) const { return directory_[chunk]; }
+    AABB chunkBounds(size_t chunk) const;
+
+    // 由块目录合并，不读取顶点数据。有待应用的变换时取块包围盒 8 个角点变换后的包围盒
+    // （平移与轴向缩放下精确，含旋转时偏保守）；重心为块坐标和的重心经变换（仿射变换下精确）
+    AABB bounds() const;
+    QVector3D center() const;
+
+    // 工作集：同时映射的块总字节数上限（被持有的块不计入淘汰，可能暂时超出）
+    void setWorkingSetLimit(size_t bytes);
+    size_t workingSetLimit() const { return workingSetLimit_; }
+    size_t residentBytes() const;
+
+    // 映射块（已映射时只调整 LRU 次序）；失败时返回空
+    ChunkRef acquire(size_t chunk);
+
+    // 按块并行流式遍历，每个线程同一时刻只持有一个块。返回 false 表示有块映射失败
+    bool forEachChunk(const std::function<void(const Chunk&)>& func);
+
+    // 待应用的修改（O(1)，不访问文件）：坐标按 matrix 变换，法线按其法线矩阵（逆转置）变换后归一化；
+    // 多次变换依次复合。setColor 覆盖全部点的颜色
+    void transform(const QMatrix4x4& matrix);
+    void setColor(const QColor& color);
+    bool hasPendingChanges() const { return transformed_ || colorOverride_; }
+
+    // 把待应用的修改流式写回映射的文件并重算块目录（耗时与文件大小成正比，应在工作线程调用，
+    // 期间不得并发读取或修改）。bakedChunks 非空时按块累加进度。只读打开时返回 false
+    bool bake(std::atomic<size_t>* bakedChunks = nullptr);
+
+    // 读取块中的顶点：应用待应用的变换与颜色
+    Vertex decode(const Record& record) const;
+
+    // 全局等步长抽样，最多 maxPoints 个点（用于内存中的预览）
+    std::vector<Vertex> sample(size_t maxPoints);
+
+    static Record toRecord(const Vertex& vertex);
+    static Vertex toVertex(const Record& record);
+
+private:
+    PagedVertexStore() = default;
+
+    bool flushPending();
+    bool writeDirectory();
+    void updateChunkInfo(ChunkInfo& info, const Record* records, size_t count) const;
+    void evict();
+    qint64 chunkOffset(size_t chunk) const;
+
+    mutable QFile file_;
+    bool writable_ = false;
+    bool writing_ = false;
+    bool removeOnClose_ = false;
+    size_t pointCount_ = 0;
+    size_t chunkPoints_ = kDefaultChunkPoints;
+    std::vector<ChunkInfo> directory_;
+    std::vector<Record> pending_;                   // 写入阶段尚未凑满一块的记录
+
+    // 待应用的修改
+    QMatrix4x4 pendingTransform_;
+    QMatrix3x3 pendingNormalMatrix_;                // pendingTransform_ 的法线矩阵（逆转置），随之更新
+    bool transformed_ = false;
+    uint8_t overrideColor_[4] = {0, 0, 0, 0};
+    bool colorOverride_ = false;
+
+    // 映射缓存：mapped_[i] 非空表示块 i 已映射；lru_ 头部为最近使用
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<Chunk>> mapped_;
+    std::list<size_t> lru_;
+    std::vector<std::list<size_t>::iterator> lruPosition_;
+    size_t residentBytes_ = 0;
+    size_t workingSetLimit_ = kDefaultWorkingSetBytes;
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+// 轻量并行工具：把区间切成连续块交给 std::thread 执行。
+// 块划分只取决于 (元素数, 块数)，因此同样的输入总是得到同样的划分，
+// 便于按块做“统计 -> 前缀和 -> 写回”的两遍式并行算法。
+class Parallel {
+public:
+    static size_t threadCount() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n > 0 ? n : 1;
+    }
+
+    // 根据元素数量与最小块大小估算块数（不超过线程数）
+    static size_t chunkCount(size_t count, size_t minChunk = 16384) {
+        if (count == 0) return 1;
+        size_t chunks = (count + minChunk - 1) / std::max<size_t>(minChunk, 1);
+        return std::max<size_t>(1, std::min(chunks, threadCount()));
+    }
+
+    // 第 chunk 块的起止位置
+    static size_t chunkBegin(size_t count, size_t chunks, size_t chunk) {
+        return static_cast<size_t>(static_cast<unsigned long long>(count) * chunk / chunks);
+    }
+
+    // func(chunkIndex, begin, end)：每块一个线程，第 0 块在调用线程执行
+    template <typename Func>
+    static void forChunks(size_t count, size_t chunks, Func&& func) {
+        if (chunks <= 1) {
+            func(size_t(0), size_t(0), count);
+            return;
+        }
+        std::vector<std::thread> workers;
+        workers.reserve(chunks - 1);
+        for (size_t c = 1; c < chunks; ++c) {
+            size_t b = chunkBegin(count, chunks, c);
+            size_t e = chunkBegin(count, chunks, c + 1);
+            workers.emplace_back([&func, c, b, e]() { func(c, b, e); });
+        }
+        func(size_t(0), size_t(0), chunkBegin(count, chunks, 1));
+        for (auto& worker : workers) worker.join();
+    }
+
+    // func(begin, end)：在 [begin, end) 上按块并行
+    template <typename Func>
+    static void forRange(size_t begin, size_t end, Func&& func, size_t minChunk = 16384) {
+        if (end <= begin) return;
+        const size_t count = end - begin;
+        forChunks(count, chunkCount(count, minChunk), [&](size_t, size_t b, size_t e) {
+            func(begin + b, begin + e);
+        });
+    }
+
+    // func(i)：逐元素并行
+    template <typename Func>
+    static void forEach(size_t begin, size_t end, Func&& func, size_t minChunk = 16384) {
+        forRange(begin, end, [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) func(i);
+        }, minChunk);
+    }
+
+    // 表示 [0, maxKey] 内整数所需的位数，用作 radixSortPairs 的 keyBits
+    static int keyBitsFor(uint64_t maxKey) {
+        int bits = 1;
+        while (bits < 64 && (maxKey >> bits) != 0) ++bits;
+        return bits;
+    }
+
+    // 并行 LSD 基数排序（稳定）：按 keys 升序同时重排 values。
+    // keyBits 为键的有效位数，每趟处理 8 位；某一趟所有键同一桶时跳过该趟。
+    static void radixSortPairs(std::vector<uint64_t>& keys, std::vector<uint32_t>& values, int keyBits = 64) {
+        const size_t n = keys.size();
+        if (n < 2) return;
+        const size_t chunks = chunkCount(n, 65536);
+        std::vector<uint64_t> tmpKeys(n);
+        std::vector<uint32_t> tmpValues(n);
+        std::vector<size_t> histogram(chunks * 256);
+
+        for (int shift = 0; shift < keyBits; shift += 8) {
+            std::fill(histogram.begin(), histogram.end(), 0);
+            forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+                size_t* h = &histogram[c * 256];
+                for (size_t i = b; i < e; ++i) ++h[(keys[i] >> shift) & 0xff];
+            });
+
+            // 按 (桶, 块) 顺序计算写入偏移，保证稳定
+            size_t offset = 0;
+            bool trivial = false;
+            for (size_t digit = 0; digit < 256; ++digit) {
+                size_t bucketTotal = 0;
+                for (size_t c = 0; c < chunks; ++c) {
+                    size_t count = histogram[c * 256 + digit];
+                    histogram[c * 256 + digit] = offset;
+                    offset += count;
+                    bucketTotal += count;
+                }
+                if (bucketTotal == n) trivial = true;
+            }
+            if (trivial) continue;
+
+            forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+                size_t* h = &histogram[c * 256];
+                for (size_t i = b; i < e; ++i) {
+                    size_t dst = h[(keys[i] >> shift) & 0xff]++;
+                    tmpKeys[dst] = keys[i];
+                    tmpValues[dst] = values[i];
+                }
+            });
+            keys.swap(tmpKeys);
+            values.swap(tmpValues);
+        }
+    }
+};
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "Model.h"
+#include <vector>
+#include <memory>
+
+class PagedVertexStore;
+class QuantizedPoints;
 
 class PointCloud : public Model {
 public:
@@ -11,10 +16,60 @@ public:
     void addPoint(const QVector3D& point, const QColor& color = Qt::white);
     void addPoint(const Vertex& vertex);
     void clear();
+    // 整体替换所有点（批量导入），与新点数不一致的属性通道被丢弃
+    void setPoints(std::vector<Vertex>&& points);
+    
+    // 逐点设置颜色（数量须与点数一致）
+    void setPointColors(const std::vector<QColor>& colors);
     
     // 统计信息
     size_t getPointCount() const { return getVertexCount(); }
     
+    // 空间排序：按量化坐标的 63 位 Morton 码重排点（颜色、法线随点一起移动）。
+    // 排序后连续的点在空间上聚集，可直接把连续区间当作剔除/查询的分块
+    void sortByMorton();
+    bool isSpatiallySorted() const { return spatiallySorted_; }
+    
+    // 连续点区间及其包围盒（排序后包围盒紧凑，可用于视锥剔除）
+    struct PointChunk {
+        size_t begin = 0;
+        size_t end = 0;
+        AABB bounds;
+    };
+    std::vector<PointChunk> computeChunks(size_t pointsPerChunk = 4096) const;
+    // 缓存的 kChunkPoints 点区间（点或坐标改变后重新计算），供选择、剖切等交互查询反复使用
+    static constexpr size_t kChunkPoints = 4096;
+    const std::vector<PointChunk>& getChunks() const;
+    
+    // 按逐点标签拆分为 labelCount 个点云（标签 >= labelCount 的点被丢弃），
+    // 颜色、属性通道与当前属性随点一起复制；点的相对顺序保持不变
+    std::vector<std::shared_ptr<PointCloud>> splitByLabels(const std::vector<uint32_t>& pointLabels,
+                                                           size_t labelCount) const;
+    
+    // 提取掩码中置位的点为新点云（保持顺序），颜色、属性通道与当前属性随点复制，并行拷贝
+    std::shared_ptr<PointCloud> extractPoints(const BitMask& mask, const QString& name) const;
+    // 删除掩码中置位的点（保持其余点的顺序与空间排序状态）
+    void removePoints(const BitMask& mask);
+    std::shared_ptr<Model> extractVertices(const BitMask& keep, const QString& name) const override {
+        return extractPoints(keep, name);
+    }
+    
+    // 外存点云：全部点保存在 PagedVertexStore 中，顶点数组只保存等步长抽样的预览，供显示、选择、
+    // 剖切等交互算法使用；包围盒、重心由外存块目录得到，导出流式读取外存中的全部点。
+    // 变换与整体着色在外存中只记录为待应用状态（O(1)），读取时应用，需要时用 PagedVertexStore::bake 写回文件。
+    // 删除点、空间排序等只改变预览的操作不会写回外存
+    void attachPagedStore(std::shared_ptr<PagedVertexStore> store, size_t previewPoints);
+    bool isPaged() const { return pagedStore_ != nullptr; }
+    const std::shared_ptr<PagedVertexStore>& getPagedStore() const { return pagedStore_; }
+    size_t getTotalPointCount() const;      // 外存 / 紧凑点云为其中的全部点数，否则同 getPointCount
+    
+    // 紧凑存储：全部点量化为 QuantizedPoints（每点 9 或 11 字节，不保存法线），顶点数组同样只保存预览；
+    // 平移与缩放为 O(1)，其余语义同外存点云。与外存存储互斥，外存点云返回 false
+    bool setCompactStorage(int precisionBits, size_t previewPoints);
+    void clearCompactStorage();             // 反量化全部点回到浮点顶点数组
+    bool isCompact() const { return quantized_ != nullptr; }
+    const std::shared_ptr<QuantizedPoints>& getQuantizedPoints() const { return quantized_; }
+    
     // 计算结果缓存
     QVector3D computeCenter() const override;
     AABB computeAABB() const override;
@@ -24,6 +79,8 @@ public:
     void translateTo(const QVector3D& position) override;
     void rotate(const QVector3D& axis, float angle) override;
     void scale(const QVector3D& factors) override;
+    void applyTransform(const QMatrix4x4& matrix) override;
+    void updateVertexColors(const QColor& color) override;
     
     // 重写虚函数
     void update() override;
@@ -40,6 +97,11 @@ private:
     void updateStatistics() const;
     
     mutable bool statsDirty_;
+    bool spatiallySorted_;
     mutable QVector3D cachedCenter_;
     mutable AABB cachedAABB_;
+    mutable std::vector<PointChunk> cachedChunks_;
+    mutable bool chunksDirty_ = true;
+    std::shared_ptr<PagedVertexStore> pagedStore_;
+    std::shared_ptr<QuantizedPoints> quantized_;
 };
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QVector3D>
+#include <QColor>
+#include <QMatrix4x4>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "Vertex.h"
+#include "AABB.h"
+
+// 量化点坐标：相对包围盒把每轴量化为 16 位或 21 位整数，颜色为 RGB8，不保存法线。
+// 16 位每点 9 字节，坐标按点交错存为 int16，可直接作为 GL_SHORT 顶点数组、由模型视图矩阵完成反量化；
+// 21 位每点 11 字节，三轴打包进一个 uint64。CPU 端反量化是无分支的逐分量乘加，按块处理便于编译器向量化。
+// 坐标 = origin + q * step（米），平移与缩放只改 origin / step，无需逐点修改
+class QuantizedPoints {
+public:
+    enum Precision {
+        Bits16 = 16,
+        Bits21 = 21
+    };
+
+    // 量化误差（米）：bound 为每轴理论上界（半个量化步长），
+    // maxError / rmsError 为与原始浮点坐标逐点比较的实测值（含 float 反量化的舍入，可能略大于 bound；
+    // 重新量化后按三角不等式累加为上界）
+    struct ErrorStats {
+        QVector3D bound;
+        QVector3D maxError;
+        double rmsError = 0.0;
+    };
+
+    static std::shared_ptr<QuantizedPoints> encode(const std::vector<Vertex>& vertices, Precision precision);
+
+    size_t size() const { return count_; }
+    Precision precision() const { return precision_; }
+    size_t byteSize() const;
+    static size_t bytesPerPoint(Precision precision) { return precision == Bits16 ? 9 : 11; }
+
+    const QVector3D& origin() const { return origin_; }
+    const QVector3D& step() const { return step_; }
+    const AABB& bounds() const { return bounds_; }
+    const QVector3D& center() const { return center_; }
+    const ErrorStats& error() const { return error_; }
+
+    // 原始数据：Bits16 时为 3 * size() 个 int16（交错 xyz），Bits21 时为 size() 个打包 uint64；颜色为 3 * size() 字节
+    const int16_t* positions16() const { return positions16_.data(); }
+    const uint64_t* positions21() const { return positions21_.data(); }
+    const uint8_t* colors() const { return colors_.data(); }
+
+    QVector3D position(size_t i) const;
+    // 反量化 [begin, begin + count) 的坐标到交错的 xyz（米）
+    void decodePositions(size_t begin, size_t count, float* xyz) const;
+    void decode(size_t begin, size_t count, Vertex* out) const;
+
+    void translate(const QVector3D& offset);
+    void scale(const QVector3D& factors);
+    // 一般变换：分块并行反量化、变换后按新包围盒重新量化（只含平移与轴向缩放时退化为 O(1)）
+    void transform(const QMatrix4x4& matrix);
+    void setColor(const QColor& color);
+
+private:
+    QuantizedPoints() = default;
+
+    // 按 bounds_ 与 precision_ 设置 origin_/step_，量化 [0, count_) 并统计本次量化误差
+    template <typename Source>
+    void quantize(const Source& source);
+
+    Precision precision_ = Bits16;
+    size_t count_ = 0;
+    QVector3D origin_;
+    QVector3D step_;
+    AABB bounds_;
+    QVector3D center_;
+    ErrorStats error_;
+    std::vector<int16_t> positions16_;
+    std::vector<uint64_t> positions21_;
+    std::vector<uint8_t> colors_;
+};
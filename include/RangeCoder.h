@@ -0,0 +1,243 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// 自包含的二进制自适应区间编码器（LZMA 风格）：每个二元判定用一个 11 位概率，
+// 编码后按 1/32 的速率向实际出现的取值靠拢。多值符号由位树（BitTreeModel）或
+// “位长类 + 尾数”（IntegerModel）分解为若干二元判定。
+// 编码器与解码器都只在单个数据块内使用，块之间互不依赖，可按块并行。
+namespace RangeCoder {
+
+constexpr int kProbBits = 11;
+constexpr uint16_t kProbInit = 1u << (kProbBits - 1);
+constexpr int kMoveBits = 5;
+constexpr uint32_t kTopValue = 1u << 24;
+
+class Encoder {
+public:
+    explicit Encoder(std::vector<uint8_t>& out) : out_(out) {}
+
+    void encodeBit(uint16_t& prob, uint32_t bit) {
+        const uint32_t bound = (range_ >> kProbBits) * prob;
+        if (bit == 0) {
+            range_ = bound;
+            prob = static_cast<uint16_t>(prob + (((1u << kProbBits) - prob) >> kMoveBits));
+        } else {
+            low_ += bound;
+            range_ -= bound;
+            prob = static_cast<uint16_t>(prob - (prob >> kMoveBits));
+        }
+        while (range_ < kTopValue) {
+            range_ <<= 8;
+            shiftLow();
+        }
+    }
+
+    // 等概率的原始位（高位在前），每次最多 16 位作为一个均匀分布的符号编码
+    void encodeDirect(uint32_t value, int bits) {
+        while (bits > 0) {
+            const int count = bits < 16 ? bits : 16;
+            bits -= count;
+            range_ >>= count;
+            low_ += static_cast<uint64_t>((value >> bits) & ((1u << count) - 1)) * range_;
+            while (range_ < kTopValue) {
+                range_ <<= 8;
+                shiftLow();
+            }
+        }
+    }
+
+    void finish() {
+        for (int i = 0; i < 5; ++i) shiftLow();
+    }
+
+private:
+    void shiftLow() {
+        if (static_cast<uint32_t>(low_) < 0xff000000u || (low_ >> 32) != 0) {
+            uint8_t carry = static_cast<uint8_t>(low_ >> 32);
+            uint8_t temp = cache_;
+            do {
+                out_.push_back(static_cast<uint8_t>(temp + carry));
+                temp = 0xff;
+            } while (--cacheSize_ != 0);
+            cache_ = static_cast<uint8_t>(low_ >> 24);
+        }
+        ++cacheSize_;
+        low_ = (low_ & 0x00ffffffu) << 8;
+    }
+
+    std::vector<uint8_t>& out_;
+    uint64_t low_ = 0;
+    uint32_t range_ = 0xffffffffu;
+    uint8_t cache_ = 0;
+    uint64_t cacheSize_ = 1;
+};
+
+// 读到数据末尾之后按 0 补齐，损坏的数据只会解出错误的值而不会越界
+class Decoder {
+public:
+    Decoder(const uint8_t* data, size_t size) : data_(data), end_(data + size) {
+        for (int i = 0; i < 5; ++i) code_ = (code_ << 8) | next();
+    }
+
+    uint32_t decodeBit(uint16_t& prob) {
+        const uint32_t bound = (range_ >> kProbBits) * prob;
+        uint32_t bit;
+        if (code_ < bound) {
+            range_ = bound;
+            prob = static_cast<uint16_t>(prob + (((1u << kProbBits) - prob) >> kMoveBits));
+            bit = 0;
+        } else {
+            code_ -= bound;
+            range_ -= bound;
+            prob = static_cast<uint16_t>(prob - (prob >> kMoveBits));
+            bit = 1;
+        }
+        if (range_ < kTopValue) {
+            range_ <<= 8;
+            code_ = (code_ << 8) | next();
+        }
+        return bit;
+    }
+
+    uint32_t decodeDirect(int bits) {
+        uint32_t value = 0;
+        while (bits > 0) {
+            const int count = bits < 16 ? bits : 16;
+            bits -= count;
+            range_ >>= count;
+            uint32_t symbol = code_ / range_;
+            const uint32_t limit = (1u << count) - 1;
+            if (symbol > limit) symbol = limit;         // 只有损坏的数据会越界
+            code_ -= symbol * range_;
+            value = (value << count) | symbol;
+            while (range_ < kTopValue) {
+                range_ <<= 8;
+                code_ = (code_ << 8) | next();
+            }
+        }
+        return value;
+    }
+
+    // 是否读过了数据末尾（完整的数据不会发生，可用于检测截断）
+    bool overrun() const { return overrun_; }
+
+private:
+    uint32_t next() {
+        if (data_ < end_) return *data_++;
+        overrun_ = true;
+        return 0;
+    }
+
+    const uint8_t* data_;
+    const uint8_t* end_;
+    uint32_t code_ = 0;
+    uint32_t range_ = 0xffffffffu;
+    bool overrun_ = false;
+};
+
+// Bits 位符号的位树：从高位到低位逐位编码，每个前缀一个概率
+template <int Bits>
+class BitTreeModel {
+public:
+    BitTreeModel() {
+        for (uint16_t& prob : probs_) prob = kProbInit;
+    }
+
+    void encode(Encoder& encoder, uint32_t symbol) {
+        uint32_t node = 1;
+        for (int i = Bits - 1; i >= 0; --i) {
+            const uint32_t bit = (symbol >> i) & 1u;
+            encoder.encodeBit(probs_[node], bit);
+            node = (node << 1) | bit;
+        }
+    }
+
+    uint32_t decode(Decoder& decoder) {
+        uint32_t node = 1;
+        for (int i = 0; i < Bits; ++i) node = (node << 1) | decoder.decodeBit(probs_[node]);
+        return node - (1u << Bits);
+    }
+
+private:
+    uint16_t probs_[1u << Bits];
+};
+
+// 无符号 64 位整数：先编码位长类（0 表示数值 0，k 表示最高位在第 k - 1 位），
+// 再编码最高位以下的尾数，尾数的前 kModeledBits 位按位长类分上下文自适应，其余为原始位。
+// 适合绝对值集中在较小范围的差分残差
+class IntegerModel {
+public:
+    static constexpr int kModeledBits = 2;
+
+    IntegerModel() {
+        for (auto& tree : mantissa_) {
+            for (uint16_t& prob : tree) prob = kProbInit;
+        }
+    }
+
+    void encode(Encoder& encoder, uint64_t value) {
+        const int length = bitLength(value);
+        lengths_.encode(encoder, static_cast<uint32_t>(length));
+        if (length <= 1) return;
+        const int bits = length - 1;
+        const int modeled = bits < kModeledBits ? bits : kModeledBits;
+        uint16_t* tree = mantissa_[length];
+        uint32_t node = 1;
+        for (int i = bits - 1; i >= bits - modeled; --i) {
+            const uint32_t bit = static_cast<uint32_t>(value >> i) & 1u;
+            encoder.encodeBit(tree[node], bit);
+            node = (node << 1) | bit;
+        }
+        int rest = bits - modeled;
+        if (rest > 32) {
+            encoder.encodeDirect(static_cast<uint32_t>(value >> 32) & ((1u << (rest - 32)) - 1), rest - 32);
+            rest = 32;
+        }
+        if (rest > 0) encoder.encodeDirect(static_cast<uint32_t>(value) & (0xffffffffu >> (32 - rest)), rest);
+    }
+
+    uint64_t decode(Decoder& decoder) {
+        const int length = static_cast<int>(lengths_.decode(decoder));
+        if (length == 0 || length > 64) return 0;
+        const int bits = length - 1;
+        const int modeled = bits < kModeledBits ? bits : kModeledBits;
+        uint16_t* tree = mantissa_[length];
+        uint32_t node = 1;
+        for (int i = 0; i < modeled; ++i) node = (node << 1) | decoder.decodeBit(tree[node]);
+        uint64_t value = node;      // 含最高位的 1
+        int rest = bits - modeled;
+        if (rest > 32) {
+            value = (value << (rest - 32)) | decoder.decodeDirect(rest - 32);
+            rest = 32;
+        }
+        if (rest > 0) value = (value << rest) | decoder.decodeDirect(rest);
+        return value;
+    }
+
+    static int bitLength(uint64_t value) {
+        int length = 0;
+        while (value != 0) {
+            ++length;
+            value >>= 1;
+        }
+        return length;
+    }
+
+private:
+    BitTreeModel<7> lengths_;                               // 0..64
+    uint16_t mantissa_[65][1u << kModeledBits];
+};
+
+// 有符号残差与无符号数之间的 zigzag 映射：0, -1, 1, -2, 2 ... -> 0, 1, 2, 3, 4 ...
+inline uint32_t zigzag(int32_t value) {
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+inline int32_t unzigzag(uint32_t value) {
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1u);
+}
+
+} // namespace RangeCoder
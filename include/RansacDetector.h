@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QVector3D>
+#include <QMatrix4x4>
+#include <QtGlobal>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class Model;
+
+// RANSAC 基本形状检测（平面 / 球面），坐标单位米。
+// 评分点按结构数组（x/y/z 各一段连续 float）存放，点到形状距离按块计算以便编译器向量化；
+// 假设按批并行评分，任一假设在剩余点全部命中也无法超过当前最优时提前放弃。
+// 检测多个形状时，每检测到一个就把它的内点排除，再在剩余点上继续。
+class RansacDetector {
+public:
+    enum Shape {
+        Plane,
+        Sphere
+    };
+
+    struct Options {
+        Shape shape = Plane;
+        float distanceThreshold = 0.01f;     // 内点距离阈值（米）
+        float minRadius = 0.0f;              // 球面半径范围（米）；maxRadius 为 0 时取包围盒对角线的一半
+        float maxRadius = 0.0f;
+        size_t minInliers = 1000;            // 内点少于此数时停止检测
+        int maxShapes = 1;                   // 依次检测的形状数上限
+        int maxIterations = 5000;            // 每个形状的假设数上限
+        double confidence = 0.99;            // 按当前内点率自适应终止的置信度
+        size_t scoreSampleCount = 200000;    // 假设评分使用的点采样上限
+        unsigned int seed = 1;               // 随机种子（结果与线程数无关）
+    };
+
+    struct Result {
+        Shape shape = Plane;
+        QVector3D normal;                    // 平面：单位法线，平面方程 normal·p + distance = 0
+        float distance = 0.0f;
+        QVector3D center;                    // 球面：球心与半径
+        float radius = 0.0f;
+        QVector3D inlierCentroid;            // 内点重心
+        size_t inlierCount = 0;
+        float rms = 0.0f;                    // 内点到形状距离的 RMS（米）
+        int iterations = 0;                  // 实际评估的假设数
+        std::vector<uint8_t> inliers;        // 逐顶点内点掩码（1 为内点），长度等于顶点数
+        qint64 elapsedMs = 0;
+    };
+
+    // 按内点数从先到后返回检测到的形状（可能为空）；被过滤/裁切图层隐藏的点不参与采样，也不计为内点
+    static std::vector<Result> detect(const Model& model, const Options& options);
+
+    // 调平变换：绕内点重心把平面法线转到 up 方向（取与 up 同侧的法线），
+    // 再沿 up 平移使平面位于高度 0
+    static QMatrix4x4 levelingTransform(const Result& plane, const QVector3D& up);
+};
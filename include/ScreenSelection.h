@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QMatrix4x4>
+#include <QPointF>
+#include <vector>
+#include <cstddef>
+
+class Model;
+class BitMask;
+
+// 屏幕空间框选 / 套索选择：把顶点按当前视图投影到屏幕，落在区域内的顶点写入位掩码。
+// 1. 套索多边形先按像素扫描线填充为覆盖图，之后每个点只需一次查表；
+// 2. 点云按缓存的 Morton 区间包围盒整块判定：8 个角点投影后的屏幕包围盒不含区域内像素则跳过，
+//    完全被区域覆盖则整块选中（套索用覆盖图的前缀和 O(1) 判断）；
+// 3. 其余区间按 64 个点一组并行投影（结构数组布局便于编译器向量化），每组恰好写一个掩码字，无需同步。
+// 只按投影位置选择，不考虑遮挡：区域内被挡住的点同样被选中。
+class ScreenSelection {
+public:
+    enum Mode {
+        Replace,    // 区域内为选中，其余取消
+        Add,        // 并入已有选择
+        Subtract    // 从已有选择中去掉
+    };
+
+    // modelToClip 把模型坐标（米）变换到裁剪空间；polygon 为视口像素坐标（原点在左上角），
+    // 4 个点且边与坐标轴平行时按矩形处理。mask 长度须与顶点数一致，返回选择后的置位数
+    static size_t select(const Model& model, const QMatrix4x4& modelToClip, int viewportWidth, int viewportHeight,
+                         const std::vector<QPointF>& polygon, Mode mode, BitMask& mask);
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QVector3D>
+#include <QtGlobal>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+class Model;
+class Mesh;
+
+// 由带法线的点重建网格：稀疏块体素上的截断有向距离场 + Marching Cubes。
+// 1. 只为点的截断带覆盖到的 8x8x8 体素块分配（块键并行生成、基数排序去重），内存与表面积成正比；
+// 2. 各块独立求场：块内采样点取邻近点切平面距离 n·(x-p) 的核加权平均，按块并行、无需同步；
+// 3. 各块独立做 Marching Cubes（查找表由立方体面上的等值线一致地生成，相邻块结果无裂缝），
+//    顶点以所在体素棱的全局编号为键排序去重，输出即为焊接好的网格。
+class SurfaceReconstructor {
+public:
+    enum NormalSource {
+        VertexNormals,       // 使用点自带的法线（须已定向）
+        EstimateOutward      // k 近邻 PCA 估计法线，按背离点云重心的方向定向（适用于单个物体）
+    };
+
+    struct Options {
+        float voxelSize = 0.01f;             // 体素边长（米）
+        float truncation = 3.0f;             // 截断半径（体素数），也是核函数半径
+        float minWeight = 0.05f;             // 采样点的核权重之和低于此值时视为无定义
+        NormalSource normalSource = VertexNormals;
+        size_t normalNeighbours = 16;
+    };
+
+    struct Result {
+        std::shared_ptr<Mesh> mesh;          // 失败时为空
+        size_t blockCount = 0;               // 分配的体素块数
+        size_t sampleCount = 0;              // 求值的采样点数
+        size_t triangleCount = 0;
+        qint64 elapsedMs = 0;
+    };
+
+    static Result reconstruct(const Model& cloud, const Options& options);
+
+    // 按第 8 近邻距离的中位数估计合适的体素边长（米）
+    static float suggestVoxelSize(const Model& cloud);
+
+    // k 近邻 PCA 法线，朝背离重心的方向定向
+    static std::vector<QVector3D> estimateNormals(const Model& cloud, size_t neighbours);
+};
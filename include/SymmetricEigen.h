@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cmath>
+#include <utility>
+
+// 3x3 实对称矩阵特征分解（循环 Jacobi 迭代）。
+// 输出特征值按升序排列，eigenvectors[k] 为第 k 个特征值对应的单位特征向量。
+// 用于邻域协方差的 PCA（法线 = 最小特征值方向，曲率 = λ0 / (λ0+λ1+λ2)）。
+inline void symmetricEigen3x3(const double matrix[3][3], double eigenvalues[3], double eigenvectors[3][3]) {
+    double a[3][3];
+    double v[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j) a[i][j] = matrix[i][j];
+
+    for (int sweep = 0; sweep < 32; ++sweep) {
+        const double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        if (off < 1e-30) break;
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                if (std::fabs(a[p][q]) < 1e-300) continue;
+                const double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                const double t = (theta >= 0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0);
+                const double s = t * c;
+                for (int k = 0; k < 3; ++k) {
+                    const double akp = a[k][p], akq = a[k][q];
+                    a[k][p] = c * akp - s * akq;
+                    a[k][q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const double apk = a[p][k], aqk = a[q][k];
+                    a[p][k] = c * apk - s * aqk;
+                    a[q][k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const double vkp = v[k][p], vkq = v[k][q];
+                    v[k][p] = c * vkp - s * vkq;
+                    v[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    int order[3] = { 0, 1, 2 };
+    if (a[order[0]][order[0]] > a[order[1]][order[1]]) std::swap(order[0], order[1]);
+    if (a[order[1]][order[1]] > a[order[2]][order[2]]) std::swap(order[1], order[2]);
+    if (a[order[0]][order[0]] > a[order[1]][order[1]]) std::swap(order[0], order[1]);
+    for (int k = 0; k < 3; ++k) {
+        eigenvalues[k] = a[order[k]][order[k]];
+        for (int i = 0; i < 3; ++i) eigenvectors[k][i] = v[i][order[k]];
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Parallel.h"
+
+// 无锁并发并查集：父指针为原子整数，unite 用 CAS 把编号较大的根挂到较小的根下，
+// find 做路径减半（失败的 CAS 只是少压缩一步，不影响正确性）。
+// 多个线程可同时调用 find/unite；合并结束后集合的根就是集合中编号最小的元素。
+class UnionFind {
+public:
+    explicit UnionFind(size_t count = 0) { reset(count); }
+
+    void reset(size_t count) {
+        parent_ = std::vector<std::atomic<uint32_t>>(count);
+        Parallel::forEach(0, count, [&](size_t i) {
+            parent_[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        });
+    }
+
+    size_t size() const { return parent_.size(); }
+
+    uint32_t find(uint32_t x) {
+        for (;;) {
+            uint32_t p = parent_[x].load(std::memory_order_relaxed);
+            if (p == x) return x;
+            const uint32_t grandparent = parent_[p].load(std::memory_order_relaxed);
+            if (grandparent != p) parent_[x].compare_exchange_weak(p, grandparent, std::memory_order_relaxed);
+            x = grandparent;
+        }
+    }
+
+    // 合并两个元素所在的集合，返回是否发生了合并
+    bool unite(uint32_t a, uint32_t b) {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return false;
+            if (a < b) std::swap(a, b);
+            // a 为较大的根：只有它仍是根时才挂到 b 下，否则重新查找
+            uint32_t expected = a;
+            if (parent_[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) return true;
+        }
+    }
+
+    bool sameSet(uint32_t a, uint32_t b) {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return true;
+            // a 仍是根说明查找期间没有被合并，结论可靠
+            if (parent_[a].load(std::memory_order_relaxed) == a) return false;
+        }
+    }
+
+private:
+    std::vector<std::atomic<uint32_t>> parent_;
+};
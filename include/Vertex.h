@@ -2,6 +2,7 @@
 
 #include <QVector3D>
 #include <QColor>
+#include <QGenericMatrix>
 
 struct Vertex {
     QVector3D position;
@@ -13,4 +14,13 @@ struct Vertex {
         : position(pos), normal(0, 0, 1), color(col) {}
     Vertex(const QVector3D& pos, const QVector3D& norm, const QColor& col = Qt::white)
         : position(pos), normal(norm), color(col) {}
-};
\ No newline at end of file
+};
+
+// 用法线矩阵（QMatrix4x4::normalMatrix()，左上 3x3 的逆转置）变换法线并归一化。
+// 非均匀缩放时不能用 mapVector，否则法线不再垂直于变换后的表面
+inline QVector3D transformNormal(const QMatrix3x3& normalMatrix, const QVector3D& normal) {
+    return QVector3D(normalMatrix(0, 0) * normal.x() + normalMatrix(0, 1) * normal.y() + normalMatrix(0, 2) * normal.z(),
+                     normalMatrix(1, 0) * normal.x() + normalMatrix(1, 1) * normal.y() + normalMatrix(1, 2) * normal.z(),
+                     normalMatrix(2, 0) * normal.x() + normalMatrix(2, 1) * normal.y() + normalMatrix(2, 2) * normal.z())
+        .normalized();
+}
\ No newline at end of file
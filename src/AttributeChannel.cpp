@@ -0,0 +1,180 @@
+#include "AttributeChannel.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <cmath>
+#include <type_traits>
+
+namespace {
+
+template <typename T>
+inline double loadAs(const uint8_t* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return static_cast<double>(value);
+}
+
+// 整数类型：超出范围的值钳制到类型的最值，NaN 存为 0（直接转换是未定义行为）
+template <typename T>
+inline void storeAs(uint8_t* p, double value) {
+    T converted;
+    if constexpr (std::is_integral<T>::value) {
+        if (std::isnan(value)) converted = 0;
+        else if (value <= static_cast<double>(std::numeric_limits<T>::lowest())) converted = std::numeric_limits<T>::lowest();
+        else if (value >= static_cast<double>(std::numeric_limits<T>::max())) converted = std::numeric_limits<T>::max();
+        else converted = static_cast<T>(value);
+    } else {
+        converted = static_cast<T>(value);
+    }
+    std::memcpy(p, &converted, sizeof(T));
+}
+
+} // namespace
+
+AttributeChannel::AttributeChannel(const QString& name, Type type, size_t count)
+    : name_(name), type_(type), count_(count) {
+}
+
+size_t AttributeChannel::typeSize(Type type) {
+    switch (type) {
+        case Int8:
+        case UInt8:   return 1;
+        case Int16:
+        case UInt16:  return 2;
+        case Int32:
+        case UInt32:
+        case Float32: return 4;
+        case Float64: return 8;
+    }
+    return 0;
+}
+
+QString AttributeChannel::typeName(Type type) {
+    switch (type) {
+        case Int8:    return "int8";
+        case UInt8:   return "uint8";
+        case Int16:   return "int16";
+        case UInt16:  return "uint16";
+        case Int32:   return "int32";
+        case UInt32:  return "uint32";
+        case Float32: return "float32";
+        case Float64: return "float64";
+    }
+    return "unknown";
+}
+
+void AttributeChannel::resize(size_t count) {
+    count_ = count;
+    if (!bytes_.empty()) bytes_.resize(count * typeSize(type_), 0);
+    invalidateRange();
+}
+
+uint8_t* AttributeChannel::mutableData() {
+    if (bytes_.empty() && count_ > 0) bytes_.assign(count_ * typeSize(type_), 0);
+    invalidateRange();
+    return bytes_.empty() ? nullptr : bytes_.data();
+}
+
+double AttributeChannel::valueAt(size_t index) const {
+    if (bytes_.empty() || index >= count_) return 0.0;
+    const uint8_t* p = bytes_.data() + index * typeSize(type_);
+    switch (type_) {
+        case Int8:    return loadAs<int8_t>(p);
+        case UInt8:   return loadAs<uint8_t>(p);
+        case Int16:   return loadAs<int16_t>(p);
+        case UInt16:  return loadAs<uint16_t>(p);
+        case Int32:   return loadAs<int32_t>(p);
+        case UInt32:  return loadAs<uint32_t>(p);
+        case Float32: return loadAs<float>(p);
+        case Float64: return loadAs<double>(p);
+    }
+    return 0.0;
+}
+
+void AttributeChannel::setValue(size_t index, double value) {
+    if (index >= count_) return;
+    uint8_t* p = mutableData() + index * typeSize(type_);
+    switch (type_) {
+        case Int8:    storeAs<int8_t>(p, value); break;
+        case UInt8:   storeAs<uint8_t>(p, value); break;
+        case Int16:   storeAs<int16_t>(p, value); break;
+        case UInt16:  storeAs<uint16_t>(p, value); break;
+        case Int32:   storeAs<int32_t>(p, value); break;
+        case UInt32:  storeAs<uint32_t>(p, value); break;
+        case Float32: storeAs<float>(p, value); break;
+        case Float64: storeAs<double>(p, value); break;
+    }
+}
+
+bool AttributeChannel::range(double& minValue, double& maxValue) const {
+    if (count_ == 0) {
+        minValue = maxValue = 0.0;
+        return false;
+    }
+    if (!rangeValid_) {
+        rangeFound_ = true;
+        if (bytes_.empty()) {
+            minValue_ = maxValue_ = 0.0;
+        } else {
+            // 分块并行求最值，跳过 NaN / 无穷；没有有限值时范围无效
+            const size_t chunks = Parallel::chunkCount(count_);
+            std::vector<double> chunkMin(chunks, std::numeric_limits<double>::max());
+            std::vector<double> chunkMax(chunks, std::numeric_limits<double>::lowest());
+            Parallel::forChunks(count_, chunks, [&](size_t c, size_t b, size_t e) {
+                double lo = chunkMin[c];
+                double hi = chunkMax[c];
+                for (size_t i = b; i < e; ++i) {
+                    const double v = valueAt(i);
+                    if (!std::isfinite(v)) continue;
+                    lo = std::min(lo, v);
+                    hi = std::max(hi, v);
+                }
+                chunkMin[c] = lo;
+                chunkMax[c] = hi;
+            });
+            minValue_ = *std::min_element(chunkMin.begin(), chunkMin.end());
+            maxValue_ = *std::max_element(chunkMax.begin(), chunkMax.end());
+            rangeFound_ = minValue_ <= maxValue_;
+            if (!rangeFound_) minValue_ = maxValue_ = 0.0;
+        }
+        rangeValid_ = true;
+    }
+    minValue = minValue_;
+    maxValue = maxValue_;
+    return rangeFound_;
+}
+
+void AttributeChannel::setDisplayRange(double minValue, double maxValue) {
+    displayMin_ = std::min(minValue, maxValue);
+    displayMax_ = std::max(minValue, maxValue);
+    displayRangeSet_ = true;
+}
+
+bool AttributeChannel::displayRange(double& minValue, double& maxValue) const {
+    if (count_ == 0) return false;
+    if (!displayRangeSet_) return range(minValue, maxValue);
+    minValue = displayMin_;
+    maxValue = displayMax_;
+    return true;
+}
+
+void AttributeChannel::gather(const std::vector<uint32_t>& newToOld) {
+    *this = gathered(newToOld);
+}
+
+AttributeChannel AttributeChannel::gathered(const std::vector<uint32_t>& newToOld) const {
+    AttributeChannel result(name_, type_, newToOld.size());
+    result.displayRangeSet_ = displayRangeSet_;
+    result.displayMin_ = displayMin_;
+    result.displayMax_ = displayMax_;
+    if (!bytes_.empty() && !newToOld.empty()) {
+        const size_t stride = typeSize(type_);
+        uint8_t* out = result.mutableData();
+        Parallel::forEach(0, newToOld.size(), [&](size_t i) {
+            const size_t src = newToOld[i];
+            if (src < count_) std::memcpy(out + i * stride, &bytes_[src * stride], stride);
+        });
+    }
+    return result;
+}
@@ -0,0 +1,390 @@
+#include "BVH.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <thread>
+#include <cmath>
+
+namespace {
+
+constexpr int kBinCount = 16;
+constexpr uint32_t kMaxLeafSize = 4;
+constexpr int kMaxDepth = 60;              // 遍历栈为 64，深度达到上限时强制生成叶子
+constexpr size_t kParallelThreshold = 65536; // 子树三角形数超过该值才另开线程
+
+inline float surfaceArea(const AABB& box) {
+    if (!box.isValid()) return 0.0f;
+    const QVector3D d = box.size();
+    return 2.0f * (d.x() * d.y() + d.y() * d.z() + d.z() * d.x());
+}
+
+inline void expandBox(AABB& box, const AABB& other) {
+    if (!other.isValid()) return;
+    box.expand(other.min);
+    box.expand(other.max);
+}
+
+// 射线与包围盒的 slab 检测，返回进入距离
+inline bool rayBox(const AABB& box, const QVector3D& origin, const QVector3D& invDir,
+                   float tMax, float& tEntry) {
+    float t0 = 0.0f, t1 = tMax;
+    for (int a = 0; a < 3; ++a) {
+        float tNear = (box.min[a] - origin[a]) * invDir[a];
+        float tFar = (box.max[a] - origin[a]) * invDir[a];
+        if (tNear > tFar) std::swap(tNear, tFar);
+        // NaN（射线分量为 0 且起点在板面上）时比较为假，保持原区间
+        t0 = tNear > t0 ? tNear : t0;
+        t1 = tFar < t1 ? tFar : t1;
+        if (t0 > t1) return false;
+    }
+    tEntry = t0;
+    return true;
+}
+
+inline float boxDistanceSquared(const AABB& box, const QVector3D& p) {
+    float d2 = 0.0f;
+    for (int a = 0; a < 3; ++a) {
+        float d = 0.0f;
+        if (p[a] < box.min[a]) d = box.min[a] - p[a];
+        else if (p[a] > box.max[a]) d = p[a] - box.max[a];
+        d2 += d * d;
+    }
+    return d2;
+}
+
+// 点到三角形的最近点（Ericson《Real-Time Collision Detection》5.1.5）
+QVector3D closestPointOnTriangle(const QVector3D& p, const QVector3D& a, const QVector3D& b, const QVector3D& c) {
+    const QVector3D ab = b - a;
+    const QVector3D ac = c - a;
+    const QVector3D ap = p - a;
+    const float d1 = QVector3D::dotProduct(ab, ap);
+    const float d2 = QVector3D::dotProduct(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+    const QVector3D bp = p - b;
+    const float d3 = QVector3D::dotProduct(ab, bp);
+    const float d4 = QVector3D::dotProduct(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    const QVector3D cp = p - c;
+    const float d5 = QVector3D::dotProduct(ab, cp);
+    const float d6 = QVector3D::dotProduct(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    const float denom = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+} // namespace
+
+// 构建器：持有每个三角形的包围盒与重心，递归划分 order 的区间
+class BVHBuilder {
+public:
+    BVHBuilder(const std::vector<AABB>& boxes, const std::vector<QVector3D>& centroids,
+               std::vector<uint32_t>& order)
+        : boxes_(boxes), centroids_(centroids), order_(order) {}
+
+    void build(std::vector<BVH::Node>& out, size_t begin, size_t end, int depth, int parallelDepth) {
+        const size_t nodeIndex = out.size();
+        out.emplace_back();
+
+        AABB bounds, centroidBounds;
+        for (size_t i = begin; i < end; ++i) {
+            expandBox(bounds, boxes_[order_[i]]);
+            centroidBounds.expand(centroids_[order_[i]]);
+        }
+        out[nodeIndex].bounds = bounds;
+
+        const size_t count = end - begin;
+        if (count <= kMaxLeafSize || depth >= kMaxDepth) {
+            makeLeaf(out[nodeIndex], begin, count);
+            return;
+        }
+
+        // 取重心跨度最大的轴
+        const QVector3D extent = centroidBounds.size();
+        int axis = 0;
+        if (extent.y() > extent[axis]) axis = 1;
+        if (extent.z() > extent[axis]) axis = 2;
+
+        size_t mid = begin + count / 2;
+        if (extent[axis] > 0.0f) {
+            // 分桶 SAH：统计各桶的包围盒与数量，扫描 kBinCount-1 个候选划分
+            struct Bin { AABB box; size_t count = 0; };
+            Bin bins[kBinCount];
+            const float lo = centroidBounds.min[axis];
+            const float scale = kBinCount / extent[axis];
+            auto binOf = [&](uint32_t prim) {
+                int b = static_cast<int>((centroids_[prim][axis] - lo) * scale);
+                return std::min(std::max(b, 0), kBinCount - 1);
+            };
+            for (size_t i = begin; i < end; ++i) {
+                Bin& bin = bins[binOf(order_[i])];
+                expandBox(bin.box, boxes_[order_[i]]);
+                ++bin.count;
+            }
+
+            float rightArea[kBinCount];
+            size_t rightCount[kBinCount];
+            AABB acc;
+            size_t accCount = 0;
+            for (int b = kBinCount - 1; b > 0; --b) {
+                expandBox(acc, bins[b].box);
+                accCount += bins[b].count;
+                rightArea[b] = surfaceArea(acc);
+                rightCount[b] = accCount;
+            }
+
+            float bestCost = FLT_MAX;
+            int bestSplit = -1;
+            acc.reset();
+            accCount = 0;
+            for (int b = 1; b < kBinCount; ++b) {
+                expandBox(acc, bins[b - 1].box);
+                accCount += bins[b - 1].count;
+                if (accCount == 0 || rightCount[b] == 0) continue;
+                const float cost = surfaceArea(acc) * accCount + rightArea[b] * rightCount[b];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestSplit = b;
+                }
+            }
+
+            // 不划分更便宜（或无法划分）且三角形不多时直接生成叶子；
+            // 代价以“遍历一次节点 ≈ 求交一个三角形”计
+            const float parentArea = surfaceArea(bounds);
+            if (count <= 4 * kMaxLeafSize && (bestSplit < 0 || parentArea + bestCost >= parentArea * count)) {
+                makeLeaf(out[nodeIndex], begin, count);
+                return;
+            }
+            if (bestSplit >= 0) {
+                auto it = std::partition(order_.begin() + begin, order_.begin() + end,
+                                         [&](uint32_t prim) { return binOf(prim) < bestSplit; });
+                mid = static_cast<size_t>(it - order_.begin());
+            }
+        }
+        // 重心重合或桶划分失败时按中位数切分
+        if (mid == begin || mid == end || extent[axis] <= 0.0f) {
+            mid = begin + count / 2;
+            std::nth_element(order_.begin() + begin, order_.begin() + mid, order_.begin() + end,
+                             [&](uint32_t a, uint32_t b) { return centroids_[a][axis] < centroids_[b][axis]; });
+        }
+
+        out[nodeIndex].axis = static_cast<uint32_t>(axis);
+        if (parallelDepth > 0 && count >= kParallelThreshold) {
+            // 右子树在新线程中构建到独立数组，完成后拼接并修正内部节点偏移
+            std::vector<BVH::Node> rightNodes;
+            std::thread worker([&]() { build(rightNodes, mid, end, depth + 1, parallelDepth - 1); });
+            build(out, begin, mid, depth + 1, parallelDepth - 1);
+            worker.join();
+            const uint32_t base = static_cast<uint32_t>(out.size());
+            out[nodeIndex].offset = base;
+            for (BVH::Node& node : rightNodes) {
+                if (node.count == 0) node.offset += base;
+            }
+            out.insert(out.end(), rightNodes.begin(), rightNodes.end());
+        } else {
+            build(out, begin, mid, depth + 1, 0);
+            out[nodeIndex].offset = static_cast<uint32_t>(out.size());
+            build(out, mid, end, depth + 1, 0);
+        }
+    }
+
+private:
+    static void makeLeaf(BVH::Node& node, size_t begin, size_t count) {
+        node.offset = static_cast<uint32_t>(begin);
+        node.count = static_cast<uint32_t>(count);
+    }
+
+    const std::vector<AABB>& boxes_;
+    const std::vector<QVector3D>& centroids_;
+    std::vector<uint32_t>& order_;
+};
+
+void BVH::build(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& triangles) {
+    nodes_.clear();
+    triangles_.clear();
+
+    const size_t triangleCount = triangles.size() / 3;
+    const size_t vertexCount = vertices.size();
+    std::vector<uint32_t> order;
+    order.reserve(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        if (triangles[t * 3] < vertexCount && triangles[t * 3 + 1] < vertexCount &&
+            triangles[t * 3 + 2] < vertexCount) {
+            order.push_back(static_cast<uint32_t>(t));
+        }
+    }
+    if (order.empty()) return;
+
+    std::vector<AABB> boxes(triangleCount);
+    std::vector<QVector3D> centroids(triangleCount);
+    Parallel::forEach(0, order.size(), [&](size_t i) {
+        const uint32_t t = order[i];
+        AABB box;
+        for (int k = 0; k < 3; ++k) box.expand(vertices[triangles[t * 3 + k]].position);
+        boxes[t] = box;
+        centroids[t] = box.center();
+    });
+
+    // 并行深度：每层一分为二，约为 log2(线程数)
+    int parallelDepth = 0;
+    while ((size_t(1) << parallelDepth) < Parallel::threadCount()) ++parallelDepth;
+
+    nodes_.reserve(order.size() / kMaxLeafSize * 2 + 1);
+    BVHBuilder builder(boxes, centroids, order);
+    builder.build(nodes_, 0, order.size(), 0, parallelDepth);
+
+    triangles_.resize(order.size());
+    Parallel::forEach(0, order.size(), [&](size_t i) {
+        const uint32_t t = order[i];
+        const QVector3D& v0 = vertices[triangles[t * 3]].position;
+        Triangle& tri = triangles_[i];
+        tri.v0 = v0;
+        tri.e1 = vertices[triangles[t * 3 + 1]].position - v0;
+        tri.e2 = vertices[triangles[t * 3 + 2]].position - v0;
+        tri.index = t;
+    });
+}
+
+bool BVH::intersect(const QVector3D& origin, const QVector3D& direction, RayHit& hit, float tMax) const {
+    if (nodes_.empty()) return false;
+
+    const QVector3D invDir(1.0f / direction.x(), 1.0f / direction.y(), 1.0f / direction.z());
+    const bool dirNegative[3] = { direction.x() < 0.0f, direction.y() < 0.0f, direction.z() < 0.0f };
+    bool found = false;
+    float closest = tMax;
+
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = nodes_[stack[--top]];
+        float tEntry;
+        if (!rayBox(node.bounds, origin, invDir, closest, tEntry)) continue;
+
+        if (node.count > 0) {
+            // Möller–Trumbore 射线三角形求交（双面）
+            for (uint32_t i = node.offset, e = node.offset + node.count; i < e; ++i) {
+                const Triangle& tri = triangles_[i];
+                const QVector3D p = QVector3D::crossProduct(direction, tri.e2);
+                const float det = QVector3D::dotProduct(tri.e1, p);
+                if (std::fabs(det) < 1e-12f) continue;
+                const float invDet = 1.0f / det;
+                const QVector3D s = origin - tri.v0;
+                const float u = QVector3D::dotProduct(s, p) * invDet;
+                if (u < 0.0f || u > 1.0f) continue;
+                const QVector3D q = QVector3D::crossProduct(s, tri.e1);
+                const float v = QVector3D::dotProduct(direction, q) * invDet;
+                if (v < 0.0f || u + v > 1.0f) continue;
+                const float t = QVector3D::dotProduct(tri.e2, q) * invDet;
+                if (t < 0.0f || t > closest) continue;
+                closest = t;
+                hit.t = t;
+                hit.triangle = tri.index;
+                hit.u = u;
+                hit.v = v;
+                found = true;
+            }
+        } else {
+            // 先压远侧子节点，使近侧先出栈
+            const uint32_t left = static_cast<uint32_t>(&node - nodes_.data()) + 1;
+            if (dirNegative[node.axis]) {
+                stack[top++] = left;
+                stack[top++] = node.offset;
+            } else {
+                stack[top++] = node.offset;
+                stack[top++] = left;
+            }
+        }
+    }
+    return found;
+}
+
+bool BVH::closestPoint(const QVector3D& point, ClosestHit& hit, float maxDistance) const {
+    if (nodes_.empty()) return false;
+
+    float best = maxDistance < FLT_MAX ? maxDistance * maxDistance : FLT_MAX;
+    bool found = false;
+
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const uint32_t index = stack[--top];
+        const Node& node = nodes_[index];
+        if (boxDistanceSquared(node.bounds, point) > best) continue;
+
+        if (node.count > 0) {
+            for (uint32_t i = node.offset, e = node.offset + node.count; i < e; ++i) {
+                const Triangle& tri = triangles_[i];
+                const QVector3D candidate = closestPointOnTriangle(point, tri.v0, tri.v0 + tri.e1, tri.v0 + tri.e2);
+                const float d2 = (candidate - point).lengthSquared();
+                if (d2 <= best) {
+                    best = d2;
+                    hit.distanceSquared = d2;
+                    hit.triangle = tri.index;
+                    hit.point = candidate;
+                    found = true;
+                }
+            }
+        } else {
+            // 距离较近的子节点后压栈、先处理，尽快收紧搜索半径
+            const uint32_t left = index + 1;
+            const uint32_t right = node.offset;
+            const float dLeft = boxDistanceSquared(nodes_[left].bounds, point);
+            const float dRight = boxDistanceSquared(nodes_[right].bounds, point);
+            if (dLeft <= dRight) {
+                if (dRight <= best) stack[top++] = right;
+                if (dLeft <= best) stack[top++] = left;
+            } else {
+                if (dLeft <= best) stack[top++] = left;
+                if (dRight <= best) stack[top++] = right;
+            }
+        }
+    }
+    return found;
+}
+
+void BVH::queryPlane(const QVector3D& normal, float offset, std::vector<uint32_t>& triangles) const {
+    if (nodes_.empty()) return;
+    const QVector3D absNormal(std::fabs(normal.x()), std::fabs(normal.y()), std::fabs(normal.z()));
+    // 放宽少许，避免顶点恰在平面上的三角形因浮点舍入被漏掉
+    const float slack = 1e-6f * (std::fabs(offset) + 1.0f);
+
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const uint32_t index = stack[--top];
+        const Node& node = nodes_[index];
+        const QVector3D center = (node.bounds.min + node.bounds.max) * 0.5f;
+        const QVector3D halfSize = (node.bounds.max - node.bounds.min) * 0.5f;
+        const float distance = QVector3D::dotProduct(normal, center) - offset;
+        const float radius = QVector3D::dotProduct(absNormal, halfSize);
+        if (std::fabs(distance) > radius * 1.0001f + slack) continue;
+
+        if (node.count > 0) {
+            for (uint32_t i = node.offset, e = node.offset + node.count; i < e; ++i) {
+                triangles.push_back(triangles_[i].index);
+            }
+        } else {
+            stack[top++] = node.offset;
+            stack[top++] = index + 1;
+        }
+    }
+}
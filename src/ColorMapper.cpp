@@ -42,6 +42,17 @@ QColor ColorMapper::mapByDistance(const QVector3D& position, const QVector3D& re
     return hsvToRgb(hue, 1.0f, 1.0f);
 }
 
+QColor ColorMapper::mapByDistance(float distance, float maxDistance) {
+    if (maxDistance <= 0.0f) return hsvToRgb(120.0f, 1.0f, 1.0f);
+    
+    float normalized = (distance / maxDistance + 1.0f) * 0.5f;
+    normalized = std::max(0.0f, std::min(1.0f, normalized));
+    
+    // 负偏差为蓝色(240°)，零偏差为绿色(120°)，正偏差为红色(0°)
+    float hue = (1.0f - normalized) * 240.0f;
+    return hsvToRgb(hue, 1.0f, 1.0f);
+}
+
 QColor ColorMapper::hsvToRgb(float hue, float saturation, float value) {
     // 确保色相在0-360范围内
     hue = std::fmod(hue, 360.0f);
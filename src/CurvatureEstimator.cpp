@@ -0,0 +1,168 @@
+#include "CurvatureEstimator.h"
+#include "Mesh.h"
+#include "MeshTopology.h"
+#include "KdTree.h"
+#include "Parallel.h"
+#include "SymmetricEigen.h"
+#include <QDebug>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+constexpr double kTwoPi = 6.283185307179586;
+constexpr size_t kPercentileSamples = 100000;
+
+inline void subtract(const QVector3D& a, const QVector3D& b, double out[3]) {
+    out[0] = double(a.x()) - b.x();
+    out[1] = double(a.y()) - b.y();
+    out[2] = double(a.z()) - b.z();
+}
+
+inline double dot(const double a[3], const double b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+} // namespace
+
+CurvatureEstimator::MeshCurvature CurvatureEstimator::computeMeshCurvature(const Mesh& mesh) {
+    MeshCurvature result;
+    const auto& vertices = mesh.getVertices();
+    const size_t n = vertices.size();
+    result.mean.assign(n, 0.0f);
+    result.gaussian.assign(n, 0.0f);
+    if (n == 0 || mesh.getTriangleCount() == 0) return result;
+
+    const MeshTopology& topology = mesh.getTopology();
+    if (topology.vertexCount() != n) {
+        qDebug() << "曲率估计: 网格拓扑无效";
+        return result;
+    }
+
+    const size_t chunks = Parallel::chunkCount(n, 4096);
+    std::vector<size_t> boundary(chunks, 0);
+    std::vector<size_t> isolated(chunks, 0);
+    Parallel::forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+        for (size_t v = b; v < e; ++v) {
+            const uint32_t vertex = static_cast<uint32_t>(v);
+            if (topology.valence(vertex) == 0) {
+                ++isolated[c];
+                continue;
+            }
+            if (topology.isBoundaryVertex(vertex)) {
+                ++boundary[c];
+                continue;
+            }
+
+            // 出边 h = v->a 所在三角形为 (v, a, p)，p 为前一条半边的起点
+            const QVector3D& pv = vertices[v].position;
+            double laplace[3] = { 0, 0, 0 };
+            double normal[3] = { 0, 0, 0 };
+            double area = 0.0;
+            double angleSum = 0.0;
+            for (uint32_t h : topology.outgoing(vertex)) {
+                const QVector3D& pa = vertices[topology.target(h)].position;
+                const QVector3D& pp = vertices[topology.source(MeshTopology::prev(h))].position;
+                double e1[3], e2[3], e3[3];
+                subtract(pa, pv, e1);   // v -> a
+                subtract(pp, pv, e2);   // v -> p
+                subtract(pp, pa, e3);   // a -> p
+                const double cross[3] = { e1[1] * e2[2] - e1[2] * e2[1],
+                                          e1[2] * e2[0] - e1[0] * e2[2],
+                                          e1[0] * e2[1] - e1[1] * e2[0] };
+                const double doubleArea = std::sqrt(dot(cross, cross));
+                if (doubleArea <= 0.0) continue;
+
+                const double dotV = dot(e1, e2);    // v 处内角
+                const double dotA = -dot(e1, e3);   // a 处内角
+                const double dotP = dot(e2, e3);    // p 处内角
+                const double cotA = dotA / doubleArea;
+                const double cotP = dotP / doubleArea;
+                // 边 v-a 对角在 p，边 v-p 对角在 a
+                for (int k = 0; k < 3; ++k) {
+                    laplace[k] += cotP * e1[k] + cotA * e2[k];
+                    normal[k] += cross[k];
+                }
+                angleSum += std::atan2(doubleArea, dotV);
+
+                // 混合面积：非钝角三角形取 Voronoi 面积；钝角在 v 取 1/2，钝角在别处取 1/4
+                if (dotV < 0.0) {
+                    area += doubleArea / 4.0;
+                } else if (dotA < 0.0 || dotP < 0.0) {
+                    area += doubleArea / 8.0;
+                } else {
+                    area += (dot(e1, e1) * cotP + dot(e2, e2) * cotA) / 8.0;
+                }
+            }
+            const double normalLength = std::sqrt(dot(normal, normal));
+            if (area <= 0.0 || normalLength <= 0.0) continue;
+
+            // 平均曲率法向 Δp = laplace / (2A) = -2H n（凸处指向内侧）
+            const double projection = dot(laplace, normal) / normalLength;
+            result.mean[v] = static_cast<float>(-projection / (4.0 * area));
+            result.gaussian[v] = static_cast<float>((kTwoPi - angleSum) / area);
+        }
+    });
+    for (size_t c = 0; c < chunks; ++c) {
+        result.boundaryVertices += boundary[c];
+        result.isolatedVertices += isolated[c];
+    }
+    return result;
+}
+
+std::vector<float> CurvatureEstimator::computeSurfaceVariation(const Model& model, size_t neighbours) {
+    const auto& points = model.getVertices();
+    std::vector<float> variation(points.size(), 0.0f);
+    if (points.size() < 3 || neighbours < 3) return variation;
+
+    KdTree tree;
+    tree.build(points);
+    Parallel::forRange(0, points.size(), [&](size_t b, size_t e) {
+        std::vector<uint32_t> indices;
+        std::vector<float> distances;
+        for (size_t i = b; i < e; ++i) {
+            tree.kNearest(points[i].position, neighbours, indices, distances);
+            if (indices.size() < 3) continue;
+            // 协方差以查询点为参考累加，避免大坐标下的抵消误差
+            double sum[3] = { 0, 0, 0 };
+            double outer[3][3] = {};
+            for (uint32_t j : indices) {
+                double d[3];
+                subtract(points[j].position, points[i].position, d);
+                for (int r = 0; r < 3; ++r) {
+                    sum[r] += d[r];
+                    for (int c = r; c < 3; ++c) outer[r][c] += d[r] * d[c];
+                }
+            }
+            const double inv = 1.0 / indices.size();
+            double cov[3][3];
+            for (int r = 0; r < 3; ++r) {
+                for (int c = r; c < 3; ++c) {
+                    cov[r][c] = cov[c][r] = outer[r][c] * inv - sum[r] * inv * sum[c] * inv;
+                }
+            }
+            double values[3], vectors[3][3];
+            symmetricEigen3x3(cov, values, vectors);
+            const double total = std::max(0.0, values[0]) + std::max(0.0, values[1]) + std::max(0.0, values[2]);
+            if (total > 0.0) variation[i] = static_cast<float>(std::max(0.0, values[0]) / total);
+        }
+    }, 4096);
+    return variation;
+}
+
+void CurvatureEstimator::percentileRange(const std::vector<float>& values, double percent, double& lo, double& hi) {
+    lo = hi = 0.0;
+    if (values.empty()) return;
+    const size_t stride = std::max<size_t>(1, values.size() / kPercentileSamples);
+    std::vector<float> sample;
+    sample.reserve(values.size() / stride + 1);
+    for (size_t i = 0; i < values.size(); i += stride) sample.push_back(values[i]);
+
+    const double fraction = std::clamp(percent, 0.0, 50.0) / 100.0;
+    const size_t low = static_cast<size_t>(fraction * (sample.size() - 1));
+    const size_t high = sample.size() - 1 - low;
+    std::nth_element(sample.begin(), sample.begin() + low, sample.end());
+    lo = sample[low];
+    std::nth_element(sample.begin(), sample.begin() + high, sample.end());
+    hi = sample[high];
+}
@@ -1,39 +1,716 @@
 #include "FileImporter.h"
 #include "PointCloud.h"
 #include "Mesh.h"
+#include "MeshOptimizer.h"
+#include "AttributeChannel.h"
+#include "PagedVertexStore.h"
+#include "QuantizedPoints.h"
+#include "ModelCompressor.h"
+#include "Parallel.h"
 #include <QFile>
+#include <QDir>
+#include <QDateTime>
 #include <QTextStream>
 #include <QFileInfo>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QtEndian>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <atomic>
+#include <algorithm>
+#include "OpenHashMap.h"
 
-std::shared_ptr<Model> FileImporter::importFile(const QString& filePath) {
+namespace {
+
+// ---- 基于字节缓冲区的轻量文本解析工具（避免 QString 分配） ----
+
+inline const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    return p;
+}
+
+inline const char* nextLine(const char* p, const char* end) {
+    const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    return nl ? nl + 1 : end;
+}
+
+// 当前行结束位置（不含 '\r' '\n'）
+inline const char* findLineEnd(const char* p, const char* end) {
+    const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    const char* e = nl ? nl : end;
+    while (e > p && e[-1] == '\r') --e;
+    return e;
+}
+
+inline bool parseFloat(const char*& p, const char* end, float& out) {
+    p = skipSpaces(p, end);
+    if (p < end && *p == '+') ++p;
+    auto result = std::from_chars(p, end, out);
+    if (result.ec != std::errc()) return false;
+    p = result.ptr;
+    return true;
+}
+
+inline bool parseInt(const char*& p, const char* end, long& out) {
+    if (p < end && *p == '+') ++p;
+    auto result = std::from_chars(p, end, out);
+    if (result.ec != std::errc()) return false;
+    p = result.ptr;
+    return true;
+}
+
+// OBJ 面片角点的 (v, vt, vn) 索引组合
+struct ObjVertexKey {
+    static constexpr uint32_t kNone = 0xffffffffu;
+    uint32_t v = kNone;
+    uint32_t vt = kNone;
+    uint32_t vn = kNone;
+    bool operator==(const ObjVertexKey& other) const {
+        return v == other.v && vt == other.vt && vn == other.vn;
+    }
+};
+
+struct ObjVertexKeyHash {
+    size_t operator()(const ObjVertexKey& key) const {
+        uint64_t h = hashMix64((static_cast<uint64_t>(key.v) << 32) | key.vt);
+        return static_cast<size_t>(hashMix64(h ^ key.vn));
+    }
+};
+
+// ---- PLY 头部描述 ----
+
+// PLY 标量类型与属性通道类型一一对应（char/uchar/short/ushort/int/uint/float/double）
+bool plyTypeFromName(const std::string& name, AttributeChannel::Type& type) {
+    static const struct { const char* name; AttributeChannel::Type type; } kTypes[] = {
+        { "char", AttributeChannel::Int8 },    { "int8", AttributeChannel::Int8 },
+        { "uchar", AttributeChannel::UInt8 },  { "uint8", AttributeChannel::UInt8 },
+        { "short", AttributeChannel::Int16 },  { "int16", AttributeChannel::Int16 },
+        { "ushort", AttributeChannel::UInt16 }, { "uint16", AttributeChannel::UInt16 },
+        { "int", AttributeChannel::Int32 },    { "int32", AttributeChannel::Int32 },
+        { "uint", AttributeChannel::UInt32 },  { "uint32", AttributeChannel::UInt32 },
+        { "float", AttributeChannel::Float32 }, { "float32", AttributeChannel::Float32 },
+        { "double", AttributeChannel::Float64 }, { "float64", AttributeChannel::Float64 },
+    };
+    for (const auto& entry : kTypes) {
+        if (name == entry.name) {
+            type = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
+
+// 导出时使用的 PLY 类型名
+const char* plyTypeName(AttributeChannel::Type type) {
+    static const char* const kNames[] = { "char", "uchar", "short", "ushort", "int", "uint", "float", "double" };
+    return kNames[type];
+}
+
+struct PlyProperty {
+    std::string name;
+    AttributeChannel::Type type = AttributeChannel::Float32;       // 标量类型；列表为元素类型
+    bool isList = false;
+    AttributeChannel::Type countType = AttributeChannel::UInt8;    // 列表长度的类型
+};
+
+struct PlyElement {
+    std::string name;
+    size_t count = 0;
+    std::vector<PlyProperty> properties;
+    
+    // 不含列表属性时每个元素的字节数，否则为 0
+    size_t fixedStride() const {
+        size_t stride = 0;
+        for (const auto& property : properties) {
+            if (property.isList) return 0;
+            stride += AttributeChannel::typeSize(property.type);
+        }
+        return stride;
+    }
+    
+    // 每个元素至少占用的字节数：二进制为各标量（列表只计长度字段）之和，ASCII 每个属性至少一个字符加一个分隔符
+    size_t minRecordBytes(bool binary) const {
+        size_t bytes = 0;
+        for (const auto& property : properties) {
+            bytes += binary ? AttributeChannel::typeSize(property.isList ? property.countType : property.type) : 2;
+        }
+        return std::max<size_t>(bytes, 1);
+    }
+};
+
+enum class PlyFormat { Ascii, BinaryLittleEndian, BinaryBigEndian };
+
+struct PlyHeader {
+    PlyFormat format = PlyFormat::Ascii;
+    std::vector<PlyElement> elements;
+};
+
+// 解析头部，成功时 body 指向 end_header 之后的第一个字节
+bool parsePlyHeader(const char* data, const char* end, PlyHeader& header, const char*& body) {
+    const char* p = data;
+    bool first = true;
+    while (p < end) {
+        const char* lineEnd = findLineEnd(p, end);
+        std::string line(p, lineEnd);
+        p = nextLine(p, end);
+        
+        std::vector<std::string> words;
+        for (size_t i = 0; i < line.size();) {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) ++i;
+            size_t j = i;
+            while (j < line.size() && line[j] != ' ' && line[j] != '\t') ++j;
+            if (j > i) words.emplace_back(line, i, j - i);
+            i = j;
+        }
+        if (first) {
+            if (words.size() != 1 || words[0] != "ply") return false;
+            first = false;
+            continue;
+        }
+        if (words.empty() || words[0] == "comment" || words[0] == "obj_info") continue;
+        
+        if (words[0] == "end_header") {
+            body = p;
+            return true;
+        } else if (words[0] == "format" && words.size() >= 2) {
+            if (words[1] == "ascii") header.format = PlyFormat::Ascii;
+            else if (words[1] == "binary_little_endian") header.format = PlyFormat::BinaryLittleEndian;
+            else if (words[1] == "binary_big_endian") header.format = PlyFormat::BinaryBigEndian;
+            else return false;
+        } else if (words[0] == "element" && words.size() >= 3) {
+            PlyElement element;
+            element.name = words[1];
+            element.count = std::strtoull(words[2].c_str(), nullptr, 10);
+            header.elements.push_back(std::move(element));
+        } else if (words[0] == "property" && !header.elements.empty()) {
+            PlyProperty property;
+            if (words.size() >= 5 && words[1] == "list") {
+                property.isList = true;
+                if (!plyTypeFromName(words[2], property.countType) || !plyTypeFromName(words[3], property.type)) return false;
+                property.name = words[4];
+            } else if (words.size() >= 3) {
+                if (!plyTypeFromName(words[1], property.type)) return false;
+                property.name = words[2];
+            } else {
+                return false;
+            }
+            header.elements.back().properties.push_back(std::move(property));
+        }
+    }
+    return false;
+}
+
+// 读取一个二进制标量（按需交换字节序）
+inline double readPlyBinary(const char* p, AttributeChannel::Type type, bool swapBytes) {
+    unsigned char bytes[8];
+    const size_t size = AttributeChannel::typeSize(type);
+    if (swapBytes) {
+        for (size_t i = 0; i < size; ++i) bytes[i] = static_cast<unsigned char>(p[size - 1 - i]);
+    } else {
+        std::memcpy(bytes, p, size);
+    }
+    switch (type) {
+        case AttributeChannel::Int8:    { int8_t v; std::memcpy(&v, bytes, 1); return v; }
+        case AttributeChannel::UInt8:   { uint8_t v; std::memcpy(&v, bytes, 1); return v; }
+        case AttributeChannel::Int16:   { int16_t v; std::memcpy(&v, bytes, 2); return v; }
+        case AttributeChannel::UInt16:  { uint16_t v; std::memcpy(&v, bytes, 2); return v; }
+        case AttributeChannel::Int32:   { int32_t v; std::memcpy(&v, bytes, 4); return v; }
+        case AttributeChannel::UInt32:  { uint32_t v; std::memcpy(&v, bytes, 4); return v; }
+        case AttributeChannel::Float32: { float v; std::memcpy(&v, bytes, 4); return v; }
+        case AttributeChannel::Float64: { double v; std::memcpy(&v, bytes, 8); return v; }
+    }
+    return 0.0;
+}
+
+inline bool parseDouble(const char*& p, const char* end, double& out) {
+    p = skipSpaces(p, end);
+    if (p < end && *p == '+') ++p;
+    auto result = std::from_chars(p, end, out);
+    if (result.ec != std::errc()) return false;
+    p = result.ptr;
+    return true;
+}
+
+// 顶点属性的去向：几何/颜色字段，或属性通道
+enum class PlyTarget { X, Y, Z, NX, NY, NZ, Red, Green, Blue, Channel, Skip };
+
+PlyTarget plyVertexTarget(const PlyProperty& property) {
+    if (property.isList) return PlyTarget::Skip;
+    const std::string& n = property.name;
+    if (n == "x") return PlyTarget::X;
+    if (n == "y") return PlyTarget::Y;
+    if (n == "z") return PlyTarget::Z;
+    if (n == "nx") return PlyTarget::NX;
+    if (n == "ny") return PlyTarget::NY;
+    if (n == "nz") return PlyTarget::NZ;
+    if (n == "red" || n == "diffuse_red" || n == "r") return PlyTarget::Red;
+    if (n == "green" || n == "diffuse_green" || n == "g") return PlyTarget::Green;
+    if (n == "blue" || n == "diffuse_blue" || n == "b") return PlyTarget::Blue;
+    return PlyTarget::Channel;
+}
+
+// 把一个属性值写入顶点（颜色：整数按 0..255，浮点按 0..1）
+inline void applyPlyValue(Vertex& vertex, PlyTarget target, AttributeChannel::Type type, double value,
+                          int rgb[3]) {
+    switch (target) {
+        case PlyTarget::X:  vertex.position.setX(static_cast<float>(value)); break;
+        case PlyTarget::Y:  vertex.position.setY(static_cast<float>(value)); break;
+        case PlyTarget::Z:  vertex.position.setZ(static_cast<float>(value)); break;
+        case PlyTarget::NX: vertex.normal.setX(static_cast<float>(value)); break;
+        case PlyTarget::NY: vertex.normal.setY(static_cast<float>(value)); break;
+        case PlyTarget::NZ: vertex.normal.setZ(static_cast<float>(value)); break;
+        case PlyTarget::Red:
+        case PlyTarget::Green:
+        case PlyTarget::Blue: {
+            const bool isFloat = type == AttributeChannel::Float32 || type == AttributeChannel::Float64;
+            const double scaled = isFloat ? value * 255.0 : (type == AttributeChannel::UInt16 ? value / 257.0 : value);
+            rgb[static_cast<int>(target) - static_cast<int>(PlyTarget::Red)] =
+                qBound(0, static_cast<int>(std::lround(scaled)), 255);
+            break;
+        }
+        default: break;
+    }
+}
+
+inline bool hostIsLittleEndian() {
+    const uint16_t probe = 1;
+    unsigned char firstByte;
+    std::memcpy(&firstByte, &probe, 1);
+    return firstByte == 1;
+}
+
+inline bool readPlyValue(const char*& p, const char* end, AttributeChannel::Type type,
+                         bool binary, bool swapBytes, double& value) {
+    if (!binary) return parseDouble(p, end, value);
+    const size_t size = AttributeChannel::typeSize(type);
+    if (static_cast<size_t>(end - p) < size) return false;
+    value = readPlyBinary(p, type, swapBytes);
+    p += size;
+    return true;
+}
+
+// 逐条读取元素记录的通用路径（支持列表属性与 ASCII）。
+// onScalar(record, property, value) / onList(record, property, values) 接收数据；
+// 返回元素数据之后的位置，数据不完整时返回 nullptr
+template <typename ScalarFn, typename ListFn>
+const char* readPlyRecords(const char* p, const char* end, const PlyElement& element, PlyFormat format,
+                           ScalarFn&& onScalar, ListFn&& onList) {
+    const bool binary = format != PlyFormat::Ascii;
+    const bool swapBytes = binary && (format == PlyFormat::BinaryBigEndian) == hostIsLittleEndian();
+    std::vector<double> list;
+    for (size_t i = 0; i < element.count; ++i) {
+        const char* lineEnd = end;
+        if (!binary) {
+            // 每条记录占一行，跳过空行
+            while (p < end && skipSpaces(p, end) >= findLineEnd(p, end)) p = nextLine(p, end);
+            if (p >= end) return nullptr;
+            lineEnd = findLineEnd(p, end);
+        }
+        for (size_t k = 0; k < element.properties.size(); ++k) {
+            const PlyProperty& property = element.properties[k];
+            double value = 0.0;
+            if (!readPlyValue(p, lineEnd, property.isList ? property.countType : property.type,
+                              binary, swapBytes, value)) {
+                return nullptr;
+            }
+            if (!property.isList) {
+                onScalar(i, k, value);
+                continue;
+            }
+            list.resize(value > 0.0 ? static_cast<size_t>(value) : 0);
+            for (double& item : list) {
+                if (!readPlyValue(p, lineEnd, property.type, binary, swapBytes, item)) return nullptr;
+            }
+            onList(i, k, list);
+        }
+        if (!binary) p = nextLine(p, end);
+    }
+    return p;
+}
+
+// 导出时按批回调 fn(顶点数组, 个数)，fn 返回 false 时中止：外存点云按块流式读取全部点（同时映射的块受工作集限制，
+// 待应用的变换与颜色在读取时应用），
+// 紧凑点云按批反量化全部点，其余模型直接给出内存中的顶点数组
+template <typename Fn>
+bool forEachExportBatch(const std::shared_ptr<Model>& model, Fn&& fn) {
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(model);
+    if (cloud && cloud->isPaged()) {
+        PagedVertexStore& store = *cloud->getPagedStore();
+        std::vector<Vertex> batch;
+        for (size_t c = 0; c < store.chunkCount(); ++c) {
+            PagedVertexStore::ChunkRef chunk = store.acquire(c);
+            if (!chunk) return false;
+            batch.resize(chunk->count);
+            Parallel::forEach(0, chunk->count, [&](size_t i) {
+                batch[i] = store.decode(chunk->records[i]);
+            });
+            if (!fn(batch.data(), batch.size())) return false;
+        }
+        return true;
+    }
+    if (cloud && cloud->isCompact()) {
+        const QuantizedPoints& points = *cloud->getQuantizedPoints();
+        std::vector<Vertex> batch(std::min<size_t>(points.size(), size_t(1) << 20));
+        for (size_t b = 0; b < points.size(); b += batch.size()) {
+            const size_t count = std::min(batch.size(), points.size() - b);
+            Parallel::forRange(0, count, [&](size_t first, size_t last) {
+                points.decode(b + first, last - first, batch.data() + first);
+            });
+            if (!fn(batch.data(), count)) return false;
+        }
+        return true;
+    }
+    const auto& vertices = model->getVertices();
+    return vertices.empty() || fn(vertices.data(), vertices.size());
+}
+
+// 导出时逐顶点回调（顺序同 forEachExportBatch）
+template <typename Fn>
+bool forEachExportVertex(const std::shared_ptr<Model>& model, Fn&& fn) {
+    return forEachExportBatch(model, [&](const Vertex* vertices, size_t count) {
+        for (size_t i = 0; i < count; ++i) fn(vertices[i]);
+        return true;
+    });
+}
+
+size_t exportVertexCount(const std::shared_ptr<Model>& model) {
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(model);
+    return cloud ? cloud->getTotalPointCount() : model->getVertexCount();
+}
+
+// ---- 导出格式化 ----
+
+// 浮点数按最短可往返表示格式化（不超过 15 个字符）
+inline char* writeFloat(char* p, float value) {
+    return std::to_chars(p, p + 16, value).ptr;
+}
+
+inline char* writeUInt(char* p, uint64_t value) {
+    return std::to_chars(p, p + 20, value).ptr;
+}
+
+template <typename T>
+inline char* writeLittleEndian(char* p, T value) {
+    value = qToLittleEndian(value);
+    std::memcpy(p, &value, sizeof(value));
+    return p + sizeof(value);
+}
+
+// 属性通道第 i 个值：二进制按原类型小端写出，ASCII 按最短可往返表示；未分配的通道写 0
+inline char* writeChannelValue(char* p, const AttributeChannel& channel, size_t i, bool binary) {
+    const size_t size = AttributeChannel::typeSize(channel.type());
+    const uint8_t* data = channel.data();
+    if (binary) {
+        for (size_t b = 0; b < size; ++b) {
+            *p++ = data ? static_cast<char>(data[i * size + (hostIsLittleEndian() ? b : size - 1 - b)]) : 0;
+        }
+        return p;
+    }
+    if (!data) {
+        *p++ = '0';
+        return p;
+    }
+    const uint8_t* bytes = data + i * size;
+    switch (channel.type()) {
+        case AttributeChannel::Int8:    { int8_t v; std::memcpy(&v, bytes, 1); return std::to_chars(p, p + 4, v).ptr; }
+        case AttributeChannel::UInt8:   { uint8_t v; std::memcpy(&v, bytes, 1); return std::to_chars(p, p + 3, v).ptr; }
+        case AttributeChannel::Int16:   { int16_t v; std::memcpy(&v, bytes, 2); return std::to_chars(p, p + 6, v).ptr; }
+        case AttributeChannel::UInt16:  { uint16_t v; std::memcpy(&v, bytes, 2); return std::to_chars(p, p + 5, v).ptr; }
+        case AttributeChannel::Int32:   { int32_t v; std::memcpy(&v, bytes, 4); return std::to_chars(p, p + 11, v).ptr; }
+        case AttributeChannel::UInt32:  { uint32_t v; std::memcpy(&v, bytes, 4); return std::to_chars(p, p + 10, v).ptr; }
+        case AttributeChannel::Float32: { float v; std::memcpy(&v, bytes, 4); return writeFloat(p, v); }
+        case AttributeChannel::Float64: { double v; std::memcpy(&v, bytes, 8); return std::to_chars(p, p + 24, v).ptr; }
+    }
+    return p;
+}
+
+// 按批并行格式化 count 项：每批切成连续块，各块由 format(i, p)（返回写入末尾）写入自己的缓冲区，
+// 再按块顺序写出，结果与逐项顺序写入相同。maxItemBytes 为单项的最大字节数
+template <typename Fn>
+bool writeItems(QFile& file, size_t count, size_t maxItemBytes, Fn&& format) {
+    const size_t batch = size_t(1) << 18;
+    std::vector<std::vector<char>> buffers(Parallel::threadCount());
+    std::vector<size_t> lengths(buffers.size(), 0);
+    for (size_t begin = 0; begin < count; begin += batch) {
+        const size_t n = std::min(batch, count - begin);
+        const size_t chunks = Parallel::chunkCount(n, 4096);
+        Parallel::forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+            std::vector<char>& buffer = buffers[c];
+            buffer.resize((e - b) * maxItemBytes);
+            char* p = buffer.data();
+            for (size_t i = b; i < e; ++i) p = format(begin + i, p);
+            lengths[c] = static_cast<size_t>(p - buffer.data());
+        });
+        for (size_t c = 0; c < chunks; ++c) {
+            if (file.write(buffers[c].data(), qint64(lengths[c])) != qint64(lengths[c])) return false;
+        }
+    }
+    return true;
+}
+
+// ---- STL ----
+
+const size_t kStlHeaderBytes = 84;      // 80 字节文件头 + uint32 三角形数
+const size_t kStlRecordBytes = 50;      // 法线 + 3 个角点（12 个 float）+ uint16 属性
+
+// ---- LAS ----
+
+const qint64 kLasHeaderBytes = 375;                 // LAS 1.4 公共头长度（更早版本的头更短）
+const qint64 kLasMinHeaderBytes = 227;              // LAS 1.0–1.2 公共头长度
+const size_t kLasWindowBytes = size_t(256) << 20;   // 每次映射的最大字节数
+const double kLasShiftThreshold = 1.0e5;            // 坐标绝对值超过此值（米）时平移
+// 点记录格式 0–10 的最小记录长度与 RGB 在记录中的偏移（-1 表示无颜色）
+const size_t kLasRecordBytes[11] = { 20, 28, 26, 34, 57, 63, 30, 36, 38, 59, 67 };
+const int kLasColorOffset[11] = { -1, -1, 20, 28, -1, 28, -1, 30, 30, -1, 30 };
+
+template <typename T>
+inline T readLittleEndian(const char* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(value));
+    return qFromLittleEndian(value);
+}
+
+// 公共头中解码点记录所需的字段
+struct LasHeader {
+    int versionMajor = 0;
+    int versionMinor = 0;
+    int pointFormat = 0;
+    size_t recordLength = 0;
+    qint64 pointOffset = 0;
+    uint64_t pointCount = 0;
+    double scale[3] = { 1.0, 1.0, 1.0 };
+    double offset[3] = { 0.0, 0.0, 0.0 };
+    double origin[3] = { 0.0, 0.0, 0.0 };   // 导入时从坐标中减去的平移
+    int colorShift = 0;                      // 16 位颜色转为 8 位时的右移位数
+};
+
+// 读取并校验公共头，确定坐标平移与颜色位深。文件不合法时记录原因并返回 false
+bool readLasHeader(QFile& file, LasHeader& header) {
+    const qint64 fileSize = file.size();
+    const QByteArray head = file.read(std::min(fileSize, kLasHeaderBytes));
+    const char* h = head.constData();
+    if (head.size() < kLasMinHeaderBytes || std::memcmp(h, "LASF", 4) != 0) {
+        qDebug() << "不是有效的LAS文件";
+        return false;
+    }
+    header.versionMajor = static_cast<uint8_t>(h[24]);
+    header.versionMinor = static_cast<uint8_t>(h[25]);
+    const qint64 headerSize = readLittleEndian<uint16_t>(h + 94);
+    header.pointOffset = readLittleEndian<uint32_t>(h + 96);
+    const int format = static_cast<uint8_t>(h[104]);
+    header.recordLength = readLittleEndian<uint16_t>(h + 105);
+    if (format & 0xc0) {
+        qDebug() << "不支持 LAZ 压缩的点数据";
+        return false;
+    }
+    if (format > 10 || header.recordLength < kLasRecordBytes[format]) {
+        qDebug() << "不支持的 LAS 点记录格式:" << format << ", 记录长度" << header.recordLength;
+        return false;
+    }
+    header.pointFormat = format;
+    header.pointCount = readLittleEndian<uint32_t>(h + 107);
+    // LAS 1.4 的 64 位点数（格式 6–10 的旧字段为 0）
+    if (header.versionMinor >= 4 && headerSize >= 255 && head.size() >= 255) {
+        const uint64_t extendedCount = readLittleEndian<uint64_t>(h + 247);
+        if (extendedCount > 0) header.pointCount = extendedCount;
+    }
+    if (headerSize < kLasMinHeaderBytes || header.pointOffset < headerSize || header.pointOffset > fileSize) {
+        qDebug() << "LAS 头部的点数据偏移无效";
+        return false;
+    }
+    const uint64_t available = static_cast<uint64_t>(fileSize - header.pointOffset) / header.recordLength;
+    if (available < header.pointCount) {
+        qDebug() << "LAS 数据不完整，只读取前" << available << "个点（头部声明" << header.pointCount << "个）";
+        header.pointCount = available;
+    }
+    
+    // 大地坐标（如 UTM）的数值远大于点间距，直接转为 float 会丢失厘米级精度：
+    // 包围盒超出 kLasShiftThreshold 的轴按整米平移到包围盒最小值
+    bool shifted = false;
+    for (int k = 0; k < 3; ++k) {
+        header.scale[k] = readLittleEndian<double>(h + 131 + k * 8);
+        header.offset[k] = readLittleEndian<double>(h + 155 + k * 8);
+        const double maxBound = readLittleEndian<double>(h + 179 + k * 16);
+        const double minBound = readLittleEndian<double>(h + 187 + k * 16);
+        if (header.scale[k] == 0.0 || !std::isfinite(header.scale[k]) || !std::isfinite(header.offset[k])) {
+            qDebug() << "LAS 头部的坐标比例无效";
+            return false;
+        }
+        if (std::isfinite(minBound) && std::isfinite(maxBound) &&
+            std::max(std::abs(minBound), std::abs(maxBound)) > kLasShiftThreshold) {
+            header.origin[k] = std::floor(minBound);
+            shifted = true;
+        }
+    }
+    if (shifted) {
+        qDebug() << "LAS 坐标平移:" << -header.origin[0] << -header.origin[1] << -header.origin[2];
+    }
+    
+    // 颜色按规范为 16 位，但不少文件直接存 8 位值：抽查前若干点，全部不超过 255 时按 8 位处理
+    const int colorOffset = kLasColorOffset[format];
+    if (colorOffset >= 0 && header.pointCount > 0) {
+        const size_t sample = static_cast<size_t>(std::min<uint64_t>(header.pointCount, 65536));
+        if (!file.seek(header.pointOffset)) return false;
+        const QByteArray records = file.read(static_cast<qint64>(sample * header.recordLength));
+        for (size_t i = 0; i < sample && header.colorShift == 0; ++i) {
+            if (static_cast<size_t>(records.size()) < (i + 1) * header.recordLength) break;
+            const char* rgb = records.constData() + i * header.recordLength + colorOffset;
+            for (int c = 0; c < 3; ++c) {
+                if (readLittleEndian<uint16_t>(rgb + c * 2) > 255) header.colorShift = 8;
+            }
+        }
+    }
+    return true;
+}
+
+// 解码一条点记录：坐标 = 整数 * scale + offset - origin
+inline Vertex decodeLasPoint(const char* record, const LasHeader& header) {
+    float xyz[3];
+    for (int k = 0; k < 3; ++k) {
+        xyz[k] = static_cast<float>(readLittleEndian<int32_t>(record + k * 4) * header.scale[k] +
+                                    header.offset[k] - header.origin[k]);
+    }
+    Vertex vertex(QVector3D(xyz[0], xyz[1], xyz[2]));
+    const int colorOffset = kLasColorOffset[header.pointFormat];
+    if (colorOffset >= 0) {
+        const char* rgb = record + colorOffset;
+        vertex.color = QColor(std::min(255, readLittleEndian<uint16_t>(rgb) >> header.colorShift),
+                              std::min(255, readLittleEndian<uint16_t>(rgb + 2) >> header.colorShift),
+                              std::min(255, readLittleEndian<uint16_t>(rgb + 4) >> header.colorShift));
+    }
+    return vertex;
+}
+
+// 格式 0–5 的分类字节低 5 位为类别（高 3 位为合成 / 关键点 / 保留标志），格式 6–10 的分类独占第 16 字节
+inline uint8_t lasClassification(const char* record, const LasHeader& header) {
+    return header.pointFormat >= 6 ? static_cast<uint8_t>(record[16]) : static_cast<uint8_t>(record[15] & 0x1f);
+}
+
+// 每个窗口的样本数：不超过 maxSamples，且映射范围不超过 kLasWindowBytes
+size_t lasWindowSamples(const LasHeader& header, size_t stride, size_t maxSamples) {
+    return std::max<size_t>(1, std::min(maxSamples, kLasWindowBytes / (stride * header.recordLength)));
+}
+
+// 按窗口映射点记录（每 stride 条取一条，映射失败时退回读取），逐窗口调用
+// fn(首个样本序号, 样本数, 首条样本记录, 相邻样本的字节间距)；读取失败或 fn 返回 false 时返回 false
+template <typename Fn>
+bool forEachLasWindow(QFile& file, const LasHeader& header, size_t stride, size_t windowSamples, Fn&& fn) {
+    const uint64_t samples = (header.pointCount + stride - 1) / stride;
+    const size_t step = stride * header.recordLength;
+    QByteArray buffer;
+    for (uint64_t first = 0; first < samples; first += windowSamples) {
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(windowSamples, samples - first));
+        const qint64 start = header.pointOffset + static_cast<qint64>(first * step);
+        const qint64 span = static_cast<qint64>((count - 1) * step + header.recordLength);
+        uchar* window = file.map(start, span);
+        const char* records = reinterpret_cast<const char*>(window);
+        if (!window) {
+            if (!file.seek(start)) return false;
+            buffer = file.read(span);
+            if (buffer.size() != span) return false;
+            records = buffer.constData();
+        }
+        const bool ok = fn(static_cast<size_t>(first), count, records, step);
+        if (window) file.unmap(window);
+        if (!ok) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+std::shared_ptr<Model> FileImporter::importFile(const QString& filePath, const ImportOptions& options) {
     FileFormat format = detectFormat(filePath);
     
+    std::shared_ptr<Model> model;
+    if (options.outOfCoreThreshold > 0 && (format == PLY || format == XYZ || format == LAS) &&
+        QFileInfo(filePath).size() > options.outOfCoreThreshold) {
+        model = importPointCloudPaged(filePath, format, options);
+        if (model) return model;
+        qDebug() << "不适用外存导入，改为常规导入: " << filePath;
+    }
     switch (format) {
         case PLY:
-            return importPLY(filePath);
+            model = importPLY(filePath);
+            break;
         case OBJ:
-            return importOBJ(filePath);
+            model = importOBJ(filePath);
+            break;
         case XYZ:
-            return importXYZ(filePath);
+            model = importXYZ(filePath);
+            break;
+        case STL:
+            model = importSTL(filePath);
+            break;
+        case LAS:
+            model = importLAS(filePath, options.lasStride);
+            break;
+        case COMPRESSED:
+            model = importCompressed(filePath);
+            break;
         default:
             qDebug() << "不支持的文件格式: " << filePath;
             return nullptr;
     }
+    
+    if (model) postProcess(model, options);
+    return model;
 }
 
-bool FileImporter::exportFile(std::shared_ptr<Model> model, const QString& filePath) {
+void FileImporter::postProcess(const std::shared_ptr<Model>& model, const ImportOptions& options) {
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(model);
+    if (cloud && options.spatialSortPoints) {
+        QElapsedTimer timer;
+        timer.start();
+        cloud->sortByMorton();
+        qDebug() << "点云空间排序:" << cloud->getPointCount() << "个点, 耗时" << timer.elapsed() << "ms";
+    }
+    
+    auto mesh = std::dynamic_pointer_cast<Mesh>(model);
+    if (mesh && options.weldVertices) {
+        QElapsedTimer timer;
+        timer.start();
+        Mesh::WeldStats stats = mesh->weldVertices(options.weldTolerance);
+        qDebug() << "顶点焊接: 合并" << stats.mergedVertices << "个顶点, 删除"
+                 << stats.removedTriangles << "个退化面, 耗时" << timer.elapsed() << "ms";
+    }
+    // 索引优化放在焊接之后：焊接会改变顶点编号与三角形集合
+    if (mesh && options.optimizeIndices) {
+        MeshOptimizer::Report report = MeshOptimizer::optimize(*mesh);
+        qDebug() << "索引优化: ACMR" << report.acmrBefore << "->" << report.acmrAfter
+                 << ", 耗时" << report.elapsedMs << "ms";
+    }
+}
+
+bool FileImporter::exportFile(std::shared_ptr<Model> model, const QString& filePath, const ExportOptions& options) {
     if (!model) return false;
     
+    // 被过滤或裁切的顶点不导出：先压缩为只含可见顶点的临时模型。
+    // 外存 / 紧凑点云的图层只覆盖内存中的预览点，导出时直接写出其中的全部点
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(model);
+    if (cloud && (cloud->isPaged() || cloud->isCompact())) {
+        if (model->hasHiddenVertices()) qDebug() << "外存/紧凑点云导出全部点，忽略预览上的过滤/裁切";
+    } else if (model->hasHiddenVertices()) {
+        model = model->compactVisible(model->getName());
+    }
+    
     FileFormat format = detectFormat(filePath);
     
     switch (format) {
         case PLY:
-            return exportPLY(model, filePath);
+            return exportPLY(model, filePath, options.binaryPly);
         case OBJ:
             return exportOBJ(model, filePath);
         case XYZ:
             return exportXYZ(model, filePath);
+        case STL:
+            return exportSTL(model, filePath);
+        case COMPRESSED:
+            return exportCompressed(model, filePath, options);
         default:
             qDebug() << "不支持的导出格式: " << filePath;
             return false;
@@ -47,173 +724,356 @@ FileImporter::FileFormat FileImporter::detectFormat(const QString& filePath) {
     if (suffix == "ply") return PLY;
     if (suffix == "obj") return OBJ;
     if (suffix == "xyz") return XYZ;
+    if (suffix == "stl") return STL;
+    if (suffix == "las") return LAS;
+    if (suffix == "3dvz") return COMPRESSED;
     
     return UNKNOWN;
 }
 
 std::shared_ptr<Model> FileImporter::importPLY(const QString& filePath) {
     QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::ReadOnly)) {
         qDebug() << "无法打开文件: " << filePath;
         return nullptr;
     }
     
-    QTextStream in(&file);
-    QString line = in.readLine();
+    // 优先内存映射整个文件，失败时退回一次性读取
+    QByteArray buffer;
+    const qint64 fileSize = file.size();
+    uchar* mapped = fileSize > 0 ? file.map(0, fileSize) : nullptr;
+    if (!mapped) buffer = file.readAll();
+    const char* const data = mapped ? reinterpret_cast<const char*>(mapped) : buffer.constData();
+    const char* const end = data + (mapped ? fileSize : buffer.size());
     
-    if (line != "ply") {
+    PlyHeader header;
+    const char* p = nullptr;
+    if (!parsePlyHeader(data, end, header, p)) {
         qDebug() << "不是有效的PLY文件";
         return nullptr;
     }
     
-    // 简化的PLY解析器
-    int vertexCount = 0;
-    int faceCount = 0;
-    bool isAscii = true;
-    
-    // 读取头部信息
-    while (!in.atEnd()) {
-        line = in.readLine().trimmed();
-        if (line == "end_header") break;
-        
-        if (line.startsWith("element vertex")) {
-            vertexCount = line.split(" ").last().toInt();
-        } else if (line.startsWith("element face")) {
-            faceCount = line.split(" ").last().toInt();
-        } else if (line == "format binary_little_endian 1.0") {
-            isAscii = false;
+    const PlyElement* vertexElement = nullptr;
+    for (const auto& element : header.elements) {
+        if (element.name == "vertex") {
+            vertexElement = &element;
+            break;
         }
     }
-    
-    if (vertexCount == 0) {
+    if (!vertexElement || vertexElement->count == 0) {
         qDebug() << "没有找到顶点数据";
         return nullptr;
     }
     
-    // 仅支持ASCII简化解析
-    if (!isAscii) {
-        qDebug() << "暂不支持二进制PLY，尝试按点云读取顶点";
+    // 顶点属性去向：x/y/z、法线、颜色写入 Vertex，其余标量属性各成一个属性通道
+    const size_t vertexCount = vertexElement->count;
+    const auto& vertexProperties = vertexElement->properties;
+    std::vector<PlyTarget> targets(vertexProperties.size());
+    std::vector<int> channelIndex(vertexProperties.size(), -1);
+    std::vector<AttributeChannel> channels;
+    int axisMask = 0;
+    bool hasColor = false;
+    for (size_t k = 0; k < vertexProperties.size(); ++k) {
+        targets[k] = plyVertexTarget(vertexProperties[k]);
+        if (targets[k] == PlyTarget::X) axisMask |= 1;
+        if (targets[k] == PlyTarget::Y) axisMask |= 2;
+        if (targets[k] == PlyTarget::Z) axisMask |= 4;
+        if (targets[k] == PlyTarget::Red || targets[k] == PlyTarget::Green || targets[k] == PlyTarget::Blue) hasColor = true;
+        if (targets[k] == PlyTarget::Channel) {
+            channelIndex[k] = static_cast<int>(channels.size());
+            channels.emplace_back(QString::fromStdString(vertexProperties[k].name), vertexProperties[k].type, vertexCount);
+        }
     }
-
-    const QString baseName = QFileInfo(filePath).baseName();
-    if (faceCount > 0) {
-        // 读取为Mesh
-        auto mesh = std::make_shared<Mesh>(baseName);
-        // 读取顶点
-        for (int i = 0; i < vertexCount && !in.atEnd(); ++i) {
-            line = in.readLine();
-            QStringList coords = line.split(" ", Qt::SkipEmptyParts);
-            if (coords.size() >= 3) {
-                float x = coords[0].toFloat();
-                float y = coords[1].toFloat();
-                float z = coords[2].toFloat();
-                QColor color = Qt::white;
-                if (coords.size() >= 6) {
-                    int r = qBound(0, coords[3].toInt(), 255);
-                    int g = qBound(0, coords[4].toInt(), 255);
-                    int b = qBound(0, coords[5].toInt(), 255);
-                    color = QColor(r, g, b);
-                }
-                mesh->addVertex(QVector3D(x, y, z), QVector3D(0,0,1), color);
-            }
+    if (axisMask != 7) {
+        qDebug() << "PLY 顶点缺少 x/y/z 属性";
+        return nullptr;
+    }
+    
+    // 按头部声明的元素数分配之前，先确认文件剩余长度至少容纳这么多记录（损坏或恶意的头部不应导致巨量分配）
+    const bool binary = header.format != PlyFormat::Ascii;
+    size_t remaining = static_cast<size_t>(end - p) + (binary ? 0 : 1);   // ASCII 末行可能没有换行
+    for (const auto& element : header.elements) {
+        const size_t minBytes = element.minRecordBytes(binary);
+        if (element.count > remaining / minBytes) {
+            qDebug() << "PLY 头部声明的元素数超出文件长度:" << QString::fromStdString(element.name) << element.count;
+            return nullptr;
         }
-        // 读取面（每行: n i0 i1 i2 ...）
-        for (int f = 0; f < faceCount && !in.atEnd(); ++f) {
-            line = in.readLine().trimmed();
-            if (line.isEmpty()) { --f; continue; }
-            QStringList parts = line.split(" ", Qt::SkipEmptyParts);
-            if (parts.size() < 4) continue; // 至少: n i j k
-            bool ok=false;
-            int n = parts[0].toInt(&ok);
-            if (!ok || n < 3 || parts.size() < n+1) continue;
-            std::vector<unsigned int> idx;
-            idx.reserve(n);
-            for (int k = 0; k < n; ++k) {
-                unsigned int vi = parts[1+k].toUInt();
-                idx.push_back(vi);
-            }
-            // 扇形三角化
-            for (int k = 1; k < n-1; ++k) {
-                mesh->addTriangle(idx[0], idx[k], idx[k+1]);
+        remaining -= element.count * minBytes;
+    }
+    
+    const bool swapBytes = binary && (header.format == PlyFormat::BinaryBigEndian) == hostIsLittleEndian();
+    std::vector<Vertex> vertices(vertexCount);
+    std::vector<unsigned int> triangles;
+    
+    for (const auto& element : header.elements) {
+        const size_t stride = binary ? element.fixedStride() : 0;
+        
+        if (&element == vertexElement && stride > 0) {
+            // 定长二进制顶点：按记录并行解码，属性通道直接按原类型拷贝字节
+            if (static_cast<size_t>(end - p) / stride < vertexCount) p = nullptr;
+            if (!p) break;
+            std::vector<size_t> offsets(vertexProperties.size());
+            std::vector<uint8_t*> channelData(vertexProperties.size(), nullptr);
+            for (size_t k = 0, offset = 0; k < vertexProperties.size(); ++k) {
+                offsets[k] = offset;
+                offset += AttributeChannel::typeSize(vertexProperties[k].type);
+                if (channelIndex[k] >= 0) channelData[k] = channels[channelIndex[k]].mutableData();
             }
+            const char* const records = p;
+            Parallel::forEach(0, vertexCount, [&](size_t i) {
+                const char* record = records + i * stride;
+                Vertex& vertex = vertices[i];
+                int rgb[3] = { 255, 255, 255 };
+                for (size_t k = 0; k < vertexProperties.size(); ++k) {
+                    const AttributeChannel::Type type = vertexProperties[k].type;
+                    if (channelData[k]) {
+                        const size_t size = AttributeChannel::typeSize(type);
+                        uint8_t* out = channelData[k] + i * size;
+                        for (size_t b = 0; b < size; ++b) {
+                            out[b] = static_cast<uint8_t>(record[offsets[k] + (swapBytes ? size - 1 - b : b)]);
+                        }
+                    } else {
+                        applyPlyValue(vertex, targets[k], type, readPlyBinary(record + offsets[k], type, swapBytes), rgb);
+                    }
+                }
+                if (hasColor) vertex.color = QColor(rgb[0], rgb[1], rgb[2]);
+            });
+            p = records + vertexCount * stride;
+        } else if (&element == vertexElement) {
+            // ASCII 或含列表属性的顶点：逐条解析，颜色在每条记录的最后一个属性后写入
+            int rgb[3] = { 255, 255, 255 };
+            const size_t lastProperty = vertexProperties.size() - 1;
+            p = readPlyRecords(p, end, element, header.format,
+                [&](size_t i, size_t k, double value) {
+                    if (channelIndex[k] >= 0) {
+                        channels[channelIndex[k]].setValue(i, value);
+                    } else {
+                        applyPlyValue(vertices[i], targets[k], vertexProperties[k].type, value, rgb);
+                    }
+                    if (k == lastProperty && hasColor) vertices[i].color = QColor(rgb[0], rgb[1], rgb[2]);
+                },
+                [&](size_t i, size_t k, const std::vector<double>&) {
+                    if (k == lastProperty && hasColor) vertices[i].color = QColor(rgb[0], rgb[1], rgb[2]);
+                });
+        } else if (element.name == "face") {
+            // 面：读取顶点索引列表并扇形三角化，越界索引的面被丢弃
+            triangles.reserve(element.count * 3);
+            p = readPlyRecords(p, end, element, header.format,
+                [](size_t, size_t, double) {},
+                [&](size_t, size_t k, const std::vector<double>& indices) {
+                    const std::string& name = element.properties[k].name;
+                    if (name != "vertex_indices" && name != "vertex_index") return;
+                    if (indices.size() < 3) return;
+                    for (double index : indices) {
+                        if (index < 0.0 || index >= static_cast<double>(vertexCount)) return;
+                    }
+                    for (size_t j = 1; j + 1 < indices.size(); ++j) {
+                        triangles.push_back(static_cast<unsigned int>(indices[0]));
+                        triangles.push_back(static_cast<unsigned int>(indices[j]));
+                        triangles.push_back(static_cast<unsigned int>(indices[j + 1]));
+                    }
+                });
+        } else if (stride > 0) {
+            // 其他定长二进制元素直接跳过
+            p = static_cast<size_t>(end - p) / stride < element.count ? nullptr : p + element.count * stride;
+        } else {
+            p = readPlyRecords(p, end, element, header.format,
+                               [](size_t, size_t, double) {},
+                               [](size_t, size_t, const std::vector<double>&) {});
         }
-        file.close();
-        return mesh;
+        if (!p) break;
+    }
+    if (!p) {
+        qDebug() << "PLY 数据不完整: " << filePath;
+        return nullptr;
+    }
+    
+    const QString baseName = QFileInfo(filePath).baseName();
+    std::shared_ptr<Model> model;
+    if (!triangles.empty()) {
+        auto mesh = std::make_shared<Mesh>(baseName);
+        mesh->setGeometry(std::move(vertices), std::move(triangles));
+        model = mesh;
     } else {
         // 无面时作为点云
         auto pointCloud = std::make_shared<PointCloud>(baseName);
-        for (int i = 0; i < vertexCount && !in.atEnd(); ++i) {
-            line = in.readLine();
-            QStringList coords = line.split(" ", Qt::SkipEmptyParts);
-            if (coords.size() >= 3) {
-                float x = coords[0].toFloat();
-                float y = coords[1].toFloat();
-                float z = coords[2].toFloat();
-                QColor color = Qt::white;
-                if (coords.size() >= 6) {
-                    int r = qBound(0, coords[3].toInt(), 255);
-                    int g = qBound(0, coords[4].toInt(), 255);
-                    int b = qBound(0, coords[5].toInt(), 255);
-                    color = QColor(r, g, b);
-                }
-                pointCloud->addPoint(QVector3D(x, y, z), color);
-            }
-        }
-        file.close();
-        return pointCloud;
+        pointCloud->setPoints(std::move(vertices));
+        model = pointCloud;
+    }
+    for (auto& channel : channels) {
+        model->addAttribute(std::move(channel));
     }
+    if (!model->getAttributes().empty()) {
+        model->setActiveAttribute(model->getAttributes().front().name());
+    }
+    return model;
 }
 
 std::shared_ptr<Model> FileImporter::importOBJ(const QString& filePath) {
     QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::ReadOnly)) {
         qDebug() << "无法打开文件: " << filePath;
         return nullptr;
     }
     
-    auto mesh = std::make_shared<Mesh>(QFileInfo(filePath).baseName());
-    QTextStream in(&file);
+    // 优先内存映射整个文件，失败时退回一次性读取
+    QByteArray buffer;
+    const qint64 fileSize = file.size();
+    uchar* mapped = fileSize > 0 ? file.map(0, fileSize) : nullptr;
+    if (!mapped) buffer = file.readAll();
+    const char* const data = mapped ? reinterpret_cast<const char*>(mapped) : buffer.constData();
+    const char* const end = data + (mapped ? fileSize : buffer.size());
     
-    while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
-        if (line.isEmpty() || line.startsWith("#")) continue;
-        
-        QStringList parts = line.split(" ", Qt::SkipEmptyParts);
-        if (parts.isEmpty()) continue;
-        
-        QString type = parts[0];
+    // 第一遍：统计各类行数，用于预分配
+    size_t positionCount = 0, texCoordCount = 0, normalCount = 0, cornerCount = 0, faceCount = 0;
+    for (const char* p = data; p < end; p = nextLine(p, end)) {
+        p = skipSpaces(p, end);
+        if (end - p < 2) continue;
+        if (p[0] == 'v') {
+            if (p[1] == ' ' || p[1] == '\t') ++positionCount;
+            else if (p[1] == 't') ++texCoordCount;
+            else if (p[1] == 'n') ++normalCount;
+        } else if (p[0] == 'f' && (p[1] == ' ' || p[1] == '\t')) {
+            ++faceCount;
+            const char* lineEnd = findLineEnd(p, end);
+            for (const char* q = p + 1; q < lineEnd;) {
+                q = skipSpaces(q, lineEnd);
+                if (q >= lineEnd) break;
+                ++cornerCount;
+                while (q < lineEnd && *q != ' ' && *q != '\t') ++q;
+            }
+        }
+    }
+    
+    std::vector<QVector3D> positions;
+    std::vector<QVector2D> texCoords;
+    std::vector<QVector3D> normals;
+    positions.reserve(positionCount);
+    texCoords.reserve(texCoordCount);
+    normals.reserve(normalCount);
+    
+    // 输出的统一顶点：每个唯一 (v, vt, vn) 组合对应一个顶点
+    std::vector<Vertex> vertices;
+    std::vector<QVector2D> vertexTexCoords;
+    std::vector<unsigned int> triangles;
+    vertices.reserve(positionCount);
+    if (texCoordCount > 0) vertexTexCoords.reserve(positionCount);
+    triangles.reserve(cornerCount > 2 * faceCount ? 3 * (cornerCount - 2 * faceCount) : 0);
+    
+    OpenHashMap<ObjVertexKey, unsigned int, ObjVertexKeyHash> vertexMap(
+        std::max(positionCount, std::max(texCoordCount, normalCount)));
+    bool anyTexCoord = false;
+    
+    // 解析面片中的单个顶点引用 "v"、"v/vt"、"v//vn"、"v/vt/vn"（支持负数相对索引）。
+    // 行内没有更多角点时返回 false；索引非法时 key.v 为 kNone
+    auto resolveIndex = [](long value, size_t count) -> uint32_t {
+        if (value > 0 && static_cast<size_t>(value) <= count) return static_cast<uint32_t>(value - 1);
+        if (value < 0 && static_cast<size_t>(-value) <= count) return static_cast<uint32_t>(count + value);
+        return ObjVertexKey::kNone;
+    };
+    auto parseCorner = [&](const char*& q, const char* lineEnd, ObjVertexKey& key) -> bool {
+        q = skipSpaces(q, lineEnd);
+        if (q >= lineEnd) return false;
+        long vi = 0, ti = 0, ni = 0;
+        parseInt(q, lineEnd, vi);
+        if (q < lineEnd && *q == '/') {
+            ++q;
+            if (q < lineEnd && *q != '/') parseInt(q, lineEnd, ti);
+            if (q < lineEnd && *q == '/') {
+                ++q;
+                parseInt(q, lineEnd, ni);
+            }
+        }
+        while (q < lineEnd && *q != ' ' && *q != '\t') ++q;
+        key.v = resolveIndex(vi, positions.size());
+        key.vt = ti != 0 ? resolveIndex(ti, texCoords.size()) : ObjVertexKey::kNone;
+        key.vn = ni != 0 ? resolveIndex(ni, normals.size()) : ObjVertexKey::kNone;
+        return true;
+    };
+    
+    // 第二遍：解析数据
+    for (const char* p = data; p < end; p = nextLine(p, end)) {
+        p = skipSpaces(p, end);
+        const char* lineEnd = findLineEnd(p, end);
+        if (lineEnd - p < 2 || *p == '#') continue;
         
-        if (type == "v" && parts.size() >= 4) {
+        if (p[0] == 'v' && (p[1] == ' ' || p[1] == '\t')) {
             // 顶点坐标
-            float x = parts[1].toFloat();
-            float y = parts[2].toFloat();
-            float z = parts[3].toFloat();
-            mesh->addVertex(QVector3D(x, y, z));
-        } else if (type == "vn" && parts.size() >= 4) {
-            // 顶点法线（暂时存储，后续处理）
-            float nx = parts[1].toFloat();
-            float ny = parts[2].toFloat();
-            float nz = parts[3].toFloat();
-            // 在实际应用中，需要将法线与顶点关联
-        } else if (type == "f" && parts.size() >= 4) {
-            // 面片
-            std::vector<unsigned int> indices;
-            for (int i = 1; i < parts.size(); ++i) {
-                QStringList vertexData = parts[i].split("/");
-                if (!vertexData.isEmpty()) {
-                    unsigned int index = vertexData[0].toUInt() - 1; // OBJ索引从1开始
-                    indices.push_back(index);
-                }
+            float x = 0, y = 0, z = 0;
+            const char* q = p + 1;
+            parseFloat(q, lineEnd, x);
+            parseFloat(q, lineEnd, y);
+            parseFloat(q, lineEnd, z);
+            positions.emplace_back(x, y, z);
+        } else if (p[0] == 'v' && p[1] == 't') {
+            // 纹理坐标
+            float u = 0, v = 0;
+            const char* q = p + 2;
+            parseFloat(q, lineEnd, u);
+            parseFloat(q, lineEnd, v);
+            texCoords.emplace_back(u, v);
+        } else if (p[0] == 'v' && p[1] == 'n') {
+            // 顶点法线
+            float nx = 0, ny = 0, nz = 1;
+            const char* q = p + 2;
+            parseFloat(q, lineEnd, nx);
+            parseFloat(q, lineEnd, ny);
+            parseFloat(q, lineEnd, nz);
+            normals.emplace_back(nx, ny, nz);
+        } else if (p[0] == 'f' && (p[1] == ' ' || p[1] == '\t')) {
+            // 面片：先校验所有角点，避免非法面留下孤立顶点
+            bool valid = true;
+            int cornerTotal = 0;
+            ObjVertexKey key;
+            for (const char* q = p + 1; parseCorner(q, lineEnd, key);) {
+                if (key.v == ObjVertexKey::kNone) { valid = false; break; }
+                ++cornerTotal;
             }
+            if (!valid || cornerTotal < 3) continue;
             
-            // 将多边形三角化（简化处理）
-            for (size_t i = 1; i < indices.size() - 1; ++i) {
-                mesh->addTriangle(indices[0], indices[i], indices[i + 1]);
+            // 逐个角点查表得到统一顶点索引，同时做扇形三角化（无需临时数组）
+            unsigned int first = 0, previous = 0;
+            int corner = 0;
+            for (const char* q = p + 1; parseCorner(q, lineEnd, key); ++corner) {
+                auto inserted = vertexMap.insert(key, static_cast<unsigned int>(vertices.size()));
+                if (inserted.second) {
+                    QVector3D normal = key.vn != ObjVertexKey::kNone ? normals[key.vn] : QVector3D(0, 0, 1);
+                    vertices.emplace_back(positions[key.v], normal);
+                    if (key.vt != ObjVertexKey::kNone) {
+                        if (!anyTexCoord) {
+                            // 首次出现纹理坐标：为之前的顶点补齐
+                            vertexTexCoords.assign(vertices.size() - 1, QVector2D(0, 0));
+                            anyTexCoord = true;
+                        }
+                        vertexTexCoords.push_back(texCoords[key.vt]);
+                    } else if (anyTexCoord) {
+                        vertexTexCoords.emplace_back(0.0f, 0.0f);
+                    }
+                }
+                const unsigned int index = *inserted.first;
+                
+                if (corner == 0) {
+                    first = index;
+                } else if (corner >= 2) {
+                    triangles.push_back(first);
+                    triangles.push_back(previous);
+                    triangles.push_back(index);
+                }
+                previous = index;
             }
         }
     }
     
+    if (mapped) file.unmap(mapped);
     file.close();
+    
+    auto mesh = std::make_shared<Mesh>(QFileInfo(filePath).baseName());
+    if (triangles.empty() && vertices.empty()) {
+        // 没有面片时保留所有顶点位置（纯顶点 OBJ）
+        vertices.reserve(positions.size());
+        for (const auto& position : positions) vertices.emplace_back(position);
+    }
+    mesh->setGeometry(std::move(vertices), std::move(triangles), std::move(vertexTexCoords));
     return mesh;
 }
 
@@ -246,97 +1106,714 @@ std::shared_ptr<Model> FileImporter::importXYZ(const QString& filePath) {
     return pointCloud;
 }
 
-bool FileImporter::exportPLY(std::shared_ptr<Model> model, const QString& filePath) {
+std::shared_ptr<Model> FileImporter::importSTL(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "无法打开文件: " << filePath;
+        return nullptr;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    
+    QByteArray buffer;
+    const qint64 fileSize = file.size();
+    uchar* mapped = fileSize > 0 ? file.map(0, fileSize) : nullptr;
+    if (!mapped) buffer = file.readAll();
+    const char* const data = mapped ? reinterpret_cast<const char*>(mapped) : buffer.constData();
+    const size_t size = mapped ? static_cast<size_t>(fileSize) : static_cast<size_t>(buffer.size());
+    
+    // 二进制：文件长度与头部给出的三角形数吻合（部分二进制文件头也以 "solid" 开头，因此先按长度判断）
+    uint32_t declared = 0;
+    if (size >= kStlHeaderBytes) {
+        std::memcpy(&declared, data + 80, sizeof(declared));
+        declared = qFromLittleEndian(declared);
+    }
+    const bool startsWithSolid = size >= 5 && std::memcmp(data, "solid", 5) == 0;
+    const bool binary = size >= kStlHeaderBytes &&
+                        (size - kStlHeaderBytes) / kStlRecordBytes >= declared &&
+                        (!startsWithSolid || size == kStlHeaderBytes + size_t(declared) * kStlRecordBytes);
+    
+    // 每个角点先作为独立顶点读入（三角形汤），随后焊接
+    std::vector<Vertex> vertices;
+    if (binary) {
+        // 定长 50 字节记录，按三角形并行解码（跳过文件中的面法线，由几何重新计算）
+        vertices.resize(size_t(declared) * 3);
+        const char* records = data + kStlHeaderBytes;
+        Parallel::forEach(0, declared, [&](size_t t) {
+            float values[9];
+            std::memcpy(values, records + t * kStlRecordBytes + 12, sizeof(values));
+            for (int k = 0; k < 3; ++k) {
+                vertices[t * 3 + k].position = QVector3D(qFromLittleEndian(values[k * 3]), qFromLittleEndian(values[k * 3 + 1]),
+                                                         qFromLittleEndian(values[k * 3 + 2]));
+            }
+        });
+    } else if (startsWithSolid) {
+        // ASCII：文件按字节均分为若干段，段界推到下一行行首，各段并行解析 "vertex x y z" 行；
+        // 各段角点按文件顺序拼接（每 3 个为一个面），结果与分段位置无关
+        const char* const end = data + size;
+        const size_t chunks = Parallel::chunkCount(size, size_t(1) << 20);
+        std::vector<const char*> bounds(chunks + 1, end);
+        bounds[0] = data;
+        for (size_t c = 1; c < chunks; ++c) bounds[c] = std::max(bounds[c - 1], nextLine(data + size / chunks * c, end));
+        std::vector<std::vector<QVector3D>> parts(chunks);
+        std::atomic<bool> malformed(false);
+        Parallel::forChunks(chunks, chunks, [&](size_t c, size_t, size_t) {
+            std::vector<QVector3D>& part = parts[c];
+            part.reserve(static_cast<size_t>(bounds[c + 1] - bounds[c]) / 80);
+            for (const char* p = bounds[c]; p < bounds[c + 1]; p = nextLine(p, end)) {
+                const char* q = skipSpaces(p, end);
+                if (end - q < 7 || std::memcmp(q, "vertex", 6) != 0 || (q[6] != ' ' && q[6] != '\t')) continue;
+                q += 6;
+                float x, y, z;
+                if (!parseFloat(q, end, x) || !parseFloat(q, end, y) || !parseFloat(q, end, z)) {
+                    malformed = true;
+                    return;
+                }
+                part.emplace_back(x, y, z);
+            }
+        });
+        if (malformed) {
+            qDebug() << "STL 顶点格式错误: " << filePath;
+            return nullptr;
+        }
+        std::vector<size_t> offsets(chunks + 1, 0);
+        for (size_t c = 0; c < chunks; ++c) offsets[c + 1] = offsets[c] + parts[c].size();
+        vertices.resize(offsets[chunks] / 3 * 3);
+        Parallel::forChunks(chunks, chunks, [&](size_t c, size_t, size_t) {
+            const size_t count = std::min(parts[c].size(), vertices.size() - std::min(vertices.size(), offsets[c]));
+            for (size_t i = 0; i < count; ++i) vertices[offsets[c] + i].position = parts[c][i];
+            std::vector<QVector3D>().swap(parts[c]);
+        });
+    } else {
+        qDebug() << "不是有效的STL文件: " << filePath;
+        return nullptr;
+    }
+    if (vertices.empty() || vertices.size() / 3 > 0xffffffffu / 3) {
+        qDebug() << "STL 文件不含三角形或过大: " << filePath;
+        return nullptr;
+    }
+    const size_t cornerCount = vertices.size();
+    std::vector<unsigned int> triangles(cornerCount);
+    Parallel::forEach(0, cornerCount, [&](size_t i) { triangles[i] = static_cast<unsigned int>(i); });
+    const qint64 parseMs = timer.elapsed();
+    
+    // 角点按坐标完全相同焊接为共享顶点（丢弃重复索引的退化面），再按面积加权重算顶点法线
+    auto mesh = std::make_shared<Mesh>(QFileInfo(filePath).baseName());
+    mesh->setGeometry(std::move(vertices), std::move(triangles));
+    mesh->weldVertices(0.0f);
+    mesh->computeVertexNormals();
+    qDebug() << "STL 导入:" << cornerCount / 3 << "个三角形," << cornerCount << "个角点焊接为"
+             << mesh->getVertexCount() << "个顶点, 解析" << parseMs << "ms, 共" << timer.elapsed() << "ms";
+    return mesh;
+}
+
+std::shared_ptr<Model> FileImporter::importLAS(const QString& filePath, size_t stride) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "无法打开文件: " << filePath;
+        return nullptr;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    
+    LasHeader header;
+    if (!readLasHeader(file, header)) return nullptr;
+    stride = std::max<size_t>(1, stride);
+    const size_t samples = static_cast<size_t>((header.pointCount + stride - 1) / stride);
+    if (samples == 0) {
+        qDebug() << "LAS 文件不含点: " << filePath;
+        return nullptr;
+    }
+    
+    // 按窗口映射（可按步长抽样），窗口内按记录并行解码；强度与分类保存为属性通道
+    std::vector<Vertex> vertices(samples);
+    AttributeChannel intensity("intensity", AttributeChannel::UInt16, samples);
+    AttributeChannel classification("classification", AttributeChannel::UInt8, samples);
+    uint16_t* intensities = intensity.values<uint16_t>();
+    uint8_t* classes = classification.values<uint8_t>();
+    const bool ok = forEachLasWindow(file, header, stride, lasWindowSamples(header, stride, size_t(1) << 20),
+        [&](size_t first, size_t count, const char* records, size_t step) {
+            Parallel::forEach(0, count, [&](size_t i) {
+                const char* record = records + i * step;
+                vertices[first + i] = decodeLasPoint(record, header);
+                intensities[first + i] = readLittleEndian<uint16_t>(record + 12);
+                classes[first + i] = lasClassification(record, header);
+            });
+            return true;
+        });
+    if (!ok) {
+        qDebug() << "LAS 数据读取失败: " << filePath;
+        return nullptr;
+    }
+    qDebug() << "LAS 导入: 版本" << header.versionMajor << "." << header.versionMinor << ", 点格式" << header.pointFormat
+             << "," << samples << "个点（共" << header.pointCount << "个, 步长" << stride << "）, 耗时"
+             << timer.elapsed() << "ms";
+    
+    auto pointCloud = std::make_shared<PointCloud>(QFileInfo(filePath).baseName());
+    pointCloud->setPoints(std::move(vertices));
+    pointCloud->addAttribute(std::move(intensity));
+    pointCloud->addAttribute(std::move(classification));
+    pointCloud->setActiveAttribute("classification");
+    return pointCloud;
+}
+
+std::shared_ptr<Model> FileImporter::importCompressed(const QString& filePath) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> triangles;
+    ModelCompressor::Stats stats;
+    if (!ModelCompressor::read(filePath, vertices, triangles, &stats)) return nullptr;
+    qDebug() << "压缩导入:" << stats.vertexCount << "个顶点," << stats.triangleCount << "个三角形, 压缩比"
+             << stats.ratio() << ", 耗时" << stats.elapsedMs << "ms," << stats.throughput() << "MB/s";
+    
+    const QString baseName = QFileInfo(filePath).baseName();
+    if (!triangles.empty()) {
+        auto mesh = std::make_shared<Mesh>(baseName);
+        mesh->setGeometry(std::move(vertices), std::move(triangles));
+        return mesh;
+    }
+    auto pointCloud = std::make_shared<PointCloud>(baseName);
+    pointCloud->setPoints(std::move(vertices));
+    return pointCloud;
+}
+
+std::shared_ptr<Model> FileImporter::importPointCloudPaged(const QString& filePath, FileFormat format,
+                                                          const ImportOptions& options) {
     QFile file(filePath);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "无法打开文件: " << filePath;
+        return nullptr;
+    }
+    const qint64 fileSize = file.size();
+    
+    // 先解析 PLY 头部（只读文件开头），确定顶点记录的位置与布局
+    PlyHeader header;
+    qint64 bodyOffset = 0;
+    const PlyElement* vertexElement = nullptr;
+    qint64 vertexOffset = 0;
+    if (format == PLY) {
+        const QByteArray head = file.read(std::min<qint64>(fileSize, 1 << 20));
+        const char* body = nullptr;
+        if (!parsePlyHeader(head.constData(), head.constData() + head.size(), header, body)) {
+            qDebug() << "不是有效的PLY文件";
+            return nullptr;
+        }
+        bodyOffset = body - head.constData();
+        // 只处理无面片的点云；顶点之前只允许定长二进制元素（可直接跳过）
+        vertexOffset = bodyOffset;
+        for (const auto& element : header.elements) {
+            if (element.name == "face" && element.count > 0) return nullptr;
+            if (element.name == "vertex") {
+                if (!vertexElement) vertexElement = &element;
+                continue;
+            }
+            if (vertexElement || element.count == 0) continue;
+            const size_t stride = header.format != PlyFormat::Ascii ? element.fixedStride() : 0;
+            if (stride == 0) return nullptr;
+            vertexOffset += static_cast<qint64>(element.count * stride);
+        }
+        if (!vertexElement || vertexElement->count == 0) return nullptr;
+    }
+    LasHeader lasHeader;
+    if (format == LAS && (!readLasHeader(file, lasHeader) || lasHeader.pointCount == 0)) return nullptr;
+    
+    static std::atomic<int> sequence(0);
+    const QString baseName = QFileInfo(filePath).baseName();
+    const QDir cacheDir(options.outOfCoreCacheDir.isEmpty() ? QDir::tempPath() : options.outOfCoreCacheDir);
+    const QString storePath = cacheDir.filePath(QString("%1_%2_%3.vpage").arg(baseName)
+                                                .arg(QDateTime::currentMSecsSinceEpoch()).arg(sequence++));
+    auto store = PagedVertexStore::create(storePath);
+    if (!store) return nullptr;
+    store->setRemoveOnClose(true);
+    const size_t batchPoints = store->chunkPoints();
+    std::vector<PagedVertexStore::Record> batch;
+    batch.reserve(batchPoints);
+    auto flushBatch = [&]() {
+        const bool ok = store->append(batch.data(), batch.size());
+        batch.clear();
+        return ok;
+    };
+    
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = true;
+    if (format == PLY) {
+        const auto& properties = vertexElement->properties;
+        std::vector<PlyTarget> targets(properties.size());
+        int axisMask = 0;
+        bool hasColor = false;
+        bool droppedChannels = false;
+        for (size_t k = 0; k < properties.size(); ++k) {
+            targets[k] = plyVertexTarget(properties[k]);
+            if (targets[k] == PlyTarget::X) axisMask |= 1;
+            if (targets[k] == PlyTarget::Y) axisMask |= 2;
+            if (targets[k] == PlyTarget::Z) axisMask |= 4;
+            if (targets[k] == PlyTarget::Red || targets[k] == PlyTarget::Green || targets[k] == PlyTarget::Blue) hasColor = true;
+            if (targets[k] == PlyTarget::Channel) droppedChannels = true;
+        }
+        if (axisMask != 7) {
+            qDebug() << "PLY 顶点缺少 x/y/z 属性";
+            return nullptr;
+        }
+        if (droppedChannels) qDebug() << "外存导入只保存坐标、法线与颜色，其余顶点属性被忽略";
+        
+        const size_t vertexCount = vertexElement->count;
+        const bool binary = header.format != PlyFormat::Ascii;
+        const bool swapBytes = binary && (header.format == PlyFormat::BinaryBigEndian) == hostIsLittleEndian();
+        const size_t stride = binary ? vertexElement->fixedStride() : 0;
+        if (stride > 0) {
+            // 定长二进制：按批映射文件窗口，批内并行解码，写入后立即解除映射
+            if (static_cast<size_t>(fileSize - vertexOffset) / stride < vertexCount) {
+                qDebug() << "PLY 数据不完整: " << filePath;
+                return nullptr;
+            }
+            std::vector<size_t> offsets(properties.size());
+            for (size_t k = 0, offset = 0; k < properties.size(); ++k) {
+                offsets[k] = offset;
+                offset += AttributeChannel::typeSize(properties[k].type);
+            }
+            for (size_t done = 0; ok && done < vertexCount; done += batchPoints) {
+                const size_t count = std::min(batchPoints, vertexCount - done);
+                uchar* window = file.map(vertexOffset + static_cast<qint64>(done * stride),
+                                         static_cast<qint64>(count * stride));
+                if (!window) {
+                    qDebug() << "无法映射文件: " << filePath;
+                    ok = false;
+                    break;
+                }
+                const char* records = reinterpret_cast<const char*>(window);
+                batch.resize(count);
+                Parallel::forEach(0, count, [&](size_t i) {
+                    const char* record = records + i * stride;
+                    Vertex vertex;
+                    int rgb[3] = { 255, 255, 255 };
+                    for (size_t k = 0; k < properties.size(); ++k) {
+                        const AttributeChannel::Type type = properties[k].type;
+                        applyPlyValue(vertex, targets[k], type, readPlyBinary(record + offsets[k], type, swapBytes), rgb);
+                    }
+                    if (hasColor) vertex.color = QColor(rgb[0], rgb[1], rgb[2]);
+                    batch[i] = PagedVertexStore::toRecord(vertex);
+                });
+                file.unmap(window);
+                ok = flushBatch();
+            }
+        } else {
+            // ASCII 或含列表属性：映射整个文件（由操作系统按需换页）逐条解析，凑满一批写入一次
+            uchar* mapped = file.map(0, fileSize);
+            if (!mapped) {
+                qDebug() << "无法映射文件: " << filePath;
+                return nullptr;
+            }
+            const char* data = reinterpret_cast<const char*>(mapped);
+            const size_t lastProperty = properties.size() - 1;
+            Vertex vertex;
+            int rgb[3] = { 255, 255, 255 };
+            auto finishVertex = [&]() {
+                if (hasColor) vertex.color = QColor(rgb[0], rgb[1], rgb[2]);
+                batch.push_back(PagedVertexStore::toRecord(vertex));
+                vertex = Vertex();
+                if (batch.size() == batchPoints) ok = flushBatch() && ok;
+            };
+            const char* p = readPlyRecords(data + vertexOffset, data + fileSize, *vertexElement, header.format,
+                [&](size_t, size_t k, double value) {
+                    applyPlyValue(vertex, targets[k], properties[k].type, value, rgb);
+                    if (k == lastProperty) finishVertex();
+                },
+                [&](size_t, size_t k, const std::vector<double>&) {
+                    if (k == lastProperty) finishVertex();
+                });
+            file.unmap(mapped);
+            if (!p) {
+                qDebug() << "PLY 数据不完整: " << filePath;
+                return nullptr;
+            }
+            ok = ok && flushBatch();
+        }
+    } else if (format == LAS) {
+        // LAS：按窗口映射定长记录（可按步长抽样），窗口内并行解码后写入一批
+        qDebug() << "外存导入只保存坐标与颜色，LAS 强度与分类被忽略";
+        const size_t stride = std::max<size_t>(1, options.lasStride);
+        ok = forEachLasWindow(file, lasHeader, stride, lasWindowSamples(lasHeader, stride, batchPoints),
+            [&](size_t, size_t count, const char* records, size_t step) {
+                batch.resize(count);
+                Parallel::forEach(0, count, [&](size_t i) {
+                    batch[i] = PagedVertexStore::toRecord(decodeLasPoint(records + i * step, lasHeader));
+                });
+                return flushBatch();
+            });
+        if (!ok) qDebug() << "LAS 数据读取失败: " << filePath;
+    } else {
+        // XYZ：映射整个文件逐行解析（每行前三个数为坐标）
+        uchar* mapped = fileSize > 0 ? file.map(0, fileSize) : nullptr;
+        if (!mapped) {
+            qDebug() << "无法映射文件: " << filePath;
+            return nullptr;
+        }
+        const char* p = reinterpret_cast<const char*>(mapped);
+        const char* const end = p + fileSize;
+        for (; ok && p < end; p = nextLine(p, end)) {
+            const char* lineEnd = findLineEnd(p, end);
+            const char* q = skipSpaces(p, lineEnd);
+            if (q >= lineEnd || *q == '#') continue;
+            float xyz[3];
+            if (!parseFloat(q, lineEnd, xyz[0]) || !parseFloat(q, lineEnd, xyz[1]) || !parseFloat(q, lineEnd, xyz[2])) continue;
+            batch.push_back(PagedVertexStore::toRecord(Vertex(QVector3D(xyz[0], xyz[1], xyz[2]))));
+            if (batch.size() == batchPoints) ok = flushBatch();
+        }
+        file.unmap(mapped);
+        ok = ok && flushBatch();
+    }
+    if (!ok || !store->finish()) return nullptr;
+    
+    auto pointCloud = std::make_shared<PointCloud>(baseName);
+    pointCloud->attachPagedStore(store, options.previewPoints);
+    qDebug() << "外存导入:" << store->size() << "个点," << store->chunkCount() << "块, 预览"
+             << pointCloud->getPointCount() << "个点, 耗时" << timer.elapsed() << "ms";
+    return pointCloud;
+}
+
+bool FileImporter::exportPLY(std::shared_ptr<Model> model, const QString& filePath, bool binary) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
         qDebug() << "无法创建文件: " << filePath;
         return false;
     }
+    QElapsedTimer timer;
+    timer.start();
     
-    QTextStream out(&file);
+    // 外存 / 紧凑点云没有面
+    auto mesh = std::dynamic_pointer_cast<Mesh>(model);
+    const std::vector<unsigned int> noTriangles;
+    const auto& triangles = mesh ? mesh->getTriangles() : noTriangles;
+    const size_t vertexCount = exportVertexCount(model);
+    const size_t faceCount = triangles.size() / 3;
     
-    // 写入PLY头部
-    out << "ply\n";
-    out << "format ascii 1.0\n";
-    out << "element vertex " << model->getVertexCount() << "\n";
-    out << "property float x\n";
-    out << "property float y\n";
-    out << "property float z\n";
-    out << "property uchar red\n";
-    out << "property uchar green\n";
-    out << "property uchar blue\n";
-    out << "end_header\n";
+    // 法线：Mesh 与外存点云总是写出；紧凑点云不保存法线；内存点云只在存在非默认法线时写出
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(model);
+    bool withNormals = !cloud || cloud->isPaged();
+    if (cloud && !cloud->isPaged() && !cloud->isCompact()) {
+        const auto& vertices = cloud->getVertices();
+        std::atomic<bool> found(false);
+        Parallel::forRange(0, vertices.size(), [&](size_t b, size_t e) {
+            for (size_t i = b; i < e && !found; ++i) {
+                if (vertices[i].normal != QVector3D(0, 0, 1)) found = true;
+            }
+        });
+        withNormals = found;
+    }
     
-    // 写入顶点数据
-    const auto& vertices = model->getVertices();
-    for (const auto& vertex : vertices) {
-        out << vertex.position.x() << " " 
-            << vertex.position.y() << " " 
-            << vertex.position.z() << " "
-            << vertex.color.red() << " "
-            << vertex.color.green() << " "
-            << vertex.color.blue() << "\n";
+    // 属性通道按原类型写在颜色之后（外存 / 紧凑点云没有通道）；名称中的空白换成下划线，
+    // 与坐标、法线、颜色重名的通道不写出，否则读回时会被当作几何字段
+    std::vector<const AttributeChannel*> channels;
+    std::vector<std::string> channelNames;
+    for (const AttributeChannel& channel : model->getAttributes()) {
+        if (channel.size() != vertexCount) continue;
+        std::string name = channel.name().toStdString();
+        for (char& c : name) {
+            if (std::isspace(static_cast<unsigned char>(c))) c = '_';
+        }
+        PlyProperty property;
+        property.name = name;
+        if (name.empty() || plyVertexTarget(property) != PlyTarget::Channel) continue;
+        channels.push_back(&channel);
+        channelNames.push_back(name);
+    }
+    
+    std::string header = "ply\n";
+    header += binary ? "format binary_little_endian 1.0\n" : "format ascii 1.0\n";
+    header += "element vertex " + std::to_string(vertexCount) + "\n";
+    header += "property float x\nproperty float y\nproperty float z\n";
+    if (withNormals) header += "property float nx\nproperty float ny\nproperty float nz\n";
+    header += "property uchar red\nproperty uchar green\nproperty uchar blue\n";
+    size_t channelBytes = 0;
+    for (size_t c = 0; c < channels.size(); ++c) {
+        header += std::string("property ") + plyTypeName(channels[c]->type()) + " " + channelNames[c] + "\n";
+        channelBytes += binary ? AttributeChannel::typeSize(channels[c]->type()) : 25;
+    }
+    if (faceCount > 0) {
+        header += "element face " + std::to_string(faceCount) + "\n";
+        header += "property list uchar int vertex_indices\n";
     }
+    header += "end_header\n";
+    bool ok = file.write(header.data(), qint64(header.size())) == qint64(header.size());
+    
+    // 顶点：二进制为 3 个 float（+ 3 个法线 float）+ 3 个 uchar + 各通道值，
+    // ASCII 为 "x y z [nx ny nz] r g b [通道值...]"
+    const size_t maxVertexBytes = (binary ? 15 + (withNormals ? 12 : 0) : 64 + (withNormals ? 48 : 0)) + channelBytes;
+    size_t batchStart = 0;
+    ok = ok && forEachExportBatch(model, [&](const Vertex* vertices, size_t count) {
+        const bool written = writeItems(file, count, maxVertexBytes, [&](size_t i, char* p) {
+            const Vertex& vertex = vertices[i];
+            if (binary) {
+                p = writeLittleEndian(p, vertex.position.x());
+                p = writeLittleEndian(p, vertex.position.y());
+                p = writeLittleEndian(p, vertex.position.z());
+                if (withNormals) {
+                    p = writeLittleEndian(p, vertex.normal.x());
+                    p = writeLittleEndian(p, vertex.normal.y());
+                    p = writeLittleEndian(p, vertex.normal.z());
+                }
+                *p++ = static_cast<char>(vertex.color.red());
+                *p++ = static_cast<char>(vertex.color.green());
+                *p++ = static_cast<char>(vertex.color.blue());
+                for (const AttributeChannel* channel : channels) p = writeChannelValue(p, *channel, batchStart + i, true);
+                return p;
+            }
+            p = writeFloat(p, vertex.position.x());
+            *p++ = ' ';
+            p = writeFloat(p, vertex.position.y());
+            *p++ = ' ';
+            p = writeFloat(p, vertex.position.z());
+            *p++ = ' ';
+            if (withNormals) {
+                p = writeFloat(p, vertex.normal.x());
+                *p++ = ' ';
+                p = writeFloat(p, vertex.normal.y());
+                *p++ = ' ';
+                p = writeFloat(p, vertex.normal.z());
+                *p++ = ' ';
+            }
+            p = writeUInt(p, vertex.color.red());
+            *p++ = ' ';
+            p = writeUInt(p, vertex.color.green());
+            *p++ = ' ';
+            p = writeUInt(p, vertex.color.blue());
+            for (const AttributeChannel* channel : channels) {
+                *p++ = ' ';
+                p = writeChannelValue(p, *channel, batchStart + i, false);
+            }
+            *p++ = '\n';
+            return p;
+        });
+        batchStart += count;
+        return written;
+    });
+    
+    // 面：三角形，二进制为 uchar 3 + 3 个 int
+    ok = ok && writeItems(file, faceCount, binary ? 13 : 40, [&](size_t t, char* p) {
+        const unsigned int* corners = &triangles[t * 3];
+        if (binary) {
+            *p++ = 3;
+            for (int k = 0; k < 3; ++k) p = writeLittleEndian(p, static_cast<int32_t>(corners[k]));
+            return p;
+        }
+        *p++ = '3';
+        for (int k = 0; k < 3; ++k) {
+            *p++ = ' ';
+            p = writeUInt(p, corners[k]);
+        }
+        *p++ = '\n';
+        return p;
+    });
     
     file.close();
-    return true;
+    qDebug() << "PLY 导出:" << vertexCount << "个顶点," << faceCount << "个面," << (binary ? "二进制" : "ASCII")
+             << ", 耗时" << timer.elapsed() << "ms";
+    return ok;
 }
 
 bool FileImporter::exportOBJ(std::shared_ptr<Model> model, const QString& filePath) {
     QFile file(filePath);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
         qDebug() << "无法创建文件: " << filePath;
         return false;
     }
+    QElapsedTimer timer;
+    timer.start();
     
-    QTextStream out(&file);
+    // "prefix a b c"：v 与 vn 共用
+    auto writeVector = [](char* p, const char* prefix, const QVector3D& value) {
+        while (*prefix) *p++ = *prefix++;
+        p = writeFloat(p, value.x());
+        *p++ = ' ';
+        p = writeFloat(p, value.y());
+        *p++ = ' ';
+        p = writeFloat(p, value.z());
+        *p++ = '\n';
+        return p;
+    };
     
     // 写入顶点
-    const auto& vertices = model->getVertices();
-    for (const auto& vertex : vertices) {
-        out << "v " << vertex.position.x() << " " 
-            << vertex.position.y() << " " 
-            << vertex.position.z() << "\n";
-    }
+    bool ok = forEachExportBatch(model, [&](const Vertex* vertices, size_t count) {
+        return writeItems(file, count, 56, [&](size_t i, char* p) {
+            return writeVector(p, "v ", vertices[i].position);
+        });
+    });
     
     // 写入法线
-    for (const auto& vertex : vertices) {
-        out << "vn " << vertex.normal.x() << " " 
-            << vertex.normal.y() << " " 
-            << vertex.normal.z() << "\n";
+    ok = ok && forEachExportBatch(model, [&](const Vertex* vertices, size_t count) {
+        return writeItems(file, count, 56, [&](size_t i, char* p) {
+            return writeVector(p, "vn ", vertices[i].normal);
+        });
+    });
+    
+    // 写入纹理坐标（仅 Mesh 且存在时）
+    auto mesh = std::dynamic_pointer_cast<Mesh>(model);
+    const bool hasTexCoords = mesh && mesh->hasTexCoords();
+    if (hasTexCoords) {
+        const auto& texCoords = mesh->getTexCoords();
+        ok = ok && writeItems(file, texCoords.size(), 40, [&](size_t i, char* p) {
+            *p++ = 'v';
+            *p++ = 't';
+            *p++ = ' ';
+            p = writeFloat(p, texCoords[i].x());
+            *p++ = ' ';
+            p = writeFloat(p, texCoords[i].y());
+            *p++ = '\n';
+            return p;
+        });
     }
     
-    // 写入面片
+    // 写入面片（顶点、纹理坐标、法线索引一一对应）
     const auto& triangles = model->getTriangles();
-    for (size_t i = 0; i < triangles.size(); i += 3) {
-        if (i + 2 < triangles.size()) {
-            out << "f " << (triangles[i] + 1) << " " 
-                << (triangles[i + 1] + 1) << " " 
-                << (triangles[i + 2] + 1) << "\n";
+    ok = ok && writeItems(file, triangles.size() / 3, 112, [&](size_t t, char* p) {
+        *p++ = 'f';
+        for (int k = 0; k < 3; ++k) {
+            const uint64_t n = uint64_t(triangles[t * 3 + k]) + 1;
+            *p++ = ' ';
+            p = writeUInt(p, n);
+            *p++ = '/';
+            if (hasTexCoords) p = writeUInt(p, n);
+            *p++ = '/';
+            p = writeUInt(p, n);
         }
-    }
+        *p++ = '\n';
+        return p;
+    });
     
     file.close();
-    return true;
+    qDebug() << "OBJ 导出:" << exportVertexCount(model) << "个顶点," << triangles.size() / 3 << "个面, 耗时"
+             << timer.elapsed() << "ms";
+    return ok;
 }
 
 bool FileImporter::exportXYZ(std::shared_ptr<Model> model, const QString& filePath) {
     QFile file(filePath);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
         qDebug() << "无法创建文件: " << filePath;
         return false;
     }
-    
-    QTextStream out(&file);
+    QElapsedTimer timer;
+    timer.start();
     
     // 写入顶点坐标（XYZ格式只包含坐标）
-    const auto& vertices = model->getVertices();
-    for (const auto& vertex : vertices) {
-        out << vertex.position.x() << " " 
-            << vertex.position.y() << " " 
-            << vertex.position.z() << "\n";
-    }
+    const bool ok = forEachExportBatch(model, [&](const Vertex* vertices, size_t count) {
+        return writeItems(file, count, 48, [&](size_t i, char* p) {
+            const QVector3D& position = vertices[i].position;
+            p = writeFloat(p, position.x());
+            *p++ = ' ';
+            p = writeFloat(p, position.y());
+            *p++ = ' ';
+            p = writeFloat(p, position.z());
+            *p++ = '\n';
+            return p;
+        });
+    });
     
     file.close();
+    qDebug() << "XYZ 导出:" << exportVertexCount(model) << "个点, 耗时" << timer.elapsed() << "ms";
+    return ok;
+}
+
+bool FileImporter::exportCompressed(std::shared_ptr<Model> model, const QString& filePath, const ExportOptions& options) {
+    // 压缩按全局 Morton 序重排顶点，需要全部顶点同时在内存中；外存 / 紧凑点云正是为了避免展开而存在，不支持
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(model);
+    if (cloud && (cloud->isPaged() || cloud->isCompact())) {
+        qDebug() << "外存/紧凑点云不能导出为压缩存档（需要把全部点展开到内存），请导出为 PLY 或先恢复为浮点存储";
+        return false;
+    }
+    // 压缩器只按排列下标读取，直接传入模型的顶点与三角形，不做拷贝
+    static const std::vector<unsigned int> kNoTriangles;
+    const bool mesh = std::dynamic_pointer_cast<Mesh>(model) != nullptr;
+    
+    ModelCompressor::Options compressorOptions;
+    compressorOptions.positionBits = options.compressedPositionBits;
+    ModelCompressor::Stats stats;
+    if (!ModelCompressor::write(filePath, model->getVertices(), mesh ? model->getTriangles() : kNoTriangles,
+                                compressorOptions, &stats)) {
+        return false;
+    }
+    qDebug() << "压缩导出:" << stats.vertexCount << "个顶点," << stats.triangleCount << "个三角形,"
+             << stats.rawBytes << "->" << stats.compressedBytes << "字节, 压缩比" << stats.ratio()
+             << ", 耗时" << stats.elapsedMs << "ms," << stats.throughput() << "MB/s";
     return true;
-}
\ No newline at end of file
+}
+
+bool FileImporter::exportSTL(std::shared_ptr<Model> model, const QString& filePath) {
+    auto mesh = std::dynamic_pointer_cast<Mesh>(model);
+    if (!mesh || mesh->getTriangleCount() == 0) {
+        qDebug() << "STL 只能导出含三角形的网格";
+        return false;
+    }
+    
+    // 含越界索引的三角形不导出（与其他导出器和分析一致）；存在时先收集保留的三角形编号
+    const auto& vertices = mesh->getVertices();
+    const auto& triangles = mesh->getTriangles();
+    const size_t n = vertices.size();
+    auto inRange = [&](size_t t) {
+        return triangles[t * 3] < n && triangles[t * 3 + 1] < n && triangles[t * 3 + 2] < n;
+    };
+    const size_t totalTriangles = triangles.size() / 3;
+    const size_t chunks = Parallel::chunkCount(totalTriangles);
+    std::vector<size_t> chunkValid(chunks + 1, 0);
+    Parallel::forChunks(totalTriangles, chunks, [&](size_t c, size_t b, size_t e) {
+        size_t count = 0;
+        for (size_t t = b; t < e; ++t) count += inRange(t);
+        chunkValid[c + 1] = count;
+    });
+    for (size_t c = 0; c < chunks; ++c) chunkValid[c + 1] += chunkValid[c];
+    const size_t triangleCount = chunkValid[chunks];
+    std::vector<uint32_t> faces;
+    if (triangleCount < totalTriangles) {
+        faces.resize(triangleCount);
+        Parallel::forChunks(totalTriangles, chunks, [&](size_t c, size_t b, size_t e) {
+            size_t dst = chunkValid[c];
+            for (size_t t = b; t < e; ++t) {
+                if (inRange(t)) faces[dst++] = static_cast<uint32_t>(t);
+            }
+        });
+        qDebug() << "STL 导出跳过" << totalTriangles - triangleCount << "个含越界索引的三角形";
+    }
+    if (triangleCount == 0) {
+        qDebug() << "STL 只能导出含三角形的网格";
+        return false;
+    }
+    
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "无法创建文件: " << filePath;
+        return false;
+    }
+    char header[kStlHeaderBytes] = {};
+    const char title[] = "binary STL exported by 3DDataVisualization";
+    std::memcpy(header, title, sizeof(title) - 1);
+    const uint32_t count = qToLittleEndian(static_cast<uint32_t>(triangleCount));
+    std::memcpy(header + 80, &count, sizeof(count));
+    bool ok = file.write(header, kStlHeaderBytes) == qint64(kStlHeaderBytes);
+    
+    // 按批并行填充记录（面法线由三角形即时计算）后顺序写出
+    const size_t batch = size_t(1) << 20;
+    std::vector<char> records(std::min(batch, triangleCount) * kStlRecordBytes);
+    for (size_t begin = 0; ok && begin < triangleCount; begin += batch) {
+        const size_t end = std::min(triangleCount, begin + batch);
+        Parallel::forEach(begin, end, [&](size_t t) {
+            const unsigned int* tri = &triangles[(faces.empty() ? t : faces[t]) * size_t(3)];
+            const QVector3D& a = vertices[tri[0]].position;
+            const QVector3D& b = vertices[tri[1]].position;
+            const QVector3D& c = vertices[tri[2]].position;
+            const QVector3D normal = QVector3D::crossProduct(b - a, c - a).normalized();
+            const float values[12] = {normal.x(), normal.y(), normal.z(), a.x(), a.y(), a.z(),
+                                      b.x(), b.y(), b.z(), c.x(), c.y(), c.z()};
+            char* record = records.data() + (t - begin) * kStlRecordBytes;
+            for (int k = 0; k < 12; ++k) {
+                const float value = qToLittleEndian(values[k]);
+                std::memcpy(record + k * sizeof(float), &value, sizeof(float));
+            }
+            record[48] = 0;
+            record[49] = 0;
+        });
+        const qint64 bytes = qint64((end - begin) * kStlRecordBytes);
+        ok = file.write(records.data(), bytes) == bytes;
+    }
+    file.close();
+    return ok;
+}
@@ -0,0 +1,249 @@
+#include "ICPRegistration.h"
+#include "Model.h"
+#include "KdTree.h"
+#include "Parallel.h"
+#include "SymmetricEigen.h"
+#include <QElapsedTimer>
+#include <QDebug>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+constexpr size_t kNormalNeighbours = 12;
+
+// 刚体变换 p' = R p + t（double 精度累积，避免多次迭代的误差）
+struct RigidTransform {
+    double r[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    double t[3] = { 0, 0, 0 };
+
+    void apply(const QVector3D& p, double out[3]) const {
+        for (int i = 0; i < 3; ++i) {
+            out[i] = r[i][0] * p.x() + r[i][1] * p.y() + r[i][2] * p.z() + t[i];
+        }
+    }
+
+    // 左乘增量：this = delta * this
+    void premultiply(const double dr[3][3], const double dt[3]) {
+        double nr[3][3], nt[3];
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                nr[i][j] = dr[i][0] * r[0][j] + dr[i][1] * r[1][j] + dr[i][2] * r[2][j];
+            }
+            nt[i] = dr[i][0] * t[0] + dr[i][1] * t[1] + dr[i][2] * t[2] + dt[i];
+        }
+        std::copy(&nr[0][0], &nr[0][0] + 9, &r[0][0]);
+        std::copy(nt, nt + 3, t);
+    }
+
+    QMatrix4x4 toMatrix() const {
+        return QMatrix4x4(float(r[0][0]), float(r[0][1]), float(r[0][2]), float(t[0]),
+                          float(r[1][0]), float(r[1][1]), float(r[1][2]), float(t[1]),
+                          float(r[2][0]), float(r[2][1]), float(r[2][2]), float(t[2]),
+                          0.0f, 0.0f, 0.0f, 1.0f);
+    }
+};
+
+// 旋转向量 -> 旋转矩阵（Rodrigues）
+void rotationFromVector(const double w[3], double out[3][3]) {
+    const double angle = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+    if (angle < 1e-12) {
+        const double identity[3][3] = { { 1, -w[2], w[1] }, { w[2], 1, -w[0] }, { -w[1], w[0], 1 } };
+        std::copy(&identity[0][0], &identity[0][0] + 9, &out[0][0]);
+        return;
+    }
+    const double x = w[0] / angle, y = w[1] / angle, z = w[2] / angle;
+    const double c = std::cos(angle), s = std::sin(angle), C = 1.0 - c;
+    out[0][0] = c + x * x * C;     out[0][1] = x * y * C - z * s; out[0][2] = x * z * C + y * s;
+    out[1][0] = y * x * C + z * s; out[1][1] = c + y * y * C;     out[1][2] = y * z * C - x * s;
+    out[2][0] = z * x * C - y * s; out[2][1] = z * y * C + x * s; out[2][2] = c + z * z * C;
+}
+
+// 6x6 线性方程组（列主元高斯消元），奇异时返回 false
+bool solve6(double a[6][6], double b[6], double x[6]) {
+    for (int col = 0; col < 6; ++col) {
+        int pivot = col;
+        for (int row = col + 1; row < 6; ++row) {
+            if (std::fabs(a[row][col]) > std::fabs(a[pivot][col])) pivot = row;
+        }
+        if (std::fabs(a[pivot][col]) < 1e-18) return false;
+        if (pivot != col) {
+            std::swap_ranges(a[col], a[col] + 6, a[pivot]);
+            std::swap(b[col], b[pivot]);
+        }
+        for (int row = col + 1; row < 6; ++row) {
+            const double f = a[row][col] / a[col][col];
+            for (int k = col; k < 6; ++k) a[row][k] -= f * a[col][k];
+            b[row] -= f * b[col];
+        }
+    }
+    for (int row = 5; row >= 0; --row) {
+        double sum = b[row];
+        for (int k = row + 1; k < 6; ++k) sum -= a[row][k] * x[k];
+        x[row] = sum / a[row][row];
+    }
+    return true;
+}
+
+// 每块的法方程累加量
+struct Accumulator {
+    double ata[6][6] = {};
+    double atb[6] = {};
+    double residual2 = 0.0;   // 点到面残差平方和
+    double distance2 = 0.0;   // 点到点距离平方和（用于自适应剔除阈值）
+    size_t count = 0;
+};
+
+} // namespace
+
+ICPRegistration::Result ICPRegistration::align(const Model& source, const Model& target, const Options& options) {
+    Result result;
+    QElapsedTimer timer;
+    timer.start();
+
+    const auto& sourcePoints = source.getVertices();
+    const auto& targetPoints = target.getVertices();
+    if (sourcePoints.size() < 3 || targetPoints.size() < 3) {
+        qDebug() << "ICP: 点数不足";
+        return result;
+    }
+
+    // 1. 目标点等间隔采样，建 k-d 树并用 k 近邻 PCA 估计法线
+    std::vector<Vertex> targetSample;
+    const std::vector<Vertex>* targetSet = &targetPoints;
+    if (options.targetSampleCount > 0 && targetPoints.size() > options.targetSampleCount) {
+        const size_t stride = (targetPoints.size() + options.targetSampleCount - 1) / options.targetSampleCount;
+        targetSample.resize(targetPoints.size() / stride);
+        Parallel::forEach(0, targetSample.size(), [&](size_t i) {
+            targetSample[i] = targetPoints[i * stride];
+        });
+        targetSet = &targetSample;
+    }
+    KdTree tree;
+    tree.build(*targetSet);
+
+    std::vector<QVector3D> normals(targetSet->size());
+    Parallel::forRange(0, targetSet->size(), [&](size_t b, size_t e) {
+        std::vector<uint32_t> neighbours;
+        std::vector<float> distances;
+        for (size_t i = b; i < e; ++i) {
+            tree.kNearest((*targetSet)[i].position, kNormalNeighbours, neighbours, distances);
+            double mean[3] = { 0, 0, 0 };
+            for (uint32_t j : neighbours) {
+                const QVector3D& p = (*targetSet)[j].position;
+                mean[0] += p.x(); mean[1] += p.y(); mean[2] += p.z();
+            }
+            const double inv = 1.0 / std::max<size_t>(neighbours.size(), 1);
+            for (double& m : mean) m *= inv;
+            double cov[3][3] = {};
+            for (uint32_t j : neighbours) {
+                const QVector3D& p = (*targetSet)[j].position;
+                const double d[3] = { p.x() - mean[0], p.y() - mean[1], p.z() - mean[2] };
+                for (int r = 0; r < 3; ++r)
+                    for (int c = 0; c < 3; ++c) cov[r][c] += d[r] * d[c];
+            }
+            double values[3], vectors[3][3];
+            symmetricEigen3x3(cov, values, vectors);
+            normals[i] = QVector3D(float(vectors[0][0]), float(vectors[0][1]), float(vectors[0][2]));
+        }
+    }, 4096);
+
+    const AABB targetBox = target.computeAABB();
+    const float diagonal = std::max(targetBox.size().length(), 1e-6f);
+    float maxDistance = options.maxCorrespondenceDistance > 0.0f ? options.maxCorrespondenceDistance
+                                                                  : 0.1f * diagonal;
+    const float minDistance = diagonal * 1e-5f;
+
+    // 2. 由粗到细迭代
+    RigidTransform transform;
+    const int levels = std::max(1, options.levels);
+    for (int level = 0; level < levels; ++level) {
+        size_t sampleCount = options.finestSampleCount;
+        for (int k = level; k < levels - 1; ++k) sampleCount /= 4;
+        sampleCount = std::max<size_t>(sampleCount, 1000);
+        const size_t stride = std::max<size_t>(1, sourcePoints.size() / sampleCount);
+        const size_t count = sourcePoints.size() / stride;
+
+        bool levelConverged = false;
+        for (int iteration = 0; iteration < options.maxIterationsPerLevel; ++iteration) {
+            const float maxDistance2 = maxDistance * maxDistance;
+            const size_t chunks = Parallel::chunkCount(count, 2048);
+            std::vector<Accumulator> partials(chunks);
+            Parallel::forChunks(count, chunks, [&](size_t c, size_t b, size_t e) {
+                Accumulator& acc = partials[c];
+                for (size_t i = b; i < e; ++i) {
+                    double p[3];
+                    transform.apply(sourcePoints[i * stride].position, p);
+                    const QVector3D moved(static_cast<float>(p[0]), static_cast<float>(p[1]), static_cast<float>(p[2]));
+                    uint32_t index = 0;
+                    float d2 = maxDistance2;
+                    if (!tree.nearest(moved, index, d2)) continue;
+
+                    const QVector3D& q = (*targetSet)[index].position;
+                    const QVector3D& n = normals[index];
+                    const double nx = n.x(), ny = n.y(), nz = n.z();
+                    const double r = (p[0] - q.x()) * nx + (p[1] - q.y()) * ny + (p[2] - q.z()) * nz;
+                    // 雅可比 J = [p × n, n]
+                    const double j[6] = { p[1] * nz - p[2] * ny, p[2] * nx - p[0] * nz, p[0] * ny - p[1] * nx,
+                                          nx, ny, nz };
+                    for (int row = 0; row < 6; ++row) {
+                        for (int col = row; col < 6; ++col) acc.ata[row][col] += j[row] * j[col];
+                        acc.atb[row] -= j[row] * r;
+                    }
+                    acc.residual2 += r * r;
+                    acc.distance2 += d2;
+                    ++acc.count;
+                }
+            });
+
+            Accumulator total;
+            for (const Accumulator& acc : partials) {
+                for (int row = 0; row < 6; ++row) {
+                    for (int col = row; col < 6; ++col) total.ata[row][col] += acc.ata[row][col];
+                    total.atb[row] += acc.atb[row];
+                }
+                total.residual2 += acc.residual2;
+                total.distance2 += acc.distance2;
+                total.count += acc.count;
+            }
+            if (total.count < 6) {
+                qDebug() << "ICP: 对应点不足，第" << level << "层终止";
+                break;
+            }
+            for (int row = 0; row < 6; ++row)
+                for (int col = 0; col < row; ++col) total.ata[row][col] = total.ata[col][row];
+
+            const float rms = static_cast<float>(std::sqrt(total.residual2 / total.count));
+            if (result.rmsHistory.empty()) result.initialRms = rms;
+            result.rmsHistory.push_back(rms);
+            result.finalRms = rms;
+            result.correspondences = total.count;
+            ++result.iterations;
+
+            double x[6];
+            if (!solve6(total.ata, total.atb, x)) {
+                qDebug() << "ICP: 法方程奇异（几何约束不足），第" << level << "层终止";
+                break;
+            }
+            double dr[3][3];
+            rotationFromVector(x, dr);
+            transform.premultiply(dr, x + 3);
+
+            // 剔除阈值随点到点 RMS 收紧
+            const float rmsDistance = static_cast<float>(std::sqrt(total.distance2 / total.count));
+            maxDistance = std::min(maxDistance, std::max(3.0f * rmsDistance, minDistance));
+
+            const double angle = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+            const double shift = std::sqrt(x[3] * x[3] + x[4] * x[4] + x[5] * x[5]);
+            if (angle < options.convergenceAngle && shift < options.convergenceTranslation * diagonal) {
+                levelConverged = true;
+                break;
+            }
+        }
+        result.converged = levelConverged;
+    }
+
+    result.transform = transform.toMatrix();
+    result.elapsedMs = timer.elapsed();
+    return result;
+}
@@ -0,0 +1,242 @@
+#include "KdTree.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+constexpr size_t kParallelThreshold = 262144; // 子树点数超过该值才另开线程
+
+struct Entry {
+    float xyz[3];
+    uint32_t index;
+};
+
+} // namespace
+
+// 构建器：在 entries 上递归做中位数划分，节点输出到 out
+class KdTreeBuilder {
+public:
+    explicit KdTreeBuilder(std::vector<Entry>& entries) : entries_(entries) {}
+
+    void build(std::vector<KdTree::Node>& out, size_t begin, size_t end,
+               const float lo[3], const float hi[3], int parallelDepth) {
+        const size_t nodeIndex = out.size();
+        out.emplace_back();
+        const size_t count = end - begin;
+
+        int axis = 0;
+        for (int a = 1; a < 3; ++a) {
+            if (hi[a] - lo[a] > hi[axis] - lo[axis]) axis = a;
+        }
+        if (count <= KdTree::kLeafSize || hi[axis] <= lo[axis]) {
+            out[nodeIndex].axis = KdTree::kLeafAxis;
+            out[nodeIndex].offset = static_cast<uint32_t>(begin);
+            out[nodeIndex].count = static_cast<uint32_t>(count);
+            return;
+        }
+
+        const size_t mid = begin + count / 2;
+        std::nth_element(entries_.begin() + begin, entries_.begin() + mid, entries_.begin() + end,
+                         [axis](const Entry& a, const Entry& b) { return a.xyz[axis] < b.xyz[axis]; });
+        const float split = entries_[mid].xyz[axis];
+        out[nodeIndex].axis = static_cast<uint32_t>(axis);
+        out[nodeIndex].split = split;
+
+        // 子节点包围盒由父节点沿划分面裁剪得到（只用于选轴，无需精确）
+        float leftHi[3] = { hi[0], hi[1], hi[2] };
+        float rightLo[3] = { lo[0], lo[1], lo[2] };
+        leftHi[axis] = split;
+        rightLo[axis] = split;
+
+        if (parallelDepth > 0 && count >= kParallelThreshold) {
+            std::vector<KdTree::Node> rightNodes;
+            std::thread worker([&]() { build(rightNodes, mid, end, rightLo, hi, parallelDepth - 1); });
+            build(out, begin, mid, lo, leftHi, parallelDepth - 1);
+            worker.join();
+            const uint32_t base = static_cast<uint32_t>(out.size());
+            out[nodeIndex].offset = base;
+            for (KdTree::Node& node : rightNodes) {
+                if (node.axis != KdTree::kLeafAxis) node.offset += base;
+            }
+            out.insert(out.end(), rightNodes.begin(), rightNodes.end());
+        } else {
+            build(out, begin, mid, lo, leftHi, 0);
+            out[nodeIndex].offset = static_cast<uint32_t>(out.size());
+            build(out, mid, end, rightLo, hi, 0);
+        }
+    }
+
+private:
+    std::vector<Entry>& entries_;
+};
+
+void KdTree::build(const std::vector<Vertex>& points) {
+    nodes_.clear();
+    points_.clear();
+    indices_.clear();
+    const size_t n = points.size();
+    if (n == 0 || n > 0xffffffffu) return;
+
+    std::vector<Entry> entries(n);
+    Parallel::forEach(0, n, [&](size_t i) {
+        const QVector3D& p = points[i].position;
+        entries[i] = Entry{ { p.x(), p.y(), p.z() }, static_cast<uint32_t>(i) };
+    });
+
+    float lo[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float hi[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (const Entry& e : entries) {
+        for (int a = 0; a < 3; ++a) {
+            lo[a] = std::min(lo[a], e.xyz[a]);
+            hi[a] = std::max(hi[a], e.xyz[a]);
+        }
+    }
+
+    int parallelDepth = 0;
+    while ((size_t(1) << parallelDepth) < Parallel::threadCount()) ++parallelDepth;
+
+    nodes_.reserve(n / kLeafSize * 2 + 1);
+    KdTreeBuilder builder(entries);
+    builder.build(nodes_, 0, n, lo, hi, parallelDepth);
+
+    points_.resize(n);
+    indices_.resize(n);
+    Parallel::forEach(0, n, [&](size_t i) {
+        points_[i] = Point{ { entries[i].xyz[0], entries[i].xyz[1], entries[i].xyz[2] } };
+        indices_[i] = entries[i].index;
+    });
+}
+
+bool KdTree::nearest(const QVector3D& query, uint32_t& index, float& distanceSquared) const {
+    if (nodes_.empty()) return false;
+
+    const float q[3] = { query.x(), query.y(), query.z() };
+    float best = distanceSquared;
+    uint32_t bestSlot = 0xffffffffu;
+
+    // 栈中记录远侧子节点及其到划分面的距离下界
+    struct StackEntry { uint32_t node; float distance2; };
+    StackEntry stack[64];
+    int top = 0;
+    stack[top++] = { 0, 0.0f };
+    while (top > 0) {
+        const StackEntry entry = stack[--top];
+        if (entry.distance2 >= best) continue;
+
+        uint32_t current = entry.node;
+        while (nodes_[current].axis != kLeafAxis) {
+            const Node& node = nodes_[current];
+            const float diff = q[node.axis] - node.split;
+            const uint32_t nearChild = diff < 0.0f ? current + 1 : node.offset;
+            const uint32_t farChild = diff < 0.0f ? node.offset : current + 1;
+            if (diff * diff < best) stack[top++] = { farChild, diff * diff };
+            current = nearChild;
+        }
+
+        const Node& leaf = nodes_[current];
+        for (uint32_t i = leaf.offset, e = leaf.offset + leaf.count; i < e; ++i) {
+            const float dx = points_[i].xyz[0] - q[0];
+            const float dy = points_[i].xyz[1] - q[1];
+            const float dz = points_[i].xyz[2] - q[2];
+            const float d2 = dx * dx + dy * dy + dz * dz;
+            if (d2 < best) {
+                best = d2;
+                bestSlot = i;
+            }
+        }
+    }
+
+    if (bestSlot == 0xffffffffu) return false;
+    index = indices_[bestSlot];
+    distanceSquared = best;
+    return true;
+}
+
+void KdTree::kNearest(const QVector3D& query, size_t k, std::vector<uint32_t>& indices,
+                      std::vector<float>& distancesSquared) const {
+    indices.clear();
+    distancesSquared.clear();
+    if (nodes_.empty() || k == 0) return;
+
+    const float q[3] = { query.x(), query.y(), query.z() };
+    // 候选集合用大顶堆维护（堆顶为当前第 k 近），满 k 个后以堆顶距离剪枝
+    std::vector<std::pair<float, uint32_t>> heap;
+    heap.reserve(k + 1);
+    auto bound = [&]() { return heap.size() < k ? FLT_MAX : heap.front().first; };
+
+    struct StackEntry { uint32_t node; float distance2; };
+    StackEntry stack[64];
+    int top = 0;
+    stack[top++] = { 0, 0.0f };
+    while (top > 0) {
+        const StackEntry entry = stack[--top];
+        if (entry.distance2 >= bound()) continue;
+
+        uint32_t current = entry.node;
+        while (nodes_[current].axis != kLeafAxis) {
+            const Node& node = nodes_[current];
+            const float diff = q[node.axis] - node.split;
+            const uint32_t nearChild = diff < 0.0f ? current + 1 : node.offset;
+            const uint32_t farChild = diff < 0.0f ? node.offset : current + 1;
+            if (diff * diff < bound()) stack[top++] = { farChild, diff * diff };
+            current = nearChild;
+        }
+
+        const Node& leaf = nodes_[current];
+        for (uint32_t i = leaf.offset, e = leaf.offset + leaf.count; i < e; ++i) {
+            const float dx = points_[i].xyz[0] - q[0];
+            const float dy = points_[i].xyz[1] - q[1];
+            const float dz = points_[i].xyz[2] - q[2];
+            const float d2 = dx * dx + dy * dy + dz * dz;
+            if (heap.size() < k) {
+                heap.emplace_back(d2, i);
+                std::push_heap(heap.begin(), heap.end());
+            } else if (d2 < heap.front().first) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = { d2, i };
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+    indices.reserve(heap.size());
+    distancesSquared.reserve(heap.size());
+    for (const auto& item : heap) {
+        indices.push_back(indices_[item.second]);
+        distancesSquared.push_back(item.first);
+    }
+}
+
+void KdTree::radiusSearch(const QVector3D& query, float radius, std::vector<uint32_t>& indices) const {
+    indices.clear();
+    if (nodes_.empty() || radius < 0.0f) return;
+
+    const float q[3] = { query.x(), query.y(), query.z() };
+    const float r2 = radius * radius;
+
+    // 半径固定，只需按划分面距离剪枝远侧子树
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        uint32_t current = stack[--top];
+        while (nodes_[current].axis != kLeafAxis) {
+            const Node& node = nodes_[current];
+            const float diff = q[node.axis] - node.split;
+            const uint32_t nearChild = diff < 0.0f ? current + 1 : node.offset;
+            const uint32_t farChild = diff < 0.0f ? node.offset : current + 1;
+            if (diff * diff <= r2) stack[top++] = farChild;
+            current = nearChild;
+        }
+
+        const Node& leaf = nodes_[current];
+        for (uint32_t i = leaf.offset, e = leaf.offset + leaf.count; i < e; ++i) {
+            const float dx = points_[i].xyz[0] - q[0];
+            const float dy = points_[i].xyz[1] - q[1];
+            const float dz = points_[i].xyz[2] - q[2];
+            if (dx * dx + dy * dy + dz * dz <= r2) indices.push_back(indices_[i]);
+        }
+    }
+}
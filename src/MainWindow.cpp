@@ -4,6 +4,15 @@
 #include "Mesh.h"
 #include "FileImporter.h"
 #include "ModelAnalyzer.h"
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include "ColorMapper.h"
+#include "ICPRegistration.h"
+#include "RansacDetector.h"
+#include "CurvatureEstimator.h"
+#include "SurfaceReconstructor.h"
+#include "QuantizedPoints.h"
+#include "PagedVertexStore.h"
 #include <QMenuBar>
 #include <QToolBar>
 #include <QDockWidget>
@@ -17,12 +26,28 @@
 #include <QGroupBox>
 #include <QTextEdit>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QMessageBox>
 #include <QCheckBox>
 #include <QDoubleSpinBox>
 #include <QDebug>
 #include <QComboBox>
+#include <QInputDialog>
+#include <QElapsedTimer>
+#include <QStatusBar>
+#include <QProgressDialog>
+#include <QCoreApplication>
 #include <cmath>
+#include <limits>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// 导出对话框的文件过滤器：ASCII 与二进制 PLY 同后缀，按所选过滤器区分
+static const char* const kBinaryPlyFilter = "PLY二进制文件 (*.ply)";
+static const char* const kExportFilters = "PLY文件 (*.ply);;PLY二进制文件 (*.ply);;OBJ文件 (*.obj);;XYZ文件 (*.xyz);;"
+                                          "STL文件 (*.stl);;压缩存档 (*.3dvz)";
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), currentModelIndex_(-1), unitScaleForImport_(1.0) {
@@ -48,6 +73,8 @@ void MainWindow::setupUI() {
     // 创建中央OpenGL窗口
     openGLWidget_ = new OpenGLWidget(this);
     setCentralWidget(openGLWidget_);
+    connect(openGLWidget_, &OpenGLWidget::modelPicked, this, &MainWindow::onModelPicked);
+    connect(openGLWidget_, &OpenGLWidget::selectionChanged, this, &MainWindow::onSelectionChanged);
 }
 
 void MainWindow::createMenuBar() {
@@ -69,6 +96,45 @@ void MainWindow::createMenuBar() {
         updateModelList(); 
     });
     
+    // 工具菜单
+    QMenu* toolsMenu = menuBar->addMenu("工具(&T)");
+    toolsMenu->addAction("焊接重合顶点", this, &MainWindow::onWeldVertices);
+    toolsMenu->addAction("网格简化 (生成LOD)", this, &MainWindow::onSimplifyMesh);
+    toolsMenu->addAction("优化顶点缓存", this, &MainWindow::onOptimizeMesh);
+    toolsMenu->addAction("点云空间排序 (Morton)", this, &MainWindow::onSortPointCloud);
+    toolsMenu->addAction("点云紧凑存储 (量化)", this, &MainWindow::onCompactStorage);
+    toolsMenu->addAction("外存点云写回变换", this, &MainWindow::onBakePagedStore);
+    toolsMenu->addAction("点云到网格距离", this, &MainWindow::onCloudToMeshDistance);
+    toolsMenu->addAction("点云到点云偏差", this, &MainWindow::onCloudToCloudDistance);
+    toolsMenu->addAction("ICP 配准", this, &MainWindow::onRegisterICP);
+    toolsMenu->addAction("网格连通分量", this, &MainWindow::onMeshComponents);
+    toolsMenu->addAction("点云欧氏聚类", this, &MainWindow::onEuclideanClusters);
+    toolsMenu->addAction("RANSAC 形状检测", this, &MainWindow::onDetectShapes);
+    toolsMenu->addAction("曲率估计", this, &MainWindow::onEstimateCurvature);
+    toolsMenu->addAction("点云表面重建", this, &MainWindow::onReconstructSurface);
+    
+    // 选择菜单：框选 / 套索在视图中左键拖动，Shift 并入、Ctrl 去除
+    QMenu* selectMenu = menuBar->addMenu("选择(&S)");
+    rectSelectAction_ = selectMenu->addAction("框选", [this]() { onSelectionToolChanged(OpenGLWidget::RectangleSelection); });
+    lassoSelectAction_ = selectMenu->addAction("套索选择", [this]() { onSelectionToolChanged(OpenGLWidget::LassoSelection); });
+    rectSelectAction_->setCheckable(true);
+    lassoSelectAction_->setCheckable(true);
+    selectMenu->addSeparator();
+    selectMenu->addAction("清除选择", this, &MainWindow::onClearSelection);
+    selectMenu->addAction("反选", this, &MainWindow::onInvertSelection);
+    selectMenu->addSeparator();
+    selectMenu->addAction("删除选中点", this, &MainWindow::onDeleteSelected);
+    selectMenu->addAction("裁剪为新模型", this, &MainWindow::onCropSelected);
+    selectMenu->addAction("导出选中点...", this, &MainWindow::onExportSelected);
+    // 隐藏只修改模型的过滤/裁切位掩码，不复制顶点；导出与统计同样跳过隐藏的顶点
+    selectMenu->addSeparator();
+    selectMenu->addAction("隐藏选中点", [this]() { onHideSelected(false); });
+    selectMenu->addAction("仅显示选中点", [this]() { onHideSelected(true); });
+    selectMenu->addAction("按属性范围过滤...", this, &MainWindow::onFilterByAttributeRange);
+    selectMenu->addAction("按剖切面裁切", this, &MainWindow::onClipBySection);
+    selectMenu->addAction("显示全部", this, &MainWindow::onShowAll);
+    selectMenu->addAction("压缩可见部分为新模型", this, &MainWindow::onCompactVisible);
+    
     // 帮助菜单
     QMenu* helpMenu = menuBar->addMenu("帮助(&H)");
     helpMenu->addAction("关于", [this]() {
@@ -143,9 +209,23 @@ void MainWindow::createDockWindows() {
         updateModelList();
     });
     
+    // 导入选项
+    weldOnImportCheck_ = new QCheckBox("导入后焊接顶点");
+    weldOnImportCheck_->setToolTip("导入网格后合并重合顶点并删除退化面（适用于三角形汤数据）");
+    optimizeOnImportCheck_ = new QCheckBox("导入后优化索引顺序");
+    optimizeOnImportCheck_->setToolTip("导入网格后重排三角形与顶点顺序，提高 GPU 顶点缓存命中率");
+    sortOnImportCheck_ = new QCheckBox("导入后按空间排序点云");
+    sortOnImportCheck_->setToolTip("导入点云后按 Morton（Z 曲线）顺序重排点，提高空间查询与分块剔除的局部性");
+    outOfCoreOnImportCheck_ = new QCheckBox("大点云外存导入 (> 1 GB)");
+    outOfCoreOnImportCheck_->setToolTip("超过 1 GB 的 PLY/XYZ/LAS 点云写入分块外存文件并按需映射，内存中只保留 200 万个抽样点用于显示");
+    
     modelLayout->addWidget(modelListWidget_);
     modelLayout->addWidget(addPointCloudBtn);
     modelLayout->addWidget(addMeshBtn);
+    modelLayout->addWidget(weldOnImportCheck_);
+    modelLayout->addWidget(optimizeOnImportCheck_);
+    modelLayout->addWidget(sortOnImportCheck_);
+    modelLayout->addWidget(outOfCoreOnImportCheck_);
     modelDock->setWidget(modelWidget);
     addDockWidget(Qt::LeftDockWidgetArea, modelDock);
     
@@ -232,17 +312,31 @@ void MainWindow::createDockWindows() {
     rgbLayout->addWidget(new QLabel("B:"));
     rgbLayout->addWidget(colorSliderB_);
     
+    // 拖动 RGB 滑块只设置模型覆盖色（渲染时生效），原始顶点颜色保留
+    QHBoxLayout* overrideLayout = new QHBoxLayout();
+    QPushButton* restoreColorButton = new QPushButton("恢复原色");
+    restoreColorButton->setToolTip("取消覆盖色，显示顶点原有颜色");
+    QPushButton* bakeColorButton = new QPushButton("烘焙颜色");
+    bakeColorButton->setToolTip("把覆盖色写入所有顶点颜色（会替换原有颜色，可随导出保存）");
+    connect(restoreColorButton, &QPushButton::clicked, this, &MainWindow::onRestoreColor);
+    connect(bakeColorButton, &QPushButton::clicked, this, &MainWindow::onBakeColor);
+    overrideLayout->addWidget(restoreColorButton);
+    overrideLayout->addWidget(bakeColorButton);
+    
     QCheckBox* pseudoColorCheck = new QCheckBox("伪彩色渲染");
     connect(pseudoColorCheck, &QCheckBox::toggled, this, &MainWindow::onPseudoColorToggled);
     
     QHBoxLayout* coordLayout = new QHBoxLayout();
     coordinateSlider_ = new QSlider(Qt::Horizontal);
-    coordinateSlider_->setRange(0, 2);
+    coordinateSlider_->setRange(0, OpenGLWidget::kAttributeAxis);
     coordinateSlider_->setValue(0);
+    coordinateSlider_->setToolTip("X / Y / Z 坐标，或模型的属性通道（强度、分类、偏差距离等）");
+    coordinateValueLabel_ = new QLabel("X");
     connect(coordinateSlider_, &QSlider::valueChanged, this, &MainWindow::onCoordinateChanged);
     
     coordLayout->addWidget(new QLabel("坐标轴:"));
     coordLayout->addWidget(coordinateSlider_);
+    coordLayout->addWidget(coordinateValueLabel_);
 
     // （移除 尺度S/自动建议S 控件与逻辑）
 
@@ -257,10 +351,20 @@ void MainWindow::createDockWindows() {
     cmapLayout->addWidget(new QLabel("色图:"));
     cmapLayout->addWidget(colorMapCombo_);
     
+    // 属性通道选择（坐标轴滑块位于“属性”时生效）
+    QHBoxLayout* attributeLayout = new QHBoxLayout();
+    attributeCombo_ = new QComboBox();
+    attributeCombo_->setToolTip("当前模型的逐顶点属性通道（来自 PLY 属性或分析结果）");
+    connect(attributeCombo_, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::onAttributeChanged);
+    attributeLayout->addWidget(new QLabel("属性:"));
+    attributeLayout->addWidget(attributeCombo_);
+    
     colorLayout->addLayout(rgbLayout);
+    colorLayout->addLayout(overrideLayout);
     colorLayout->addWidget(pseudoColorCheck);
     colorLayout->addLayout(coordLayout);
     colorLayout->addLayout(cmapLayout);
+    colorLayout->addLayout(attributeLayout);
     // 导入单位选择（影响几何缩放，内部统一为米）
     QHBoxLayout* unitLayout = new QHBoxLayout();
     unitCombo_ = new QComboBox();
@@ -273,9 +377,47 @@ void MainWindow::createDockWindows() {
     unitLayout->addWidget(unitCombo_);
     colorLayout->addLayout(unitLayout);
     
+    // 剖切：勾选后拖动滑块实时显示截线（网格）或薄片内的点（点云）
+    sectionGroup_ = new QGroupBox("剖切");
+    sectionGroup_->setCheckable(true);
+    sectionGroup_->setChecked(false);
+    QVBoxLayout* sectionLayout = new QVBoxLayout(sectionGroup_);
+    QHBoxLayout* sectionAxisLayout = new QHBoxLayout();
+    sectionAxisCombo_ = new QComboBox();
+    sectionAxisCombo_->addItem("X", 0);
+    sectionAxisCombo_->addItem("Y", 1);
+    sectionAxisCombo_->addItem("Z", 2);
+    sectionAxisCombo_->setCurrentIndex(1);
+    sectionThicknessSpinBox_ = new QDoubleSpinBox();
+    sectionThicknessSpinBox_->setRange(0.001, 1000.0);
+    sectionThicknessSpinBox_->setDecimals(3);
+    sectionThicknessSpinBox_->setValue(0.5);
+    sectionThicknessSpinBox_->setSuffix(" cm");
+    sectionThicknessSpinBox_->setToolTip("点云薄片厚度（网格剖切不使用）");
+    sectionAxisLayout->addWidget(new QLabel("法向:"));
+    sectionAxisLayout->addWidget(sectionAxisCombo_);
+    sectionAxisLayout->addWidget(new QLabel("厚度:"));
+    sectionAxisLayout->addWidget(sectionThicknessSpinBox_);
+    sectionSlider_ = new QSlider(Qt::Horizontal);
+    sectionSlider_->setRange(0, 1000);
+    sectionSlider_->setValue(500);
+    sectionInfoLabel_ = new QLabel("未剖切");
+    sectionInfoLabel_->setWordWrap(true);
+    QPushButton* batchSectionButton = new QPushButton("批量切片...");
+    connect(sectionGroup_, &QGroupBox::toggled, this, &MainWindow::onSectionChanged);
+    connect(sectionAxisCombo_, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::onSectionChanged);
+    connect(sectionThicknessSpinBox_, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &MainWindow::onSectionChanged);
+    connect(sectionSlider_, &QSlider::valueChanged, this, &MainWindow::onSectionChanged);
+    connect(batchSectionButton, &QPushButton::clicked, this, &MainWindow::onBatchSections);
+    sectionLayout->addLayout(sectionAxisLayout);
+    sectionLayout->addWidget(sectionSlider_);
+    sectionLayout->addWidget(sectionInfoLabel_);
+    sectionLayout->addWidget(batchSectionButton);
+    
     propertyLayout->addWidget(analysisGroup_);
     propertyLayout->addWidget(transformGroup_);
     propertyLayout->addWidget(colorGroup_);
+    propertyLayout->addWidget(sectionGroup_);
     propertyLayout->addStretch();
     
     propertyDock->setWidget(propertyWidget);
@@ -284,11 +426,25 @@ void MainWindow::createDockWindows() {
 
 void MainWindow::onImportModel() {
     QString fileName = QFileDialog::getOpenFileName(this, "导入模型", "", 
-                                                   "所有支持的格式 (*.ply *.obj *.xyz);;PLY文件 (*.ply);;OBJ文件 (*.obj);;XYZ文件 (*.xyz)");
+                                                   "所有支持的格式 (*.ply *.obj *.xyz *.stl *.las *.3dvz);;PLY文件 (*.ply);;OBJ文件 (*.obj);;XYZ文件 (*.xyz);;"
+                                                   "STL文件 (*.stl);;LAS文件 (*.las);;压缩存档 (*.3dvz)");
     if (fileName.isEmpty()) return;
     
     // 使用文件导入器导入模型
-    auto model = FileImporter::importFile(fileName);
+    ImportOptions options;
+    options.weldVertices = weldOnImportCheck_->isChecked();
+    options.optimizeIndices = optimizeOnImportCheck_->isChecked();
+    options.spatialSortPoints = sortOnImportCheck_->isChecked();
+    if (outOfCoreOnImportCheck_->isChecked()) options.outOfCoreThreshold = qint64(1) << 30;
+    if (QFileInfo(fileName).suffix().toLower() == "las") {
+        // 大型 LAS 可先按步长抽样快速预览
+        bool ok = false;
+        const int stride = QInputDialog::getInt(this, "LAS 导入", "抽样步长（每 N 个点读取 1 个，1 为全部）:",
+                                                1, 1, 1000000, 1, &ok);
+        if (!ok) return;
+        options.lasStride = static_cast<size_t>(stride);
+    }
+    auto model = FileImporter::importFile(fileName, options);
     if (model) {
         models_.push_back(model);
         if (unitScaleForImport_ != 1.0) {
@@ -299,11 +455,14 @@ void MainWindow::onImportModel() {
         // 若用户未手动修改尺度，自动按当前轴范围设置 S
         // 移除自动建议 S 逻辑：不再调整伪彩色尺度
         
+        auto cloud = std::dynamic_pointer_cast<PointCloud>(model);
         QMessageBox::information(this, "导入成功", 
                                 QString("成功导入模型: %1\n类型: %2\n顶点数: %3")
                                 .arg(model->getName())
                                 .arg(model->getType())
-                                .arg(model->getVertexCount()));
+                                .arg(cloud && (cloud->isPaged() || cloud->isCompact())
+                                     ? QString(cloud->isPaged() ? "%1（外存，预览 %2）" : "%1（紧凑，预览 %2）").arg(cloud->getTotalPointCount()).arg(cloud->getPointCount())
+                                     : QString::number(static_cast<qulonglong>(model->getVertexCount()))));
     } else {
         QMessageBox::warning(this, "导入失败", "无法导入选定的文件，请检查文件格式是否正确。");
     }
@@ -314,12 +473,28 @@ void MainWindow::onExportModel() {
         QMessageBox::warning(this, "警告", "请先选择一个模型");
         return;
     }
-    QString fileName = QFileDialog::getSaveFileName(this, "导出模型", "", 
-                                                   "PLY文件 (*.ply);;OBJ文件 (*.obj);;XYZ文件 (*.xyz)");
+    QString selectedFilter;
+    QString fileName = QFileDialog::getSaveFileName(this, "导出模型", "", kExportFilters, &selectedFilter);
     if (fileName.isEmpty()) return;
     
     auto model = models_[currentModelIndex_];
-    if (FileImporter::exportFile(model, fileName)) {
+    ExportOptions options;
+    options.binaryPly = selectedFilter == kBinaryPlyFilter;
+    if (QFileInfo(fileName).suffix().toLower() == "3dvz") {
+        auto cloud = std::dynamic_pointer_cast<PointCloud>(model);
+        if (cloud && (cloud->isPaged() || cloud->isCompact())) {
+            QMessageBox::warning(this, "导出失败", "压缩存档需要把全部点展开到内存中排序，外存/紧凑点云不支持。\n"
+                                                   "请导出为 PLY，或先用“点云紧凑存储”恢复为浮点存储。");
+            return;
+        }
+        // 量化步长 = 包围盒尺寸 / (2^位数 - 1)
+        bool ok = false;
+        options.compressedPositionBits = QInputDialog::getInt(this, "压缩存档", "每轴坐标量化位数 (8-21):",
+                                                              options.compressedPositionBits, 8, 21, 1, &ok);
+        if (!ok) return;
+    }
+    
+    if (FileImporter::exportFile(model, fileName, options)) {
         QMessageBox::information(this, "导出成功", 
                                 QString("模型已成功导出到: %1").arg(fileName));
     } else {
@@ -340,12 +515,14 @@ void MainWindow::onDeleteModel() {
     
     currentModelIndex_ = -1;
     updatePropertyPanel();
+    onSectionChanged();
 }
 
 void MainWindow::onModelSelectionChanged() {
     currentModelIndex_ = modelListWidget_->currentRow();
     openGLWidget_->setSelectedModelIndex(currentModelIndex_);
     updatePropertyPanel();
+    onSectionChanged();
 }
 
 void MainWindow::onColorChanged() {
@@ -361,11 +538,34 @@ void MainWindow::onColorChanged() {
     openGLWidget_->update();
 }
 
+void MainWindow::onRestoreColor() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) return;
+    models_[currentModelIndex_]->clearColorOverride();
+    openGLWidget_->update();
+}
+
+void MainWindow::onBakeColor() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) return;
+    auto model = models_[currentModelIndex_];
+    if (!model->hasColorOverride()) {
+        QMessageBox::information(this, "提示", "当前模型没有设置覆盖色");
+        return;
+    }
+    if (QMessageBox::question(this, "烘焙颜色", "将覆盖色写入所有顶点颜色，原有颜色将被替换。是否继续？")
+        != QMessageBox::Yes) {
+        return;
+    }
+    model->bakeColor();
+    openGLWidget_->update();
+}
+
 void MainWindow::onPseudoColorToggled(bool checked) {
     openGLWidget_->setPseudoColorEnabled(checked);
 }
 
 void MainWindow::onCoordinateChanged(int value) {
+    static const char* names[] = { "X", "Y", "Z", "属性" };
+    coordinateValueLabel_->setText(names[std::max(0, std::min(value, OpenGLWidget::kAttributeAxis))]);
     openGLWidget_->setCoordinateAxis(value);
 }
 
@@ -376,11 +576,1165 @@ void MainWindow::onColorMapChanged(int index) {
     openGLWidget_->setColorMapMode(mode);
 }
 
+void MainWindow::onAttributeChanged(int index) {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size() || index < 0) return;
+    models_[currentModelIndex_]->setActiveAttribute(attributeCombo_->itemData(index).toString());
+    if (coordinateSlider_->value() != OpenGLWidget::kAttributeAxis) {
+        coordinateSlider_->setValue(OpenGLWidget::kAttributeAxis);
+    }
+    openGLWidget_->update();
+}
+
 void MainWindow::onImportUnitChanged(int index) {
     if (!unitCombo_) return;
     unitScaleForImport_ = unitCombo_->itemData(index).toDouble();
 }
 
+void MainWindow::onWeldVertices() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    auto mesh = std::dynamic_pointer_cast<Mesh>(models_[currentModelIndex_]);
+    if (!mesh) {
+        QMessageBox::warning(this, "警告", "顶点焊接仅适用于网格模型");
+        return;
+    }
+    
+    bool ok = false;
+    double toleranceCm = QInputDialog::getDouble(this, "焊接重合顶点", "焊接容差 (cm):",
+                                                 0.001, 0.0, 100.0, 4, &ok);
+    if (!ok) return;
+    
+    const int index = currentModelIndex_;
+    Mesh::WeldStats stats = mesh->weldVertices(static_cast<float>(toleranceCm / 100.0)); // cm -> m
+    updateModelList();
+    modelListWidget_->setCurrentRow(index);
+    openGLWidget_->update();
+    QMessageBox::information(this, "焊接完成",
+                             QString("合并顶点: %1\n删除退化面: %2\n当前顶点数: %3")
+                             .arg(stats.mergedVertices)
+                             .arg(stats.removedTriangles)
+                             .arg(mesh->getVertexCount()));
+}
+
+void MainWindow::onSimplifyMesh() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    auto mesh = std::dynamic_pointer_cast<Mesh>(models_[currentModelIndex_]);
+    if (!mesh || mesh->getTriangleCount() == 0) {
+        QMessageBox::warning(this, "警告", "网格简化仅适用于含三角面的网格模型");
+        return;
+    }
+    
+    bool ok = false;
+    double percent = QInputDialog::getDouble(this, "网格简化", "保留三角形比例 (%):",
+                                             50.0, 0.1, 100.0, 1, &ok);
+    if (!ok) return;
+    
+    // 在副本上简化，原模型保留，便于生成多级 LOD
+    auto lod = std::make_shared<Mesh>(QString("%1_LOD%2").arg(mesh->getName()).arg(percent, 0, 'f', 0));
+    std::vector<Vertex> vertices = mesh->getVertices();
+    std::vector<unsigned int> triangles = mesh->getTriangles();
+    std::vector<QVector2D> texCoords = mesh->getTexCoords();
+    lod->setGeometry(std::move(vertices), std::move(triangles), std::move(texCoords));
+    
+    MeshSimplifier::Options options;
+    options.targetTriangleCount = static_cast<size_t>(mesh->getTriangleCount() * percent / 100.0);
+    
+    QElapsedTimer timer;
+    timer.start();
+    // 百万面以上使用分区并行版本
+    MeshSimplifier::Result result = mesh->getTriangleCount() > 1000000
+        ? MeshSimplifier::simplifyParallel(*lod, options)
+        : MeshSimplifier::simplify(*lod, options);
+    
+    models_.push_back(lod);
+    openGLWidget_->addModel(lod);
+    updateModelList();
+    QMessageBox::information(this, "简化完成",
+                             QString("三角形: %1 -> %2\n顶点: %3 -> %4\n耗时: %5 ms")
+                             .arg(result.originalTriangles)
+                             .arg(result.resultTriangles)
+                             .arg(result.originalVertices)
+                             .arg(result.resultVertices)
+                             .arg(timer.elapsed()));
+}
+
+void MainWindow::onOptimizeMesh() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    auto mesh = std::dynamic_pointer_cast<Mesh>(models_[currentModelIndex_]);
+    if (!mesh || mesh->getTriangleCount() == 0) {
+        QMessageBox::warning(this, "警告", "顶点缓存优化仅适用于含三角面的网格模型");
+        return;
+    }
+    
+    MeshOptimizer::Report report = MeshOptimizer::optimize(*mesh);
+    openGLWidget_->update();
+    QMessageBox::information(this, "优化完成",
+                             QString("三角形数: %1\nACMR: %2 -> %3\n耗时: %4 ms")
+                             .arg(report.triangleCount)
+                             .arg(report.acmrBefore, 0, 'f', 3)
+                             .arg(report.acmrAfter, 0, 'f', 3)
+                             .arg(report.elapsedMs));
+}
+
+void MainWindow::onSortPointCloud() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(models_[currentModelIndex_]);
+    if (!cloud) {
+        QMessageBox::warning(this, "警告", "空间排序仅适用于点云模型");
+        return;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    cloud->sortByMorton();
+    const qint64 elapsed = timer.elapsed();
+    const size_t chunkCount = cloud->computeChunks().size();
+    openGLWidget_->update();
+    QMessageBox::information(this, "排序完成",
+                             QString("点数: %1\n分块数 (4096 点/块): %2\n耗时: %3 ms")
+                             .arg(cloud->getPointCount())
+                             .arg(chunkCount)
+                             .arg(elapsed));
+}
+
+void MainWindow::onCompactStorage() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(models_[currentModelIndex_]);
+    if (!cloud) {
+        QMessageBox::warning(this, "警告", "紧凑存储仅适用于点云模型");
+        return;
+    }
+    if (cloud->isPaged()) {
+        QMessageBox::warning(this, "警告", "外存点云不支持紧凑存储");
+        return;
+    }
+    
+    const QStringList items = {"16 位/轴 (9 字节/点)", "21 位/轴 (11 字节/点)", "恢复为浮点存储"};
+    bool ok = false;
+    const QString item = QInputDialog::getItem(this, "点云紧凑存储", "坐标量化精度 (不保存法线):", items,
+                                               cloud->isCompact() && cloud->getQuantizedPoints()->precision() ==
+                                                   QuantizedPoints::Bits21 ? 1 : 0,
+                                               false, &ok);
+    if (!ok) return;
+    const int choice = items.indexOf(item);
+    
+    QElapsedTimer timer;
+    timer.start();
+    if (choice == 2) {
+        cloud->clearCompactStorage();
+    } else if (!cloud->setCompactStorage(choice == 0 ? 16 : 21, 2000000)) {
+        QMessageBox::warning(this, "警告", "紧凑存储失败");
+        return;
+    }
+    const qint64 elapsed = timer.elapsed();
+    updatePropertyPanel();
+    onSectionChanged();
+    openGLWidget_->update();
+    if (!cloud->isCompact()) {
+        statusBar()->showMessage(QString("已恢复为浮点存储：%1 点，耗时 %2 ms").arg(cloud->getPointCount()).arg(elapsed));
+        return;
+    }
+    
+    const QuantizedPoints& points = *cloud->getQuantizedPoints();
+    const double floatBytes = static_cast<double>(points.size()) * sizeof(Vertex);
+    const QVector3D boundCm = points.error().bound * 100.0f;
+    const QVector3D maxCm = points.error().maxError * 100.0f;
+    QMessageBox::information(this, "紧凑存储完成",
+                             QString("点数: %1（预览 %2）\n占用: %3 MB（浮点顶点 %4 MB）\n"
+                                     "误差上界(cm): %5, %6, %7\n实测最大误差(cm): %8, %9, %10\n耗时: %11 ms")
+                             .arg(static_cast<qulonglong>(points.size())).arg(cloud->getPointCount())
+                             .arg(points.byteSize() / 1048576.0, 0, 'f', 1)
+                             .arg(floatBytes / 1048576.0, 0, 'f', 1)
+                             .arg(boundCm.x(), 0, 'g', 3).arg(boundCm.y(), 0, 'g', 3).arg(boundCm.z(), 0, 'g', 3)
+                             .arg(maxCm.x(), 0, 'g', 3).arg(maxCm.y(), 0, 'g', 3).arg(maxCm.z(), 0, 'g', 3)
+                             .arg(elapsed));
+}
+
+void MainWindow::onBakePagedStore() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(models_[currentModelIndex_]);
+    if (!cloud || !cloud->isPaged()) {
+        QMessageBox::warning(this, "警告", "请先选择外存点云");
+        return;
+    }
+    PagedVertexStore& store = *cloud->getPagedStore();
+    if (!store.hasPendingChanges()) {
+        statusBar()->showMessage("外存点云没有待写回的变换或着色");
+        return;
+    }
+    if (!store.isWritable()) {
+        QMessageBox::warning(this, "警告", "外存文件以只读方式打开，无法写回");
+        return;
+    }
+    
+    // 写回耗时与文件大小成正比，在工作线程执行；界面线程显示模态进度，写回期间不能操作该点云。
+    // 中途停止会使文件中的块不一致，因此不提供取消
+    QProgressDialog progress("正在写回外存文件...", QString(), 0, static_cast<int>(store.chunkCount()), this);
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(0);
+    QElapsedTimer timer;
+    timer.start();
+    std::atomic<size_t> bakedChunks(0);
+    std::atomic<bool> done(false);
+    bool ok = false;
+    std::thread worker([&]() {
+        ok = store.bake(&bakedChunks);
+        done = true;
+    });
+    while (!done) {
+        progress.setValue(static_cast<int>(bakedChunks.load()));
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    worker.join();
+    progress.setValue(static_cast<int>(store.chunkCount()));
+    if (!ok) {
+        QMessageBox::warning(this, "警告", "外存文件写回失败");
+        return;
+    }
+    statusBar()->showMessage(QString("已写回外存文件：%1 点，%2 块，耗时 %3 ms")
+                             .arg(store.size()).arg(store.chunkCount()).arg(timer.elapsed()));
+}
+
+void MainWindow::onCloudToMeshDistance() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个点云模型");
+        return;
+    }
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(models_[currentModelIndex_]);
+    if (!cloud || cloud->getPointCount() == 0) {
+        QMessageBox::warning(this, "警告", "请先选择一个点云模型");
+        return;
+    }
+    
+    // 选择参考网格
+    QStringList meshNames;
+    std::vector<std::shared_ptr<Mesh>> meshes;
+    for (const auto& model : models_) {
+        auto mesh = std::dynamic_pointer_cast<Mesh>(model);
+        if (mesh && mesh->getTriangleCount() > 0) {
+            meshes.push_back(mesh);
+            meshNames << mesh->getName();
+        }
+    }
+    if (meshes.empty()) {
+        QMessageBox::warning(this, "警告", "没有可作为参考的网格模型");
+        return;
+    }
+    bool ok = false;
+    QString chosen = QInputDialog::getItem(this, "点云到网格距离", "参考网格:", meshNames, 0, false, &ok);
+    if (!ok) return;
+    auto reference = meshes[std::max<qsizetype>(0, meshNames.indexOf(chosen))];
+    
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<float> distances = ModelAnalyzer::computeCloudToMeshDistances(cloud, reference);
+    const qint64 elapsed = timer.elapsed();
+    if (distances.empty()) return;
+    
+    const ModelAnalyzer::DistanceStats stats = ModelAnalyzer::computeStatistics(distances);
+    const float maxAbsCm = std::max(std::fabs(stats.minValue), std::fabs(stats.maxValue)) * 100.0f;
+    
+    double rangeCm = QInputDialog::getDouble(this, "点云到网格距离", "着色范围 ±(cm):",
+                                             maxAbsCm > 0.0f ? maxAbsCm : 1.0, 0.0001, 1e6, 4, &ok);
+    if (!ok) return;
+    
+    std::vector<QColor> colors(distances.size());
+    for (size_t i = 0; i < distances.size(); ++i) {
+        colors[i] = ColorMapper::mapByDistance(distances[i] * 100.0f, static_cast<float>(rangeCm));
+    }
+    cloud->setPointColors(colors);
+    cloud->clearColorOverride();
+    cloud->setScalarField(QString("到 %1 的距离").arg(reference->getName()), std::move(distances));
+    updateAttributeList();
+    openGLWidget_->update();
+    
+    QMessageBox::information(this, "距离计算完成",
+                             QString("参考网格: %1\n%2耗时: %3 ms\n\n"
+                                     "（蓝=网格内侧，绿=贴合，红=网格外侧；如开启了伪彩色请先关闭以查看距离着色，"
+                                     "或在伪彩色中选择“属性”）")
+                             .arg(reference->getName())
+                             .arg(formatDistanceStats(stats))
+                             .arg(elapsed));
+}
+
+void MainWindow::onCloudToCloudDistance() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择要比较的点云模型");
+        return;
+    }
+    auto compared = std::dynamic_pointer_cast<PointCloud>(models_[currentModelIndex_]);
+    if (!compared || compared->getPointCount() == 0) {
+        QMessageBox::warning(this, "警告", "请先选择要比较的点云模型");
+        return;
+    }
+    
+    // 选择参考点云（排除自身）
+    QStringList cloudNames;
+    std::vector<std::shared_ptr<PointCloud>> clouds;
+    for (const auto& model : models_) {
+        auto cloud = std::dynamic_pointer_cast<PointCloud>(model);
+        if (cloud && cloud != compared && cloud->getPointCount() > 0) {
+            clouds.push_back(cloud);
+            cloudNames << QString("%1: %2").arg(clouds.size()).arg(cloud->getName());
+        }
+    }
+    if (clouds.empty()) {
+        QMessageBox::warning(this, "警告", "没有可作为参考的其他点云");
+        return;
+    }
+    bool ok = false;
+    QString chosen = QInputDialog::getItem(this, "点云到点云偏差", "参考点云:", cloudNames, 0, false, &ok);
+    if (!ok) return;
+    auto reference = clouds[std::max<qsizetype>(0, cloudNames.indexOf(chosen))];
+    
+    QElapsedTimer timer;
+    timer.start();
+    const ModelAnalyzer::DistanceStats stats = ModelAnalyzer::computeCloudToCloudDistances(compared, reference);
+    const qint64 elapsed = timer.elapsed();
+    
+    // 结果写入属性通道，直接切换到“属性”伪彩色显示
+    updateAttributeList();
+    coordinateSlider_->setValue(OpenGLWidget::kAttributeAxis);
+    openGLWidget_->update();
+    QMessageBox::information(this, "偏差计算完成",
+                             QString("参考点云: %1\n%2耗时: %3 ms\n\n"
+                                     "距离已保存为属性通道，勾选“伪彩色渲染”即可查看")
+                             .arg(reference->getName())
+                             .arg(formatDistanceStats(stats))
+                             .arg(elapsed));
+}
+
+void MainWindow::onRegisterICP() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择要移动的模型（源模型）");
+        return;
+    }
+    auto source = models_[currentModelIndex_];
+    
+    // 选择固定不动的目标模型
+    QStringList names;
+    std::vector<std::shared_ptr<Model>> candidates;
+    for (const auto& model : models_) {
+        if (model && model != source && model->getVertexCount() >= 3) {
+            candidates.push_back(model);
+            names << QString("%1: %2").arg(candidates.size()).arg(model->getName());
+        }
+    }
+    if (candidates.empty() || source->getVertexCount() < 3) {
+        QMessageBox::warning(this, "警告", "ICP 配准需要两个包含顶点的模型");
+        return;
+    }
+    bool ok = false;
+    QString chosen = QInputDialog::getItem(this, "ICP 配准", QString("将 %1 对齐到:").arg(source->getName()),
+                                           names, 0, false, &ok);
+    if (!ok) return;
+    auto target = candidates[std::max<qsizetype>(0, names.indexOf(chosen))];
+    
+    ICPRegistration::Options options;
+    ICPRegistration::Result result = ICPRegistration::align(*source, *target, options);
+    if (result.iterations == 0) {
+        QMessageBox::warning(this, "配准失败", "未找到足够的对应点，请先手动把两个模型大致对齐");
+        return;
+    }
+    
+    const int index = currentModelIndex_;
+    source->applyTransform(result.transform);
+    updatePropertyPanel();
+    openGLWidget_->update();
+    modelListWidget_->setCurrentRow(index);
+    
+    QMessageBox::information(this, "配准完成",
+                             QString("状态: %1\n迭代次数: %2\n对应点数: %3\n点到面 RMS: %4 -> %5 cm\n耗时: %6 ms")
+                             .arg(result.converged ? "已收敛" : "达到迭代上限")
+                             .arg(result.iterations)
+                             .arg(result.correspondences)
+                             .arg(result.initialRms * 100.0f, 0, 'f', 4)
+                             .arg(result.finalRms * 100.0f, 0, 'f', 4)
+                             .arg(result.elapsedMs));
+}
+
+void MainWindow::onMeshComponents() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    auto mesh = std::dynamic_pointer_cast<Mesh>(models_[currentModelIndex_]);
+    if (!mesh || mesh->getTriangleCount() == 0) {
+        QMessageBox::warning(this, "警告", "连通分量分析仅适用于含三角面的网格模型");
+        return;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<uint32_t> faceLabels;
+    const std::vector<ModelAnalyzer::ComponentStats> components = ModelAnalyzer::computeMeshComponents(mesh, faceLabels);
+    const qint64 elapsed = timer.elapsed();
+    const QString summary = QString("分量数: %1（耗时 %2 ms）\n\n%3")
+                                .arg(components.size())
+                                .arg(elapsed)
+                                .arg(formatComponentStats(components, "三角形", 10));
+    if (components.size() <= 1) {
+        QMessageBox::information(this, "网格连通分量", summary);
+        return;
+    }
+    
+    const QStringList actions = { "标记分量（属性通道，伪彩色显示）", "拆分为独立模型" };
+    bool ok = false;
+    QString action = QInputDialog::getItem(this, "网格连通分量", summary + "\n操作:", actions, 0, false, &ok);
+    if (!ok) return;
+    
+    if (action == actions[0]) {
+        // 分量互不共享顶点，三角形标签即顶点标签
+        AttributeChannel* channel = mesh->addAttribute("连通分量", AttributeChannel::UInt32);
+        uint32_t* labels = channel->values<uint32_t>();
+        const auto& triangles = mesh->getTriangles();
+        for (size_t t = 0; t < faceLabels.size(); ++t) {
+            if (faceLabels[t] == ModelAnalyzer::kNoComponent) continue;
+            for (int k = 0; k < 3; ++k) labels[triangles[t * 3 + k]] = faceLabels[t];
+        }
+        mesh->setActiveAttribute("连通分量");
+        updateAttributeList();
+        coordinateSlider_->setValue(OpenGLWidget::kAttributeAxis);
+        openGLWidget_->update();
+        return;
+    }
+    
+    std::vector<std::shared_ptr<Mesh>> parts = mesh->splitByFaceLabels(faceLabels, components.size());
+    for (size_t c = 0; c < parts.size(); ++c) {
+        parts[c]->setName(QString("%1_part%2").arg(mesh->getName()).arg(c + 1));
+        models_.push_back(parts[c]);
+        openGLWidget_->addModel(parts[c]);
+    }
+    updateModelList();
+    QMessageBox::information(this, "拆分完成",
+                             QString("已生成 %1 个网格模型（原模型保留）").arg(parts.size()));
+}
+
+void MainWindow::onEuclideanClusters() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(models_[currentModelIndex_]);
+    if (!cloud || cloud->getPointCount() == 0) {
+        QMessageBox::warning(this, "警告", "欧氏聚类仅适用于点云模型");
+        return;
+    }
+    
+    bool ok = false;
+    const double radiusCm = QInputDialog::getDouble(this, "点云欧氏聚类", "邻域半径 (cm):",
+                                                    2.0, 0.001, 10000.0, 3, &ok);
+    if (!ok) return;
+    const int minSize = QInputDialog::getInt(this, "点云欧氏聚类", "最小聚类点数:",
+                                             100, 1, std::numeric_limits<int>::max(), 1, &ok);
+    if (!ok) return;
+    const int maxSize = QInputDialog::getInt(this, "点云欧氏聚类", "最大聚类点数:",
+                                             std::numeric_limits<int>::max(), minSize,
+                                             std::numeric_limits<int>::max(), 1, &ok);
+    if (!ok) return;
+    
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<uint32_t> pointLabels;
+    const std::vector<ModelAnalyzer::ComponentStats> clusters = ModelAnalyzer::computeEuclideanClusters(
+        cloud, static_cast<float>(radiusCm / 100.0), // cm -> m
+        static_cast<size_t>(minSize), static_cast<size_t>(maxSize), pointLabels);
+    const qint64 elapsed = timer.elapsed();
+    size_t clusteredPoints = 0;
+    for (const auto& stats : clusters) clusteredPoints += stats.elementCount;
+    const QString summary = QString("聚类数: %1，已聚类点: %2 / %3（耗时 %4 ms）\n\n%5")
+                                .arg(clusters.size())
+                                .arg(clusteredPoints)
+                                .arg(cloud->getPointCount())
+                                .arg(elapsed)
+                                .arg(formatComponentStats(clusters, "点", 10));
+    if (clusters.empty()) {
+        QMessageBox::information(this, "点云欧氏聚类", summary);
+        return;
+    }
+    
+    const QStringList actions = { "标记聚类（属性通道，伪彩色显示）", "拆分为独立模型" };
+    QString action = QInputDialog::getItem(this, "点云欧氏聚类", summary + "\n操作:", actions, 0, false, &ok);
+    if (!ok) return;
+    
+    if (action == actions[0]) {
+        // 被丢弃的点记为 -1，避免 kNoComponent 撑大伪彩色范围
+        AttributeChannel* channel = cloud->addAttribute("聚类", AttributeChannel::Int32);
+        int32_t* labels = channel->values<int32_t>();
+        for (size_t i = 0; i < pointLabels.size(); ++i) {
+            labels[i] = pointLabels[i] == ModelAnalyzer::kNoComponent ? -1 : static_cast<int32_t>(pointLabels[i]);
+        }
+        cloud->setActiveAttribute("聚类");
+        updateAttributeList();
+        coordinateSlider_->setValue(OpenGLWidget::kAttributeAxis);
+        openGLWidget_->update();
+        return;
+    }
+    
+    std::vector<std::shared_ptr<PointCloud>> parts = cloud->splitByLabels(pointLabels, clusters.size());
+    for (size_t c = 0; c < parts.size(); ++c) {
+        parts[c]->setName(QString("%1_cluster%2").arg(cloud->getName()).arg(c + 1));
+        models_.push_back(parts[c]);
+        openGLWidget_->addModel(parts[c]);
+    }
+    updateModelList();
+    QMessageBox::information(this, "拆分完成",
+                             QString("已生成 %1 个点云模型（原模型保留）").arg(parts.size()));
+}
+
+void MainWindow::onDetectShapes() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    auto model = models_[currentModelIndex_];
+    if (!model || model->getVertexCount() < 4) {
+        QMessageBox::warning(this, "警告", "形状检测需要包含顶点的模型");
+        return;
+    }
+    
+    bool ok = false;
+    const QStringList shapes = { "平面", "球面" };
+    const QString shapeName = QInputDialog::getItem(this, "RANSAC 形状检测", "形状:", shapes, 0, false, &ok);
+    if (!ok) return;
+    RansacDetector::Options options;
+    options.shape = shapeName == shapes[1] ? RansacDetector::Sphere : RansacDetector::Plane;
+    const double thresholdCm = QInputDialog::getDouble(this, "RANSAC 形状检测", "内点距离阈值 (cm):",
+                                                       1.0, 0.001, 1000.0, 3, &ok);
+    if (!ok) return;
+    options.distanceThreshold = static_cast<float>(thresholdCm / 100.0); // cm -> m
+    if (options.shape == RansacDetector::Sphere) {
+        const double maxRadiusCm = QInputDialog::getDouble(this, "RANSAC 形状检测", "最大球半径 (cm，0 表示不限):",
+                                                           0.0, 0.0, 1e6, 2, &ok);
+        if (!ok) return;
+        options.maxRadius = static_cast<float>(maxRadiusCm / 100.0);
+    }
+    options.maxShapes = QInputDialog::getInt(this, "RANSAC 形状检测", "最多检测形状数:",
+                                             options.shape == RansacDetector::Plane ? 3 : 1, 1, 100, 1, &ok);
+    if (!ok) return;
+    options.minInliers = std::max<size_t>(100, model->getVertexCount() / 1000);
+    
+    const std::vector<RansacDetector::Result> results = RansacDetector::detect(*model, options);
+    if (results.empty()) {
+        QMessageBox::information(this, "RANSAC 形状检测", "未检测到满足条件的形状");
+        return;
+    }
+    QString summary = QString("检测到 %1 个%2（耗时 %3 ms）\n\n")
+                          .arg(results.size())
+                          .arg(shapeName)
+                          .arg(results.back().elapsedMs);
+    for (size_t k = 0; k < results.size(); ++k) {
+        const RansacDetector::Result& r = results[k];
+        summary += QString("#%1: 内点 %2, RMS %3 cm, ").arg(k + 1).arg(r.inlierCount).arg(r.rms * 100.0f, 0, 'f', 3);
+        if (r.shape == RansacDetector::Plane) {
+            summary += QString("法线 (%1, %2, %3), 原点距离 %4 cm\n")
+                           .arg(r.normal.x(), 0, 'f', 4)
+                           .arg(r.normal.y(), 0, 'f', 4)
+                           .arg(r.normal.z(), 0, 'f', 4)
+                           .arg(r.distance * 100.0f, 0, 'f', 2);
+        } else {
+            summary += QString("球心 (%1, %2, %3) cm, 半径 %4 cm\n")
+                           .arg(r.center.x() * 100.0f, 0, 'f', 2)
+                           .arg(r.center.y() * 100.0f, 0, 'f', 2)
+                           .arg(r.center.z() * 100.0f, 0, 'f', 2)
+                           .arg(r.radius * 100.0f, 0, 'f', 2);
+        }
+    }
+    
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(model);
+    QStringList actions = { "标记内点（属性通道，伪彩色显示）" };
+    if (options.shape == RansacDetector::Plane) actions << "调平到地面（旋转模型使地面水平）";
+    if (cloud) actions << "拆分内点为独立点云";
+    const QString action = QInputDialog::getItem(this, "RANSAC 形状检测", summary + "\n操作:", actions, 0, false, &ok);
+    if (!ok) return;
+    
+    // 各形状内点互不重叠，合并为逐顶点形状编号
+    std::vector<uint32_t> labels(model->getVertexCount(), ModelAnalyzer::kNoComponent);
+    for (size_t k = 0; k < results.size(); ++k) {
+        for (size_t i = 0; i < labels.size(); ++i) {
+            if (results[k].inliers[i]) labels[i] = static_cast<uint32_t>(k);
+        }
+    }
+    
+    if (action == actions[0]) {
+        AttributeChannel* channel = model->addAttribute("RANSAC 形状", AttributeChannel::Int32);
+        int32_t* values = channel->values<int32_t>();
+        for (size_t i = 0; i < labels.size(); ++i) {
+            values[i] = labels[i] == ModelAnalyzer::kNoComponent ? -1 : static_cast<int32_t>(labels[i]);
+        }
+        model->setActiveAttribute("RANSAC 形状");
+        updateAttributeList();
+        coordinateSlider_->setValue(OpenGLWidget::kAttributeAxis);
+        openGLWidget_->update();
+        return;
+    }
+    
+    if (action.startsWith("调平")) {
+        const QStringList axes = { "Y 轴向上（视图默认）", "Z 轴向上" };
+        const QString axis = QInputDialog::getItem(this, "调平到地面", "竖直方向:", axes, 0, false, &ok);
+        if (!ok) return;
+        const QVector3D up = axis == axes[1] ? QVector3D(0, 0, 1) : QVector3D(0, 1, 0);
+        // 地面取与竖直方向夹角不超过 45° 的平面中内点最多者，没有则取最大平面
+        size_t ground = 0;
+        for (size_t k = 0; k < results.size(); ++k) {
+            if (std::fabs(QVector3D::dotProduct(results[k].normal, up)) >= std::sqrt(0.5f)) {
+                ground = k;
+                break;
+            }
+        }
+        const int index = currentModelIndex_;
+        model->applyTransform(RansacDetector::levelingTransform(results[ground], up));
+        updatePropertyPanel();
+        openGLWidget_->update();
+        modelListWidget_->setCurrentRow(index);
+        QMessageBox::information(this, "调平完成", QString("已将平面 #%1 旋转为水平并移到高度 0").arg(ground + 1));
+        return;
+    }
+    
+    std::vector<std::shared_ptr<PointCloud>> parts = cloud->splitByLabels(labels, results.size());
+    for (size_t k = 0; k < parts.size(); ++k) {
+        parts[k]->setName(QString("%1_%2%3").arg(cloud->getName()).arg(shapeName).arg(k + 1));
+        models_.push_back(parts[k]);
+        openGLWidget_->addModel(parts[k]);
+    }
+    updateModelList();
+    QMessageBox::information(this, "拆分完成",
+                             QString("已生成 %1 个点云模型（原模型保留）").arg(parts.size()));
+}
+
+void MainWindow::onEstimateCurvature() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    auto model = models_[currentModelIndex_];
+    if (!model || model->getVertexCount() < 3) {
+        QMessageBox::warning(this, "警告", "曲率估计需要包含顶点的模型");
+        return;
+    }
+    
+    // 显示范围取 2%~98% 分位数，少数尖点不会占满色带
+    constexpr double kDisplayPercent = 2.0;
+    QElapsedTimer timer;
+    timer.start();
+    QString summary;
+    auto mesh = std::dynamic_pointer_cast<Mesh>(model);
+    if (mesh && mesh->getTriangleCount() > 0) {
+        CurvatureEstimator::MeshCurvature curvature = CurvatureEstimator::computeMeshCurvature(*mesh);
+        double meanLo, meanHi, gaussLo, gaussHi;
+        CurvatureEstimator::percentileRange(curvature.mean, kDisplayPercent, meanLo, meanHi);
+        CurvatureEstimator::percentileRange(curvature.gaussian, kDisplayPercent, gaussLo, gaussHi);
+        mesh->setScalarField("高斯曲率", std::move(curvature.gaussian));
+        mesh->setScalarField("平均曲率", std::move(curvature.mean));
+        if (AttributeChannel* channel = mesh->findAttribute("高斯曲率")) channel->setDisplayRange(gaussLo, gaussHi);
+        if (AttributeChannel* channel = mesh->findAttribute("平均曲率")) channel->setDisplayRange(meanLo, meanHi);
+        summary = QString("平均曲率 P2~P98: %1 ~ %2 1/m\n高斯曲率 P2~P98: %3 ~ %4 1/m²\n"
+                          "边界顶点（记为 0）: %5\n孤立顶点（记为 0）: %6\n")
+                      .arg(meanLo, 0, 'g', 4)
+                      .arg(meanHi, 0, 'g', 4)
+                      .arg(gaussLo, 0, 'g', 4)
+                      .arg(gaussHi, 0, 'g', 4)
+                      .arg(curvature.boundaryVertices)
+                      .arg(curvature.isolatedVertices);
+    } else {
+        bool ok = false;
+        const int neighbours = QInputDialog::getInt(this, "曲率估计", "近邻点数 k:", 16, 3, 256, 1, &ok);
+        if (!ok) return;
+        std::vector<float> variation = CurvatureEstimator::computeSurfaceVariation(*model, static_cast<size_t>(neighbours));
+        double lo, hi;
+        CurvatureEstimator::percentileRange(variation, kDisplayPercent, lo, hi);
+        model->setScalarField("表面变化度", std::move(variation));
+        if (AttributeChannel* channel = model->findAttribute("表面变化度")) channel->setDisplayRange(0.0, hi);
+        summary = QString("表面变化度 λ0/(λ0+λ1+λ2)，k = %1\nP98: %2（0 为平面，1/3 为各向同性）\n")
+                      .arg(neighbours)
+                      .arg(hi, 0, 'g', 4);
+    }
+    const qint64 elapsed = timer.elapsed();
+    
+    updateAttributeList();
+    coordinateSlider_->setValue(OpenGLWidget::kAttributeAxis);
+    openGLWidget_->update();
+    QMessageBox::information(this, "曲率估计完成",
+                             summary + QString("耗时: %1 ms\n\n曲率已保存为属性通道，勾选“伪彩色渲染”即可查看，可在属性下拉框中切换通道")
+                                           .arg(elapsed));
+}
+
+void MainWindow::onReconstructSurface() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(models_[currentModelIndex_]);
+    if (!cloud || cloud->getPointCount() < 3) {
+        QMessageBox::warning(this, "警告", "表面重建仅适用于点云模型");
+        return;
+    }
+    
+    // 导入时没有法线的点云法线都是默认的 (0, 0, 1)，此时默认改为估计法线
+    const auto& points = cloud->getVertices();
+    const bool hasNormals = std::any_of(points.begin(), points.end(), [](const Vertex& v) {
+        return v.normal != QVector3D(0, 0, 1) && !v.normal.isNull();
+    });
+    bool ok = false;
+    const QStringList sources = { "使用点云自带法线（须已定向）", "估计法线（朝外定向，适用于单个物体）" };
+    const QString source = QInputDialog::getItem(this, "点云表面重建", "法线来源:", sources,
+                                                 hasNormals ? 0 : 1, false, &ok);
+    if (!ok) return;
+    SurfaceReconstructor::Options options;
+    options.normalSource = source == sources[1] ? SurfaceReconstructor::EstimateOutward
+                                                : SurfaceReconstructor::VertexNormals;
+    
+    const double suggestedCm = SurfaceReconstructor::suggestVoxelSize(*cloud) * 100.0;
+    const double voxelCm = QInputDialog::getDouble(this, "点云表面重建",
+                                                   QString("体素边长 (cm，建议 %1):").arg(suggestedCm, 0, 'g', 3),
+                                                   suggestedCm, 1e-4, 1e4, 4, &ok);
+    if (!ok) return;
+    options.voxelSize = static_cast<float>(voxelCm / 100.0); // cm -> m
+    options.truncation = static_cast<float>(QInputDialog::getDouble(this, "点云表面重建", "截断半径（体素数）:",
+                                                                    options.truncation, 1.0, 16.0, 1, &ok));
+    if (!ok) return;
+    
+    const SurfaceReconstructor::Result result = SurfaceReconstructor::reconstruct(*cloud, options);
+    if (!result.mesh) {
+        QMessageBox::warning(this, "点云表面重建", "重建失败：体素过小或没有有效法线，详见调试输出");
+        return;
+    }
+    models_.push_back(result.mesh);
+    openGLWidget_->addModel(result.mesh);
+    updateModelList();
+    QMessageBox::information(this, "重建完成",
+                             QString("体素块: %1（采样点 %2）\n三角形: %3，顶点: %4\n耗时: %5 ms\n\n"
+                                     "结果为焊接好的网格，可直接导出 OBJ/PLY")
+                                 .arg(result.blockCount)
+                                 .arg(result.sampleCount)
+                                 .arg(result.triangleCount)
+                                 .arg(result.mesh->getVertexCount())
+                                 .arg(result.elapsedMs));
+}
+
+bool MainWindow::sectionPlane(QVector3D& normal, float& minOffset, float& maxOffset) const {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) return false;
+    const auto& model = models_[currentModelIndex_];
+    if (!model || model->getVertexCount() == 0) return false;
+    const int axis = sectionAxisCombo_->currentData().toInt();
+    normal = QVector3D(axis == 0, axis == 1, axis == 2);
+    const AABB box = model->computeAABB();
+    minOffset = QVector3D::dotProduct(normal, box.min);
+    maxOffset = QVector3D::dotProduct(normal, box.max);
+    return true;
+}
+
+void MainWindow::onSectionChanged() {
+    QVector3D normal;
+    float minOffset, maxOffset;
+    if (!sectionGroup_->isChecked() || !sectionPlane(normal, minOffset, maxOffset)) {
+        openGLWidget_->clearSectionOverlay();
+        sectionInfoLabel_->setText("未剖切");
+        return;
+    }
+    auto model = models_[currentModelIndex_];
+    const float offset = minOffset + (maxOffset - minOffset) * sectionSlider_->value() / sectionSlider_->maximum();
+    QElapsedTimer timer;
+    timer.start();
+    QString info = QString("位置: %1 cm\n").arg(offset * 100.0f, 0, 'f', 2);
+    
+    if (auto mesh = std::dynamic_pointer_cast<Mesh>(model)) {
+        const ModelAnalyzer::Section section = ModelAnalyzer::computeMeshSection(mesh, normal, offset);
+        std::vector<QVector3D> lines;
+        size_t closedCount = 0;
+        for (size_t k = 0; k < section.polylines.size(); ++k) {
+            const auto& polyline = section.polylines[k];
+            for (size_t j = 0; j + 1 < polyline.size(); ++j) {
+                lines.push_back(polyline[j]);
+                lines.push_back(polyline[j + 1]);
+            }
+            if (section.closed[k] && polyline.size() > 1) {
+                lines.push_back(polyline.back());
+                lines.push_back(polyline.front());
+                ++closedCount;
+            }
+        }
+        info += QString("截线 %1 条（闭合 %2），总长 %3 cm\n")
+                    .arg(section.polylines.size())
+                    .arg(closedCount)
+                    .arg(section.length * 100.0, 0, 'f', 2);
+        openGLWidget_->setSectionOverlay(std::move(lines), {});
+    } else if (auto cloud = std::dynamic_pointer_cast<PointCloud>(model)) {
+        // 区间包围盒由点云缓存，拖动时直接复用
+        const float halfThickness = static_cast<float>(sectionThicknessSpinBox_->value() / 200.0); // cm -> m，取一半
+        const std::vector<uint32_t> indices =
+            ModelAnalyzer::extractPointSlab(cloud, cloud->getChunks(), normal, offset, halfThickness);
+        const auto& points = cloud->getVertices();
+        std::vector<QVector3D> slab(indices.size());
+        for (size_t k = 0; k < indices.size(); ++k) slab[k] = points[indices[k]].position;
+        info += QString("薄片内点数: %1\n").arg(indices.size());
+        openGLWidget_->setSectionOverlay({}, std::move(slab));
+    }
+    sectionInfoLabel_->setText(info + QString("耗时: %1 ms").arg(timer.elapsed()));
+}
+
+void MainWindow::onBatchSections() {
+    QVector3D normal;
+    float minOffset, maxOffset;
+    if (!sectionPlane(normal, minOffset, maxOffset)) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    bool ok = false;
+    const int count = QInputDialog::getInt(this, "批量切片", "切片数（沿所选法向等距分布）:", 10, 1, 10000, 1, &ok);
+    if (!ok) return;
+    // 平面取在 count 等分区间的中点，首尾不会恰好落在包围盒表面
+    const float step = (maxOffset - minOffset) / count;
+    const float first = minOffset + step * 0.5f;
+    const float last = maxOffset - step * 0.5f;
+    auto model = models_[currentModelIndex_];
+    QElapsedTimer timer;
+    timer.start();
+    
+    if (auto mesh = std::dynamic_pointer_cast<Mesh>(model)) {
+        const std::vector<ModelAnalyzer::Section> sections =
+            ModelAnalyzer::computeMeshSections(mesh, normal, first, last, count);
+        const qint64 elapsed = timer.elapsed();
+        std::vector<QVector3D> lines;
+        QString table;
+        constexpr int kMaxRows = 20;
+        for (int k = 0; k < count; ++k) {
+            const ModelAnalyzer::Section& section = sections[k];
+            for (size_t c = 0; c < section.polylines.size(); ++c) {
+                const auto& polyline = section.polylines[c];
+                for (size_t j = 0; j + 1 < polyline.size(); ++j) {
+                    lines.push_back(polyline[j]);
+                    lines.push_back(polyline[j + 1]);
+                }
+                if (section.closed[c] && polyline.size() > 1) {
+                    lines.push_back(polyline.back());
+                    lines.push_back(polyline.front());
+                }
+            }
+            if (k < kMaxRows) {
+                table += QString("#%1 位置 %2 cm: 截线 %3 条，总长 %4 cm\n")
+                             .arg(k + 1)
+                             .arg((count > 1 ? first + (last - first) * k / (count - 1) : first) * 100.0f, 0, 'f', 2)
+                             .arg(section.polylines.size())
+                             .arg(section.length * 100.0, 0, 'f', 2);
+            }
+        }
+        if (count > kMaxRows) table += QString("……另有 %1 个\n").arg(count - kMaxRows);
+        openGLWidget_->setSectionOverlay(std::move(lines), {});
+        QMessageBox::information(this, "批量切片",
+                                 QString("%1 个剖切面（并行计算，耗时 %2 ms）\n\n%3").arg(count).arg(elapsed).arg(table));
+        return;
+    }
+    
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(model);
+    if (!cloud) return;
+    const float halfThickness = static_cast<float>(sectionThicknessSpinBox_->value() / 200.0);
+    const std::vector<uint32_t> labels =
+        ModelAnalyzer::computePointSlabLabels(cloud, normal, first, last, count, halfThickness);
+    const qint64 elapsed = timer.elapsed();
+    const QStringList actions = { "标记切片（属性通道，伪彩色显示）", "拆分为独立点云" };
+    const QString action = QInputDialog::getItem(this, "批量切片",
+                                                 QString("%1 个薄片，厚度 %2 cm（耗时 %3 ms）\n操作:")
+                                                     .arg(count)
+                                                     .arg(sectionThicknessSpinBox_->value())
+                                                     .arg(elapsed),
+                                                 actions, 0, false, &ok);
+    if (!ok) return;
+    if (action == actions[0]) {
+        AttributeChannel* channel = cloud->addAttribute("切片", AttributeChannel::Int32);
+        int32_t* values = channel->values<int32_t>();
+        for (size_t i = 0; i < labels.size(); ++i) {
+            values[i] = labels[i] == ModelAnalyzer::kNoComponent ? -1 : static_cast<int32_t>(labels[i]);
+        }
+        cloud->setActiveAttribute("切片");
+        updateAttributeList();
+        coordinateSlider_->setValue(OpenGLWidget::kAttributeAxis);
+        openGLWidget_->update();
+        return;
+    }
+    std::vector<std::shared_ptr<PointCloud>> parts = cloud->splitByLabels(labels, static_cast<size_t>(count));
+    size_t added = 0;
+    for (size_t k = 0; k < parts.size(); ++k) {
+        if (parts[k]->getPointCount() == 0) continue;
+        parts[k]->setName(QString("%1_slice%2").arg(cloud->getName()).arg(k + 1));
+        models_.push_back(parts[k]);
+        openGLWidget_->addModel(parts[k]);
+        ++added;
+    }
+    updateModelList();
+    QMessageBox::information(this, "拆分完成", QString("已生成 %1 个点云模型（原模型保留，空薄片跳过）").arg(added));
+}
+
+QString MainWindow::formatComponentStats(const std::vector<ModelAnalyzer::ComponentStats>& components,
+                                         const QString& elementName, size_t maxRows) {
+    // 长度显示为厘米、面积为 cm^2
+    QString text;
+    for (size_t c = 0; c < components.size() && c < maxRows; ++c) {
+        const ModelAnalyzer::ComponentStats& stats = components[c];
+        const QVector3D sizeCm = stats.bounds.size() * 100.0f;
+        text += QString("#%1: %2 %3, 顶点 %4, 尺寸 %5 x %6 x %7 cm")
+                    .arg(c + 1)
+                    .arg(stats.elementCount)
+                    .arg(elementName)
+                    .arg(stats.vertexCount)
+                    .arg(sizeCm.x(), 0, 'f', 2)
+                    .arg(sizeCm.y(), 0, 'f', 2)
+                    .arg(sizeCm.z(), 0, 'f', 2);
+        if (stats.area > 0.0) text += QString(", 面积 %1 cm^2").arg(stats.area * 1e4, 0, 'f', 2);
+        const QVector3D centroidCm = stats.centroid * 100.0f;
+        text += QString(", 中心 (%1, %2, %3) cm")
+                    .arg(centroidCm.x(), 0, 'f', 2)
+                    .arg(centroidCm.y(), 0, 'f', 2)
+                    .arg(centroidCm.z(), 0, 'f', 2);
+        text += "\n";
+    }
+    if (components.size() > maxRows) text += QString("……另有 %1 个\n").arg(components.size() - maxRows);
+    return text;
+}
+
+QString MainWindow::formatDistanceStats(const ModelAnalyzer::DistanceStats& stats) {
+    // 统计值内部为米，显示为厘米
+    return QString("点数: %1\n平均偏差: %2 cm\n平均绝对偏差: %3 cm\nRMS: %4 cm\n"
+                   "最小/最大: %5 / %6 cm\n绝对偏差 P50 / P90 / P95 / P99: %7 / %8 / %9 / %10 cm\n")
+        .arg(stats.count)
+        .arg(stats.mean * 100.0f, 0, 'f', 4)
+        .arg(stats.meanAbs * 100.0f, 0, 'f', 4)
+        .arg(stats.rms * 100.0f, 0, 'f', 4)
+        .arg(stats.minValue * 100.0f, 0, 'f', 4)
+        .arg(stats.maxValue * 100.0f, 0, 'f', 4)
+        .arg(stats.p50 * 100.0f, 0, 'f', 4)
+        .arg(stats.p90 * 100.0f, 0, 'f', 4)
+        .arg(stats.p95 * 100.0f, 0, 'f', 4)
+        .arg(stats.p99 * 100.0f, 0, 'f', 4);
+}
+
+void MainWindow::onSelectionToolChanged(int tool) {
+    // 两个工具互斥；再次点击已选中的工具即关闭选择、恢复鼠标旋转
+    QAction* action = tool == OpenGLWidget::RectangleSelection ? rectSelectAction_ : lassoSelectAction_;
+    QAction* other = tool == OpenGLWidget::RectangleSelection ? lassoSelectAction_ : rectSelectAction_;
+    const bool enabled = action->isChecked();
+    other->setChecked(false);
+    openGLWidget_->setSelectionTool(enabled ? static_cast<OpenGLWidget::SelectionTool>(tool)
+                                            : OpenGLWidget::NoSelectionTool);
+    statusBar()->showMessage(enabled ? "左键拖动选择；Shift 并入已有选择，Ctrl 从选择中去除" : "已退出选择模式");
+}
+
+void MainWindow::onSelectionChanged() {
+    size_t total = 0;
+    size_t selectedModels = 0;
+    for (const auto& model : models_) {
+        if (!model->hasSelection()) continue;
+        total += model->getSelectedCount();
+        ++selectedModels;
+    }
+    statusBar()->showMessage(QString("已选择 %1 个点（%2 个模型）").arg(total).arg(selectedModels));
+}
+
+void MainWindow::onClearSelection() {
+    for (const auto& model : models_) model->clearSelection();
+    openGLWidget_->update();
+    onSelectionChanged();
+}
+
+void MainWindow::onInvertSelection() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    models_[currentModelIndex_]->selection().invert();
+    openGLWidget_->update();
+    onSelectionChanged();
+}
+
+std::shared_ptr<Model> MainWindow::modelWithSelection() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return nullptr;
+    }
+    auto model = models_[currentModelIndex_];
+    if (!model->hasSelection()) {
+        QMessageBox::information(this, "提示", "当前模型没有选中的点，请先用框选或套索选择");
+        return nullptr;
+    }
+    return model;
+}
+
+void MainWindow::onDeleteSelected() {
+    auto model = modelWithSelection();
+    if (!model) return;
+    auto cloud = std::dynamic_pointer_cast<PointCloud>(model);
+    if (!cloud) {
+        QMessageBox::warning(this, "警告", "删除选中点只适用于点云；网格可用“隐藏选中点”或“裁剪为新模型”");
+        return;
+    }
+    if (cloud->isPaged() || cloud->isCompact()) {
+        QMessageBox::warning(this, "警告", "外存/紧凑点云的选择只作用于内存中的预览点，不能删除；可用“隐藏选中点”或“裁剪为新模型”");
+        return;
+    }
+    const size_t before = cloud->getVertexCount();
+    cloud->removePoints(cloud->getSelection());
+    cloud->clearSelection();
+    updatePropertyPanel();
+    onSectionChanged();
+    openGLWidget_->update();
+    statusBar()->showMessage(QString("已删除 %1 个点，剩余 %2 个").arg(before - cloud->getVertexCount())
+                             .arg(cloud->getVertexCount()));
+}
+
+void MainWindow::onCropSelected() {
+    auto model = modelWithSelection();
+    if (!model) return;
+    auto part = model->extractVertices(model->getSelection(), QString("%1_选区").arg(model->getName()));
+    models_.push_back(part);
+    openGLWidget_->addModel(part);
+    updateModelList();
+    statusBar()->showMessage(QString("已将 %1 个选中点裁剪为新模型 %2").arg(part->getVertexCount()).arg(part->getName()));
+}
+
+void MainWindow::onExportSelected() {
+    auto model = modelWithSelection();
+    if (!model) return;
+    QString selectedFilter;
+    QString fileName = QFileDialog::getSaveFileName(this, "导出选中点", "", kExportFilters, &selectedFilter);
+    if (fileName.isEmpty()) return;
+    
+    // 选中点先拷贝为临时模型，再复用各格式的导出器
+    ExportOptions options;
+    options.binaryPly = selectedFilter == kBinaryPlyFilter;
+    auto part = model->extractVertices(model->getSelection(), model->getName());
+    if (FileImporter::exportFile(part, fileName, options)) {
+        QMessageBox::information(this, "导出成功",
+                                QString("%1 个选中点已导出到: %2").arg(part->getVertexCount()).arg(fileName));
+    } else {
+        QMessageBox::warning(this, "导出失败", "无法导出选中点到指定文件。");
+    }
+}
+
+void MainWindow::onHideSelected(bool keepSelected) {
+    auto model = modelWithSelection();
+    if (!model) return;
+    // 只改过滤图层，顶点数据不变；选择随之清除
+    BitMask& filter = model->mask(Model::FilterLayer);
+    if (keepSelected) {
+        BitMask unselected = model->getSelection();
+        unselected.invert();
+        filter.unite(unselected);
+    } else {
+        filter.unite(model->getSelection());
+    }
+    model->clearSelection();
+    onVisibilityChanged();
+}
+
+void MainWindow::onFilterByAttributeRange() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    auto model = models_[currentModelIndex_];
+    const AttributeChannel* channel = model->getActiveAttribute();
+    if (!channel) {
+        QMessageBox::information(this, "提示", "当前模型没有着色属性，请先在属性面板选择一个属性通道");
+        return;
+    }
+    double minValue = 0.0, maxValue = 0.0;
+    channel->displayRange(minValue, maxValue);
+    bool ok = false;
+    minValue = QInputDialog::getDouble(this, "按属性过滤", QString("“%1”保留的最小值:").arg(channel->name()),
+                                       minValue, -1e12, 1e12, 4, &ok);
+    if (!ok) return;
+    maxValue = QInputDialog::getDouble(this, "按属性过滤", QString("“%1”保留的最大值:").arg(channel->name()),
+                                       maxValue, minValue, 1e12, 4, &ok);
+    if (!ok) return;
+    // 重新设置过滤条件：以本次范围替换原过滤图层
+    ModelAnalyzer::markOutsideRange(*channel, minValue, maxValue, model->mask(Model::FilterLayer));
+    onVisibilityChanged();
+}
+
+void MainWindow::onClipBySection() {
+    QVector3D normal;
+    float minOffset, maxOffset;
+    if (!sectionGroup_->isChecked() || !sectionPlane(normal, minOffset, maxOffset)) {
+        QMessageBox::information(this, "提示", "请先在属性面板启用剖切并选择剖切位置");
+        return;
+    }
+    auto model = models_[currentModelIndex_];
+    const float offset = minOffset + (maxOffset - minOffset) * sectionSlider_->value() / sectionSlider_->maximum();
+    ModelAnalyzer::markAbovePlane(*model, normal, offset, model->mask(Model::ClipLayer));
+    onVisibilityChanged();
+}
+
+void MainWindow::onShowAll() {
+    for (const auto& model : models_) {
+        model->clearMask(Model::FilterLayer);
+        model->clearMask(Model::ClipLayer);
+    }
+    onVisibilityChanged();
+}
+
+void MainWindow::onCompactVisible() {
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) {
+        QMessageBox::warning(this, "警告", "请先选择一个模型");
+        return;
+    }
+    auto model = models_[currentModelIndex_];
+    if (!model->hasHiddenVertices()) {
+        QMessageBox::information(this, "提示", "当前模型没有被过滤或裁切的顶点");
+        return;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    auto part = model->compactVisible(QString("%1_可见").arg(model->getName()));
+    const qint64 elapsed = timer.elapsed();
+    models_.push_back(part);
+    openGLWidget_->addModel(part);
+    updateModelList();
+    statusBar()->showMessage(QString("已将 %1 / %2 个可见顶点压缩为新模型 %3（%4 ms）")
+                             .arg(part->getVertexCount()).arg(model->getVertexCount())
+                             .arg(part->getName()).arg(elapsed));
+}
+
+void MainWindow::onVisibilityChanged() {
+    updatePropertyPanel();
+    openGLWidget_->update();
+    if (currentModelIndex_ < 0 || currentModelIndex_ >= models_.size()) return;
+    auto model = models_[currentModelIndex_];
+    statusBar()->showMessage(QString("%1: 显示 %2 / %3 个顶点").arg(model->getName())
+                             .arg(model->getVisibleCount()).arg(model->getVertexCount()));
+}
+
+void MainWindow::onModelPicked(int modelIndex, int triangleIndex, int vertexIndex, const QVector3D& pointCm) {
+    if (modelIndex < 0 || modelIndex >= static_cast<int>(models_.size())) return;
+    if (modelIndex != currentModelIndex_) {
+        modelListWidget_->setCurrentRow(modelIndex);
+    }
+    statusBar()->showMessage(QString("拾取: %1  三角形 #%2  顶点 #%3  位置(cm): (%4, %5, %6)")
+                             .arg(models_[modelIndex]->getName())
+                             .arg(triangleIndex)
+                             .arg(vertexIndex)
+                             .arg(pointCm.x(), 0, 'f', 3)
+                             .arg(pointCm.y(), 0, 'f', 3)
+                             .arg(pointCm.z(), 0, 'f', 3));
+}
+
 void MainWindow::updateModelInfo() {
     if (currentModelIndex_ >= 0 && currentModelIndex_ < models_.size()) {
         auto model = models_[currentModelIndex_];
@@ -421,11 +1775,17 @@ void MainWindow::updatePropertyPanel() {
     if (currentModelIndex_ >= 0 && currentModelIndex_ < models_.size()) {
         auto model = models_[currentModelIndex_];
         
-        // 更新颜色
+        // 更新颜色（不触发信号：仅切换选中模型时不应设置覆盖色）
         QColor color = model->getColor();
+        colorSliderR_->blockSignals(true);
+        colorSliderG_->blockSignals(true);
+        colorSliderB_->blockSignals(true);
         colorSliderR_->setValue(color.red());
         colorSliderG_->setValue(color.green());
         colorSliderB_->setValue(color.blue());
+        colorSliderR_->blockSignals(false);
+        colorSliderG_->blockSignals(false);
+        colorSliderB_->blockSignals(false);
         
         // 更新位置
         QVector3D center = model->computeCenter();
@@ -450,6 +1810,8 @@ void MainWindow::updatePropertyPanel() {
             triangleCountLabel_->setText("三角形数: N/A");
         }
 
+        updateAttributeList();
+
         // 同步尺度显示（不触发信号）
         // 尺度控件逻辑废弃，不再更新
     } else {
@@ -461,10 +1823,26 @@ void MainWindow::updatePropertyPanel() {
     triangleCountLabel_->setText("三角形数: N/A");
         centerLabel_->setText("重心(cm): (0, 0, 0)");
         surfaceAreaLabel_->setText("表面积: 0.0 cm^2");
+        updateAttributeList();
         // 尺度控件逻辑废弃，不再更新
     }
 }
 
+void MainWindow::updateAttributeList() {
+    attributeCombo_->blockSignals(true);
+    attributeCombo_->clear();
+    if (currentModelIndex_ >= 0 && currentModelIndex_ < models_.size()) {
+        auto model = models_[currentModelIndex_];
+        for (const auto& channel : model->getAttributes()) {
+            attributeCombo_->addItem(QString("%1 (%2)").arg(channel.name()).arg(AttributeChannel::typeName(channel.type())),
+                                     channel.name());
+        }
+        attributeCombo_->setCurrentIndex(attributeCombo_->findData(model->getActiveAttributeName()));
+    }
+    attributeCombo_->setEnabled(attributeCombo_->count() > 0);
+    attributeCombo_->blockSignals(false);
+}
+
 void MainWindow::onTransformChanged() {
     // 变换改变的处理
     openGLWidget_->update();
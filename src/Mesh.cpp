@@ -1,6 +1,214 @@
 #include "Mesh.h"
+#include "BVH.h"
+#include "MeshTopology.h"
 #include <QDebug>
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include "Parallel.h"
+#include "OpenHashMap.h"
+
+namespace {
+
+struct CellKeyHash {
+    size_t operator()(uint64_t key) const { return static_cast<size_t>(hashMix64(key)); }
+};
+
+// 网格单元坐标 -> 64 位键（哈希混合，不同单元偶尔碰撞也无妨：之后仍做距离判断）
+inline uint64_t cellKey(int64_t x, int64_t y, int64_t z) {
+    uint64_t h = hashMix64(static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ULL);
+    h = hashMix64(h ^ (static_cast<uint64_t>(y) + 0x632BE59BD9B4E019ULL));
+    return hashMix64(h ^ (static_cast<uint64_t>(z) + 0x85157AF5ULL));
+}
+
+// 容差焊接的代表：每个顶点在邻域单元内找距离不超过 tolerance 的编号最小的顶点，再压缩代表链，
+// 返回的 rep[i] 为最终代表（rep[i] <= i，rep[rep[i]] == rep[i]）
+std::vector<uint32_t> toleranceRepresentatives(const std::vector<Vertex>& vertices, float tolerance) {
+    const size_t n = vertices.size();
+    
+    // 1. 并行计算包围盒
+    const size_t chunks = Parallel::chunkCount(n);
+    std::vector<AABB> chunkBoxes(chunks);
+    Parallel::forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) chunkBoxes[c].expand(vertices[i].position);
+    });
+    AABB box;
+    for (const auto& chunkBox : chunkBoxes) {
+        if (!chunkBox.isValid()) continue;
+        box.expand(chunkBox.min);
+        box.expand(chunkBox.max);
+    }
+    const QVector3D extent = box.size();
+    const float maxExtent = std::max(extent.x(), std::max(extent.y(), extent.z()));
+    
+    // 单元边长取容差的数倍：查询时只需访问距离不超过容差的相邻单元（平均约 2 个而非 27 个）；
+    // 同时限制单元数避免坐标溢出
+    const float tol = std::max(tolerance, 0.0f);
+    const float tol2 = tol * tol;
+    float cellSize = std::max(tol * 8.0f, maxExtent / static_cast<float>(1 << 30));
+    if (cellSize <= 0.0f) cellSize = 1.0f;
+    const float invCell = 1.0f / cellSize;
+    
+    // 2. 并行计算每个顶点的单元坐标与键
+    std::vector<int32_t> cellCoords(n * 3);
+    std::vector<uint64_t> keys(n);
+    std::vector<uint32_t> order(n);
+    Parallel::forEach(0, n, [&](size_t i) {
+        const QVector3D local = (vertices[i].position - box.min) * invCell;
+        int32_t cx = static_cast<int32_t>(std::floor(local.x()));
+        int32_t cy = static_cast<int32_t>(std::floor(local.y()));
+        int32_t cz = static_cast<int32_t>(std::floor(local.z()));
+        cellCoords[i * 3] = cx;
+        cellCoords[i * 3 + 1] = cy;
+        cellCoords[i * 3 + 2] = cz;
+        keys[i] = cellKey(cx, cy, cz);
+        order[i] = static_cast<uint32_t>(i);
+    });
+    
+    // 3. 按键基数排序，同一单元的顶点变为连续区间；再建立 键 -> 区间起点 的哈希表
+    Parallel::radixSortPairs(keys, order);
+    OpenHashMap<uint64_t, uint32_t, CellKeyHash> cellStart(n / 2);
+    for (size_t i = 0; i < n; ++i) {
+        if (i == 0 || keys[i] != keys[i - 1]) cellStart.insert(keys[i], static_cast<uint32_t>(i));
+    }
+    
+    // 4. 并行：每个顶点在邻域单元内寻找容差范围内编号最小的顶点作为代表（rep[i] <= i）
+    std::vector<uint32_t> rep(n);
+    const float border = tol * invCell;
+    Parallel::forEach(0, n, [&](size_t i) {
+        const QVector3D& p = vertices[i].position;
+        const QVector3D local = (p - box.min) * invCell;
+        // 每个轴上仅当点距单元边界不超过容差时才需要查看相邻单元
+        int lo[3], hi[3];
+        for (int a = 0; a < 3; ++a) {
+            const float frac = local[a] - static_cast<float>(cellCoords[i * 3 + a]);
+            lo[a] = frac <= border ? -1 : 0;
+            hi[a] = frac >= 1.0f - border ? 1 : 0;
+        }
+        uint32_t best = static_cast<uint32_t>(i);
+        for (int dz = lo[2]; dz <= hi[2]; ++dz)
+        for (int dy = lo[1]; dy <= hi[1]; ++dy)
+        for (int dx = lo[0]; dx <= hi[0]; ++dx) {
+            const uint64_t key = cellKey(cellCoords[i * 3] + dx, cellCoords[i * 3 + 1] + dy, cellCoords[i * 3 + 2] + dz);
+            const uint32_t* start = cellStart.find(key);
+            if (!start) continue;
+            for (size_t k = *start; k < n && keys[k] == key; ++k) {
+                const uint32_t j = order[k];
+                if (j >= best) continue;
+                if ((vertices[j].position - p).lengthSquared() <= tol2) best = j;
+            }
+        }
+        rep[i] = best;
+    }, 4096);
+    
+    // 5. 按编号升序压缩代表链（rep[i] <= i，前面的已是最终代表）
+    for (size_t i = 0; i < n; ++i) rep[i] = rep[rep[i]];
+    return rep;
+}
+
+inline uint32_t floatBits(float value) {
+    value += 0.0f;                      // -0 与 +0 视为同一坐标
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// 精确焊接时按哈希分桶的顶点（20 字节，不做初始化，由并行散列首次写入）
+struct ExactWeldEntry {
+    float position[3];
+    uint32_t vertex;
+    uint32_t hash;                      // 坐标哈希的低 32 位，用于桶内查重表
+};
+
+inline uint64_t positionHash(const float* p) {
+    const uint64_t h = hashMix64(floatBits(p[0]) * 0x9E3779B97F4A7C15ULL);
+    return hashMix64(h ^ (uint64_t(floatBits(p[1])) << 32 | floatBits(p[2])));
+}
+
+// 精确焊接的代表：坐标完全相同的顶点中编号最小者。不建网格，适合 STL 等三角形汤的千万级角点：
+// 1. 坐标位模式哈希，按哈希高位把（坐标, 顶点编号）稳定地分散到约 64K 个元素的桶中（一趟并行散列）；
+// 2. 各桶并行地在可放入缓存的局部开放寻址表中查重，桶内顶点按编号升序，先插入的即编号最小的相同顶点
+std::vector<uint32_t> exactRepresentatives(const std::vector<Vertex>& vertices) {
+    const size_t n = vertices.size();
+    const int bucketBits = std::max(1, std::min(16, Parallel::keyBitsFor(n / 65536)));
+    const size_t bucketCount = size_t(1) << bucketBits;
+    std::vector<uint64_t> hashes(n);
+    Parallel::forEach(0, n, [&](size_t i) {
+        const QVector3D& p = vertices[i].position;
+        const float xyz[3] = { p.x(), p.y(), p.z() };
+        hashes[i] = positionHash(xyz);
+    });
+
+    // 分块统计各桶数量 -> 前缀和得到每块在每个桶中的写入位置 -> 稳定散列
+    const size_t chunks = Parallel::chunkCount(n, 65536);
+    std::vector<size_t> offsets(chunks * bucketCount, 0);
+    Parallel::forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+        size_t* counts = &offsets[c * bucketCount];
+        for (size_t i = b; i < e; ++i) ++counts[hashes[i] >> (64 - bucketBits)];
+    });
+    std::vector<size_t> bucketBegin(bucketCount + 1, 0);
+    size_t total = 0;
+    for (size_t bucket = 0; bucket < bucketCount; ++bucket) {
+        bucketBegin[bucket] = total;
+        for (size_t c = 0; c < chunks; ++c) {
+            const size_t count = offsets[c * bucketCount + bucket];
+            offsets[c * bucketCount + bucket] = total;
+            total += count;
+        }
+    }
+    bucketBegin[bucketCount] = total;
+    std::unique_ptr<ExactWeldEntry[]> entries(new ExactWeldEntry[n]);
+    Parallel::forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+        size_t* cursor = &offsets[c * bucketCount];
+        for (size_t i = b; i < e; ++i) {
+            ExactWeldEntry& entry = entries[cursor[hashes[i] >> (64 - bucketBits)]++];
+            const QVector3D& p = vertices[i].position;
+            entry.position[0] = p.x();
+            entry.position[1] = p.y();
+            entry.position[2] = p.z();
+            entry.vertex = static_cast<uint32_t>(i);
+            entry.hash = static_cast<uint32_t>(hashes[i]);
+        }
+    });
+    hashes.clear();
+    hashes.shrink_to_fit();
+
+    // 各桶局部查重：表中存桶内位置 + 1（0 为空槽）
+    std::vector<uint32_t> rep(n);
+    Parallel::forRange(0, bucketCount, [&](size_t first, size_t last) {
+        std::vector<uint32_t> table;
+        for (size_t bucket = first; bucket < last; ++bucket) {
+            const size_t begin = bucketBegin[bucket];
+            const size_t count = bucketBegin[bucket + 1] - begin;
+            size_t capacity = 16;
+            while (capacity < count * 2) capacity <<= 1;
+            table.assign(capacity, 0);
+            const size_t mask = capacity - 1;
+            const ExactWeldEntry* bucketEntries = &entries[begin];
+            for (size_t i = 0; i < count; ++i) {
+                const ExactWeldEntry& entry = bucketEntries[i];
+                size_t slot = entry.hash & mask;
+                uint32_t representative = entry.vertex;
+                while (table[slot] != 0) {
+                    const ExactWeldEntry& other = bucketEntries[table[slot] - 1];
+                    if (other.hash == entry.hash && other.position[0] == entry.position[0] && other.position[1] == entry.position[1] &&
+                        other.position[2] == entry.position[2]) {
+                        representative = other.vertex;
+                        break;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+                if (table[slot] == 0) table[slot] = static_cast<uint32_t>(i + 1);
+                rep[entry.vertex] = representative;
+            }
+        }
+    }, 1);
+    return rep;
+}
+
+} // namespace
 
 int Mesh::meshCount_ = 0;
 
@@ -14,17 +222,334 @@ Mesh::~Mesh() {
 
 void Mesh::addVertex(const QVector3D& vertex, const QVector3D& normal, const QColor& color) {
     vertices_.emplace_back(vertex, normal, color);
+    if (!texCoords_.empty()) texCoords_.emplace_back(0.0f, 0.0f);
+    if (!attributes_.empty()) syncAttributeSizes();
+    markTopologyDirty();
 }
 
 void Mesh::addTriangle(unsigned int i1, unsigned int i2, unsigned int i3) {
     triangles_.push_back(i1);
     triangles_.push_back(i2);
     triangles_.push_back(i3);
+    markTopologyDirty();
 }
 
 void Mesh::clear() {
     vertices_.clear();
+    clearAttributes();
     triangles_.clear();
+    texCoords_.clear();
+    markTopologyDirty();
+}
+
+void Mesh::setGeometry(std::vector<Vertex>&& vertices,
+                       std::vector<unsigned int>&& triangles,
+                       std::vector<QVector2D>&& texCoords) {
+    vertices_ = std::move(vertices);
+    triangles_ = std::move(triangles);
+    texCoords_ = std::move(texCoords);
+    // 属性通道只保留与新顶点数一致的（调用方可先用 remapAttributes 对齐）
+    dropMismatchedAttributes();
+    if (!texCoords_.empty() && texCoords_.size() != vertices_.size()) {
+        qDebug() << "纹理坐标数量与顶点数不一致，已忽略纹理坐标";
+        texCoords_.clear();
+    }
+    markTopologyDirty();
+}
+
+void Mesh::setTriangles(std::vector<unsigned int>&& triangles) {
+    triangles_ = std::move(triangles);
+    markTopologyDirty();
+}
+
+const MeshTopology& Mesh::getTopology() const {
+    if (!topology_) {
+        auto topology = std::make_shared<MeshTopology>();
+        topology->build(vertices_.size(), triangles_);
+        topology_ = topology;
+    }
+    return *topology_;
+}
+
+const BVH& Mesh::getBVH() const {
+    if (!bvh_) {
+        auto bvh = std::make_shared<BVH>();
+        bvh->build(vertices_, triangles_);
+        bvh_ = bvh;
+    }
+    return *bvh_;
+}
+
+void Mesh::translate(const QVector3D& offset) {
+    Model::translate(offset);
+    markDirty();
+}
+
+void Mesh::translateTo(const QVector3D& position) {
+    Model::translateTo(position);
+    markDirty();
+}
+
+void Mesh::scale(const QVector3D& factors) {
+    Model::scale(factors);
+    markDirty();
+}
+
+void Mesh::applyTransform(const QMatrix4x4& matrix) {
+    Model::applyTransform(matrix);
+    markDirty();
+}
+
+void Mesh::markDirty() const {
+    bvh_.reset();
+}
+
+void Mesh::markTopologyDirty() const {
+    topology_.reset();
+    markDirty();
+}
+
+Mesh::WeldStats Mesh::weldVertices(float tolerance) {
+    WeldStats stats;
+    const size_t n = vertices_.size();
+    if (n == 0) return stats;
+    markTopologyDirty();
+    
+    // 1. 每个顶点的最终代表（编号最小的重合顶点）
+    const std::vector<uint32_t> rep = tolerance > 0.0f ? toleranceRepresentatives(vertices_, tolerance)
+                                                       : exactRepresentatives(vertices_);
+    
+    // 2. 代表按编号顺序分配新编号：分块计数 -> 前缀和 -> 写回，被合并的顶点取其代表的新编号
+    std::vector<uint32_t> newIndex(n);
+    const size_t chunks = Parallel::chunkCount(n);
+    std::vector<size_t> chunkKept(chunks + 1, 0);
+    Parallel::forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+        size_t count = 0;
+        for (size_t i = b; i < e; ++i) count += rep[i] == i;
+        chunkKept[c + 1] = count;
+    });
+    for (size_t c = 0; c < chunks; ++c) chunkKept[c + 1] += chunkKept[c];
+    Parallel::forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+        uint32_t next = static_cast<uint32_t>(chunkKept[c]);
+        for (size_t i = b; i < e; ++i) {
+            if (rep[i] == i) newIndex[i] = next++;
+        }
+    });
+    Parallel::forEach(0, n, [&](size_t i) {
+        if (rep[i] != i) newIndex[i] = newIndex[rep[i]];
+    });
+    const size_t kept = chunkKept[chunks];
+    stats.mergedVertices = n - kept;
+    
+    // 3. 收集保留的顶点
+    if (kept < n) {
+        std::vector<Vertex> newVertices(kept);
+        std::vector<QVector2D> newTexCoords(texCoords_.empty() ? 0 : kept);
+        std::vector<uint32_t> newToOld(kept);
+        Parallel::forEach(0, n, [&](size_t i) {
+            if (rep[i] != i) return;
+            newVertices[newIndex[i]] = vertices_[i];
+            if (!texCoords_.empty()) newTexCoords[newIndex[i]] = texCoords_[i];
+            newToOld[newIndex[i]] = static_cast<uint32_t>(i);
+        });
+        vertices_.swap(newVertices);
+        texCoords_.swap(newTexCoords);
+        remapAttributes(newToOld);
+    }
+    
+    // 4. 并行重映射三角形并删除退化面与含越界索引的面（压缩后越界索引可能落入新编号范围，
+    //    指向无关顶点）：先按块统计保留数，再按前缀和写回。越界的面写成 (0,0,0)，随退化面一起删除
+    const size_t triCount = triangles_.size() / 3;
+    const size_t triChunks = Parallel::chunkCount(triCount);
+    std::vector<size_t> keptPerChunk(triChunks + 1, 0);
+    Parallel::forChunks(triCount, triChunks, [&](size_t c, size_t b, size_t e) {
+        size_t count = 0;
+        for (size_t t = b; t < e; ++t) {
+            unsigned int* tri = &triangles_[t * 3];
+            if (tri[0] >= n || tri[1] >= n || tri[2] >= n) {
+                tri[0] = tri[1] = tri[2] = 0;
+                continue;
+            }
+            for (int k = 0; k < 3; ++k) tri[k] = newIndex[tri[k]];
+            if (tri[0] != tri[1] && tri[1] != tri[2] && tri[0] != tri[2]) ++count;
+        }
+        keptPerChunk[c + 1] = count;
+    });
+    for (size_t c = 0; c < triChunks; ++c) keptPerChunk[c + 1] += keptPerChunk[c];
+    std::vector<unsigned int> newTriangles(keptPerChunk[triChunks] * 3);
+    Parallel::forChunks(triCount, triChunks, [&](size_t c, size_t b, size_t e) {
+        size_t dst = keptPerChunk[c] * 3;
+        for (size_t t = b; t < e; ++t) {
+            const unsigned int* tri = &triangles_[t * 3];
+            if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2]) continue;
+            newTriangles[dst++] = tri[0];
+            newTriangles[dst++] = tri[1];
+            newTriangles[dst++] = tri[2];
+        }
+    });
+    stats.removedTriangles = triCount - keptPerChunk[triChunks];
+    triangles_.swap(newTriangles);
+    return stats;
+}
+
+void Mesh::computeVertexNormals() {
+    const size_t n = vertices_.size();
+    const size_t triCount = triangles_.size() / 3;
+    // 面法线（叉积，长度为面积的 2 倍）按三角形并行计算，再依次累加到三个顶点
+    std::vector<QVector3D> faceNormals(triCount);
+    Parallel::forEach(0, triCount, [&](size_t t) {
+        const unsigned int* tri = &triangles_[t * 3];
+        if (tri[0] >= n || tri[1] >= n || tri[2] >= n) return;
+        const QVector3D& a = vertices_[tri[0]].position;
+        faceNormals[t] = QVector3D::crossProduct(vertices_[tri[1]].position - a, vertices_[tri[2]].position - a);
+    });
+    std::vector<QVector3D> sums(n, QVector3D(0, 0, 0));
+    for (size_t t = 0; t < triCount; ++t) {
+        const unsigned int* tri = &triangles_[t * 3];
+        if (tri[0] >= n || tri[1] >= n || tri[2] >= n) continue;
+        for (int k = 0; k < 3; ++k) sums[tri[k]] += faceNormals[t];
+    }
+    Parallel::forEach(0, n, [&](size_t i) {
+        vertices_[i].normal = sums[i].lengthSquared() > 0.0f ? sums[i].normalized() : QVector3D(0, 0, 1);
+    });
+}
+
+void Mesh::permuteVertices(const std::vector<uint32_t>& oldToNew) {
+    const size_t n = vertices_.size();
+    if (oldToNew.size() != n) return;
+    
+    std::vector<Vertex> newVertices(n);
+    std::vector<QVector2D> newTexCoords(texCoords_.size());
+    std::vector<uint32_t> newToOld(n);
+    Parallel::forEach(0, n, [&](size_t i) {
+        newVertices[oldToNew[i]] = vertices_[i];
+        if (!texCoords_.empty()) newTexCoords[oldToNew[i]] = texCoords_[i];
+        newToOld[oldToNew[i]] = static_cast<uint32_t>(i);
+    });
+    vertices_.swap(newVertices);
+    texCoords_.swap(newTexCoords);
+    remapAttributes(newToOld);
+    
+    Parallel::forEach(0, triangles_.size(), [&](size_t i) {
+        if (triangles_[i] < n) triangles_[i] = oldToNew[triangles_[i]];
+    });
+    markTopologyDirty();
+}
+
+std::vector<std::shared_ptr<Mesh>> Mesh::splitByFaceLabels(const std::vector<uint32_t>& faceLabels,
+                                                         size_t labelCount) const {
+    std::vector<std::shared_ptr<Mesh>> parts;
+    const size_t triCount = triangles_.size() / 3;
+    if (faceLabels.size() != triCount || labelCount == 0) return parts;
+    
+    // 计数排序：按标签把三角形分桶
+    std::vector<size_t> offsets(labelCount + 1, 0);
+    for (size_t t = 0; t < triCount; ++t) {
+        if (faceLabels[t] < labelCount) ++offsets[faceLabels[t] + 1];
+    }
+    for (size_t c = 0; c < labelCount; ++c) offsets[c + 1] += offsets[c];
+    std::vector<uint32_t> faceOrder(offsets[labelCount]);
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triCount; ++t) {
+        if (faceLabels[t] < labelCount) faceOrder[cursor[faceLabels[t]]++] = static_cast<uint32_t>(t);
+    }
+    
+    // 模型构造会修改静态计数器，须在串行部分创建
+    parts.reserve(labelCount);
+    for (size_t c = 0; c < labelCount; ++c) {
+        parts.push_back(std::make_shared<Mesh>(QString("%1_%2").arg(name_).arg(c + 1)));
+    }
+    
+    // 各部分互不相关，按部分并行：收集并排序引用到的顶点，作为新编号 -> 旧编号
+    Parallel::forEach(0, labelCount, [&](size_t c) {
+        const size_t begin = offsets[c], end = offsets[c + 1];
+        if (begin == end) return;
+        std::vector<uint32_t> newToOld;
+        newToOld.reserve((end - begin) * 3);
+        for (size_t k = begin; k < end; ++k) {
+            const unsigned int* tri = &triangles_[faceOrder[k] * 3];
+            newToOld.insert(newToOld.end(), tri, tri + 3);
+        }
+        std::sort(newToOld.begin(), newToOld.end());
+        newToOld.erase(std::unique(newToOld.begin(), newToOld.end()), newToOld.end());
+        while (!newToOld.empty() && newToOld.back() >= vertices_.size()) newToOld.pop_back();
+        
+        std::vector<unsigned int> triangles;
+        triangles.reserve((end - begin) * 3);
+        for (size_t k = begin; k < end; ++k) {
+            const unsigned int* tri = &triangles_[faceOrder[k] * 3];
+            if (tri[0] >= vertices_.size() || tri[1] >= vertices_.size() || tri[2] >= vertices_.size()) continue;
+            for (int j = 0; j < 3; ++j) {
+                triangles.push_back(static_cast<unsigned int>(
+                    std::lower_bound(newToOld.begin(), newToOld.end(), tri[j]) - newToOld.begin()));
+            }
+        }
+        std::vector<Vertex> vertices(newToOld.size());
+        std::vector<QVector2D> texCoords(texCoords_.empty() ? 0 : newToOld.size());
+        for (size_t i = 0; i < newToOld.size(); ++i) {
+            vertices[i] = vertices_[newToOld[i]];
+            if (!texCoords.empty()) texCoords[i] = texCoords_[newToOld[i]];
+        }
+        
+        Mesh& part = *parts[c];
+        part.setGeometry(std::move(vertices), std::move(triangles), std::move(texCoords));
+        part.color_ = color_;
+        part.colorOverride_ = colorOverride_;
+        for (const auto& channel : attributes_) {
+            part.addAttribute(channel.gathered(newToOld));
+        }
+        part.activeAttribute_ = activeAttribute_;
+    }, 1);
+    return parts;
+}
+
+std::shared_ptr<Model> Mesh::extractVertices(const BitMask& keep, const QString& name) const {
+    // 模型构造会修改静态计数器，在调用线程创建
+    auto part = std::make_shared<Mesh>(name);
+    if (keep.size() != vertices_.size()) return part;
+    const std::vector<uint32_t> newToOld = keep.indices(true);
+    const uint32_t kDropped = 0xffffffffu;
+    std::vector<uint32_t> oldToNew(vertices_.size(), kDropped);
+    std::vector<Vertex> vertices(newToOld.size());
+    std::vector<QVector2D> texCoords(texCoords_.empty() ? 0 : newToOld.size());
+    Parallel::forEach(0, newToOld.size(), [&](size_t i) {
+        oldToNew[newToOld[i]] = static_cast<uint32_t>(i);
+        vertices[i] = vertices_[newToOld[i]];
+        if (!texCoords.empty()) texCoords[i] = texCoords_[newToOld[i]];
+    });
+    
+    // 三角形分块：先统计各块保留数，前缀和后按原顺序写出
+    const size_t triCount = triangles_.size() / 3;
+    const size_t chunks = Parallel::chunkCount(triCount, 4096);
+    std::vector<size_t> offsets(chunks + 1, 0);
+    auto kept = [&](size_t t) {
+        const unsigned int* tri = &triangles_[t * 3];
+        return tri[0] < oldToNew.size() && tri[1] < oldToNew.size() && tri[2] < oldToNew.size() &&
+               oldToNew[tri[0]] != kDropped && oldToNew[tri[1]] != kDropped && oldToNew[tri[2]] != kDropped;
+    };
+    Parallel::forChunks(triCount, chunks, [&](size_t c, size_t b, size_t e) {
+        size_t count = 0;
+        for (size_t t = b; t < e; ++t) count += kept(t);
+        offsets[c + 1] = count;
+    });
+    for (size_t c = 0; c < chunks; ++c) offsets[c + 1] += offsets[c];
+    std::vector<unsigned int> triangles(offsets[chunks] * 3);
+    Parallel::forChunks(triCount, chunks, [&](size_t c, size_t b, size_t e) {
+        size_t out = offsets[c] * 3;
+        for (size_t t = b; t < e; ++t) {
+            if (!kept(t)) continue;
+            for (int j = 0; j < 3; ++j) triangles[out++] = oldToNew[triangles_[t * 3 + j]];
+        }
+    });
+    
+    part->setGeometry(std::move(vertices), std::move(triangles), std::move(texCoords));
+    part->color_ = color_;
+    part->colorOverride_ = colorOverride_;
+    for (const auto& channel : attributes_) {
+        part->addAttribute(channel.gathered(newToOld));
+    }
+    part->activeAttribute_ = activeAttribute_;
+    return part;
 }
 
 float Mesh::computeSurfaceArea() const {
@@ -0,0 +1,214 @@
+#include "MeshOptimizer.h"
+#include "Mesh.h"
+#include <QElapsedTimer>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+// Forsyth 线性速度顶点缓存优化的评分参数
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriangleScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+
+// 预先计算的分数表（按模拟的缓存容量），避免循环内 pow 调用
+struct ScoreTable {
+    float cache[MeshOptimizer::kMaxCacheSize];
+    float valence[64];
+    explicit ScoreTable(int cacheSize) {
+        for (int i = 0; i < cacheSize; ++i) {
+            if (i < 3) {
+                cache[i] = kLastTriangleScore;
+            } else {
+                const float scaler = 1.0f / (cacheSize - 3);
+                cache[i] = std::pow(1.0f - (i - 3) * scaler, kCacheDecayPower);
+            }
+        }
+        valence[0] = 0.0f;
+        for (int i = 1; i < 64; ++i) {
+            valence[i] = kValenceBoostScale * std::pow(static_cast<float>(i), -kValenceBoostPower);
+        }
+    }
+};
+
+inline float vertexScore(const ScoreTable& table, int cachePosition, uint32_t remainingTriangles) {
+    if (remainingTriangles == 0) return -1.0f;
+    float score = cachePosition >= 0 ? table.cache[cachePosition] : 0.0f;
+    score += remainingTriangles < 64 ? table.valence[remainingTriangles]
+                                     : kValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -kValenceBoostPower);
+    return score;
+}
+
+} // namespace
+
+float MeshOptimizer::computeACMR(const std::vector<unsigned int>& triangles, size_t vertexCount,
+                                 unsigned int cacheSize) {
+    const size_t triangleCount = triangles.size() / 3;
+    if (triangleCount == 0) return 0.0f;
+    
+    // FIFO 缓存：记录每个顶点进入缓存时的时间戳，时间差超过容量即视为已被挤出
+    std::vector<size_t> insertedAt(vertexCount, 0);
+    size_t timestamp = cacheSize + 1;
+    size_t misses = 0;
+    for (unsigned int index : triangles) {
+        if (index >= vertexCount) continue;
+        if (timestamp - insertedAt[index] > cacheSize) {
+            insertedAt[index] = timestamp++;
+            ++misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(triangleCount);
+}
+
+unsigned int MeshOptimizer::clampCacheSize(unsigned int cacheSize) {
+    return std::clamp(cacheSize, kMinCacheSize, kMaxCacheSize);
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<unsigned int>& triangles, size_t vertexCount,
+                                        unsigned int cacheSize) {
+    const size_t triangleCount = triangles.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0) return;
+    for (unsigned int index : triangles) {
+        if (index >= vertexCount) return; // 含越界索引时保持原样
+    }
+    const int capacity = static_cast<int>(clampCacheSize(cacheSize));
+    const ScoreTable table(capacity);
+    
+    // 顶点 -> 三角形邻接（CSR），remaining 为尚未输出的三角形数
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (unsigned int index : triangles) ++remaining[index];
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] = offsets[v] + remaining[v];
+    std::vector<uint32_t> adjacency(triangles.size());
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) adjacency[fill[triangles[t * 3 + k]]++] = static_cast<uint32_t>(t);
+        }
+    }
+    
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) vScore[v] = vertexScore(table, -1, remaining[v]);
+    
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    int bestTriangle = -1;
+    float bestScore = -1.0f;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const float score = vScore[triangles[t * 3]] + vScore[triangles[t * 3 + 1]] + vScore[triangles[t * 3 + 2]];
+        if (score > bestScore) {
+            bestScore = score;
+            bestTriangle = static_cast<int>(t);
+        }
+    }
+    
+    std::vector<unsigned int> output;
+    output.reserve(triangles.size());
+    std::vector<uint32_t> cache, newCache;
+    cache.reserve(capacity + 3);
+    newCache.reserve(capacity + 3);
+    size_t scanCursor = 0; // 缓存中无候选时，从此处顺序寻找下一个未输出的三角形
+    
+    while (output.size() < triangles.size()) {
+        if (bestTriangle < 0) {
+            while (scanCursor < triangleCount && emitted[scanCursor]) ++scanCursor;
+            if (scanCursor >= triangleCount) break;
+            bestTriangle = static_cast<int>(scanCursor);
+        }
+        
+        // 输出三角形，并从其顶点的剩余邻接中移除
+        const uint32_t t = static_cast<uint32_t>(bestTriangle);
+        emitted[t] = 1;
+        const unsigned int* tri = &triangles[t * 3];
+        newCache.clear();
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t v = tri[k];
+            output.push_back(v);
+            newCache.push_back(v);
+            uint32_t* begin = &adjacency[offsets[v]];
+            uint32_t* end = begin + remaining[v];
+            uint32_t* found = std::find(begin, end, t);
+            if (found != end) {
+                std::swap(*found, *(end - 1));
+                --remaining[v];
+            }
+        }
+        
+        // 新缓存 = 刚输出的三个顶点 + 旧缓存中的其他顶点（LRU）
+        for (uint32_t v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2]) newCache.push_back(v);
+        }
+        for (size_t i = capacity; i < newCache.size(); ++i) {
+            const uint32_t v = newCache[i];
+            cachePosition[v] = -1;
+            vScore[v] = vertexScore(table, -1, remaining[v]);
+        }
+        if (newCache.size() > static_cast<size_t>(capacity)) newCache.resize(capacity);
+        cache.swap(newCache);
+        
+        for (size_t i = 0; i < cache.size(); ++i) {
+            const uint32_t v = cache[i];
+            cachePosition[v] = static_cast<int>(i);
+            vScore[v] = vertexScore(table, static_cast<int>(i), remaining[v]);
+        }
+        
+        // 只需重新评估缓存中顶点相邻的三角形
+        bestTriangle = -1;
+        bestScore = -1.0f;
+        for (uint32_t v : cache) {
+            for (uint32_t i = offsets[v], e = offsets[v] + remaining[v]; i < e; ++i) {
+                const uint32_t candidate = adjacency[i];
+                const unsigned int* c = &triangles[candidate * 3];
+                const float score = vScore[c[0]] + vScore[c[1]] + vScore[c[2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestTriangle = static_cast<int>(candidate);
+                }
+            }
+        }
+    }
+    
+    triangles.swap(output);
+}
+
+std::vector<uint32_t> MeshOptimizer::computeVertexFetchRemap(const std::vector<unsigned int>& triangles,
+                                                             size_t vertexCount) {
+    const uint32_t kUnassigned = 0xffffffffu;
+    std::vector<uint32_t> remap(vertexCount, kUnassigned);
+    uint32_t next = 0;
+    for (unsigned int index : triangles) {
+        if (index < vertexCount && remap[index] == kUnassigned) remap[index] = next++;
+    }
+    for (size_t v = 0; v < vertexCount; ++v) {
+        if (remap[v] == kUnassigned) remap[v] = next++;
+    }
+    return remap;
+}
+
+MeshOptimizer::Report MeshOptimizer::optimize(Mesh& mesh, unsigned int cacheSize) {
+    Report report;
+    QElapsedTimer timer;
+    timer.start();
+    
+    // 重排与 ACMR 统计使用同一（限幅后的）缓存容量
+    cacheSize = clampCacheSize(cacheSize);
+    const size_t vertexCount = mesh.getVertexCount();
+    std::vector<unsigned int> triangles = mesh.getTriangles();
+    report.triangleCount = triangles.size() / 3;
+    report.acmrBefore = computeACMR(triangles, vertexCount, cacheSize);
+    
+    optimizeVertexCache(triangles, vertexCount, cacheSize);
+    report.acmrAfter = computeACMR(triangles, vertexCount, cacheSize);
+    
+    // 仅当确实改善时才采用新的三角形顺序
+    if (report.acmrAfter < report.acmrBefore) {
+        mesh.setTriangles(std::move(triangles));
+    } else {
+        report.acmrAfter = report.acmrBefore;
+    }
+    
+    mesh.permuteVertices(computeVertexFetchRemap(mesh.getTriangles(), vertexCount));
+    report.elapsedMs = timer.elapsed();
+    return report;
+}
@@ -0,0 +1,528 @@
+#include "MeshSimplifier.h"
+#include "Mesh.h"
+#include "Parallel.h"
+#include "OpenHashMap.h"
+#include <queue>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// 平面二次型：Q(p) = (n·p + d)^2 的对称矩阵上三角系数
+struct Quadric {
+    double a2 = 0, ab = 0, ac = 0, ad = 0;
+    double b2 = 0, bc = 0, bd = 0;
+    double c2 = 0, cd = 0;
+    double d2 = 0;
+
+    static Quadric fromPlane(double a, double b, double c, double d) {
+        Quadric q;
+        q.a2 = a * a; q.ab = a * b; q.ac = a * c; q.ad = a * d;
+        q.b2 = b * b; q.bc = b * c; q.bd = b * d;
+        q.c2 = c * c; q.cd = c * d;
+        q.d2 = d * d;
+        return q;
+    }
+
+    Quadric& operator+=(const Quadric& o) {
+        a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+        b2 += o.b2; bc += o.bc; bd += o.bd;
+        c2 += o.c2; cd += o.cd;
+        d2 += o.d2;
+        return *this;
+    }
+
+    double evaluate(const QVector3D& p) const {
+        const double x = p.x(), y = p.y(), z = p.z();
+        return a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+             + b2 * y * y + 2 * bc * y * z + 2 * bd * y
+             + c2 * z * z + 2 * cd * z + d2;
+    }
+
+    // 求使误差最小的位置；矩阵接近奇异时返回 false
+    bool optimize(QVector3D& out) const {
+        const double det = a2 * (b2 * c2 - bc * bc) - ab * (ab * c2 - bc * ac) + ac * (ab * bc - b2 * ac);
+        const double scale = a2 * a2 + b2 * b2 + c2 * c2;
+        if (std::fabs(det) <= 1e-12 * scale * std::sqrt(scale) || scale == 0.0) return false;
+        const double inv = 1.0 / det;
+        const double x = -inv * (ad * (b2 * c2 - bc * bc) - ab * (bd * c2 - bc * cd) + ac * (bd * bc - b2 * cd));
+        const double y = -inv * (a2 * (bd * c2 - cd * bc) - ad * (ab * c2 - bc * ac) + ac * (ab * cd - bd * ac));
+        const double z = -inv * (a2 * (b2 * cd - bc * bd) - ab * (ab * cd - bd * ac) + ad * (ab * bc - b2 * ac));
+        out = QVector3D(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+        return std::isfinite(x) && std::isfinite(y) && std::isfinite(z);
+    }
+};
+
+// 堆中的候选折叠：把 from 并入 to，to 移动到 target
+struct Collapse {
+    double cost;
+    uint32_t from, to;
+    uint32_t versionFrom, versionTo;
+    QVector3D target;
+    bool operator<(const Collapse& other) const { return cost > other.cost; } // 小顶堆
+};
+
+struct EdgeKeyHash {
+    size_t operator()(uint64_t key) const { return static_cast<size_t>(hashMix64(key)); }
+};
+
+inline uint64_t edgeKey(uint32_t a, uint32_t b) {
+    return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+}
+
+// 单个（子）网格上的简化过程。positions 与 triangles 被原地修改：
+// 折叠后的顶点位置写回 positions，结果三角形（引用原顶点编号）写回 triangles
+class QuadricSimplifier {
+public:
+    QuadricSimplifier(std::vector<QVector3D>& positions, std::vector<uint32_t>& triangles,
+                      const std::vector<uint8_t>& locked)
+        : positions_(positions), triangles_(triangles), locked_(locked) {}
+
+    // initialQuadrics 非空时沿用其中的二次型（此前的简化累积的误差），否则由三角形平面重新计算
+    void run(size_t targetTriangles, double maxCost, std::vector<Quadric>* initialQuadrics = nullptr) {
+        const size_t vertexCount = positions_.size();
+        const size_t triangleCount = triangles_.size() / 3;
+        triAlive_.assign(triangleCount, 1);
+        aliveTriangles_ = triangleCount;
+        const bool carried = initialQuadrics && initialQuadrics->size() == vertexCount;
+        if (carried) {
+            quadrics_.swap(*initialQuadrics);
+        } else {
+            quadrics_.assign(vertexCount, Quadric());
+        }
+        versions_.assign(vertexCount, 0);
+        vertexTriangles_.assign(vertexCount, {});
+
+        // 顶点-三角形邻接：先计数再一次性预留
+        std::vector<uint32_t> valence(vertexCount, 0);
+        for (uint32_t index : triangles_) ++valence[index];
+        for (size_t v = 0; v < vertexCount; ++v) vertexTriangles_[v].reserve(valence[v]);
+
+        for (size_t t = 0; t < triangleCount; ++t) {
+            const uint32_t* tri = &triangles_[t * 3];
+            for (int k = 0; k < 3; ++k) vertexTriangles_[tri[k]].push_back(static_cast<uint32_t>(t));
+            if (carried) continue;
+            const QVector3D& p0 = positions_[tri[0]];
+            QVector3D n = QVector3D::crossProduct(positions_[tri[1]] - p0, positions_[tri[2]] - p0);
+            const float len = n.length();
+            if (len <= 0.0f) continue;
+            n /= len;
+            const Quadric q = Quadric::fromPlane(n.x(), n.y(), n.z(), -QVector3D::dotProduct(n, p0));
+            for (int k = 0; k < 3; ++k) quadrics_[tri[k]] += q;
+        }
+
+        // 内部边会被相邻两个三角形各压入一次，重复条目在弹出时因端点已失效而被丢弃
+        for (size_t t = 0; t < triangleCount; ++t) {
+            const uint32_t* tri = &triangles_[t * 3];
+            for (int k = 0; k < 3; ++k) pushCollapse(tri[k], tri[(k + 1) % 3]);
+        }
+
+        while (aliveTriangles_ > targetTriangles && !heap_.empty()) {
+            Collapse c = heap_.top();
+            heap_.pop();
+            if (c.cost > maxCost) break;
+            if (c.versionFrom != versions_[c.from] || c.versionTo != versions_[c.to]) continue;
+            if (!isValid(c)) continue;
+            apply(c);
+        }
+
+        // 写回存活的三角形
+        size_t dst = 0;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            if (!triAlive_[t]) continue;
+            for (int k = 0; k < 3; ++k) triangles_[dst * 3 + k] = triangles_[t * 3 + k];
+            ++dst;
+        }
+        triangles_.resize(dst * 3);
+    }
+
+    // 折叠后每个顶点累积的二次型（被并入的顶点已无意义）
+    std::vector<Quadric>& quadrics() { return quadrics_; }
+
+private:
+    void pushCollapse(uint32_t a, uint32_t b) {
+        if (locked_[a] && locked_[b]) return;
+        Collapse c;
+        Quadric q = quadrics_[a];
+        q += quadrics_[b];
+        if (locked_[a] || locked_[b]) {
+            // 只能把未锁定的一端并入锁定端，位置固定
+            c.from = locked_[a] ? b : a;
+            c.to = locked_[a] ? a : b;
+            c.target = positions_[c.to];
+            c.cost = q.evaluate(c.target);
+        } else {
+            QVector3D best;
+            if (q.optimize(best)) {
+                c.target = best;
+                c.cost = q.evaluate(best);
+            } else {
+                // 退化情形：在两端点与中点之间取最优
+                const QVector3D candidates[3] = { positions_[a], positions_[b], (positions_[a] + positions_[b]) * 0.5f };
+                c.cost = q.evaluate(candidates[0]);
+                c.target = candidates[0];
+                for (int i = 1; i < 3; ++i) {
+                    double cost = q.evaluate(candidates[i]);
+                    if (cost < c.cost) { c.cost = cost; c.target = candidates[i]; }
+                }
+            }
+            c.from = a;
+            c.to = b;
+        }
+        c.cost = std::max(c.cost, 0.0);
+        c.versionFrom = versions_[c.from];
+        c.versionTo = versions_[c.to];
+        heap_.push(c);
+    }
+
+    bool triangleHas(uint32_t t, uint32_t v) const {
+        const uint32_t* tri = &triangles_[t * 3];
+        return tri[0] == v || tri[1] == v || tri[2] == v;
+    }
+
+    void collectNeighbors(uint32_t v, std::vector<uint32_t>& out) const {
+        out.clear();
+        for (uint32_t t : vertexTriangles_[v]) {
+            if (!triAlive_[t]) continue;
+            const uint32_t* tri = &triangles_[t * 3];
+            for (int k = 0; k < 3; ++k) if (tri[k] != v) out.push_back(tri[k]);
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    // 顶点 moved 移动到 target 后，其余不含 other 的三角形不得翻转或退化
+    bool keepsOrientation(uint32_t moved, uint32_t other, const QVector3D& target) const {
+        for (uint32_t t : vertexTriangles_[moved]) {
+            if (!triAlive_[t] || triangleHas(t, other)) continue;
+            const uint32_t* tri = &triangles_[t * 3];
+            QVector3D p[3], q[3];
+            for (int k = 0; k < 3; ++k) {
+                p[k] = positions_[tri[k]];
+                q[k] = tri[k] == moved ? target : p[k];
+            }
+            const QVector3D before = QVector3D::crossProduct(p[1] - p[0], p[2] - p[0]);
+            const QVector3D after = QVector3D::crossProduct(q[1] - q[0], q[2] - q[0]);
+            const float afterLen = after.length();
+            if (afterLen <= 1e-12f) return false;
+            if (QVector3D::dotProduct(before, after) < 0.2f * before.length() * afterLen) return false;
+        }
+        return true;
+    }
+
+    bool isValid(const Collapse& c) {
+        const uint32_t u = c.from, v = c.to;
+        // 必须仍是一条边，统计共享三角形
+        int shared = 0;
+        for (uint32_t t : vertexTriangles_[u]) {
+            if (triAlive_[t] && triangleHas(t, v)) ++shared;
+        }
+        if (shared == 0 || shared > 2) return false;
+
+        // 链接条件：两端点的公共邻点数必须等于共享三角形数，否则折叠会产生非流形
+        collectNeighbors(u, scratchA_);
+        collectNeighbors(v, scratchB_);
+        size_t common = 0;
+        for (size_t i = 0, j = 0; i < scratchA_.size() && j < scratchB_.size();) {
+            if (scratchA_[i] < scratchB_[j]) ++i;
+            else if (scratchA_[i] > scratchB_[j]) ++j;
+            else { ++common; ++i; ++j; }
+        }
+        if (common != static_cast<size_t>(shared)) return false;
+
+        return keepsOrientation(u, v, c.target) && keepsOrientation(v, u, c.target);
+    }
+
+    void apply(const Collapse& c) {
+        const uint32_t u = c.from, v = c.to;
+        positions_[v] = c.target;
+        quadrics_[v] += quadrics_[u];
+        ++versions_[u];
+        ++versions_[v];
+
+        for (uint32_t t : vertexTriangles_[u]) {
+            if (!triAlive_[t]) continue;
+            uint32_t* tri = &triangles_[t * 3];
+            if (triangleHas(t, v)) {
+                triAlive_[t] = 0;
+                --aliveTriangles_;
+            } else {
+                for (int k = 0; k < 3; ++k) if (tri[k] == u) tri[k] = v;
+                vertexTriangles_[v].push_back(t);
+            }
+        }
+        std::vector<uint32_t>().swap(vertexTriangles_[u]);
+
+        // 清理 v 的邻接表中已删除的三角形，并重新评估 v 的所有邻边
+        auto& list = vertexTriangles_[v];
+        list.erase(std::remove_if(list.begin(), list.end(), [this](uint32_t t) { return !triAlive_[t]; }), list.end());
+        collectNeighbors(v, scratchA_);
+        for (uint32_t w : scratchA_) pushCollapse(v, w);
+    }
+
+    std::vector<QVector3D>& positions_;
+    std::vector<uint32_t>& triangles_;
+    const std::vector<uint8_t>& locked_;
+
+    std::vector<uint8_t> triAlive_;
+    std::vector<Quadric> quadrics_;
+    std::vector<uint32_t> versions_;
+    std::vector<std::vector<uint32_t>> vertexTriangles_;
+    std::priority_queue<Collapse> heap_;
+    std::vector<uint32_t> scratchA_, scratchB_;
+    size_t aliveTriangles_ = 0;
+};
+
+// 标记开放边界（只被一个三角形使用的边）与非流形边上的顶点
+void markBoundaryVertices(const std::vector<uint32_t>& triangles, std::vector<uint8_t>& locked, bool includeOpenBoundary) {
+    OpenHashMap<uint64_t, uint32_t, EdgeKeyHash> edgeUse(triangles.size());
+    for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+        for (int k = 0; k < 3; ++k) {
+            auto inserted = edgeUse.insert(edgeKey(triangles[i + k], triangles[i + (k + 1) % 3]), 0);
+            ++*inserted.first;
+        }
+    }
+    edgeUse.forEach([&](uint64_t key, uint32_t count) {
+        if (count == 2 || (count == 1 && !includeOpenBoundary)) return;
+        locked[static_cast<uint32_t>(key >> 32)] = 1;
+        locked[static_cast<uint32_t>(key & 0xffffffffu)] = 1;
+    });
+}
+
+// 把简化结果写回 Mesh：只保留被三角形引用的顶点，保留其颜色/法线/纹理坐标/属性通道
+void writeBack(Mesh& mesh, const std::vector<QVector3D>& positions, const std::vector<uint32_t>& triangles) {
+    const auto& vertices = mesh.getVertices();
+    const auto& texCoords = mesh.getTexCoords();
+    std::vector<uint32_t> remap(positions.size(), UINT32_MAX);
+    std::vector<Vertex> newVertices;
+    std::vector<QVector2D> newTexCoords;
+    std::vector<uint32_t> newToOld;
+    std::vector<unsigned int> newTriangles(triangles.size());
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        const uint32_t v = triangles[i];
+        if (remap[v] == UINT32_MAX) {
+            remap[v] = static_cast<uint32_t>(newVertices.size());
+            Vertex vertex = vertices[v];
+            vertex.position = positions[v];
+            newVertices.push_back(vertex);
+            if (!texCoords.empty()) newTexCoords.push_back(texCoords[v]);
+            newToOld.push_back(v);
+        }
+        newTriangles[i] = remap[v];
+    }
+    // 属性通道随保留的顶点一起筛选
+    mesh.remapAttributes(newToOld);
+    mesh.setGeometry(std::move(newVertices), std::move(newTriangles), std::move(newTexCoords));
+}
+
+double maxCostFor(const MeshSimplifier::Options& options) {
+    if (options.maxError >= FLT_MAX) return std::numeric_limits<double>::max();
+    return static_cast<double>(options.maxError) * options.maxError;
+}
+
+// 读取网格的位置与三角形（过滤越界索引）
+void extract(const Mesh& mesh, std::vector<QVector3D>& positions, std::vector<uint32_t>& triangles) {
+    const auto& vertices = mesh.getVertices();
+    positions.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) positions[i] = vertices[i].position;
+    const auto& source = mesh.getTriangles();
+    triangles.clear();
+    triangles.reserve(source.size());
+    for (size_t i = 0; i + 2 < source.size(); i += 3) {
+        const uint32_t a = source[i], b = source[i + 1], c = source[i + 2];
+        if (a >= vertices.size() || b >= vertices.size() || c >= vertices.size()) continue;
+        if (a == b || b == c || a == c) continue;
+        triangles.push_back(a);
+        triangles.push_back(b);
+        triangles.push_back(c);
+    }
+}
+
+// 从全局网格中抽取的子网格：顶点按首次出现顺序重新编号，isLocked(全局编号) 给出锁定标记
+struct SubMesh {
+    std::vector<uint32_t> localToGlobal;
+    std::vector<QVector3D> positions;
+    std::vector<uint32_t> triangles;
+    std::vector<uint8_t> locked;
+    OpenHashMap<uint32_t, uint32_t, EdgeKeyHash> globalToLocal;
+
+    void reserve(size_t triangleCount) {
+        globalToLocal.reserve(triangleCount / 2 + 16);
+        triangles.reserve(triangleCount * 3);
+    }
+
+    template <typename LockedFn>
+    void addTriangle(const uint32_t* tri, const std::vector<QVector3D>& source, LockedFn&& isLocked) {
+        for (int k = 0; k < 3; ++k) {
+            auto inserted = globalToLocal.insert(tri[k], static_cast<uint32_t>(localToGlobal.size()));
+            if (inserted.second) {
+                localToGlobal.push_back(tri[k]);
+                positions.push_back(source[tri[k]]);
+                locked.push_back(isLocked(tri[k]) ? 1 : 0);
+            }
+            triangles.push_back(*inserted.first);
+        }
+    }
+};
+
+} // namespace
+
+MeshSimplifier::Result MeshSimplifier::simplify(Mesh& mesh, const Options& options) {
+    Result result;
+    result.originalTriangles = mesh.getTriangleCount();
+    result.originalVertices = mesh.getVertexCount();
+
+    std::vector<QVector3D> positions;
+    std::vector<uint32_t> triangles;
+    extract(mesh, positions, triangles);
+
+    std::vector<uint8_t> locked(positions.size(), 0);
+    markBoundaryVertices(triangles, locked, options.preserveBoundary);
+
+    QuadricSimplifier simplifier(positions, triangles, locked);
+    simplifier.run(options.targetTriangleCount, maxCostFor(options));
+
+    writeBack(mesh, positions, triangles);
+    result.resultTriangles = mesh.getTriangleCount();
+    result.resultVertices = mesh.getVertexCount();
+    return result;
+}
+
+MeshSimplifier::Result MeshSimplifier::simplifyParallel(Mesh& mesh, const Options& options, size_t partitions) {
+    if (partitions == 0) partitions = Parallel::threadCount();
+    const size_t triangleTotal = mesh.getTriangleCount();
+    if (partitions <= 1 || triangleTotal < partitions * 10000) return simplify(mesh, options);
+
+    Result result;
+    result.originalTriangles = triangleTotal;
+    result.originalVertices = mesh.getVertexCount();
+
+    std::vector<QVector3D> positions;
+    std::vector<uint32_t> triangles;
+    extract(mesh, positions, triangles);
+    const size_t triangleCount = triangles.size() / 3;
+
+    // 1. 按三角形重心在最长轴上的位置均分为若干块
+    AABB box = mesh.computeAABB();
+    const QVector3D size = box.size();
+    const int axis = (size.x() >= size.y() && size.x() >= size.z()) ? 0 : (size.y() >= size.z() ? 1 : 2);
+    std::vector<uint64_t> keys(triangleCount);
+    std::vector<uint32_t> order(triangleCount);
+    const float minCoord = box.min[axis];
+    const float invExtent = size[axis] > 0.0f ? 1.0f / size[axis] : 0.0f;
+    Parallel::forEach(0, triangleCount, [&](size_t t) {
+        const uint32_t* tri = &triangles[t * 3];
+        const float c = (positions[tri[0]][axis] + positions[tri[1]][axis] + positions[tri[2]][axis]) / 3.0f;
+        keys[t] = static_cast<uint64_t>(std::clamp((c - minCoord) * invExtent, 0.0f, 1.0f) * 16777215.0f);
+        order[t] = static_cast<uint32_t>(t);
+    });
+    Parallel::radixSortPairs(keys, order, 24);
+
+    std::vector<uint32_t> partitionOf(triangleCount);
+    for (size_t p = 0; p < partitions; ++p) {
+        const size_t b = Parallel::chunkBegin(triangleCount, partitions, p);
+        const size_t e = Parallel::chunkBegin(triangleCount, partitions, p + 1);
+        for (size_t i = b; i < e; ++i) partitionOf[order[i]] = static_cast<uint32_t>(p);
+    }
+
+    // 2. 被多个分块使用的顶点以及边界顶点全部锁定
+    const uint32_t kUnassigned = UINT32_MAX, kShared = UINT32_MAX - 1;
+    std::vector<uint32_t> owner(positions.size(), kUnassigned);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            uint32_t& o = owner[triangles[t * 3 + k]];
+            if (o == kUnassigned) o = partitionOf[t];
+            else if (o != partitionOf[t]) o = kShared;
+        }
+    }
+    std::vector<uint8_t> globalLocked(positions.size(), 0);
+    markBoundaryVertices(triangles, globalLocked, options.preserveBoundary);
+
+    // 3. 各分块抽取为局部子网格并行简化，保留各顶点累积的二次型
+    const size_t target = options.targetTriangleCount;
+    const double maxCost = maxCostFor(options);
+    std::vector<SubMesh> parts(partitions);
+    std::vector<std::vector<Quadric>> partQuadrics(partitions);
+    Parallel::forChunks(partitions, partitions, [&](size_t p, size_t, size_t) {
+        const size_t b = Parallel::chunkBegin(triangleCount, partitions, p);
+        const size_t e = Parallel::chunkBegin(triangleCount, partitions, p + 1);
+        SubMesh& part = parts[p];
+        part.reserve(e - b);
+        for (size_t i = b; i < e; ++i) {
+            part.addTriangle(&triangles[order[i] * 3], positions, [&](uint32_t v) {
+                return owner[v] == kShared || globalLocked[v];
+            });
+        }
+        const size_t localTarget = target == 0 ? 0
+            : static_cast<size_t>(static_cast<double>(target) * (e - b) / triangleCount);
+        QuadricSimplifier simplifier(part.positions, part.triangles, part.locked);
+        simplifier.run(localTarget, maxCost);
+        partQuadrics[p].swap(simplifier.quadrics());
+    });
+
+    // 4. 合并：局部结果映射回全局编号（存活顶点的位置写回）；
+    //    接缝顶点的二次型是各分块部分之和（各块的三角形互不相交，和即为整体误差）
+    std::vector<Quadric> quadrics(positions.size());
+    triangles.clear();
+    for (size_t p = 0; p < partitions; ++p) {
+        const auto& l2g = parts[p].localToGlobal;
+        for (size_t i = 0; i < l2g.size(); ++i) {
+            if (owner[l2g[i]] != kShared) positions[l2g[i]] = parts[p].positions[i];
+            quadrics[l2g[i]] += partQuadrics[p][i];
+        }
+        for (uint32_t local : parts[p].triangles) triangles.push_back(l2g[local]);
+        parts[p] = SubMesh();
+        std::vector<Quadric>().swap(partQuadrics[p]);
+    }
+
+    // 5. 接缝收尾：只解锁接缝顶点及其 1 环邻点，在它们的 2 环内沿用分块累积的二次型再简化。
+    //    2 环顶点保持锁定但带有完整的星形，折叠的链接条件与翻转检查因而与在整体上执行一致；
+    //    其余三角形原样保留。已达到目标面数时跳过
+    const size_t mergedCount = triangles.size() / 3;
+    if (target == 0 || mergedCount > target) {
+        // 逐环扩张：接缝顶点为 3，1 环为 2（解锁），2 环为 1（锁定），其余为 0
+        std::vector<uint8_t> level(positions.size(), 0);
+        for (size_t v = 0; v < positions.size(); ++v) {
+            if (owner[v] == kShared) level[v] = 3;
+        }
+        for (uint8_t ring = 3; ring > 1; --ring) {
+            for (size_t t = 0; t < mergedCount; ++t) {
+                const uint32_t* tri = &triangles[t * 3];
+                if (level[tri[0]] < ring && level[tri[1]] < ring && level[tri[2]] < ring) continue;
+                for (int k = 0; k < 3; ++k) level[tri[k]] = std::max<uint8_t>(level[tri[k]], ring - 1);
+            }
+        }
+
+        SubMesh seam;
+        std::vector<uint32_t> kept;
+        kept.reserve(triangles.size());
+        for (size_t t = 0; t < mergedCount; ++t) {
+            const uint32_t* tri = &triangles[t * 3];
+            if (level[tri[0]] || level[tri[1]] || level[tri[2]]) {
+                seam.addTriangle(tri, positions, [&](uint32_t v) { return level[v] < 2 || globalLocked[v]; });
+            } else {
+                kept.insert(kept.end(), tri, tri + 3);
+            }
+        }
+        std::vector<Quadric> seamQuadrics(seam.localToGlobal.size());
+        for (size_t i = 0; i < seamQuadrics.size(); ++i) seamQuadrics[i] = quadrics[seam.localToGlobal[i]];
+        std::vector<Quadric>().swap(quadrics);
+
+        // 目标面数扣除接缝外保留的面；不足时至少保留 1 个（0 表示不限面数）
+        const size_t keptCount = kept.size() / 3;
+        const size_t seamTarget = target == 0 ? 0 : std::max<size_t>(1, target > keptCount ? target - keptCount : 0);
+        QuadricSimplifier finisher(seam.positions, seam.triangles, seam.locked);
+        finisher.run(seamTarget, maxCost, &seamQuadrics);
+
+        for (size_t i = 0; i < seam.localToGlobal.size(); ++i) positions[seam.localToGlobal[i]] = seam.positions[i];
+        for (uint32_t local : seam.triangles) kept.push_back(seam.localToGlobal[local]);
+        triangles.swap(kept);
+    }
+
+    writeBack(mesh, positions, triangles);
+    result.resultTriangles = mesh.getTriangleCount();
+    result.resultVertices = mesh.getVertexCount();
+    return result;
+}
@@ -0,0 +1,218 @@
+#include "MeshTopology.h"
+#include "Parallel.h"
+#include <QDebug>
+#include <algorithm>
+
+void MeshTopology::build(size_t vertexCount, const std::vector<unsigned int>& triangles) {
+    *this = MeshTopology();
+    const size_t faceCount = triangles.size() / 3;
+    if (vertexCount >= kIgnored || faceCount * 3 >= kIgnored) {
+        qDebug() << "网格规模超出拓扑索引范围:" << vertexCount << "个顶点," << faceCount << "个三角形";
+        return;
+    }
+    stats_.vertexCount = vertexCount;
+    stats_.faceCount = faceCount;
+    triangles_.assign(triangles.begin(), triangles.begin() + faceCount * 3);
+    opposite_.assign(triangles_.size(), kBoundary);
+
+    // 退化或越界的三角形不参与拓扑
+    Parallel::forEach(0, faceCount, [&](size_t f) {
+        const uint32_t* t = &triangles_[f * 3];
+        if (t[0] >= vertexCount || t[1] >= vertexCount || t[2] >= vertexCount ||
+            t[0] == t[1] || t[1] == t[2] || t[0] == t[2]) {
+            opposite_[f * 3] = opposite_[f * 3 + 1] = opposite_[f * 3 + 2] = kIgnored;
+        }
+    });
+
+    stats_.ignoredFaceCount = static_cast<size_t>(std::count(opposite_.begin(), opposite_.end(), kIgnored)) / 3;
+    buildVertexIndex(Parallel::keyBitsFor(vertexCount));
+    buildEdges();
+    classifyVertices();
+    traceBoundaryLoops();
+
+    const Stats& s = stats_;
+    stats_.eulerCharacteristic = static_cast<long long>(s.vertexCount - s.isolatedVertexCount)
+                               - static_cast<long long>(s.edgeCount)
+                               + static_cast<long long>(s.faceCount - s.ignoredFaceCount);
+    stats_.closed = s.boundaryEdgeCount == 0 && s.nonManifoldEdgeCount == 0;
+    stats_.manifold = s.nonManifoldEdgeCount == 0 && s.nonManifoldVertexCount == 0;
+}
+
+void MeshTopology::buildVertexIndex(int vertexBits) {
+    const size_t m = triangles_.size();
+    const size_t n = stats_.vertexCount;
+
+    // 按起点对半边做并行基数排序得到 CSR 出边表；忽略的半边以 n 为键排在最后
+    std::vector<uint64_t> keys(m);
+    outgoing_.resize(m);
+    Parallel::forEach(0, m, [&](size_t h) {
+        keys[h] = opposite_[h] == kIgnored ? n : triangles_[h];
+        outgoing_[h] = static_cast<uint32_t>(h);
+    });
+    Parallel::radixSortPairs(keys, outgoing_, vertexBits);
+
+    vertexOffsets_.resize(n + 1);
+    Parallel::forEach(0, n + 1, [&](size_t v) {
+        vertexOffsets_[v] = static_cast<uint32_t>(std::lower_bound(keys.begin(), keys.end(), v) - keys.begin());
+    });
+    outgoing_.resize(vertexOffsets_[n]);
+}
+
+void MeshTopology::buildEdges() {
+    const size_t m = triangles_.size();
+
+    // 出边表中每条半边的终点（与 outgoing_ 对齐，顺序扫描）
+    std::vector<uint32_t> outgoingTargets(outgoing_.size());
+    Parallel::forEach(0, outgoing_.size(), [&](size_t i) {
+        outgoingTargets[i] = target(outgoing_[i]);
+    });
+
+    // 半边 a->b：在 a 的出边中数同向半边，在 b 的出边中找反向半边。
+    // 恰好一对反向半边为内部边，只有自身为边界边，其余情况为非流形边。
+    // 一条无向边只由编号最小的半边计数
+    struct ChunkCounts {
+        size_t edges = 0;
+        size_t boundary = 0;
+        std::vector<std::pair<uint32_t, uint32_t>> nonManifold;
+    };
+    const size_t chunks = Parallel::chunkCount(m);
+    std::vector<ChunkCounts> counts(chunks);
+    Parallel::forChunks(m, chunks, [&](size_t c, size_t b, size_t e) {
+        ChunkCounts& out = counts[c];
+        for (size_t i = b; i < e; ++i) {
+            const uint32_t h = static_cast<uint32_t>(i);
+            if (opposite_[h] == kIgnored) continue;
+            const uint32_t from = source(h);
+            const uint32_t to = target(h);
+            uint32_t sameDirection = 0, reverseDirection = 0, twin = kInvalid, smallest = h;
+            for (uint32_t k = vertexOffsets_[from]; k < vertexOffsets_[from + 1]; ++k) {
+                if (outgoingTargets[k] != to) continue;
+                ++sameDirection;
+                smallest = std::min(smallest, outgoing_[k]);
+            }
+            for (uint32_t k = vertexOffsets_[to]; k < vertexOffsets_[to + 1]; ++k) {
+                if (outgoingTargets[k] != from) continue;
+                ++reverseDirection;
+                twin = outgoing_[k];
+                smallest = std::min(smallest, twin);
+            }
+            const bool counted = smallest == h;
+            if (sameDirection == 1 && reverseDirection == 1) {
+                opposite_[h] = twin;
+                if (counted) ++out.edges;
+            } else if (sameDirection == 1 && reverseDirection == 0) {
+                opposite_[h] = kBoundary;
+                if (counted) {
+                    ++out.edges;
+                    ++out.boundary;
+                }
+            } else {
+                opposite_[h] = kNonManifold;
+                if (counted) {
+                    ++out.edges;
+                    out.nonManifold.emplace_back(std::min(from, to), std::max(from, to));
+                }
+            }
+        }
+    });
+    for (auto& chunk : counts) {
+        stats_.edgeCount += chunk.edges;
+        stats_.boundaryEdgeCount += chunk.boundary;
+        nonManifoldEdges_.insert(nonManifoldEdges_.end(), chunk.nonManifold.begin(), chunk.nonManifold.end());
+    }
+    stats_.nonManifoldEdgeCount = nonManifoldEdges_.size();
+}
+
+void MeshTopology::classifyVertices() {
+    const size_t n = stats_.vertexCount;
+    const size_t chunks = Parallel::chunkCount(n, 4096);
+    std::vector<size_t> isolated(chunks, 0);
+    std::vector<size_t> nonManifold(chunks, 0);
+
+    // 绕顶点旋转：h (v->a) 的前一条半边指向 v，其对边是 v 的下一条出边；反向为 next(opposite(h))。
+    // 从任一出边双向旋转能到达的出边数少于度数时，邻接面片不止一个扇形
+    Parallel::forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+        for (size_t v = b; v < e; ++v) {
+            const size_t degree = valence(static_cast<uint32_t>(v));
+            if (degree == 0) {
+                ++isolated[c];
+                continue;
+            }
+            const uint32_t start = outgoing_[vertexOffsets_[v]];
+            size_t reached = 1;
+            bool closedFan = false;
+            bool touchesNonManifold = false;
+            for (uint32_t h = start;;) {
+                const uint32_t o = opposite_[prev(h)];
+                if (o == kNonManifold) touchesNonManifold = true;
+                if (o >= kIgnored) break;
+                if (o == start) {
+                    closedFan = true;
+                    break;
+                }
+                h = o;
+                if (++reached > degree) break;
+            }
+            for (uint32_t h = start; !closedFan;) {
+                const uint32_t o = opposite_[h];
+                if (o == kNonManifold) touchesNonManifold = true;
+                if (o >= kIgnored) break;
+                h = next(o);
+                if (h == start || ++reached > degree) break;
+            }
+            if (touchesNonManifold || reached != degree) ++nonManifold[c];
+        }
+    });
+    for (size_t c = 0; c < chunks; ++c) {
+        stats_.isolatedVertexCount += isolated[c];
+        stats_.nonManifoldVertexCount += nonManifold[c];
+    }
+}
+
+void MeshTopology::traceBoundaryLoops() {
+    if (stats_.boundaryEdgeCount == 0) return;
+    std::vector<uint8_t> visited(triangles_.size(), 0);
+    for (uint32_t h = 0; h < triangles_.size(); ++h) {
+        if (opposite_[h] != kBoundary || visited[h]) continue;
+        std::vector<uint32_t> loop;
+        for (uint32_t current = h; current != kInvalid;) {
+            visited[current] = 1;
+            loop.push_back(source(current));
+            // 下一条边界边从当前边的终点出发
+            const uint32_t v = target(current);
+            current = kInvalid;
+            for (uint32_t candidate : outgoing(v)) {
+                if (opposite_[candidate] == kBoundary && !visited[candidate]) {
+                    current = candidate;
+                    break;
+                }
+            }
+        }
+        boundaryLoops_.push_back(std::move(loop));
+    }
+    stats_.boundaryLoopCount = boundaryLoops_.size();
+}
+
+bool MeshTopology::isBoundaryVertex(uint32_t v) const {
+    for (uint32_t h : outgoing(v)) {
+        if (opposite_[h] == kBoundary || opposite_[prev(h)] == kBoundary) return true;
+    }
+    return false;
+}
+
+void MeshTopology::vertexRing(uint32_t v, std::vector<uint32_t>& ring) const {
+    ring.clear();
+    for (uint32_t h : outgoing(v)) {
+        ring.push_back(target(h));
+        ring.push_back(source(prev(h)));
+    }
+    std::sort(ring.begin(), ring.end());
+    ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+}
+
+void MeshTopology::faceNeighbors(uint32_t f, uint32_t neighbors[3]) const {
+    for (uint32_t k = 0; k < 3; ++k) {
+        const uint32_t o = opposite_[f * 3 + k];
+        neighbors[k] = o < kIgnored ? face(o) : kInvalid;
+    }
+}
@@ -1,5 +1,7 @@
 #include "Model.h"
 #include <QDebug>
+#include <algorithm>
+#include "Parallel.h"
 
 int Model::totalModelCount_ = 0;
 
@@ -13,6 +15,124 @@ Model::~Model() {
     totalModelCount_--;
 }
 
+AttributeChannel* Model::addAttribute(const QString& name, AttributeChannel::Type type) {
+    removeAttribute(name);
+    attributes_.emplace_back(name, type, vertices_.size());
+    return &attributes_.back();
+}
+
+AttributeChannel* Model::addAttribute(AttributeChannel&& channel) {
+    if (channel.size() != vertices_.size()) {
+        qDebug() << "属性通道长度与顶点数不一致:" << channel.name() << channel.size() << "vs" << vertices_.size();
+        return nullptr;
+    }
+    removeAttribute(channel.name());
+    attributes_.push_back(std::move(channel));
+    return &attributes_.back();
+}
+
+AttributeChannel* Model::findAttribute(const QString& name) {
+    for (auto& channel : attributes_) {
+        if (channel.name() == name) return &channel;
+    }
+    return nullptr;
+}
+
+const AttributeChannel* Model::findAttribute(const QString& name) const {
+    for (const auto& channel : attributes_) {
+        if (channel.name() == name) return &channel;
+    }
+    return nullptr;
+}
+
+void Model::removeAttribute(const QString& name) {
+    attributes_.erase(std::remove_if(attributes_.begin(), attributes_.end(),
+                                     [&](const AttributeChannel& channel) { return channel.name() == name; }),
+                      attributes_.end());
+}
+
+void Model::clearAttributes() {
+    attributes_.clear();
+    activeAttribute_.clear();
+}
+
+void Model::remapAttributes(const std::vector<uint32_t>& newToOld) {
+    for (auto& channel : attributes_) {
+        channel.gather(newToOld);
+    }
+    for (auto& mask : masks_) {
+        if (!mask.empty()) mask = mask.gathered(newToOld);
+    }
+}
+
+void Model::syncAttributeSizes() {
+    for (auto& channel : attributes_) {
+        if (channel.size() != vertices_.size()) channel.resize(vertices_.size());
+    }
+    for (auto& mask : masks_) {
+        if (mask.size() != vertices_.size()) mask.clear();
+    }
+}
+
+void Model::dropMismatchedAttributes() {
+    attributes_.erase(std::remove_if(attributes_.begin(), attributes_.end(),
+                                     [&](const AttributeChannel& channel) { return channel.size() != vertices_.size(); }),
+                      attributes_.end());
+    for (auto& mask : masks_) {
+        if (mask.size() != vertices_.size()) mask.clear();
+    }
+}
+
+BitMask& Model::mask(MaskLayer layer) {
+    if (masks_[layer].size() != vertices_.size()) masks_[layer].resize(vertices_.size());
+    return masks_[layer];
+}
+
+size_t Model::getMaskCount(MaskLayer layer) const {
+    return masks_[layer].size() == vertices_.size() ? masks_[layer].count() : 0;
+}
+
+BitMask Model::visibleMask() const {
+    BitMask visible(vertices_.size(), true);
+    const bool filtered = hasMask(FilterLayer);
+    const bool clipped = hasMask(ClipLayer);
+    if (!filtered && !clipped) return visible;
+    const uint64_t* filter = filtered ? masks_[FilterLayer].words() : nullptr;
+    const uint64_t* clip = clipped ? masks_[ClipLayer].words() : nullptr;
+    uint64_t* words = visible.words();
+    // 尾部无效位在两个图层中都为 0，取反后须由全 1 的初始值截断
+    Parallel::forEach(0, visible.wordCount(), [&](size_t w) {
+        uint64_t hidden = 0;
+        if (filter) hidden |= filter[w];
+        if (clip) hidden |= clip[w];
+        words[w] &= ~hidden;
+    });
+    return visible;
+}
+
+size_t Model::getVisibleCount() const {
+    return hasHiddenVertices() ? visibleMask().count() : vertices_.size();
+}
+
+const AttributeChannel* Model::getActiveAttribute() const {
+    if (activeAttribute_.isEmpty()) return nullptr;
+    const AttributeChannel* channel = findAttribute(activeAttribute_);
+    return channel && channel->size() == vertices_.size() ? channel : nullptr;
+}
+
+void Model::setScalarField(const QString& name, std::vector<float>&& values) {
+    if (values.size() != vertices_.size()) {
+        qDebug() << "标量数量与顶点数不一致:" << values.size() << "vs" << vertices_.size();
+        return;
+    }
+    AttributeChannel* channel = addAttribute(name, AttributeChannel::Float32);
+    if (!values.empty()) {
+        std::copy(values.begin(), values.end(), channel->values<float>());
+    }
+    std::vector<float>().swap(values);
+    activeAttribute_ = name;
+}
+
 void Model::translate(const QVector3D& offset) {
     position_ += offset;
     // 更新所有顶点位置
@@ -51,6 +171,16 @@ void Model::scale(const QVector3D& factors) {
     }
 }
 
+void Model::applyTransform(const QMatrix4x4& matrix) {
+    position_ = matrix.map(position_);
+    const QMatrix3x3 normalMatrix = matrix.normalMatrix();
+    Parallel::forEach(0, vertices_.size(), [&](size_t i) {
+        Vertex& vertex = vertices_[i];
+        vertex.position = matrix.map(vertex.position);
+        vertex.normal = transformNormal(normalMatrix, vertex.normal);
+    });
+}
+
 QVector3D Model::computeCenter() const {
     // 返回单位：厘米（假设内部存储为米）
     if (vertices_.empty()) {
@@ -75,11 +205,17 @@ AABB Model::computeAABB() const {
 
 void Model::setColor(const QColor& color) {
     color_ = color;
-    updateVertexColors(color);
+    colorOverride_ = true;
+}
+
+void Model::bakeColor() {
+    if (!colorOverride_) return;
+    updateVertexColors(color_);
+    colorOverride_ = false;
 }
 
 void Model::updateVertexColors(const QColor& color) {
-    for (auto& vertex : vertices_) {
-        vertex.color = color;
-    }
+    Parallel::forEach(0, vertices_.size(), [&](size_t i) {
+        vertices_[i].color = color;
+    });
 }
\ No newline at end of file
@@ -1,7 +1,18 @@
 #include "ModelAnalyzer.h"
 #include "PointCloud.h"
+#include "PagedVertexStore.h"
+#include "QuantizedPoints.h"
 #include "Mesh.h"
 #include "AABB.h"
+#include "BVH.h"
+#include "MeshTopology.h"
+#include "KdTree.h"
+#include "Morton.h"
+#include "Parallel.h"
+#include "UnionFind.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
 
 QString ModelAnalyzer::analyzePointCloud(std::shared_ptr<PointCloud> pointCloud) {
     if (!pointCloud) return "无效的点云对象";
@@ -9,11 +20,37 @@ QString ModelAnalyzer::analyzePointCloud(std::shared_ptr<PointCloud> pointCloud)
     QString result;
     result += QString("点云名称: %1\n").arg(pointCloud->getName());
     result += QString("点数量: %1\n").arg(pointCloud->getPointCount());
+    if (pointCloud->isPaged()) {
+        // 外存点云：上面的点数为内存中的预览，重心与包围盒由外存块目录得到，覆盖全部点
+        const PagedVertexStore& store = *pointCloud->getPagedStore();
+        result += QString("外存点数: %1（%2 块，已映射 %3 MB / 工作集 %4 MB）\n")
+                      .arg(store.size()).arg(store.chunkCount())
+                      .arg(store.residentBytes() >> 20).arg(store.workingSetLimit() >> 20);
+    }
+    if (pointCloud->isCompact()) {
+        // 紧凑点云：误差为相对导入时浮点坐标的量化误差（厘米）
+        const QuantizedPoints& points = *pointCloud->getQuantizedPoints();
+        const QuantizedPoints::ErrorStats& error = points.error();
+        result += QString("紧凑存储: %1 点，%2 位/轴，%3 字节/点，共 %4 MB\n")
+                      .arg(static_cast<qulonglong>(points.size())).arg(static_cast<int>(points.precision()))
+                      .arg(static_cast<qulonglong>(QuantizedPoints::bytesPerPoint(points.precision())))
+                      .arg(points.byteSize() / 1048576.0, 0, 'f', 1);
+        result += QString("  量化误差上界(cm): %1\n").arg(formatVector3D(error.bound * 100.0f));
+        result += QString("  实测最大误差(cm): %1\n").arg(formatVector3D(error.maxError * 100.0f));
+        result += QString("  实测均方根误差(cm): %1\n").arg(error.rmsError * 100.0, 0, 'g', 4);
+    }
     
     QVector3D centerCm = pointCloud->computeCenter(); // 现为厘米
+    AABB aabb = pointCloud->computeAABB();
+    if (pointCloud->hasHiddenVertices()) {
+        // 有过滤/裁切图层时重心与包围盒只统计可见点（外存点云的图层作用于内存预览，统计的也是可见的预览点）
+        const ComponentStats visible = computeMaskedStats(*pointCloud, pointCloud->visibleMask());
+        result += QString("可见点数: %1\n").arg(visible.vertexCount);
+        centerCm = visible.centroid * 100.0f;
+        aabb = visible.bounds;
+    }
     result += QString("几何重心(cm): %1\n").arg(formatVector3D(centerCm));
     
-    AABB aabb = pointCloud->computeAABB();
     QVector3D minCm = aabb.min * 100.0f;
     QVector3D maxCm = aabb.max * 100.0f;
     QVector3D sizeCm = (aabb.size()) * 100.0f;
@@ -21,6 +58,7 @@ QString ModelAnalyzer::analyzePointCloud(std::shared_ptr<PointCloud> pointCloud)
     result += QString("  最小点: %1\n").arg(formatVector3D(minCm));
     result += QString("  最大点: %1\n").arg(formatVector3D(maxCm));
     result += QString("  尺寸: %1\n").arg(formatVector3D(sizeCm));
+    result += formatMaskedStats(*pointCloud, false);
     
     return result;
 }
@@ -32,8 +70,15 @@ QString ModelAnalyzer::formatVector3D(const QVector3D& vec) {
         .arg(vec.z(), 0, 'f', 3);
 }
 
-QString ModelAnalyzer::analyzeMesh(std::shared_ptr<Mesh> mesh) {
-    if (!mesh) return "无效的网格对象";
+QString ModelAnalyzer::analyzeMesh(std::shared_ptr<Mesh> source) {
+    if (!source) return "无效的网格对象";
+    
+    // 有过滤/裁切图层时压缩出可见部分再统计，计数、面积与拓扑都只含可见的顶点和三角形
+    std::shared_ptr<Mesh> mesh = source;
+    if (source->hasHiddenVertices()) {
+        mesh = std::dynamic_pointer_cast<Mesh>(source->compactVisible(source->getName()));
+        if (!mesh) return "无效的网格对象";
+    }
     
     QString result;
     result += QString("网格名称: %1\n").arg(mesh->getName());
@@ -55,5 +100,700 @@ QString ModelAnalyzer::analyzeMesh(std::shared_ptr<Mesh> mesh) {
     float surfaceAreaCm2 = mesh->computeSurfaceArea(); // 已切换为cm²
     result += QString("表面积(cm^2): %1\n").arg(surfaceAreaCm2, 0, 'f', 3);
     
+    const MeshTopology::Stats& topo = mesh->getTopology().stats();
+    result += QString("拓扑:\n");
+    result += QString("  边数: %1\n").arg(topo.edgeCount);
+    result += QString("  边界边: %1（%2 个边界环）\n").arg(topo.boundaryEdgeCount).arg(topo.boundaryLoopCount);
+    result += QString("  非流形边: %1，非流形顶点: %2\n").arg(topo.nonManifoldEdgeCount).arg(topo.nonManifoldVertexCount);
+    if (topo.isolatedVertexCount > 0 || topo.ignoredFaceCount > 0) {
+        result += QString("  孤立顶点: %1，退化面: %2\n").arg(topo.isolatedVertexCount).arg(topo.ignoredFaceCount);
+    }
+    result += QString("  欧拉示性数: %1\n").arg(topo.eulerCharacteristic);
+    result += QString("  %1，%2\n").arg(topo.closed ? "封闭" : "开放").arg(topo.manifold ? "流形" : "非流形");
+    result += formatMaskedStats(*source, true);
+    
+    return result;
+}
+
+QString ModelAnalyzer::formatMaskedStats(const Model& model, bool mesh) {
+    QString result;
+    auto append = [&](const QString& title, const BitMask& mask) {
+        const ComponentStats stats = computeMaskedStats(model, mask);
+        result += QString("%1: %2 / %3 个顶点").arg(title).arg(stats.vertexCount).arg(model.getVertexCount());
+        if (mesh) result += QString("，%1 个面片，面积 %2 cm^2").arg(stats.elementCount).arg(stats.area * 1e4, 0, 'f', 3);
+        result += "\n";
+        if (stats.vertexCount == 0) return;
+        result += QString("  重心(cm): %1\n").arg(formatVector3D(stats.centroid * 100.0f));
+        result += QString("  尺寸(cm): %1\n").arg(formatVector3D(stats.bounds.size() * 100.0f));
+    };
+    if (!model.hasHiddenVertices()) {
+        if (model.hasSelection()) append("选中部分", model.getSelection());
+        return result;
+    }
+    const BitMask visible = model.visibleMask();
+    const size_t visibleCount = visible.count();
+    result += QString("已隐藏 %1 / %2 个顶点（过滤/裁切图层），以上统计只含可见部分\n")
+                  .arg(model.getVertexCount() - visibleCount).arg(model.getVertexCount());
+    if (model.hasSelection()) {
+        BitMask selected = model.getSelection();
+        selected.intersect(visible);
+        append("选中部分（可见）", selected);
+    }
     return result;
 }
+
+ModelAnalyzer::ComponentStats ModelAnalyzer::computeMaskedStats(const Model& model, const BitMask& mask) {
+    ComponentStats stats;
+    const auto& vertices = model.getVertices();
+    if (mask.size() != vertices.size()) return stats;
+    
+    // 顶点：按字分块，各块累加点数、坐标和与包围盒后合并
+    struct Partial {
+        size_t count = 0;
+        double sum[3] = {0.0, 0.0, 0.0};
+        AABB bounds;
+    };
+    const uint64_t* words = mask.words();
+    const size_t chunks = Parallel::chunkCount(mask.wordCount(), 256);
+    std::vector<Partial> partials(chunks);
+    Parallel::forChunks(mask.wordCount(), chunks, [&](size_t c, size_t b, size_t e) {
+        Partial& partial = partials[c];
+        for (size_t w = b; w < e; ++w) {
+            for (uint64_t word = words[w]; word; word &= word - 1) {
+                const QVector3D& p = vertices[w * BitMask::kWordBits + BitMask::countTrailingZeros(word)].position;
+                ++partial.count;
+                partial.sum[0] += p.x();
+                partial.sum[1] += p.y();
+                partial.sum[2] += p.z();
+                partial.bounds.expand(p);
+            }
+        }
+    });
+    double sum[3] = {0.0, 0.0, 0.0};
+    for (const Partial& partial : partials) {
+        stats.vertexCount += partial.count;
+        for (int k = 0; k < 3; ++k) sum[k] += partial.sum[k];
+        if (partial.count == 0) continue;
+        stats.bounds.expand(partial.bounds.min);
+        stats.bounds.expand(partial.bounds.max);
+    }
+    if (stats.vertexCount > 0) {
+        const double n = static_cast<double>(stats.vertexCount);
+        stats.centroid = QVector3D(static_cast<float>(sum[0] / n), static_cast<float>(sum[1] / n),
+                                   static_cast<float>(sum[2] / n));
+    }
+    
+    // 三角形：三个顶点都在子集内才计入
+    const auto& triangles = model.getTriangles();
+    if (triangles.empty()) {
+        stats.elementCount = stats.vertexCount;
+        return stats;
+    }
+    const size_t triCount = triangles.size() / 3;
+    const size_t triChunks = Parallel::chunkCount(triCount, 4096);
+    std::vector<size_t> counts(triChunks, 0);
+    std::vector<double> areas(triChunks, 0.0);
+    Parallel::forChunks(triCount, triChunks, [&](size_t c, size_t b, size_t e) {
+        for (size_t t = b; t < e; ++t) {
+            const unsigned int* tri = &triangles[t * 3];
+            if (tri[0] >= vertices.size() || tri[1] >= vertices.size() || tri[2] >= vertices.size()) continue;
+            if (!mask.test(tri[0]) || !mask.test(tri[1]) || !mask.test(tri[2])) continue;
+            const QVector3D& v0 = vertices[tri[0]].position;
+            const QVector3D cross = QVector3D::crossProduct(vertices[tri[1]].position - v0,
+                                                            vertices[tri[2]].position - v0);
+            ++counts[c];
+            areas[c] += 0.5 * cross.length();
+        }
+    });
+    for (size_t c = 0; c < triChunks; ++c) {
+        stats.elementCount += counts[c];
+        stats.area += areas[c];
+    }
+    return stats;
+}
+
+void ModelAnalyzer::markAbovePlane(const Model& model, const QVector3D& normal, float offset, BitMask& mask) {
+    const auto& vertices = model.getVertices();
+    mask.resize(vertices.size());
+    uint64_t* words = mask.words();
+    Parallel::forEach(0, mask.wordCount(), [&](size_t w) {
+        const size_t begin = w * BitMask::kWordBits;
+        const size_t end = std::min(begin + BitMask::kWordBits, vertices.size());
+        uint64_t word = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const bool above = QVector3D::dotProduct(normal, vertices[i].position) > offset;
+            word |= uint64_t(above) << (i - begin);
+        }
+        words[w] = word;
+    }, 256);
+}
+
+void ModelAnalyzer::markOutsideRange(const AttributeChannel& channel, double minValue, double maxValue, BitMask& mask) {
+    mask.resize(channel.size());
+    uint64_t* words = mask.words();
+    Parallel::forEach(0, mask.wordCount(), [&](size_t w) {
+        const size_t begin = w * BitMask::kWordBits;
+        const size_t end = std::min(begin + BitMask::kWordBits, channel.size());
+        uint64_t word = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const double value = channel.valueAt(i);
+            // NaN 的比较结果为假，同样视为范围外
+            const bool inside = value >= minValue && value <= maxValue;
+            word |= uint64_t(!inside) << (i - begin);
+        }
+        words[w] = word;
+    }, 256);
+}
+
+std::vector<float> ModelAnalyzer::computeCloudToMeshDistances(std::shared_ptr<PointCloud> pointCloud,
+                                                              std::shared_ptr<Mesh> mesh,
+                                                              bool signedDistance) {
+    std::vector<float> distances;
+    if (!pointCloud || !mesh || mesh->getTriangleCount() == 0) return distances;
+    
+    const BVH& bvh = mesh->getBVH();
+    const auto& points = pointCloud->getVertices();
+    const auto& vertices = mesh->getVertices();
+    const auto& triangles = mesh->getTriangles();
+    distances.resize(points.size(), 0.0f);
+    // 被过滤/裁切图层隐藏的点不参与计算，距离记为 NaN（computeStatistics 跳过）
+    BitMask visible;
+    if (pointCloud->hasHiddenVertices()) visible = pointCloud->visibleMask();
+    
+    // 符号取自最近点处的角度加权伪法线（Bærentzen & Aanæs）：落在面内取面法线，落在边上取两侧面法线之和，
+    // 落在顶点上取各邻面法线按该顶点处内角加权之和。只用最近三角形的面法线时，
+    // 最近点落在共享边/顶点上会因哪个邻面胜出而翻转符号
+    std::vector<QVector3D> faceNormals;
+    std::vector<QVector3D> vertexNormals;
+    const MeshTopology* topology = nullptr;
+    if (signedDistance) {
+        const size_t faceCount = triangles.size() / 3;
+        faceNormals.assign(faceCount, QVector3D(0, 0, 0));
+        Parallel::forEach(0, faceCount, [&](size_t f) {
+            const unsigned int* tri = &triangles[f * 3];
+            // 越界索引的面（BVH 同样跳过）法线保持为 0
+            if (tri[0] >= vertices.size() || tri[1] >= vertices.size() || tri[2] >= vertices.size()) return;
+            const QVector3D& v0 = vertices[tri[0]].position;
+            faceNormals[f] = QVector3D::crossProduct(vertices[tri[1]].position - v0,
+                                                     vertices[tri[2]].position - v0).normalized();
+        });
+        topology = &mesh->getTopology();
+        vertexNormals.assign(vertices.size(), QVector3D(0, 0, 0));
+        Parallel::forEach(0, vertices.size(), [&](size_t v) {
+            // 每个邻面恰有一条从 v 出发的半边
+            QVector3D sum(0, 0, 0);
+            for (uint32_t h : topology->outgoing(static_cast<uint32_t>(v))) {
+                const QVector3D& center = vertices[v].position;
+                const QVector3D a = vertices[topology->target(h)].position - center;
+                const QVector3D b = vertices[topology->source(MeshTopology::prev(h))].position - center;
+                const float angle = std::atan2(QVector3D::crossProduct(a, b).length(), QVector3D::dotProduct(a, b));
+                sum += angle * faceNormals[MeshTopology::face(h)];
+            }
+            vertexNormals[v] = sum;
+        });
+    }
+    
+    // 最近点处的伪法线：按重心坐标判断落在面内、边上还是顶点上
+    auto pseudoNormal = [&](uint32_t f, const QVector3D& point) {
+        const unsigned int* tri = &triangles[f * 3];
+        const QVector3D& a = vertices[tri[0]].position;
+        const QVector3D e0 = vertices[tri[1]].position - a;
+        const QVector3D e1 = vertices[tri[2]].position - a;
+        const QVector3D e2 = point - a;
+        const float d00 = QVector3D::dotProduct(e0, e0), d01 = QVector3D::dotProduct(e0, e1);
+        const float d11 = QVector3D::dotProduct(e1, e1);
+        const float d20 = QVector3D::dotProduct(e2, e0), d21 = QVector3D::dotProduct(e2, e1);
+        const float denominator = d00 * d11 - d01 * d01;
+        if (denominator <= 0.0f) return faceNormals[f];
+        const float bary[3] = { 0.0f, (d11 * d20 - d01 * d21) / denominator, (d00 * d21 - d01 * d20) / denominator };
+        const float weights[3] = { 1.0f - bary[1] - bary[2], bary[1], bary[2] };
+        const float eps = 1e-4f;
+        int small = 0, corner = -1, edge = -1;
+        for (int k = 0; k < 3; ++k) {
+            if (weights[k] < eps) {
+                ++small;
+                edge = (k + 1) % 3;         // 对边：从 tri[k+1] 指向 tri[k+2] 的半边
+            } else {
+                corner = k;
+            }
+        }
+        if (small >= 2) return vertexNormals[tri[corner]];
+        if (small == 1) {
+            const uint32_t h = static_cast<uint32_t>(f * 3 + edge);
+            if (topology->hasOpposite(h)) return faceNormals[f] + faceNormals[MeshTopology::face(topology->opposite(h))];
+        }
+        return faceNormals[f];
+    };
+    
+    Parallel::forEach(0, points.size(), [&](size_t i) {
+        if (!visible.empty() && !visible.test(i)) {
+            distances[i] = std::numeric_limits<float>::quiet_NaN();
+            return;
+        }
+        const QVector3D& p = points[i].position;
+        BVH::ClosestHit hit;
+        if (!bvh.closestPoint(p, hit)) return;
+        float d = std::sqrt(hit.distanceSquared);
+        if (signedDistance && QVector3D::dotProduct(p - hit.point, pseudoNormal(hit.triangle, hit.point)) < 0.0f) d = -d;
+        distances[i] = d;
+    }, 1024);
+    return distances;
+}
+
+ModelAnalyzer::DistanceStats ModelAnalyzer::computeCloudToCloudDistances(std::shared_ptr<PointCloud> compared,
+                                                                         std::shared_ptr<PointCloud> reference) {
+    if (!compared || !reference || compared->getPointCount() == 0 || reference->getPointCount() == 0) {
+        return DistanceStats();
+    }
+    
+    KdTree tree;
+    tree.build(reference->getVertices());
+    
+    const auto& points = compared->getVertices();
+    const auto& refPoints = reference->getVertices();
+    const size_t n = points.size();
+    
+    // 查询按 Morton 顺序进行：相邻查询落在同一片树节点上，缓存命中高，
+    // 且上一个查询的最近点可作为下一个查询的初始上界
+    std::vector<uint32_t> order(n);
+    if (compared->isSpatiallySorted()) {
+        Parallel::forEach(0, n, [&](size_t i) { order[i] = static_cast<uint32_t>(i); });
+    } else {
+        const AABB box = compared->computeAABB();
+        std::vector<uint64_t> keys(n);
+        Parallel::forEach(0, n, [&](size_t i) {
+            keys[i] = Morton::encode(points[i].position, box);
+            order[i] = static_cast<uint32_t>(i);
+        });
+        Parallel::radixSortPairs(keys, order, 3 * Morton::kBitsPerAxis);
+    }
+    
+    // 被过滤/裁切图层隐藏的点不参与查询，距离记为 NaN
+    BitMask visible;
+    if (compared->hasHiddenVertices()) visible = compared->visibleMask();
+    std::vector<float> distances(n, 0.0f);
+    Parallel::forRange(0, n, [&](size_t b, size_t e) {
+        uint32_t previous = 0;
+        bool hasPrevious = false;
+        for (size_t k = b; k < e; ++k) {
+            if (!visible.empty() && !visible.test(order[k])) {
+                distances[order[k]] = std::numeric_limits<float>::quiet_NaN();
+                continue;
+            }
+            const QVector3D& p = points[order[k]].position;
+            uint32_t index = previous;
+            float d2 = hasPrevious ? (refPoints[previous].position - p).lengthSquared() : FLT_MAX;
+            tree.nearest(p, index, d2);
+            distances[order[k]] = std::sqrt(d2);
+            previous = index;
+            hasPrevious = true;
+        }
+    }, 4096);
+    
+    DistanceStats stats = computeStatistics(distances);
+    compared->setScalarField(QString("到 %1 的距离").arg(reference->getName()), std::move(distances));
+    return stats;
+}
+
+ModelAnalyzer::DistanceStats ModelAnalyzer::computeStatistics(const std::vector<float>& values) {
+    DistanceStats stats;
+    if (values.empty()) return stats;
+    
+    // 分块并行累加（double 避免千万级求和的精度损失）；NaN（隐藏点）不计入
+    struct Partial { size_t count = 0; double sum = 0.0, sumAbs = 0.0, sumSq = 0.0; float lo = FLT_MAX, hi = -FLT_MAX; };
+    const size_t chunks = Parallel::chunkCount(values.size());
+    std::vector<Partial> partials(chunks);
+    Parallel::forChunks(values.size(), chunks, [&](size_t c, size_t b, size_t e) {
+        Partial& part = partials[c];
+        for (size_t i = b; i < e; ++i) {
+            if (std::isnan(values[i])) continue;
+            const double v = values[i];
+            ++part.count;
+            part.sum += v;
+            part.sumAbs += std::fabs(v);
+            part.sumSq += v * v;
+            part.lo = std::min(part.lo, values[i]);
+            part.hi = std::max(part.hi, values[i]);
+        }
+    });
+    Partial total;
+    std::vector<size_t> offsets(chunks + 1, 0);
+    for (size_t c = 0; c < chunks; ++c) {
+        const Partial& part = partials[c];
+        offsets[c + 1] = offsets[c] + part.count;
+        total.count += part.count;
+        total.sum += part.sum;
+        total.sumAbs += part.sumAbs;
+        total.sumSq += part.sumSq;
+        total.lo = std::min(total.lo, part.lo);
+        total.hi = std::max(total.hi, part.hi);
+    }
+    const size_t n = total.count;
+    if (n == 0) return stats;
+    stats.count = n;
+    stats.mean = static_cast<float>(total.sum / n);
+    stats.meanAbs = static_cast<float>(total.sumAbs / n);
+    stats.rms = static_cast<float>(std::sqrt(total.sumSq / n));
+    stats.minValue = total.lo;
+    stats.maxValue = total.hi;
+    
+    // 百分位数：对绝对值逐个 nth_element（依次缩小区间）
+    std::vector<float> magnitudes(n);
+    Parallel::forChunks(values.size(), chunks, [&](size_t c, size_t b, size_t e) {
+        size_t out = offsets[c];
+        for (size_t i = b; i < e; ++i) {
+            if (!std::isnan(values[i])) magnitudes[out++] = std::fabs(values[i]);
+        }
+    });
+    auto percentile = [&](double q, size_t from) {
+        const size_t k = std::min(n - 1, static_cast<size_t>(q * (n - 1) + 0.5));
+        std::nth_element(magnitudes.begin() + from, magnitudes.begin() + k, magnitudes.end());
+        return std::make_pair(magnitudes[k], k);
+    };
+    auto p50 = percentile(0.50, 0);
+    auto p90 = percentile(0.90, p50.second);
+    auto p95 = percentile(0.95, p90.second);
+    auto p99 = percentile(0.99, p95.second);
+    stats.p50 = p50.first;
+    stats.p90 = p90.first;
+    stats.p95 = p95.first;
+    stats.p99 = p99.first;
+    return stats;
+}
+
+std::vector<ModelAnalyzer::ComponentStats> ModelAnalyzer::computeMeshComponents(std::shared_ptr<Mesh> mesh,
+                                                                               std::vector<uint32_t>& faceLabels) {
+    std::vector<ComponentStats> components;
+    faceLabels.clear();
+    if (!mesh || mesh->getTriangleCount() == 0) return components;
+    
+    const auto& vertices = mesh->getVertices();
+    const auto& triangles = mesh->getTriangles();
+    const size_t n = vertices.size();
+    const size_t triCount = triangles.size() / 3;
+    if (n >= kNoComponent || triCount >= kNoComponent) return components;
+    auto validTriangle = [&](size_t t) {
+        return triangles[t * 3] < n && triangles[t * 3 + 1] < n && triangles[t * 3 + 2] < n;
+    };
+    
+    // 1. 按三角形并行合并顶点集合
+    UnionFind sets(n);
+    Parallel::forEach(0, triCount, [&](size_t t) {
+        if (!validTriangle(t)) return;
+        sets.unite(triangles[t * 3], triangles[t * 3 + 1]);
+        sets.unite(triangles[t * 3 + 1], triangles[t * 3 + 2]);
+    });
+    
+    // 2. 以所在集合的根为键对三角形排序，同一分量的三角形变为连续区间（越界三角形以 n 为键排在最后）
+    std::vector<uint64_t> keys(triCount);
+    std::vector<uint32_t> order(triCount);
+    Parallel::forEach(0, triCount, [&](size_t t) {
+        keys[t] = validTriangle(t) ? sets.find(triangles[t * 3]) : n;
+        order[t] = static_cast<uint32_t>(t);
+    });
+    Parallel::radixSortPairs(keys, order, Parallel::keyBitsFor(n));
+    
+    struct Range { size_t begin, end; };
+    std::vector<Range> ranges;
+    for (size_t k = 0; k < triCount && keys[k] != n;) {
+        size_t e = k + 1;
+        while (e < triCount && keys[e] == keys[k]) ++e;
+        ranges.push_back({ k, e });
+        k = e;
+    }
+    // 按三角形数降序编号（同样大小保持根编号顺序）
+    std::stable_sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) {
+        return a.end - a.begin > b.end - b.begin;
+    });
+    
+    // 3. 各分量顶点互不相交，可按分量并行统计而无需同步
+    faceLabels.assign(triCount, kNoComponent);
+    components.resize(ranges.size());
+    std::vector<uint8_t> seen(n, 0);
+    Parallel::forEach(0, ranges.size(), [&](size_t c) {
+        ComponentStats& stats = components[c];
+        double sx = 0.0, sy = 0.0, sz = 0.0;
+        for (size_t k = ranges[c].begin; k < ranges[c].end; ++k) {
+            const uint32_t t = order[k];
+            faceLabels[t] = static_cast<uint32_t>(c);
+            const unsigned int* tri = &triangles[t * 3];
+            const QVector3D& a = vertices[tri[0]].position;
+            const QVector3D& b = vertices[tri[1]].position;
+            const QVector3D& d = vertices[tri[2]].position;
+            stats.area += 0.5 * QVector3D::crossProduct(b - a, d - a).length();
+            for (int j = 0; j < 3; ++j) {
+                if (seen[tri[j]]) continue;
+                seen[tri[j]] = 1;
+                const QVector3D& p = vertices[tri[j]].position;
+                sx += p.x();
+                sy += p.y();
+                sz += p.z();
+                stats.bounds.expand(p);
+                ++stats.vertexCount;
+            }
+        }
+        stats.elementCount = ranges[c].end - ranges[c].begin;
+        if (stats.vertexCount > 0) {
+            stats.centroid = QVector3D(static_cast<float>(sx / stats.vertexCount),
+                                       static_cast<float>(sy / stats.vertexCount),
+                                       static_cast<float>(sz / stats.vertexCount));
+        }
+    }, 1);
+    return components;
+}
+
+std::vector<ModelAnalyzer::ComponentStats> ModelAnalyzer::computeEuclideanClusters(std::shared_ptr<PointCloud> pointCloud,
+                                                                                  float radius, size_t minSize, size_t maxSize,
+                                                                                  std::vector<uint32_t>& pointLabels) {
+    std::vector<ComponentStats> components;
+    pointLabels.clear();
+    if (!pointCloud || pointCloud->getPointCount() == 0 || radius <= 0.0f) return components;
+    
+    const auto& points = pointCloud->getVertices();
+    const size_t n = points.size();
+    if (n >= kNoComponent) return components;
+    
+    // 1. 按点并行做半径查询并合并邻居；邻域关系对称，只合并编号更大的邻居。
+    // 已与查询点同集合的邻居由 unite 直接跳过，稠密区域很快收敛为同一个根。
+    // 查询按 Morton 顺序进行（已空间排序的点云直接按编号），相邻查询访问同一片树节点
+    KdTree tree;
+    tree.build(points);
+    UnionFind sets(n);
+    // 被过滤/裁切图层隐藏的点不查询、不合并，也不计入任何聚类
+    BitMask visible;
+    if (pointCloud->hasHiddenVertices()) visible = pointCloud->visibleMask();
+    auto isVisible = [&](size_t i) { return visible.empty() || visible.test(i); };
+    std::vector<uint32_t> queryOrder;
+    if (!pointCloud->isSpatiallySorted()) {
+        const AABB box = pointCloud->computeAABB();
+        std::vector<uint64_t> mortonKeys(n);
+        queryOrder.resize(n);
+        Parallel::forEach(0, n, [&](size_t i) {
+            mortonKeys[i] = Morton::encode(points[i].position, box);
+            queryOrder[i] = static_cast<uint32_t>(i);
+        });
+        Parallel::radixSortPairs(mortonKeys, queryOrder, 3 * Morton::kBitsPerAxis);
+    }
+    const size_t chunks = Parallel::chunkCount(n, 4096);
+    Parallel::forChunks(n, chunks, [&](size_t, size_t b, size_t e) {
+        std::vector<uint32_t> neighbors;
+        for (size_t k = b; k < e; ++k) {
+            const size_t i = queryOrder.empty() ? k : queryOrder[k];
+            if (!isVisible(i)) continue;
+            tree.radiusSearch(points[i].position, radius, neighbors);
+            const uint32_t self = static_cast<uint32_t>(i);
+            for (uint32_t j : neighbors) {
+                if (j > self && isVisible(j)) sets.unite(self, j);
+            }
+        }
+    });
+    
+    // 2. 以根为键对点排序，同一聚类的点变为连续区间；隐藏点的键为 n，排在最后且不构成聚类
+    std::vector<uint64_t> keys(n);
+    std::vector<uint32_t> order(n);
+    Parallel::forEach(0, n, [&](size_t i) {
+        keys[i] = isVisible(i) ? sets.find(static_cast<uint32_t>(i)) : n;
+        order[i] = static_cast<uint32_t>(i);
+    });
+    Parallel::radixSortPairs(keys, order, Parallel::keyBitsFor(n));
+    
+    struct Range { size_t begin, end; };
+    std::vector<Range> ranges;
+    for (size_t k = 0; k < n && keys[k] < n;) {
+        size_t e = k + 1;
+        while (e < n && keys[e] == keys[k]) ++e;
+        if (e - k >= minSize && e - k <= maxSize) ranges.push_back({ k, e });
+        k = e;
+    }
+    // 按点数降序编号（同样大小保持根编号顺序）
+    std::stable_sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) {
+        return a.end - a.begin > b.end - b.begin;
+    });
+    
+    // 3. 按聚类并行统计
+    pointLabels.assign(n, kNoComponent);
+    components.resize(ranges.size());
+    Parallel::forEach(0, ranges.size(), [&](size_t c) {
+        ComponentStats& stats = components[c];
+        double sx = 0.0, sy = 0.0, sz = 0.0;
+        for (size_t k = ranges[c].begin; k < ranges[c].end; ++k) {
+            const uint32_t i = order[k];
+            pointLabels[i] = static_cast<uint32_t>(c);
+            const QVector3D& p = points[i].position;
+            sx += p.x();
+            sy += p.y();
+            sz += p.z();
+            stats.bounds.expand(p);
+        }
+        stats.elementCount = stats.vertexCount = ranges[c].end - ranges[c].begin;
+        stats.centroid = QVector3D(static_cast<float>(sx / stats.vertexCount),
+                                   static_cast<float>(sy / stats.vertexCount),
+                                   static_cast<float>(sz / stats.vertexCount));
+    }, 1);
+    return components;
+}
+
+namespace {
+
+// 剖切平面序列：count 为 1 时只取 firstOffset
+inline float sectionOffset(float firstOffset, float lastOffset, int count, int k) {
+    return count > 1 ? firstOffset + (lastOffset - firstOffset) * k / (count - 1) : firstOffset;
+}
+
+} // namespace
+
+ModelAnalyzer::Section ModelAnalyzer::computeMeshSection(std::shared_ptr<Mesh> mesh, const QVector3D& normal,
+                                                         float offset) {
+    Section section;
+    if (!mesh || mesh->getTriangleCount() == 0 || normal.isNull()) return section;
+    
+    const auto& vertices = mesh->getVertices();
+    const auto& triangles = mesh->getTriangles();
+    const size_t n = vertices.size();
+    std::vector<uint32_t> candidates;
+    mesh->getBVH().queryPlane(normal, offset, candidates);
+    
+    // 1. 逐个候选三角形求截线段。顶点按 d >= 0 归入正侧，因此跨越平面的三角形恰有两条棱与平面相交；
+    // 端点以所在棱（两端顶点编号）为键，交点总是从编号小的顶点插值，共享棱的两个三角形得到相同的点
+    auto signedDistance = [&](unsigned int v) {
+        const QVector3D& p = vertices[v].position;
+        return double(normal.x()) * p.x() + double(normal.y()) * p.y() + double(normal.z()) * p.z() - offset;
+    };
+    std::vector<uint64_t> endpointKeys;
+    std::vector<QVector3D> endpoints;
+    for (uint32_t t : candidates) {
+        const unsigned int* tri = &triangles[size_t(t) * 3];
+        if (tri[0] >= n || tri[1] >= n || tri[2] >= n) continue;
+        const double d[3] = { signedDistance(tri[0]), signedDistance(tri[1]), signedDistance(tri[2]) };
+        const bool positive[3] = { d[0] >= 0.0, d[1] >= 0.0, d[2] >= 0.0 };
+        if (positive[0] == positive[1] && positive[1] == positive[2]) continue;
+        for (int j = 0; j < 3; ++j) {
+            const int k = (j + 1) % 3;
+            if (positive[j] == positive[k]) continue;
+            const int lo = tri[j] < tri[k] ? j : k;
+            const int hi = lo == j ? k : j;
+            const double s = d[lo] / (d[lo] - d[hi]);
+            const QVector3D& a = vertices[tri[lo]].position;
+            const QVector3D& b = vertices[tri[hi]].position;
+            endpointKeys.push_back((uint64_t(tri[lo]) << 32) | tri[hi]);
+            endpoints.push_back(QVector3D(static_cast<float>(a.x() + s * (double(b.x()) - a.x())),
+                                          static_cast<float>(a.y() + s * (double(b.y()) - a.y())),
+                                          static_cast<float>(a.z() + s * (double(b.z()) - a.z()))));
+        }
+    }
+    const size_t segmentCount = endpoints.size() / 2;
+    section.segmentCount = segmentCount;
+    if (segmentCount == 0) return section;
+    
+    // 2. 键相同的端点两两配对（流形棱恰好两个；非流形棱按排序顺序依次配对）
+    constexpr uint32_t kNone = 0xffffffffu;
+    std::vector<uint32_t> order(endpoints.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<uint32_t>(i);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return endpointKeys[a] != endpointKeys[b] ? endpointKeys[a] < endpointKeys[b] : a < b;
+    });
+    std::vector<uint32_t> partner(endpoints.size(), kNone);
+    for (size_t k = 0; k + 1 < order.size(); ++k) {
+        if (endpointKeys[order[k]] != endpointKeys[order[k + 1]]) continue;
+        partner[order[k]] = order[k + 1];
+        partner[order[k + 1]] = order[k];
+        ++k;
+    }
+    
+    // 3. 沿配对关系走出折线：先从无配对的端点出发得到开放折线，剩余的线段都在闭合环上
+    std::vector<uint8_t> visited(segmentCount, 0);
+    auto trace = [&](uint32_t start) {
+        std::vector<QVector3D> line;
+        line.push_back(endpoints[start]);
+        uint32_t enter = start;
+        bool closed = false;
+        for (;;) {
+            visited[enter / 2] = 1;
+            const uint32_t exit = enter ^ 1u;
+            line.push_back(endpoints[exit]);
+            section.length += (endpoints[exit] - endpoints[enter]).length();
+            const uint32_t next = partner[exit];
+            if (next == kNone || visited[next / 2]) {
+                closed = next == start;
+                break;
+            }
+            enter = next;
+        }
+        if (closed) line.pop_back();
+        section.polylines.push_back(std::move(line));
+        section.closed.push_back(closed ? 1 : 0);
+    };
+    for (uint32_t e = 0; e < endpoints.size(); ++e) {
+        if (partner[e] == kNone && !visited[e / 2]) trace(e);
+    }
+    for (uint32_t s = 0; s < segmentCount; ++s) {
+        if (!visited[s]) trace(s * 2);
+    }
+    return section;
+}
+
+std::vector<ModelAnalyzer::Section> ModelAnalyzer::computeMeshSections(std::shared_ptr<Mesh> mesh,
+                                                                       const QVector3D& normal, float firstOffset,
+                                                                       float lastOffset, int count) {
+    std::vector<Section> sections(std::max(count, 0));
+    if (!mesh || sections.empty()) return sections;
+    mesh->getBVH(); // 在调用线程构建缓存，并行剖切时只读
+    Parallel::forEach(0, sections.size(), [&](size_t k) {
+        sections[k] = computeMeshSection(mesh, normal, sectionOffset(firstOffset, lastOffset, count, int(k)));
+    }, 1);
+    return sections;
+}
+
+std::vector<uint32_t> ModelAnalyzer::extractPointSlab(std::shared_ptr<PointCloud> pointCloud,
+                                                      const std::vector<PointCloud::PointChunk>& chunks,
+                                                      const QVector3D& normal, float offset, float halfThickness) {
+    std::vector<uint32_t> indices;
+    if (!pointCloud || chunks.empty() || halfThickness < 0.0f) return indices;
+    const auto& points = pointCloud->getVertices();
+    const QVector3D absNormal(std::fabs(normal.x()), std::fabs(normal.y()), std::fabs(normal.z()));
+    
+    // 各区间的结果写入自己的桶，最后按区间顺序拼接，编号保持升序
+    std::vector<std::vector<uint32_t>> buckets(chunks.size());
+    Parallel::forEach(0, chunks.size(), [&](size_t c) {
+        const PointCloud::PointChunk& chunk = chunks[c];
+        if (chunk.end > points.size()) return;
+        const QVector3D center = (chunk.bounds.min + chunk.bounds.max) * 0.5f;
+        const float distance = QVector3D::dotProduct(normal, center) - offset;
+        const float radius = QVector3D::dotProduct(absNormal, (chunk.bounds.max - chunk.bounds.min) * 0.5f);
+        if (std::fabs(distance) - radius > halfThickness) return;
+        std::vector<uint32_t>& bucket = buckets[c];
+        if (std::fabs(distance) + radius < halfThickness) {
+            for (size_t i = chunk.begin; i < chunk.end; ++i) bucket.push_back(static_cast<uint32_t>(i));
+            return;
+        }
+        for (size_t i = chunk.begin; i < chunk.end; ++i) {
+            if (std::fabs(QVector3D::dotProduct(normal, points[i].position) - offset) <= halfThickness) {
+                bucket.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }, 16);
+    size_t total = 0;
+    for (const auto& bucket : buckets) total += bucket.size();
+    indices.reserve(total);
+    for (const auto& bucket : buckets) indices.insert(indices.end(), bucket.begin(), bucket.end());
+    return indices;
+}
+
+std::vector<uint32_t> ModelAnalyzer::computePointSlabLabels(std::shared_ptr<PointCloud> pointCloud,
+                                                            const QVector3D& normal, float firstOffset,
+                                                            float lastOffset, int count, float halfThickness) {
+    std::vector<uint32_t> labels;
+    if (!pointCloud || count <= 0) return labels;
+    const auto& points = pointCloud->getVertices();
+    labels.assign(points.size(), kNoComponent);
+    const float step = count > 1 ? (lastOffset - firstOffset) / (count - 1) : 0.0f;
+    Parallel::forEach(0, points.size(), [&](size_t i) {
+        const float d = QVector3D::dotProduct(normal, points[i].position);
+        int k = 0;
+        if (step != 0.0f) k = std::clamp(static_cast<int>(std::lround((d - firstOffset) / step)), 0, count - 1);
+        if (std::fabs(d - sectionOffset(firstOffset, lastOffset, count, k)) <= halfThickness) {
+            labels[i] = static_cast<uint32_t>(k);
+        }
+    });
+    return labels;
+}
@@ -0,0 +1,426 @@
+#include "ModelCompressor.h"
+#include "RangeCoder.h"
+#include "Morton.h"
+#include "Parallel.h"
+#include "AABB.h"
+#include <QFile>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const char kMagic[8] = {'3', 'D', 'V', 'Z', '0', '0', '0', '1'};
+const uint32_t kVersion = 1;
+const uint32_t kHasTriangles = 1u << 0;
+const uint32_t kHasNormals = 1u << 1;
+const int kNormalBits = 10;
+const uint32_t kNormalLevels = (1u << kNormalBits) - 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t vertexCount;
+    uint64_t triangleCount;
+    uint32_t positionBits;
+    uint32_t blockVertices;
+    uint32_t blockTriangles;
+    uint32_t vertexBlockCount;
+    uint32_t triangleBlockCount;
+    uint32_t reserved;
+    double origin[3];
+    double step[3];
+};
+
+// 每个顶点块独立建模：块内第一个值相对 0 编码
+struct VertexModels {
+    RangeCoder::IntegerModel key;
+    RangeCoder::IntegerModel normal[2];
+    RangeCoder::BitTreeModel<8> color[3];
+};
+
+// 三角形 (a, b, c) 已轮换为 a 最小：a 相对上一个三角形的 a 递增；
+// a 相同时 b 相对上一个 b 递增，否则相对 a 编码；c 相对 a 编码
+struct TriangleModels {
+    RangeCoder::IntegerModel first;
+    RangeCoder::IntegerModel second;
+    RangeCoder::IntegerModel secondSameFirst;
+    RangeCoder::IntegerModel third;
+};
+
+// 八面体映射：单位法线 -> [0, kNormalLevels]^2
+void encodeNormal(const QVector3D& n, uint32_t& u, uint32_t& v) {
+    const float sum = std::fabs(n.x()) + std::fabs(n.y()) + std::fabs(n.z());
+    float x = 0.0f, y = 0.0f;
+    if (sum > 0.0f) {
+        x = n.x() / sum;
+        y = n.y() / sum;
+        if (n.z() < 0.0f) {
+            const float fx = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+            const float fy = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+            x = fx;
+            y = fy;
+        }
+    }
+    u = static_cast<uint32_t>(std::lround((x * 0.5f + 0.5f) * kNormalLevels));
+    v = static_cast<uint32_t>(std::lround((y * 0.5f + 0.5f) * kNormalLevels));
+}
+
+QVector3D decodeNormal(uint32_t u, uint32_t v) {
+    float x = static_cast<float>(u) / kNormalLevels * 2.0f - 1.0f;
+    float y = static_cast<float>(v) / kNormalLevels * 2.0f - 1.0f;
+    const float z = 1.0f - std::fabs(x) - std::fabs(y);
+    if (z < 0.0f) {
+        const float fx = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        const float fy = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = fx;
+        y = fy;
+    }
+    return QVector3D(x, y, z).normalized();
+}
+
+size_t blockCount(size_t count, size_t blockSize) {
+    return (count + blockSize - 1) / blockSize;
+}
+
+qint64 rawByteSize(size_t vertexCount, size_t triangleCount, bool normals) {
+    return static_cast<qint64>(vertexCount) * (normals ? 27 : 15) + static_cast<qint64>(triangleCount) * 13;
+}
+
+} // namespace
+
+bool ModelCompressor::write(const QString& path, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& triangles,
+                            const Options& options, Stats* stats) {
+    QElapsedTimer timer;
+    timer.start();
+    const size_t n = vertices.size();
+    const size_t triangleCount = triangles.size() / 3;
+    if (n > 0xffffffffu || options.positionBits < 8 || options.positionBits > Morton::kBitsPerAxis ||
+        options.blockVertices == 0 || options.blockTriangles == 0) {
+        qDebug() << "ModelCompressor::write: unsupported input or options";
+        return false;
+    }
+
+    // 包围盒与量化参数
+    const size_t chunks = Parallel::chunkCount(n);
+    std::vector<AABB> partials(chunks);
+    Parallel::forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) partials[c].expand(vertices[i].position);
+    });
+    AABB box;
+    for (const AABB& partial : partials) {
+        if (!partial.isValid()) continue;
+        box.expand(partial.min);
+        box.expand(partial.max);
+    }
+    if (n == 0) box = AABB(QVector3D(0, 0, 0), QVector3D(0, 0, 0));
+    const uint32_t levels = (1u << options.positionBits) - 1;
+    double step[3], inverse[3], origin[3];
+    for (int k = 0; k < 3; ++k) {
+        const double extent = static_cast<double>(box.max[k]) - static_cast<double>(box.min[k]);
+        origin[k] = box.min[k];
+        step[k] = extent > 0.0 ? extent / levels : 0.0;
+        inverse[k] = extent > 0.0 ? levels / extent : 0.0;
+    }
+
+    // 量化坐标的 Morton 码排序（只排列下标 order，不移动顶点），三角形索引映射到排序后的编号
+    std::vector<uint64_t> keys(n);
+    std::vector<uint32_t> order(n);
+    std::atomic<bool> hasNormals(false);
+    Parallel::forRange(0, n, [&](size_t b, size_t e) {
+        bool normals = false;
+        for (size_t i = b; i < e; ++i) {
+            uint32_t q[3];
+            for (int k = 0; k < 3; ++k) {
+                const double t = std::round((vertices[i].position[k] - origin[k]) * inverse[k]);
+                q[k] = static_cast<uint32_t>(std::min(std::max(t, 0.0), static_cast<double>(levels)));
+            }
+            keys[i] = Morton::encode(q[0], q[1], q[2]);
+            order[i] = static_cast<uint32_t>(i);
+            normals = normals || vertices[i].normal != QVector3D(0, 0, 1);
+        }
+        if (normals) hasNormals = true;
+    });
+    Parallel::radixSortPairs(keys, order, 3 * options.positionBits);
+    std::vector<uint32_t> oldToNew(n);
+    Parallel::forEach(0, n, [&](size_t i) { oldToNew[order[i]] = static_cast<uint32_t>(i); });
+
+    std::vector<uint32_t> sortedTriangles(triangleCount * 3);
+    {
+        std::vector<uint64_t> triangleKeys(triangleCount);
+        std::vector<uint32_t> triangleOrder(triangleCount);
+        std::vector<uint32_t> canonical(triangleCount * 3);
+        std::atomic<bool> invalid(false);
+        Parallel::forEach(0, triangleCount, [&](size_t t) {
+            uint32_t idx[3];
+            for (int k = 0; k < 3; ++k) {
+                const unsigned int old = triangles[t * 3 + k];
+                if (old >= n) {
+                    invalid = true;
+                    idx[k] = 0;
+                } else {
+                    idx[k] = oldToNew[old];
+                }
+            }
+            // 轮换（不改变绕序）使最小索引在首位
+            int r = 0;
+            if (idx[1] < idx[r]) r = 1;
+            if (idx[2] < idx[r]) r = 2;
+            for (int k = 0; k < 3; ++k) canonical[t * 3 + k] = idx[(r + k) % 3];
+            triangleKeys[t] = (uint64_t(canonical[t * 3]) << 32) | canonical[t * 3 + 1];
+            triangleOrder[t] = static_cast<uint32_t>(t);
+        });
+        if (invalid) {
+            qDebug() << "ModelCompressor::write: triangle index out of range";
+            return false;
+        }
+        Parallel::radixSortPairs(triangleKeys, triangleOrder, n > 0 ? 32 + Parallel::keyBitsFor(n - 1) : 1);
+        Parallel::forEach(0, triangleCount, [&](size_t t) {
+            std::memcpy(&sortedTriangles[t * 3], &canonical[size_t(triangleOrder[t]) * 3], 3 * sizeof(uint32_t));
+        });
+    }
+
+    // 按块并行编码
+    const bool normals = hasNormals;
+    const size_t vertexBlocks = blockCount(n, options.blockVertices);
+    const size_t triangleBlocks = blockCount(triangleCount, options.blockTriangles);
+    std::vector<std::vector<uint8_t>> payloads(vertexBlocks + triangleBlocks);
+    Parallel::forEach(0, payloads.size(), [&](size_t block) {
+        std::vector<uint8_t>& out = payloads[block];
+        RangeCoder::Encoder encoder(out);
+        if (block < vertexBlocks) {
+            const size_t begin = block * options.blockVertices;
+            const size_t end = std::min(n, begin + options.blockVertices);
+            out.reserve((end - begin) * 6);
+            VertexModels models;
+            uint64_t previousKey = 0;
+            uint32_t previousNormal[2] = {kNormalLevels / 2, kNormalLevels / 2};
+            int previousColor[3] = {0, 0, 0};
+            for (size_t i = begin; i < end; ++i) {
+                models.key.encode(encoder, keys[i] - previousKey);
+                previousKey = keys[i];
+                const Vertex& vertex = vertices[order[i]];
+                if (normals) {
+                    uint32_t normal[2];
+                    encodeNormal(vertex.normal, normal[0], normal[1]);
+                    for (int k = 0; k < 2; ++k) {
+                        const int32_t delta = static_cast<int32_t>(normal[k]) - static_cast<int32_t>(previousNormal[k]);
+                        models.normal[k].encode(encoder, RangeCoder::zigzag(delta));
+                        previousNormal[k] = normal[k];
+                    }
+                }
+                // 颜色：绿色差分直接编码，红 / 蓝差分再减去绿色差分（通道间去相关）
+                const int color[3] = {vertex.color.red(), vertex.color.green(), vertex.color.blue()};
+                const int green = color[1] - previousColor[1];
+                models.color[1].encode(encoder, static_cast<uint32_t>(green) & 0xffu);
+                models.color[0].encode(encoder, static_cast<uint32_t>(color[0] - previousColor[0] - green) & 0xffu);
+                models.color[2].encode(encoder, static_cast<uint32_t>(color[2] - previousColor[2] - green) & 0xffu);
+                std::copy(color, color + 3, previousColor);
+            }
+        } else {
+            const size_t begin = (block - vertexBlocks) * options.blockTriangles;
+            const size_t end = std::min(triangleCount, begin + options.blockTriangles);
+            out.reserve((end - begin) * 3);
+            TriangleModels models;
+            uint32_t previous[2] = {0, 0};
+            for (size_t t = begin; t < end; ++t) {
+                const uint32_t* tri = &sortedTriangles[t * 3];
+                models.first.encode(encoder, tri[0] - previous[0]);
+                if (tri[0] == previous[0] && t > begin) models.secondSameFirst.encode(encoder, tri[1] - previous[1]);
+                else models.second.encode(encoder, tri[1] - tri[0]);
+                models.third.encode(encoder, tri[2] - tri[0]);
+                previous[0] = tri[0];
+                previous[1] = tri[1];
+            }
+        }
+        encoder.finish();
+    }, 1);
+
+    // 写出文件
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "无法写入压缩文件: " << path;
+        return false;
+    }
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.flags = (triangleCount > 0 ? kHasTriangles : 0) | (normals ? kHasNormals : 0);
+    header.vertexCount = n;
+    header.triangleCount = triangleCount;
+    header.positionBits = static_cast<uint32_t>(options.positionBits);
+    header.blockVertices = static_cast<uint32_t>(options.blockVertices);
+    header.blockTriangles = static_cast<uint32_t>(options.blockTriangles);
+    header.vertexBlockCount = static_cast<uint32_t>(vertexBlocks);
+    header.triangleBlockCount = static_cast<uint32_t>(triangleBlocks);
+    for (int k = 0; k < 3; ++k) {
+        header.origin[k] = origin[k];
+        header.step[k] = step[k];
+    }
+    std::vector<uint64_t> sizes(payloads.size());
+    for (size_t i = 0; i < payloads.size(); ++i) sizes[i] = payloads[i].size();
+    bool ok = file.write(reinterpret_cast<const char*>(&header), sizeof(header)) == qint64(sizeof(header));
+    ok = ok && file.write(reinterpret_cast<const char*>(sizes.data()), qint64(sizes.size() * sizeof(uint64_t))) ==
+                   qint64(sizes.size() * sizeof(uint64_t));
+    for (size_t i = 0; ok && i < payloads.size(); ++i) {
+        ok = file.write(reinterpret_cast<const char*>(payloads[i].data()), qint64(payloads[i].size())) ==
+             qint64(payloads[i].size());
+    }
+    const qint64 compressedBytes = file.size();
+    file.close();
+    if (!ok) {
+        qDebug() << "写入压缩文件失败: " << path;
+        return false;
+    }
+
+    if (stats) {
+        stats->vertexCount = n;
+        stats->triangleCount = triangleCount;
+        stats->rawBytes = rawByteSize(n, triangleCount, normals);
+        stats->compressedBytes = compressedBytes;
+        stats->maxError = QVector3D(static_cast<float>(step[0] * 0.5), static_cast<float>(step[1] * 0.5),
+                                    static_cast<float>(step[2] * 0.5));
+        stats->elapsedMs = timer.elapsed();
+    }
+    return true;
+}
+
+bool ModelCompressor::read(const QString& path, std::vector<Vertex>& vertices, std::vector<unsigned int>& triangles,
+                           Stats* stats) {
+    QElapsedTimer timer;
+    timer.start();
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "无法打开压缩文件: " << path;
+        return false;
+    }
+    const qint64 fileSize = file.size();
+    FileHeader header;
+    if (fileSize < qint64(sizeof(header)) ||
+        file.read(reinterpret_cast<char*>(&header), sizeof(header)) != qint64(sizeof(header)) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+        qDebug() << "不是有效的压缩文件: " << path;
+        return false;
+    }
+    const size_t n = header.vertexCount;
+    const size_t triangleCount = header.triangleCount;
+    const size_t vertexBlocks = header.vertexBlockCount;
+    const size_t triangleBlocks = header.triangleBlockCount;
+    if (n > 0xffffffffu || header.positionBits < 8 || header.positionBits > uint32_t(Morton::kBitsPerAxis) ||
+        header.blockVertices == 0 || header.blockTriangles == 0 ||
+        vertexBlocks != blockCount(n, header.blockVertices) ||
+        triangleBlocks != blockCount(triangleCount, header.blockTriangles)) {
+        qDebug() << "压缩文件头无效: " << path;
+        return false;
+    }
+
+    // 块目录 -> 各块偏移
+    const size_t blocks = vertexBlocks + triangleBlocks;
+    const qint64 directoryBytes = qint64(blocks * sizeof(uint64_t));
+    std::vector<uint64_t> sizes(blocks);
+    if (fileSize - qint64(sizeof(header)) < directoryBytes ||
+        file.read(reinterpret_cast<char*>(sizes.data()), directoryBytes) != directoryBytes) {
+        qDebug() << "压缩文件数据不完整: " << path;
+        return false;
+    }
+    std::vector<uint64_t> offsets(blocks + 1, uint64_t(sizeof(header)) + uint64_t(directoryBytes));
+    for (size_t i = 0; i < blocks; ++i) {
+        offsets[i + 1] = offsets[i] + sizes[i];
+        if (offsets[i + 1] < offsets[i] || offsets[i + 1] > uint64_t(fileSize)) {
+            qDebug() << "压缩文件数据不完整: " << path;
+            return false;
+        }
+    }
+    uchar* data = file.map(0, fileSize);
+    QByteArray buffer;
+    if (!data) {
+        file.seek(0);
+        buffer = file.readAll();
+        data = reinterpret_cast<uchar*>(buffer.data());
+    }
+
+    const bool normals = (header.flags & kHasNormals) != 0;
+    const uint32_t positionBits = header.positionBits;
+    vertices.assign(n, Vertex());
+    triangles.assign(triangleCount * 3, 0);
+    std::atomic<bool> corrupt(false);
+    Parallel::forEach(0, blocks, [&](size_t block) {
+        RangeCoder::Decoder decoder(data + offsets[block], static_cast<size_t>(sizes[block]));
+        if (block < vertexBlocks) {
+            const size_t begin = block * header.blockVertices;
+            const size_t end = std::min(n, begin + header.blockVertices);
+            VertexModels models;
+            uint64_t key = 0;
+            uint32_t normal[2] = {kNormalLevels / 2, kNormalLevels / 2};
+            int color[3] = {0, 0, 0};
+            for (size_t i = begin; i < end; ++i) {
+                key += models.key.decode(decoder);
+                uint32_t q[3];
+                Morton::decode(key, q[0], q[1], q[2]);
+                Vertex& vertex = vertices[i];
+                vertex.position = QVector3D(static_cast<float>(header.origin[0] + q[0] * header.step[0]),
+                                            static_cast<float>(header.origin[1] + q[1] * header.step[1]),
+                                            static_cast<float>(header.origin[2] + q[2] * header.step[2]));
+                if (normals) {
+                    for (int k = 0; k < 2; ++k) {
+                        const uint32_t delta = static_cast<uint32_t>(models.normal[k].decode(decoder));
+                        normal[k] = static_cast<uint32_t>(static_cast<int32_t>(normal[k]) + RangeCoder::unzigzag(delta)) &
+                                    kNormalLevels;
+                    }
+                    vertex.normal = decodeNormal(normal[0], normal[1]);
+                }
+                const int green = static_cast<int>(models.color[1].decode(decoder));
+                color[1] = (color[1] + green) & 0xff;
+                color[0] = (color[0] + green + static_cast<int>(models.color[0].decode(decoder))) & 0xff;
+                color[2] = (color[2] + green + static_cast<int>(models.color[2].decode(decoder))) & 0xff;
+                vertex.color = QColor(color[0], color[1], color[2]);
+            }
+            if ((key >> (3 * positionBits)) != 0) corrupt = true;
+        } else {
+            const size_t begin = (block - vertexBlocks) * header.blockTriangles;
+            const size_t end = std::min(triangleCount, begin + header.blockTriangles);
+            TriangleModels models;
+            uint64_t previous[2] = {0, 0};
+            for (size_t t = begin; t < end; ++t) {
+                const uint64_t first = previous[0] + models.first.decode(decoder);
+                const uint64_t second = first == previous[0] && t > begin
+                                            ? previous[1] + models.secondSameFirst.decode(decoder)
+                                            : first + models.second.decode(decoder);
+                const uint64_t third = first + models.third.decode(decoder);
+                if (first >= n || second >= n || third >= n) {
+                    corrupt = true;
+                    break;
+                }
+                triangles[t * 3] = static_cast<unsigned int>(first);
+                triangles[t * 3 + 1] = static_cast<unsigned int>(second);
+                triangles[t * 3 + 2] = static_cast<unsigned int>(third);
+                previous[0] = first;
+                previous[1] = second;
+            }
+        }
+        if (decoder.overrun()) corrupt = true;
+    }, 1);
+    if (buffer.isEmpty()) file.unmap(data);
+    if (corrupt) {
+        qDebug() << "压缩文件数据损坏: " << path;
+        vertices.clear();
+        triangles.clear();
+        return false;
+    }
+
+    if (stats) {
+        stats->vertexCount = n;
+        stats->triangleCount = triangleCount;
+        stats->rawBytes = rawByteSize(n, triangleCount, normals);
+        stats->compressedBytes = fileSize;
+        stats->maxError = QVector3D(static_cast<float>(header.step[0] * 0.5), static_cast<float>(header.step[1] * 0.5),
+                                    static_cast<float>(header.step[2] * 0.5));
+        stats->elapsedMs = timer.elapsed();
+    }
+    return true;
+}
@@ -1,6 +1,11 @@
 #include "OpenGLWidget.h"
 #include "Model.h"
+#include "Mesh.h"
+#include "PointCloud.h"
+#include "QuantizedPoints.h"
+#include "BVH.h"
 #include "AABB.h"
+#include "ScreenSelection.h"
 #include <QMouseEvent>
 #include <QWheelEvent>
 #include <QPainter>
@@ -74,6 +79,10 @@ void OpenGLWidget::paintGL() {
     glMultMatrixf(m);
     glTranslatef(-cameraPosition_.x(), -cameraPosition_.y(), -cameraPosition_.z());
     
+    // 同步保存视图矩阵，供拾取时反投影使用
+    viewMatrix_.setToIdentity();
+    viewMatrix_.lookAt(cameraPosition_, cameraTarget_, cameraUp_);
+    
     // 绘制网格
     if (showGrid_) {
         drawGrid();
@@ -86,19 +95,50 @@ void OpenGLWidget::paintGL() {
     
     // 绘制模型
     drawModels();
+    
+    if (hasPickedPoint_) {
+        drawPickMarker();
+    }
+    
+    if (!sectionLines_.empty() || !sectionPoints_.empty()) {
+        drawSectionOverlay();
+    }
+    
+    if (selecting_) {
+        drawSelectionOutline();
+    }
 
     // （已移除调试文本覆盖层，以避免自动提示干扰渲染与终端输出）
 }
 
 void OpenGLWidget::mousePressEvent(QMouseEvent *event) {
     lastMousePos_ = event->pos();
+    pressMousePos_ = event->pos();
     mousePressed_ = true;
     mouseButton_ = event->button();
+    if (selectionTool_ != NoSelectionTool && mouseButton_ == Qt::LeftButton) {
+        selecting_ = true;
+        selectionPath_.assign(1, QPointF(event->pos()));
+    }
 }
 
 void OpenGLWidget::mouseMoveEvent(QMouseEvent *event) {
     if (!mousePressed_) return;
     
+    if (selecting_) {
+        const QPointF pos(event->pos());
+        if (selectionTool_ == RectangleSelection) {
+            selectionPath_.resize(1);
+            selectionPath_.push_back(pos);
+        } else {
+            // 套索轨迹：移动超过 2 像素才记录一个顶点
+            const QPointF& last = selectionPath_.back();
+            if (std::fabs(pos.x() - last.x()) + std::fabs(pos.y() - last.y()) > 2.0) selectionPath_.push_back(pos);
+        }
+        update();
+        return;
+    }
+    
     QPoint delta = event->pos() - lastMousePos_;
     
     if (mouseButton_ == Qt::LeftButton) {
@@ -137,6 +177,185 @@ void OpenGLWidget::mouseMoveEvent(QMouseEvent *event) {
 
 void OpenGLWidget::mouseReleaseEvent(QMouseEvent *event) {
     mousePressed_ = false;
+    if (selecting_) {
+        selecting_ = false;
+        applySelection(event->modifiers());
+        selectionPath_.clear();
+        update();
+        return;
+    }
+    // 左键几乎未拖动：视为单击拾取
+    if (event->button() == Qt::LeftButton &&
+        (event->pos() - pressMousePos_).manhattanLength() <= 3) {
+        pickAt(event->pos());
+    }
+}
+
+void OpenGLWidget::pickAt(const QPoint& pos) {
+    if (width() <= 0 || height() <= 0) return;
+    
+    // 屏幕 -> NDC -> 世界坐标（cm），再换算到模型单位（米）
+    const float ndcX = 2.0f * pos.x() / width() - 1.0f;
+    const float ndcY = 1.0f - 2.0f * pos.y() / height();
+    bool invertible = false;
+    const QMatrix4x4 inverse = (projectionMatrix_ * viewMatrix_).inverted(&invertible);
+    if (!invertible) return;
+    const QVector3D nearCm = inverse.map(QVector3D(ndcX, ndcY, -1.0f));
+    const QVector3D farCm = inverse.map(QVector3D(ndcX, ndcY, 1.0f));
+    const QVector3D origin = nearCm / unitToCm_;
+    const QVector3D direction = (farCm - nearCm) / unitToCm_;
+    
+    int bestModel = -1;
+    BVH::RayHit bestHit;
+    float bestT = 1.0f; // 只接受近远裁剪面之间的交点
+    for (size_t i = 0; i < models_.size(); ++i) {
+        auto mesh = std::dynamic_pointer_cast<Mesh>(models_[i]);
+        if (!mesh || mesh->getTriangleCount() == 0) continue;
+        BVH::RayHit hit;
+        if (mesh->getBVH().intersect(origin, direction, hit, bestT)) {
+            bestT = hit.t;
+            bestHit = hit;
+            bestModel = static_cast<int>(i);
+        }
+    }
+    
+    if (bestModel < 0) {
+        if (hasPickedPoint_) {
+            hasPickedPoint_ = false;
+            update();
+        }
+        return;
+    }
+    
+    // 最近顶点：重心坐标最大的角点
+    const auto& triangles = models_[bestModel]->getTriangles();
+    const float w = 1.0f - bestHit.u - bestHit.v;
+    int corner = 0;
+    if (bestHit.u > w && bestHit.u >= bestHit.v) corner = 1;
+    else if (bestHit.v > w && bestHit.v > bestHit.u) corner = 2;
+    const int vertexIndex = static_cast<int>(triangles[bestHit.triangle * 3 + corner]);
+    
+    pickedPointCm_ = (origin + direction * bestHit.t) * unitToCm_;
+    hasPickedPoint_ = true;
+    update();
+    emit modelPicked(bestModel, static_cast<int>(bestHit.triangle), vertexIndex, pickedPointCm_);
+}
+
+void OpenGLWidget::drawPickMarker() {
+    glDisable(GL_LIGHTING);
+    glDisable(GL_DEPTH_TEST);
+    glPointSize(10.0f);
+    glColor3f(1.0f, 0.0f, 1.0f);
+    glBegin(GL_POINTS);
+    glVertex3f(pickedPointCm_.x(), pickedPointCm_.y(), pickedPointCm_.z());
+    glEnd();
+    glPointSize(1.0f);
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_LIGHTING);
+}
+
+void OpenGLWidget::setSectionOverlay(std::vector<QVector3D>&& lineVertices, std::vector<QVector3D>&& points) {
+    sectionLines_ = std::move(lineVertices);
+    sectionPoints_ = std::move(points);
+    update();
+}
+
+void OpenGLWidget::clearSectionOverlay() {
+    if (sectionLines_.empty() && sectionPoints_.empty()) return;
+    sectionLines_.clear();
+    sectionPoints_.clear();
+    update();
+}
+
+void OpenGLWidget::drawSectionOverlay() {
+    glDisable(GL_LIGHTING);
+    glDisable(GL_DEPTH_TEST);
+    glColor3f(1.0f, 0.85f, 0.0f);
+    glLineWidth(2.0f);
+    glBegin(GL_LINES);
+    for (const QVector3D& p : sectionLines_) {
+        glVertex3f(p.x() * unitToCm_, p.y() * unitToCm_, p.z() * unitToCm_);
+    }
+    glEnd();
+    glLineWidth(1.0f);
+    glPointSize(4.0f);
+    glBegin(GL_POINTS);
+    for (const QVector3D& p : sectionPoints_) {
+        glVertex3f(p.x() * unitToCm_, p.y() * unitToCm_, p.z() * unitToCm_);
+    }
+    glEnd();
+    glPointSize(1.0f);
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_LIGHTING);
+}
+
+void OpenGLWidget::setSelectionTool(SelectionTool tool) {
+    selectionTool_ = tool;
+    selecting_ = false;
+    selectionPath_.clear();
+    update();
+}
+
+void OpenGLWidget::applySelection(Qt::KeyboardModifiers modifiers) {
+    if (selectionPath_.empty()) return;
+    std::vector<QPointF> polygon;
+    if (selectionTool_ == RectangleSelection) {
+        const QPointF a = selectionPath_.front();
+        const QPointF b = selectionPath_.back();
+        polygon = { a, QPointF(b.x(), a.y()), b, QPointF(a.x(), b.y()) };
+    } else {
+        polygon = selectionPath_;
+    }
+    ScreenSelection::Mode mode = ScreenSelection::Replace;
+    if (modifiers & Qt::ShiftModifier) mode = ScreenSelection::Add;
+    else if (modifiers & Qt::ControlModifier) mode = ScreenSelection::Subtract;
+    
+    // 模型坐标为米，视图矩阵按厘米构造
+    QMatrix4x4 toCm;
+    toCm.scale(unitToCm_);
+    const QMatrix4x4 modelToClip = projectionMatrix_ * viewMatrix_ * toCm;
+    const bool single = selectedModelIndex_ >= 0 && selectedModelIndex_ < static_cast<int>(models_.size());
+    for (size_t i = 0; i < models_.size(); ++i) {
+        if (single && static_cast<int>(i) != selectedModelIndex_) continue;
+        if (!models_[i] || models_[i]->getVertexCount() == 0) continue;
+        ScreenSelection::select(*models_[i], modelToClip, width(), height(), polygon, mode, models_[i]->selection());
+        // 隐藏的顶点不可被选中
+        if (models_[i]->hasHiddenVertices()) models_[i]->selection().intersect(models_[i]->visibleMask());
+    }
+    emit selectionChanged(single ? selectedModelIndex_ : -1);
+}
+
+void OpenGLWidget::drawSelectionOutline() {
+    if (selectionPath_.size() < 2) return;
+    // 在像素坐标系下绘制矩形 / 套索轮廓
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0, width(), height(), 0, -1, 1);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+    glDisable(GL_LIGHTING);
+    glDisable(GL_DEPTH_TEST);
+    glColor3f(1.0f, 1.0f, 0.0f);
+    glBegin(GL_LINE_LOOP);
+    if (selectionTool_ == RectangleSelection) {
+        const QPointF a = selectionPath_.front();
+        const QPointF b = selectionPath_.back();
+        glVertex2f(a.x(), a.y());
+        glVertex2f(b.x(), a.y());
+        glVertex2f(b.x(), b.y());
+        glVertex2f(a.x(), b.y());
+    } else {
+        for (const QPointF& p : selectionPath_) glVertex2f(p.x(), p.y());
+    }
+    glEnd();
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_LIGHTING);
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
 }
 
 void OpenGLWidget::wheelEvent(QWheelEvent *event) {
@@ -160,12 +379,18 @@ void OpenGLWidget::removeModel(std::shared_ptr<Model> model) {
     auto it = std::find(models_.begin(), models_.end(), model);
     if (it != models_.end()) {
         models_.erase(it);
+        hasPickedPoint_ = false;
+        sectionLines_.clear();
+        sectionPoints_.clear();
         update();
     }
 }
 
 void OpenGLWidget::clearModels() {
     models_.clear();
+    hasPickedPoint_ = false;
+    sectionLines_.clear();
+    sectionPoints_.clear();
     update();
 }
 
@@ -222,6 +447,10 @@ void OpenGLWidget::updateProjection() {
     };
     glMultMatrixf(matrix);
     
+    // 与上面的固定管线投影保持一致，供拾取使用
+    projectionMatrix_.setToIdentity();
+    projectionMatrix_.perspective(45.0f, aspect, zNear, zFar);
+    
     glMatrixMode(GL_MODELVIEW);
 }
 
@@ -269,7 +498,9 @@ void OpenGLWidget::drawAxes() {
 void OpenGLWidget::drawModels() {
     // 预计算当前帧在所选轴上的全局范围（厘米）并构造 O(1) 的映射函数
     float minCm = 0.0f, maxCm = 0.0f;
-    computeAxisRange(coordinateAxis_, minCm, maxCm);
+    if (coordinateAxis_ != kAttributeAxis) {
+        computeAxisRange(coordinateAxis_, minCm, maxCm);
+    }
     float rangeCm = maxCm - minCm;
     if (rangeCm <= 1e-8f) rangeCm = 1.0f; // 防止除零
     auto mapCoordToTFast = [&](float coord_m) -> float {
@@ -292,20 +523,119 @@ void OpenGLWidget::drawModels() {
         const auto& vertices = model->getVertices();
         const auto& triangles = model->getTriangles();
         
-        if (model->getType() == "PointCloud") {
-            // 点云：仅根据绝对坐标位置映射伪彩色（不依赖内部关系）
+        // 属性模式：按模型当前着色通道的显示范围（默认为数值范围）归一化；
+        // 没有该通道或通道没有有限值（范围无效）的模型保持原色，非有限的单个值同样按原色绘制
+        const AttributeChannel* channel = coordinateAxis_ == kAttributeAxis ? model->getActiveAttribute() : nullptr;
+        double channelMin = 0.0, channelMax = 0.0;
+        if (channel && !channel->displayRange(channelMin, channelMax)) channel = nullptr;
+        const bool pseudo = pseudoColorEnabled_ && (coordinateAxis_ != kAttributeAxis || channel);
+        const double channelRange = channelMax - channelMin > 1e-12 ? channelMax - channelMin : 1.0;
+        // 过滤 / 裁切图层隐藏的顶点不绘制（网格中含隐藏顶点的三角形不绘制），按位直接读取图层，不合成新掩码
+        const uint64_t* filterWords = model->hasMask(Model::FilterLayer) ? model->getMask(Model::FilterLayer).words() : nullptr;
+        const uint64_t* clipWords = model->hasMask(Model::ClipLayer) ? model->getMask(Model::ClipLayer).words() : nullptr;
+        auto hiddenWord = [&](size_t w) -> uint64_t {
+            return (filterWords ? filterWords[w] : 0) | (clipWords ? clipWords[w] : 0);
+        };
+        auto isHidden = [&](size_t index) {
+            return ((hiddenWord(index / BitMask::kWordBits) >> (index % BitMask::kWordBits)) & 1u) != 0;
+        };
+        const bool anyHidden = filterWords || clipWords;
+        // 选中的顶点以高亮色绘制
+        const BitMask* selection = model->hasSelection() ? &model->getSelection() : nullptr;
+        // 模型覆盖色：整个模型只设置一次颜色，不读取/改写逐顶点颜色（有选择时须逐顶点切换颜色）
+        const bool uniformColor = !pseudo && model->hasColorOverride() && !selection;
+        auto beginColors = [&]() {
+            if (!uniformColor) return;
+            const QColor c = model->getColor();
+            glColor3f(c.redF(), c.greenF(), c.blueF());
+        };
+        auto setVertexColor = [&](const Vertex& v, size_t index) {
+            const double value = channel ? channel->valueAt(index) : 0.0;
+            if (selection && selection->test(index)) {
+                glColor3f(1.0f, 0.2f, 0.2f);
+            } else if (pseudo && std::isfinite(value)) {
+                float t;
+                if (channel) {
+                    t = static_cast<float>((value - channelMin) / channelRange);
+                } else {
+                    float coord = (coordinateAxis_ == 0 ? v.position.x() : (coordinateAxis_ == 1 ? v.position.y() : v.position.z()));
+                    t = mapCoordToTFast(coord);
+                }
+                float r, g, b; computePseudoColor(t, r, g, b); glColor3f(r, g, b);
+            } else if (!uniformColor) {
+                const QColor& c = model->hasColorOverride() ? model->getColor() : v.color;
+                glColor3f(c.redF(), c.greenF(), c.blueF());
+            }
+        };
+        
+        // 紧凑点云在没有选择、隐藏与属性着色（均只作用于预览点）时直接绘制全部量化点
+        auto cloud = std::dynamic_pointer_cast<PointCloud>(model);
+        const QuantizedPoints* compact = cloud && cloud->isCompact() && !selection && !anyHidden && !channel
+                                             ? cloud->getQuantizedPoints().get() : nullptr;
+        
+        if (compact) {
+            // 16 位坐标直接作为 GL_SHORT 顶点数组，反量化（origin + q * step）并入模型视图矩阵；
+            // 21 位坐标或伪彩色按批在 CPU 端反量化后提交
             glDisable(GL_LIGHTING);
             glPointSize(3.0f);
+            beginColors();
+            const size_t total = compact->size();
+            glEnableClientState(GL_VERTEX_ARRAY);
+            if (!uniformColor) glEnableClientState(GL_COLOR_ARRAY);
+            if (compact->precision() == QuantizedPoints::Bits16 && !pseudo) {
+                const QVector3D& origin = compact->origin();
+                const QVector3D& step = compact->step();
+                glPushMatrix();
+                glScalef(unitToCm_, unitToCm_, unitToCm_);
+                glTranslatef(origin.x(), origin.y(), origin.z());
+                glScalef(step.x(), step.y(), step.z());
+                const size_t batch = size_t(1) << 24;
+                for (size_t b = 0; b < total; b += batch) {
+                    glVertexPointer(3, GL_SHORT, 0, compact->positions16() + b * 3);
+                    if (!uniformColor) glColorPointer(3, GL_UNSIGNED_BYTE, 0, compact->colors() + b * 3);
+                    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(std::min(batch, total - b)));
+                }
+                glPopMatrix();
+            } else {
+                const size_t batch = 65536;
+                std::vector<float> xyz(std::min(batch, total) * 3);
+                std::vector<float> rgb(pseudo ? xyz.size() : 0);
+                const int axis = coordinateAxis_ < 3 ? coordinateAxis_ : 2;
+                for (size_t b = 0; b < total; b += batch) {
+                    const size_t count = std::min(batch, total - b);
+                    compact->decodePositions(b, count, xyz.data());
+                    for (size_t k = 0; k < count; ++k) {
+                        if (pseudo) computePseudoColor(mapCoordToTFast(xyz[k * 3 + axis]), rgb[k * 3], rgb[k * 3 + 1], rgb[k * 3 + 2]);
+                        xyz[k * 3] *= unitToCm_;
+                        xyz[k * 3 + 1] *= unitToCm_;
+                        xyz[k * 3 + 2] *= unitToCm_;
+                    }
+                    glVertexPointer(3, GL_FLOAT, 0, xyz.data());
+                    if (pseudo) glColorPointer(3, GL_FLOAT, 0, rgb.data());
+                    else if (!uniformColor) glColorPointer(3, GL_UNSIGNED_BYTE, 0, compact->colors() + b * 3);
+                    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(count));
+                }
+            }
+            if (!uniformColor) glDisableClientState(GL_COLOR_ARRAY);
+            glDisableClientState(GL_VERTEX_ARRAY);
+            glPointSize(1.0f);
+            glEnable(GL_LIGHTING);
+        } else if (model->getType() == "PointCloud") {
+            // 点云：根据绝对坐标位置或属性通道映射伪彩色（不依赖内部关系）
+            glDisable(GL_LIGHTING);
+            glPointSize(3.0f);
+            beginColors();
             glBegin(GL_POINTS);
             for (size_t vi = 0; vi < vertices.size(); ++vi) {
-                const auto& v = vertices[vi];
-                if (pseudoColorEnabled_) {
-                    float coord = (coordinateAxis_ == 0 ? v.position.x() : (coordinateAxis_ == 1 ? v.position.y() : v.position.z()));
-                    float t = mapCoordToTFast(coord);
-                    float r, g, b; computePseudoColor(t, r, g, b); glColor3f(r, g, b);
-                } else {
-                    const QColor& c = v.color; glColor3f(c.redF(), c.greenF(), c.blueF());
+                if (anyHidden && isHidden(vi)) {
+                    // 整字隐藏时一次跳过 64 个点
+                    if (vi % BitMask::kWordBits == 0 && hiddenWord(vi / BitMask::kWordBits) == ~uint64_t(0)) {
+                        vi += BitMask::kWordBits - 1;
+                    }
+                    continue;
                 }
+                const auto& v = vertices[vi];
+                setVertexColor(v, vi);
                 glVertex3f(v.position.x() * unitToCm_,
                            v.position.y() * unitToCm_,
                            v.position.z() * unitToCm_);
@@ -317,7 +647,7 @@ void OpenGLWidget::drawModels() {
             // 绘制网格
             bool disabledLighting = false;
             bool enabledColorMaterial = false;
-            if (pseudoColorEnabled_) {
+            if (pseudo) {
                 glDisable(GL_LIGHTING);
                 disabledLighting = true;
             } else {
@@ -326,6 +656,7 @@ void OpenGLWidget::drawModels() {
                 glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
                 enabledColorMaterial = true;
             }
+            beginColors();
             glBegin(GL_TRIANGLES);
             for (size_t i = 0; i < triangles.size(); i += 3) {
                 if (i + 2 < triangles.size()) {
@@ -334,42 +665,22 @@ void OpenGLWidget::drawModels() {
                     unsigned int i3 = triangles[i + 2];
                     
                     if (i1 < vertices.size() && i2 < vertices.size() && i3 < vertices.size()) {
+                        if (anyHidden && (isHidden(i1) || isHidden(i2) || isHidden(i3))) continue;
                         const Vertex& v1 = vertices[i1];
                         const Vertex& v2 = vertices[i2];
                         const Vertex& v3 = vertices[i3];
                         
                         // 设置法线
                         glNormal3f(v1.normal.x(), v1.normal.y(), v1.normal.z());
-                        if (pseudoColorEnabled_) {
-                            float coord = (coordinateAxis_==0? v1.position.x() : (coordinateAxis_==1? v1.position.y() : v1.position.z()));
-                            float t = mapCoordToTFast(coord);
-                            float r,g,b; computePseudoColor(t, r, g, b);
-                            glColor3f(r,g,b);
-                        } else {
-                            glColor3f(v1.color.redF(), v1.color.greenF(), v1.color.blueF());
-                        }
+                        setVertexColor(v1, i1);
                         glVertex3f(v1.position.x()*unitToCm_, v1.position.y()*unitToCm_, v1.position.z()*unitToCm_);
                         
                         glNormal3f(v2.normal.x(), v2.normal.y(), v2.normal.z());
-                        if (pseudoColorEnabled_) {
-                            float coord = (coordinateAxis_==0? v2.position.x() : (coordinateAxis_==1? v2.position.y() : v2.position.z()));
-                            float t = mapCoordToTFast(coord);
-                            float r,g,b; computePseudoColor(t, r, g, b);
-                            glColor3f(r,g,b);
-                        } else {
-                            glColor3f(v2.color.redF(), v2.color.greenF(), v2.color.blueF());
-                        }
+                        setVertexColor(v2, i2);
                         glVertex3f(v2.position.x()*unitToCm_, v2.position.y()*unitToCm_, v2.position.z()*unitToCm_);
                         
                         glNormal3f(v3.normal.x(), v3.normal.y(), v3.normal.z());
-                        if (pseudoColorEnabled_) {
-                            float coord = (coordinateAxis_==0? v3.position.x() : (coordinateAxis_==1? v3.position.y() : v3.position.z()));
-                            float t = mapCoordToTFast(coord);
-                            float r,g,b; computePseudoColor(t, r, g, b);
-                            glColor3f(r,g,b);
-                        } else {
-                            glColor3f(v3.color.redF(), v3.color.greenF(), v3.color.blueF());
-                        }
+                        setVertexColor(v3, i3);
                         glVertex3f(v3.position.x()*unitToCm_, v3.position.y()*unitToCm_, v3.position.z()*unitToCm_);
                     }
                 }
@@ -0,0 +1,378 @@
+#include "PagedVertexStore.h"
+#include "Parallel.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cfloat>
+#include <atomic>
+
+namespace {
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t pointCount;
+    uint64_t chunkPoints;
+    uint64_t directoryOffset;
+    uint64_t reserved[3];
+};
+static_assert(sizeof(FileHeader) == 64, "FileHeader must stay 64 bytes");
+static_assert(sizeof(PagedVertexStore::Record) == 28, "Record must stay 28 bytes");
+
+const char kMagic[8] = { '3', 'D', 'V', 'P', 'A', 'G', 'E', '1' };
+const uint32_t kVersion = 1;
+
+} // namespace
+
+PagedVertexStore::~PagedVertexStore() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& chunk : mapped_) {
+            if (chunk) file_.unmap(reinterpret_cast<uchar*>(chunk->records));
+        }
+        mapped_.clear();
+    }
+    if (writing_) finish();
+    file_.close();
+    if (removeOnClose_) QFile::remove(file_.fileName());
+}
+
+std::shared_ptr<PagedVertexStore> PagedVertexStore::create(const QString& path, size_t chunkPoints) {
+    std::shared_ptr<PagedVertexStore> store(new PagedVertexStore());
+    store->file_.setFileName(path);
+    if (!store->file_.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        qDebug() << "无法创建外存文件: " << path;
+        return nullptr;
+    }
+    store->writable_ = true;
+    store->writing_ = true;
+    store->chunkPoints_ = std::max<size_t>(chunkPoints, 1);
+    store->pending_.reserve(store->chunkPoints_);
+    // 先写占位头部，finish 时回填
+    FileHeader header = {};
+    if (store->file_.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header)) return nullptr;
+    return store;
+}
+
+bool PagedVertexStore::append(const Vertex* vertices, size_t count) {
+    if (!writing_) return false;
+    while (count > 0) {
+        const size_t take = std::min(count, chunkPoints_ - pending_.size());
+        const size_t base = pending_.size();
+        pending_.resize(base + take);
+        Parallel::forEach(0, take, [&](size_t i) { pending_[base + i] = toRecord(vertices[i]); });
+        vertices += take;
+        count -= take;
+        if (pending_.size() == chunkPoints_ && !flushPending()) return false;
+    }
+    return true;
+}
+
+bool PagedVertexStore::append(const Record* records, size_t count) {
+    if (!writing_) return false;
+    while (count > 0) {
+        const size_t take = std::min(count, chunkPoints_ - pending_.size());
+        pending_.insert(pending_.end(), records, records + take);
+        records += take;
+        count -= take;
+        if (pending_.size() == chunkPoints_ && !flushPending()) return false;
+    }
+    return true;
+}
+
+bool PagedVertexStore::flushPending() {
+    if (pending_.empty()) return true;
+    ChunkInfo info;
+    info.begin = pointCount_;
+    updateChunkInfo(info, pending_.data(), pending_.size());
+    const qint64 bytes = static_cast<qint64>(pending_.size() * sizeof(Record));
+    if (file_.write(reinterpret_cast<const char*>(pending_.data()), bytes) != bytes) {
+        qDebug() << "外存文件写入失败: " << file_.fileName();
+        return false;
+    }
+    directory_.push_back(info);
+    pointCount_ += pending_.size();
+    pending_.clear();
+    return true;
+}
+
+bool PagedVertexStore::finish() {
+    if (!writing_) return false;
+    writing_ = false;
+    if (!flushPending() || !writeDirectory()) return false;
+    pending_.clear();
+    pending_.shrink_to_fit();
+    mapped_.assign(directory_.size(), nullptr);
+    lruPosition_.assign(directory_.size(), lru_.end());
+    return true;
+}
+
+bool PagedVertexStore::writeDirectory() {
+    FileHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.recordSize = sizeof(Record);
+    header.pointCount = pointCount_;
+    header.chunkPoints = chunkPoints_;
+    header.directoryOffset = sizeof(FileHeader) + pointCount_ * sizeof(Record);
+    const qint64 directoryBytes = static_cast<qint64>(directory_.size() * sizeof(ChunkInfo));
+    bool ok = file_.seek(static_cast<qint64>(header.directoryOffset)) &&
+              file_.write(reinterpret_cast<const char*>(directory_.data()), directoryBytes) == directoryBytes &&
+              file_.seek(0) &&
+              file_.write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header);
+    ok = ok && file_.flush();
+    if (!ok) qDebug() << "外存文件目录写入失败: " << file_.fileName();
+    return ok;
+}
+
+std::shared_ptr<PagedVertexStore> PagedVertexStore::open(const QString& path) {
+    std::shared_ptr<PagedVertexStore> store(new PagedVertexStore());
+    store->file_.setFileName(path);
+    store->writable_ = store->file_.open(QIODevice::ReadWrite);
+    if (!store->writable_ && !store->file_.open(QIODevice::ReadOnly)) {
+        qDebug() << "无法打开外存文件: " << path;
+        return nullptr;
+    }
+
+    FileHeader header = {};
+    if (store->file_.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.recordSize != sizeof(Record) || header.chunkPoints == 0) {
+        qDebug() << "不是有效的外存顶点文件: " << path;
+        return nullptr;
+    }
+    const uint64_t chunkCount = (header.pointCount + header.chunkPoints - 1) / header.chunkPoints;
+    if (header.directoryOffset != sizeof(FileHeader) + header.pointCount * sizeof(Record) ||
+        static_cast<uint64_t>(store->file_.size()) < header.directoryOffset + chunkCount * sizeof(ChunkInfo)) {
+        qDebug() << "外存顶点文件不完整: " << path;
+        return nullptr;
+    }
+    store->pointCount_ = header.pointCount;
+    store->chunkPoints_ = header.chunkPoints;
+    store->directory_.resize(chunkCount);
+    const qint64 directoryBytes = static_cast<qint64>(chunkCount * sizeof(ChunkInfo));
+    if (!store->file_.seek(static_cast<qint64>(header.directoryOffset)) ||
+        store->file_.read(reinterpret_cast<char*>(store->directory_.data()), directoryBytes) != directoryBytes) {
+        qDebug() << "外存顶点文件目录读取失败: " << path;
+        return nullptr;
+    }
+    store->mapped_.assign(chunkCount, nullptr);
+    store->lruPosition_.assign(chunkCount, store->lru_.end());
+    return store;
+}
+
+void PagedVertexStore::updateChunkInfo(ChunkInfo& info, const Record* records, size_t count) const {
+    info.count = count;
+    for (int k = 0; k < 3; ++k) {
+        info.min[k] = FLT_MAX;
+        info.max[k] = -FLT_MAX;
+        info.sum[k] = 0.0;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            const float value = records[i].position[k];
+            info.min[k] = std::min(info.min[k], value);
+            info.max[k] = std::max(info.max[k], value);
+            info.sum[k] += value;
+        }
+    }
+}
+
+AABB PagedVertexStore::chunkBounds(size_t chunk) const {
+    const ChunkInfo& info = directory_[chunk];
+    if (!transformed_) {
+        return AABB(QVector3D(info.min[0], info.min[1], info.min[2]), QVector3D(info.max[0], info.max[1], info.max[2]));
+    }
+    AABB box;
+    for (int corner = 0; corner < 8; ++corner) {
+        box.expand(pendingTransform_.map(QVector3D(corner & 1 ? info.max[0] : info.min[0],
+                                                   corner & 2 ? info.max[1] : info.min[1],
+                                                   corner & 4 ? info.max[2] : info.min[2])));
+    }
+    return box;
+}
+
+AABB PagedVertexStore::bounds() const {
+    AABB box;
+    for (size_t c = 0; c < directory_.size(); ++c) {
+        if (directory_[c].count == 0) continue;
+        const AABB chunk = chunkBounds(c);
+        box.expand(chunk.min);
+        box.expand(chunk.max);
+    }
+    return box;
+}
+
+QVector3D PagedVertexStore::center() const {
+    if (pointCount_ == 0) return QVector3D(0.0f, 0.0f, 0.0f);
+    double sum[3] = {0.0, 0.0, 0.0};
+    for (const ChunkInfo& info : directory_) {
+        for (int k = 0; k < 3; ++k) sum[k] += info.sum[k];
+    }
+    const double n = static_cast<double>(pointCount_);
+    const QVector3D centroid(static_cast<float>(sum[0] / n), static_cast<float>(sum[1] / n), static_cast<float>(sum[2] / n));
+    return transformed_ ? pendingTransform_.map(centroid) : centroid;
+}
+
+qint64 PagedVertexStore::chunkOffset(size_t chunk) const {
+    return static_cast<qint64>(sizeof(FileHeader) + directory_[chunk].begin * sizeof(Record));
+}
+
+void PagedVertexStore::setWorkingSetLimit(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    workingSetLimit_ = bytes;
+    evict();
+}
+
+size_t PagedVertexStore::residentBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return residentBytes_;
+}
+
+PagedVertexStore::ChunkRef PagedVertexStore::acquire(size_t chunk) {
+    if (writing_ || chunk >= directory_.size()) return nullptr;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (mapped_[chunk]) {
+        lru_.splice(lru_.begin(), lru_, lruPosition_[chunk]);
+        return mapped_[chunk];
+    }
+
+    // 先淘汰再映射，给新块腾出工作集
+    const size_t bytes = directory_[chunk].count * sizeof(Record);
+    residentBytes_ += bytes;
+    evict();
+    uchar* data = file_.map(chunkOffset(chunk), static_cast<qint64>(bytes));
+    if (!data) {
+        residentBytes_ -= bytes;
+        qDebug() << "外存块映射失败: " << file_.fileName() << "块" << chunk;
+        return nullptr;
+    }
+    auto mappedChunk = std::make_shared<Chunk>();
+    mappedChunk->index = chunk;
+    mappedChunk->records = reinterpret_cast<Record*>(data);
+    mappedChunk->count = directory_[chunk].count;
+    mapped_[chunk] = mappedChunk;
+    lru_.push_front(chunk);
+    lruPosition_[chunk] = lru_.begin();
+    return mappedChunk;
+}
+
+void PagedVertexStore::evict() {
+    // 从最久未用的一端解除映射；仍被调用方持有（引用计数大于 1）的块跳过。
+    // 新的引用只在持锁时产生，因此计数为 1 时可以安全解除
+    auto it = lru_.end();
+    while (residentBytes_ > workingSetLimit_ && it != lru_.begin()) {
+        --it;
+        const size_t chunk = *it;
+        if (mapped_[chunk].use_count() > 1) continue;
+        file_.unmap(reinterpret_cast<uchar*>(mapped_[chunk]->records));
+        residentBytes_ -= mapped_[chunk]->count * sizeof(Record);
+        mapped_[chunk].reset();
+        lruPosition_[chunk] = lru_.end();
+        it = lru_.erase(it);
+    }
+}
+
+bool PagedVertexStore::forEachChunk(const std::function<void(const Chunk&)>& func) {
+    if (writing_) return false;
+    std::atomic<bool> ok(true);
+    Parallel::forEach(0, directory_.size(), [&](size_t c) {
+        ChunkRef chunk = acquire(c);
+        if (!chunk) {
+            ok = false;
+            return;
+        }
+        func(*chunk);
+    }, 1);
+    return ok;
+}
+
+void PagedVertexStore::transform(const QMatrix4x4& matrix) {
+    pendingTransform_ = matrix * pendingTransform_;
+    pendingNormalMatrix_ = pendingTransform_.normalMatrix();
+    transformed_ = !pendingTransform_.isIdentity();
+}
+
+void PagedVertexStore::setColor(const QColor& color) {
+    overrideColor_[0] = static_cast<uint8_t>(color.red());
+    overrideColor_[1] = static_cast<uint8_t>(color.green());
+    overrideColor_[2] = static_cast<uint8_t>(color.blue());
+    overrideColor_[3] = static_cast<uint8_t>(color.alpha());
+    colorOverride_ = true;
+}
+
+bool PagedVertexStore::bake(std::atomic<size_t>* bakedChunks) {
+    if (!writable_) return false;
+    if (!hasPendingChanges()) return true;
+    const bool ok = forEachChunk([&](const Chunk& chunk) {
+        for (size_t i = 0; i < chunk.count; ++i) {
+            Record& record = chunk.records[i];
+            if (transformed_) {
+                const QVector3D p = pendingTransform_.map(QVector3D(record.position[0], record.position[1], record.position[2]));
+                const QVector3D n = transformNormal(pendingNormalMatrix_, QVector3D(record.normal[0], record.normal[1], record.normal[2]));
+                for (int k = 0; k < 3; ++k) {
+                    record.position[k] = p[k];
+                    record.normal[k] = n[k];
+                }
+            }
+            if (colorOverride_) std::memcpy(record.color, overrideColor_, sizeof(overrideColor_));
+        }
+        // 每块只由一个线程处理，目录项可直接改写
+        if (transformed_) updateChunkInfo(directory_[chunk.index], chunk.records, chunk.count);
+        if (bakedChunks) ++*bakedChunks;
+    });
+    // 部分块失败时文件中的记录已不一致，仍清除待应用状态以免重复应用到已写回的块
+    const bool directoryOk = !transformed_ || writeDirectory();
+    pendingTransform_.setToIdentity();
+    pendingNormalMatrix_ = pendingTransform_.normalMatrix();
+    transformed_ = false;
+    colorOverride_ = false;
+    return ok && directoryOk;
+}
+
+Vertex PagedVertexStore::decode(const Record& record) const {
+    Vertex vertex = toVertex(record);
+    if (transformed_) {
+        vertex.position = pendingTransform_.map(vertex.position);
+        vertex.normal = transformNormal(pendingNormalMatrix_, vertex.normal);
+    }
+    if (colorOverride_) vertex.color = QColor(overrideColor_[0], overrideColor_[1], overrideColor_[2], overrideColor_[3]);
+    return vertex;
+}
+
+std::vector<Vertex> PagedVertexStore::sample(size_t maxPoints) {
+    std::vector<Vertex> points;
+    if (writing_ || pointCount_ == 0 || maxPoints == 0) return points;
+    // 取编号为 stride 整数倍的点；各块的输出位置可由编号直接算出，按块并行写入
+    const size_t stride = (pointCount_ + maxPoints - 1) / maxPoints;
+    points.resize((pointCount_ + stride - 1) / stride);
+    forEachChunk([&](const Chunk& chunk) {
+        const size_t begin = directory_[chunk.index].begin;
+        size_t out = (begin + stride - 1) / stride;
+        for (size_t i = out * stride - begin; i < chunk.count; i += stride) {
+            points[out++] = decode(chunk.records[i]);
+        }
+    });
+    return points;
+}
+
+PagedVertexStore::Record PagedVertexStore::toRecord(const Vertex& vertex) {
+    Record record;
+    for (int k = 0; k < 3; ++k) {
+        record.position[k] = vertex.position[k];
+        record.normal[k] = vertex.normal[k];
+    }
+    record.color[0] = static_cast<uint8_t>(vertex.color.red());
+    record.color[1] = static_cast<uint8_t>(vertex.color.green());
+    record.color[2] = static_cast<uint8_t>(vertex.color.blue());
+    record.color[3] = static_cast<uint8_t>(vertex.color.alpha());
+    return record;
+}
+
+Vertex PagedVertexStore::toVertex(const Record& record) {
+    return Vertex(QVector3D(record.position[0], record.position[1], record.position[2]),
+                  QVector3D(record.normal[0], record.normal[1], record.normal[2]),
+                  QColor(record.color[0], record.color[1], record.color[2], record.color[3]));
+}
@@ -1,4 +1,8 @@
 #include "PointCloud.h"
+#include "PagedVertexStore.h"
+#include "QuantizedPoints.h"
+#include "Morton.h"
+#include "Parallel.h"
 #include <QDebug>
 
 int PointCloud::pointCloudCount_ = 0;
@@ -6,6 +10,7 @@ int PointCloud::pointCloudCount_ = 0;
 PointCloud::PointCloud(const QString& name)
     : Model(name),
       statsDirty_(true),
+      spatiallySorted_(false),
       cachedCenter_(0.0f, 0.0f, 0.0f),
       cachedAABB_() {
     pointCloudCount_++;
@@ -17,33 +22,232 @@ PointCloud::~PointCloud() {
 
 void PointCloud::addPoint(const QVector3D& point, const QColor& color) {
     vertices_.emplace_back(point, color);
+    if (!attributes_.empty()) syncAttributeSizes();
+    spatiallySorted_ = false;
     markDirty();
 }
 
 void PointCloud::addPoint(const Vertex& vertex) {
     vertices_.push_back(vertex);
+    if (!attributes_.empty()) syncAttributeSizes();
+    spatiallySorted_ = false;
     markDirty();
 }
 
 void PointCloud::clear() {
     vertices_.clear();
+    quantized_.reset();
+    clearAttributes();
     cachedAABB_.reset();
     cachedCenter_ = QVector3D(0.0f, 0.0f, 0.0f);
+    spatiallySorted_ = false;
     markDirty();
 }
 
+void PointCloud::setPoints(std::vector<Vertex>&& points) {
+    vertices_ = std::move(points);
+    dropMismatchedAttributes();
+    spatiallySorted_ = false;
+    markDirty();
+}
+
+void PointCloud::setPointColors(const std::vector<QColor>& colors) {
+    if (colors.size() != vertices_.size()) return;
+    Parallel::forEach(0, vertices_.size(), [&](size_t i) {
+        vertices_[i].color = colors[i];
+    });
+}
+
+void PointCloud::sortByMorton() {
+    const size_t n = vertices_.size();
+    if (n < 2 || n > 0xffffffffu) return;
+    
+    // 包围盒（平移/缩放只整体变换坐标，不影响 Morton 顺序）
+    const AABB box = computeAABB();
+    
+    std::vector<uint64_t> keys(n);
+    std::vector<uint32_t> order(n);
+    Parallel::forEach(0, n, [&](size_t i) {
+        keys[i] = Morton::encode(vertices_[i].position, box);
+        order[i] = static_cast<uint32_t>(i);
+    });
+    Parallel::radixSortPairs(keys, order, 3 * Morton::kBitsPerAxis);
+    
+    std::vector<Vertex> sorted(n);
+    Parallel::forEach(0, n, [&](size_t i) {
+        sorted[i] = vertices_[order[i]];
+    });
+    vertices_.swap(sorted);
+    remapAttributes(order);
+    spatiallySorted_ = true;
+    chunksDirty_ = true;
+}
+
+std::vector<std::shared_ptr<PointCloud>> PointCloud::splitByLabels(const std::vector<uint32_t>& pointLabels,
+                                                                   size_t labelCount) const {
+    std::vector<std::shared_ptr<PointCloud>> parts;
+    const size_t n = vertices_.size();
+    if (pointLabels.size() != n || labelCount == 0) return parts;
+    
+    // 计数排序：按标签把点分桶，桶内保持原顺序
+    std::vector<size_t> offsets(labelCount + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        if (pointLabels[i] < labelCount) ++offsets[pointLabels[i] + 1];
+    }
+    for (size_t c = 0; c < labelCount; ++c) offsets[c + 1] += offsets[c];
+    std::vector<uint32_t> pointOrder(offsets[labelCount]);
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        if (pointLabels[i] < labelCount) pointOrder[cursor[pointLabels[i]]++] = static_cast<uint32_t>(i);
+    }
+    
+    // 模型构造会修改静态计数器，须在串行部分创建
+    parts.reserve(labelCount);
+    for (size_t c = 0; c < labelCount; ++c) {
+        parts.push_back(std::make_shared<PointCloud>(QString("%1_%2").arg(name_).arg(c + 1)));
+    }
+    
+    Parallel::forEach(0, labelCount, [&](size_t c) {
+        const std::vector<uint32_t> newToOld(pointOrder.begin() + offsets[c], pointOrder.begin() + offsets[c + 1]);
+        if (newToOld.empty()) return;
+        std::vector<Vertex> points(newToOld.size());
+        for (size_t i = 0; i < newToOld.size(); ++i) points[i] = vertices_[newToOld[i]];
+        
+        PointCloud& part = *parts[c];
+        part.setPoints(std::move(points));
+        part.color_ = color_;
+        part.colorOverride_ = colorOverride_;
+        for (const auto& channel : attributes_) {
+            part.addAttribute(channel.gathered(newToOld));
+        }
+        part.activeAttribute_ = activeAttribute_;
+    }, 1);
+    return parts;
+}
+
+std::vector<PointCloud::PointChunk> PointCloud::computeChunks(size_t pointsPerChunk) const {
+    std::vector<PointChunk> chunks;
+    const size_t n = vertices_.size();
+    if (n == 0) return chunks;
+    if (pointsPerChunk == 0) pointsPerChunk = n;
+    
+    chunks.resize((n + pointsPerChunk - 1) / pointsPerChunk);
+    Parallel::forEach(0, chunks.size(), [&](size_t c) {
+        PointChunk& chunk = chunks[c];
+        chunk.begin = c * pointsPerChunk;
+        chunk.end = std::min(n, chunk.begin + pointsPerChunk);
+        for (size_t i = chunk.begin; i < chunk.end; ++i) {
+            chunk.bounds.expand(vertices_[i].position);
+        }
+    }, 16);
+    return chunks;
+}
+
+const std::vector<PointCloud::PointChunk>& PointCloud::getChunks() const {
+    if (chunksDirty_) {
+        cachedChunks_ = computeChunks(kChunkPoints);
+        chunksDirty_ = false;
+    }
+    return cachedChunks_;
+}
+
+std::shared_ptr<PointCloud> PointCloud::extractPoints(const BitMask& mask, const QString& name) const {
+    // 模型构造会修改静态计数器，在调用线程创建
+    auto part = std::make_shared<PointCloud>(name);
+    if (mask.size() != vertices_.size()) return part;
+    const std::vector<uint32_t> newToOld = mask.indices(true);
+    std::vector<Vertex> points(newToOld.size());
+    Parallel::forEach(0, newToOld.size(), [&](size_t i) { points[i] = vertices_[newToOld[i]]; });
+    part->setPoints(std::move(points));
+    part->color_ = color_;
+    part->colorOverride_ = colorOverride_;
+    for (const auto& channel : attributes_) {
+        part->addAttribute(channel.gathered(newToOld));
+    }
+    part->activeAttribute_ = activeAttribute_;
+    part->spatiallySorted_ = spatiallySorted_;
+    return part;
+}
+
+void PointCloud::removePoints(const BitMask& mask) {
+    if (mask.size() != vertices_.size()) return;
+    const std::vector<uint32_t> newToOld = mask.indices(false);
+    if (newToOld.size() == vertices_.size()) return;
+    std::vector<Vertex> kept(newToOld.size());
+    Parallel::forEach(0, newToOld.size(), [&](size_t i) { kept[i] = vertices_[newToOld[i]]; });
+    vertices_.swap(kept);
+    // 有序序列的子序列仍然有序，空间排序状态保持不变
+    remapAttributes(newToOld);
+    markDirty();
+}
+
+void PointCloud::attachPagedStore(std::shared_ptr<PagedVertexStore> store, size_t previewPoints) {
+    pagedStore_ = std::move(store);
+    setPoints(pagedStore_ ? pagedStore_->sample(previewPoints) : std::vector<Vertex>());
+}
+
+size_t PointCloud::getTotalPointCount() const {
+    if (pagedStore_) return pagedStore_->size();
+    if (quantized_) return quantized_->size();
+    return vertices_.size();
+}
+
+bool PointCloud::setCompactStorage(int precisionBits, size_t previewPoints) {
+    if (pagedStore_) {
+        qDebug() << "PointCloud::setCompactStorage: paged point cloud is not supported";
+        return false;
+    }
+    if (quantized_) clearCompactStorage();
+    if (vertices_.empty()) return false;
+
+    const QuantizedPoints::Precision precision =
+        precisionBits > 16 ? QuantizedPoints::Bits21 : QuantizedPoints::Bits16;
+    quantized_ = QuantizedPoints::encode(vertices_, precision);
+    // 预览与外存点云一致：全局等步长抽样
+    const size_t total = vertices_.size();
+    const size_t step = previewPoints > 0 && total > previewPoints ? (total + previewPoints - 1) / previewPoints : 1;
+    std::vector<Vertex> preview((total + step - 1) / step);
+    Parallel::forEach(0, preview.size(), [&](size_t i) {
+        quantized_->decode(i * step, 1, &preview[i]);
+    });
+    setPoints(std::move(preview));
+    return true;
+}
+
+void PointCloud::clearCompactStorage() {
+    if (!quantized_) return;
+    std::vector<Vertex> points(quantized_->size());
+    const size_t chunks = Parallel::chunkCount(points.size());
+    Parallel::forChunks(points.size(), chunks, [&](size_t, size_t b, size_t e) {
+        quantized_->decode(b, e - b, points.data() + b);
+    });
+    quantized_.reset();
+    setPoints(std::move(points));
+}
+
 QVector3D PointCloud::computeCenter() const {
+    // 外存点云由块目录合并，不读取顶点数据
+    if (pagedStore_) return pagedStore_->center();
+    if (quantized_) return quantized_->center();
     updateStatistics();
     return cachedCenter_;
 }
 
 AABB PointCloud::computeAABB() const {
+    if (pagedStore_) return pagedStore_->bounds();
+    if (quantized_) return quantized_->bounds();
     updateStatistics();
     return cachedAABB_;
 }
 
 void PointCloud::translate(const QVector3D& offset) {
     Model::translate(offset);
+    if (pagedStore_) {
+        QMatrix4x4 matrix;
+        matrix.translate(offset);
+        pagedStore_->transform(matrix);
+    }
+    if (quantized_) quantized_->translate(offset);
     markDirty();
 }
 
@@ -59,9 +263,28 @@ void PointCloud::rotate(const QVector3D& axis, float angle) {
 
 void PointCloud::scale(const QVector3D& factors) {
     Model::scale(factors);
+    if (pagedStore_) {
+        QMatrix4x4 matrix;
+        matrix.scale(factors);
+        pagedStore_->transform(matrix);
+    }
+    if (quantized_) quantized_->scale(factors);
     markDirty();
 }
 
+void PointCloud::applyTransform(const QMatrix4x4& matrix) {
+    Model::applyTransform(matrix);
+    if (pagedStore_) pagedStore_->transform(matrix);
+    if (quantized_) quantized_->transform(matrix);
+    markDirty();
+}
+
+void PointCloud::updateVertexColors(const QColor& color) {
+    Model::updateVertexColors(color);
+    if (pagedStore_) pagedStore_->setColor(color);
+    if (quantized_) quantized_->setColor(color);
+}
+
 void PointCloud::update() {
     updateStatistics();
 }
@@ -74,6 +297,7 @@ void PointCloud::render() {
 
 void PointCloud::markDirty() const {
     statsDirty_ = true;
+    chunksDirty_ = true;
 }
 
 void PointCloud::updateStatistics() const {
@@ -0,0 +1,250 @@
+#include "QuantizedPoints.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const uint64_t kMask21 = (uint64_t(1) << 21) - 1;
+
+// 分块统计的部分结果
+struct ErrorPartial {
+    float maxError[3] = {0.0f, 0.0f, 0.0f};
+    double sumSquared = 0.0;
+};
+
+struct BoundsPartial {
+    AABB bounds;
+    double sum[3] = {0.0, 0.0, 0.0};
+};
+
+} // namespace
+
+std::shared_ptr<QuantizedPoints> QuantizedPoints::encode(const std::vector<Vertex>& vertices, Precision precision) {
+    std::shared_ptr<QuantizedPoints> points(new QuantizedPoints());
+    points->precision_ = precision;
+    points->count_ = vertices.size();
+    if (precision == Bits16) points->positions16_.resize(vertices.size() * 3);
+    else points->positions21_.resize(vertices.size());
+    points->colors_.resize(vertices.size() * 3);
+
+    // 包围盒与重心（分块并行归约）
+    const size_t chunks = Parallel::chunkCount(vertices.size());
+    std::vector<BoundsPartial> partials(chunks);
+    Parallel::forChunks(vertices.size(), chunks, [&](size_t c, size_t b, size_t e) {
+        BoundsPartial& partial = partials[c];
+        for (size_t i = b; i < e; ++i) {
+            const QVector3D& p = vertices[i].position;
+            partial.bounds.expand(p);
+            for (int k = 0; k < 3; ++k) partial.sum[k] += p[k];
+        }
+    });
+    double sum[3] = {0.0, 0.0, 0.0};
+    for (const BoundsPartial& partial : partials) {
+        if (partial.bounds.isValid()) {
+            points->bounds_.expand(partial.bounds.min);
+            points->bounds_.expand(partial.bounds.max);
+        }
+        for (int k = 0; k < 3; ++k) sum[k] += partial.sum[k];
+    }
+    if (!vertices.empty()) {
+        const double n = static_cast<double>(vertices.size());
+        points->center_ = QVector3D(static_cast<float>(sum[0] / n), static_cast<float>(sum[1] / n),
+                                    static_cast<float>(sum[2] / n));
+    } else {
+        points->bounds_ = AABB(QVector3D(0, 0, 0), QVector3D(0, 0, 0));
+    }
+
+    points->quantize([&](size_t i) { return vertices[i].position; });
+    uint8_t* colors = points->colors_.data();
+    Parallel::forEach(0, vertices.size(), [&](size_t i) {
+        const QColor& c = vertices[i].color;
+        colors[i * 3] = static_cast<uint8_t>(c.red());
+        colors[i * 3 + 1] = static_cast<uint8_t>(c.green());
+        colors[i * 3 + 2] = static_cast<uint8_t>(c.blue());
+    });
+    return points;
+}
+
+template <typename Source>
+void QuantizedPoints::quantize(const Source& source) {
+    const uint32_t levels = (uint32_t(1) << precision_) - 1;
+    float inverse[3];
+    for (int k = 0; k < 3; ++k) {
+        const float extent = bounds_.max[k] - bounds_.min[k];
+        step_[k] = extent > 0.0f ? extent / static_cast<float>(levels) : 0.0f;
+        inverse[k] = extent > 0.0f ? static_cast<float>(levels) / extent : 0.0f;
+    }
+    // 16 位存为有符号数 q - 32768，把偏移并入 origin，反量化仍是一次乘加
+    origin_ = precision_ == Bits16 ? bounds_.min + step_ * 32768.0f : bounds_.min;
+    error_.bound = step_ * 0.5f;
+
+    const QVector3D minimum = bounds_.min;
+    const size_t chunks = Parallel::chunkCount(count_);
+    std::vector<ErrorPartial> partials(chunks);
+    Parallel::forChunks(count_, chunks, [&](size_t c, size_t b, size_t e) {
+        ErrorPartial& partial = partials[c];
+        for (size_t i = b; i < e; ++i) {
+            const QVector3D p = source(i);
+            uint32_t q[3];
+            for (int k = 0; k < 3; ++k) {
+                const float scaled = std::round((p[k] - minimum[k]) * inverse[k]);
+                q[k] = static_cast<uint32_t>(std::min(std::max(scaled, 0.0f), static_cast<float>(levels)));
+            }
+            if (precision_ == Bits16) {
+                for (int k = 0; k < 3; ++k) positions16_[i * 3 + k] = static_cast<int16_t>(static_cast<int32_t>(q[k]) - 32768);
+            } else {
+                positions21_[i] = uint64_t(q[0]) | (uint64_t(q[1]) << 21) | (uint64_t(q[2]) << 42);
+            }
+            const QVector3D decoded = position(i);
+            for (int k = 0; k < 3; ++k) {
+                const float error = std::fabs(decoded[k] - p[k]);
+                partial.maxError[k] = std::max(partial.maxError[k], error);
+                partial.sumSquared += static_cast<double>(error) * error;
+            }
+        }
+    });
+    QVector3D maxError(0.0f, 0.0f, 0.0f);
+    double sumSquared = 0.0;
+    for (const ErrorPartial& partial : partials) {
+        for (int k = 0; k < 3; ++k) maxError[k] = std::max(maxError[k], partial.maxError[k]);
+        sumSquared += partial.sumSquared;
+    }
+    // 重新量化时与上一次的误差叠加（三角不等式上界）
+    error_.maxError += maxError;
+    const double rms = count_ > 0 ? std::sqrt(sumSquared / static_cast<double>(count_)) : 0.0;
+    error_.rmsError += rms;
+}
+
+size_t QuantizedPoints::byteSize() const {
+    return positions16_.size() * sizeof(int16_t) + positions21_.size() * sizeof(uint64_t) + colors_.size();
+}
+
+QVector3D QuantizedPoints::position(size_t i) const {
+    if (precision_ == Bits16) {
+        const int16_t* q = &positions16_[i * 3];
+        return QVector3D(origin_.x() + q[0] * step_.x(), origin_.y() + q[1] * step_.y(), origin_.z() + q[2] * step_.z());
+    }
+    const uint64_t packed = positions21_[i];
+    return QVector3D(origin_.x() + static_cast<float>(packed & kMask21) * step_.x(),
+                     origin_.y() + static_cast<float>((packed >> 21) & kMask21) * step_.y(),
+                     origin_.z() + static_cast<float>((packed >> 42) & kMask21) * step_.z());
+}
+
+void QuantizedPoints::decodePositions(size_t begin, size_t count, float* xyz) const {
+    // 无分支的逐分量乘加，循环体不含函数调用，编译器可向量化
+    const float ox = origin_.x(), oy = origin_.y(), oz = origin_.z();
+    const float sx = step_.x(), sy = step_.y(), sz = step_.z();
+    if (precision_ == Bits16) {
+        const int16_t* q = positions16_.data() + begin * 3;
+        for (size_t i = 0; i < count; ++i) {
+            xyz[i * 3] = ox + static_cast<float>(q[i * 3]) * sx;
+            xyz[i * 3 + 1] = oy + static_cast<float>(q[i * 3 + 1]) * sy;
+            xyz[i * 3 + 2] = oz + static_cast<float>(q[i * 3 + 2]) * sz;
+        }
+        return;
+    }
+    const uint64_t* packed = positions21_.data() + begin;
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t word = packed[i];
+        xyz[i * 3] = ox + static_cast<float>(static_cast<uint32_t>(word & kMask21)) * sx;
+        xyz[i * 3 + 1] = oy + static_cast<float>(static_cast<uint32_t>((word >> 21) & kMask21)) * sy;
+        xyz[i * 3 + 2] = oz + static_cast<float>(static_cast<uint32_t>((word >> 42) & kMask21)) * sz;
+    }
+}
+
+void QuantizedPoints::decode(size_t begin, size_t count, Vertex* out) const {
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* c = &colors_[(begin + i) * 3];
+        out[i] = Vertex(position(begin + i), QColor(c[0], c[1], c[2]));
+    }
+}
+
+void QuantizedPoints::translate(const QVector3D& offset) {
+    origin_ += offset;
+    bounds_ = AABB(bounds_.min + offset, bounds_.max + offset);
+    center_ += offset;
+}
+
+void QuantizedPoints::scale(const QVector3D& factors) {
+    origin_ *= factors;
+    step_ *= factors;
+    const QVector3D a = bounds_.min * factors;
+    const QVector3D b = bounds_.max * factors;
+    bounds_ = AABB();
+    bounds_.expand(a);
+    bounds_.expand(b);
+    center_ *= factors;
+    for (int k = 0; k < 3; ++k) {
+        const float f = std::fabs(factors[k]);
+        error_.bound[k] *= f;
+        error_.maxError[k] *= f;
+    }
+}
+
+void QuantizedPoints::transform(const QMatrix4x4& matrix) {
+    // 只含平移与轴向缩放：直接改 origin / step
+    const bool axisAligned = matrix(0, 1) == 0.0f && matrix(0, 2) == 0.0f && matrix(1, 0) == 0.0f &&
+                             matrix(1, 2) == 0.0f && matrix(2, 0) == 0.0f && matrix(2, 1) == 0.0f &&
+                             matrix(3, 0) == 0.0f && matrix(3, 1) == 0.0f && matrix(3, 2) == 0.0f &&
+                             matrix(3, 3) == 1.0f;
+    if (axisAligned) {
+        scale(QVector3D(matrix(0, 0), matrix(1, 1), matrix(2, 2)));
+        translate(QVector3D(matrix(0, 3), matrix(1, 3), matrix(2, 3)));
+        return;
+    }
+
+    // 第一遍：变换后的包围盒与重心
+    const size_t chunks = Parallel::chunkCount(count_);
+    std::vector<BoundsPartial> partials(chunks);
+    Parallel::forChunks(count_, chunks, [&](size_t c, size_t b, size_t e) {
+        BoundsPartial& partial = partials[c];
+        for (size_t i = b; i < e; ++i) {
+            const QVector3D p = matrix.map(position(i));
+            partial.bounds.expand(p);
+            for (int k = 0; k < 3; ++k) partial.sum[k] += p[k];
+        }
+    });
+    AABB bounds;
+    double sum[3] = {0.0, 0.0, 0.0};
+    for (const BoundsPartial& partial : partials) {
+        if (partial.bounds.isValid()) {
+            bounds.expand(partial.bounds.min);
+            bounds.expand(partial.bounds.max);
+        }
+        for (int k = 0; k < 3; ++k) sum[k] += partial.sum[k];
+    }
+    if (count_ == 0) return;
+    const double n = static_cast<double>(count_);
+    center_ = QVector3D(static_cast<float>(sum[0] / n), static_cast<float>(sum[1] / n), static_cast<float>(sum[2] / n));
+
+    // 第二遍：原位重新量化；每个点先按旧参数读出再写入新值。
+    // 旧误差随变换改变方向，按各轴最大值合并为各向同性的上界
+    const float previous = std::max(error_.maxError.x(), std::max(error_.maxError.y(), error_.maxError.z()));
+    error_.maxError = QVector3D(previous, previous, previous);
+    const QVector3D oldOrigin = origin_;
+    const QVector3D oldStep = step_;
+    const Precision precision = precision_;
+    const int16_t* q16 = positions16_.data();
+    const uint64_t* q21 = positions21_.data();
+    bounds_ = bounds;
+    quantize([&, oldOrigin, oldStep](size_t i) {
+        QVector3D p;
+        if (precision == Bits16) {
+            p = QVector3D(q16[i * 3], q16[i * 3 + 1], q16[i * 3 + 2]);
+        } else {
+            const uint64_t word = q21[i];
+            p = QVector3D(static_cast<float>(word & kMask21), static_cast<float>((word >> 21) & kMask21),
+                          static_cast<float>((word >> 42) & kMask21));
+        }
+        return matrix.map(oldOrigin + p * oldStep);
+    });
+}
+
+void QuantizedPoints::setColor(const QColor& color) {
+    const uint8_t rgb[3] = { static_cast<uint8_t>(color.red()), static_cast<uint8_t>(color.green()),
+                             static_cast<uint8_t>(color.blue()) };
+    Parallel::forEach(0, count_, [&](size_t i) {
+        for (int k = 0; k < 3; ++k) colors_[i * 3 + k] = rgb[k];
+    });
+}
@@ -0,0 +1,457 @@
+#include "RansacDetector.h"
+#include "Model.h"
+#include "Parallel.h"
+#include "SymmetricEigen.h"
+#include "Morton.h"
+#include <QElapsedTimer>
+#include <QDebug>
+#include <atomic>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+constexpr size_t kScoreBlock = 1024;      // 评分时每块点数，块末检查能否提前放弃
+constexpr int kHypothesesPerBatch = 64;   // 每批并行评估的假设数，批间更新自适应终止条件
+
+// 形状参数（相对参考点的坐标）：平面为 (nx, ny, nz, d)，球面为 (cx, cy, cz, r)
+struct ShapeParams {
+    double a[4] = { 0, 0, 0, 0 };
+};
+
+// 评分点（结构数组，坐标相对参考点）
+struct ScoreSet {
+    std::vector<float> x, y, z;
+    size_t size() const { return x.size(); }
+};
+
+// 按假设编号生成的随机序列（SplitMix64），结果与线程划分无关
+struct SplitMix {
+    uint64_t state;
+    uint64_t next() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+    size_t below(size_t n) { return static_cast<size_t>(next() % n); }
+};
+
+int minimalSampleSize(RansacDetector::Shape shape) {
+    return shape == RansacDetector::Sphere ? 4 : 3;
+}
+
+// 4x4 线性方程组（列主元高斯消元），奇异时返回 false
+bool solve4(double a[4][4], double b[4], double x[4]) {
+    for (int col = 0; col < 4; ++col) {
+        int pivot = col;
+        for (int row = col + 1; row < 4; ++row) {
+            if (std::fabs(a[row][col]) > std::fabs(a[pivot][col])) pivot = row;
+        }
+        if (std::fabs(a[pivot][col]) < 1e-18) return false;
+        if (pivot != col) {
+            std::swap_ranges(a[col], a[col] + 4, a[pivot]);
+            std::swap(b[col], b[pivot]);
+        }
+        for (int row = col + 1; row < 4; ++row) {
+            const double f = a[row][col] / a[col][col];
+            for (int k = col; k < 4; ++k) a[row][k] -= f * a[col][k];
+            b[row] -= f * b[col];
+        }
+    }
+    for (int row = 3; row >= 0; --row) {
+        double sum = b[row];
+        for (int k = row + 1; k < 4; ++k) sum -= a[row][k] * x[k];
+        x[row] = sum / a[row][row];
+    }
+    return true;
+}
+
+// 最小样本 -> 形状参数；样本退化（共线/共面）或球半径超出范围时返回 false
+bool fitMinimal(RansacDetector::Shape shape, const double p[4][3], double minRadius, double maxRadius,
+                ShapeParams& out) {
+    if (shape == RansacDetector::Plane) {
+        const double u[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+        const double v[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+        double n[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+        const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        const double scale = std::sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]) *
+                             std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        if (length <= 1e-6 * scale) return false;
+        for (double& c : n) c /= length;
+        out.a[0] = n[0];
+        out.a[1] = n[1];
+        out.a[2] = n[2];
+        out.a[3] = -(n[0] * p[0][0] + n[1] * p[0][1] + n[2] * p[0][2]);
+        return true;
+    }
+
+    // 球面 x²+y²+z² + Dx + Ey + Fz + G = 0 过 4 点
+    double a[4][4], b[4], x[4];
+    for (int i = 0; i < 4; ++i) {
+        a[i][0] = p[i][0];
+        a[i][1] = p[i][1];
+        a[i][2] = p[i][2];
+        a[i][3] = 1.0;
+        b[i] = -(p[i][0] * p[i][0] + p[i][1] * p[i][1] + p[i][2] * p[i][2]);
+    }
+    if (!solve4(a, b, x)) return false;
+    const double c[3] = { -0.5 * x[0], -0.5 * x[1], -0.5 * x[2] };
+    const double r2 = c[0] * c[0] + c[1] * c[1] + c[2] * c[2] - x[3];
+    if (!(r2 > 0.0) || !std::isfinite(r2)) return false;
+    out.a[0] = c[0];
+    out.a[1] = c[1];
+    out.a[2] = c[2];
+    out.a[3] = std::sqrt(r2);
+    return out.a[3] >= minRadius && out.a[3] <= maxRadius;
+}
+
+// 统计内点数；内点数加上剩余点数仍少于 bestSoFar 时提前放弃并返回 0。
+// 内层循环只做乘加与比较，按块累加命中数以便向量化
+size_t scoreHypothesis(RansacDetector::Shape shape, const ShapeParams& params, const ScoreSet& points,
+                       float threshold, const std::atomic<size_t>& bestSoFar) {
+    const size_t m = points.size();
+    const float* xs = points.x.data();
+    const float* ys = points.y.data();
+    const float* zs = points.z.data();
+    const float a0 = static_cast<float>(params.a[0]);
+    const float a1 = static_cast<float>(params.a[1]);
+    const float a2 = static_cast<float>(params.a[2]);
+    const float a3 = static_cast<float>(params.a[3]);
+    const float lower = std::max(0.0f, a3 - threshold);
+    const float lower2 = lower * lower;
+    const float upper2 = (a3 + threshold) * (a3 + threshold);
+
+    size_t hits = 0;
+    for (size_t b = 0; b < m; b += kScoreBlock) {
+        const size_t e = std::min(m, b + kScoreBlock);
+        unsigned int blockHits = 0;
+        if (shape == RansacDetector::Plane) {
+            for (size_t i = b; i < e; ++i) {
+                const float d = a0 * xs[i] + a1 * ys[i] + a2 * zs[i] + a3;
+                blockHits += std::fabs(d) <= threshold ? 1u : 0u;
+            }
+        } else {
+            for (size_t i = b; i < e; ++i) {
+                const float dx = xs[i] - a0, dy = ys[i] - a1, dz = zs[i] - a2;
+                const float d2 = dx * dx + dy * dy + dz * dz;
+                blockHits += (d2 >= lower2 && d2 <= upper2) ? 1u : 0u;
+            }
+        }
+        hits += blockHits;
+        if (hits + (m - e) < bestSoFar.load(std::memory_order_relaxed)) return 0;
+    }
+    return hits;
+}
+
+double shapeDistance(RansacDetector::Shape shape, const ShapeParams& params, const double d[3]) {
+    if (shape == RansacDetector::Plane) {
+        return params.a[0] * d[0] + params.a[1] * d[1] + params.a[2] * d[2] + params.a[3];
+    }
+    const double dx = d[0] - params.a[0], dy = d[1] - params.a[1], dz = d[2] - params.a[2];
+    return std::sqrt(dx * dx + dy * dy + dz * dz) - params.a[3];
+}
+
+// 内点矩（相对参考点）：平面用协方差 PCA，球面用代数最小二乘
+struct Moments {
+    double count = 0.0;
+    double sum[3] = { 0, 0, 0 };
+    double outer[3][3] = {};
+    double sumR2 = 0.0;
+    double sumR2d[3] = { 0, 0, 0 };
+    double residual2 = 0.0;
+
+    void add(const double d[3]) {
+        const double r2 = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+        count += 1.0;
+        for (int i = 0; i < 3; ++i) {
+            sum[i] += d[i];
+            for (int j = 0; j < 3; ++j) outer[i][j] += d[i] * d[j];
+            sumR2d[i] += r2 * d[i];
+        }
+        sumR2 += r2;
+    }
+
+    void merge(const Moments& other) {
+        count += other.count;
+        for (int i = 0; i < 3; ++i) {
+            sum[i] += other.sum[i];
+            for (int j = 0; j < 3; ++j) outer[i][j] += other.outer[i][j];
+            sumR2d[i] += other.sumR2d[i];
+        }
+        sumR2 += other.sumR2;
+        residual2 += other.residual2;
+    }
+};
+
+bool fitMoments(RansacDetector::Shape shape, const Moments& m, ShapeParams& out) {
+    if (m.count < minimalSampleSize(shape)) return false;
+    if (shape == RansacDetector::Plane) {
+        const double mean[3] = { m.sum[0] / m.count, m.sum[1] / m.count, m.sum[2] / m.count };
+        double cov[3][3];
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) cov[i][j] = m.outer[i][j] / m.count - mean[i] * mean[j];
+        double values[3], vectors[3][3];
+        symmetricEigen3x3(cov, values, vectors);
+        out.a[0] = vectors[0][0];
+        out.a[1] = vectors[0][1];
+        out.a[2] = vectors[0][2];
+        out.a[3] = -(vectors[0][0] * mean[0] + vectors[0][1] * mean[1] + vectors[0][2] * mean[2]);
+        return true;
+    }
+
+    // 行 [x y z 1]，右端 -(x²+y²+z²)
+    double a[4][4], b[4], x[4];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) a[i][j] = m.outer[i][j];
+        a[i][3] = a[3][i] = m.sum[i];
+        b[i] = -m.sumR2d[i];
+    }
+    a[3][3] = m.count;
+    b[3] = -m.sumR2;
+    if (!solve4(a, b, x)) return false;
+    const double c[3] = { -0.5 * x[0], -0.5 * x[1], -0.5 * x[2] };
+    const double r2 = c[0] * c[0] + c[1] * c[1] + c[2] * c[2] - x[3];
+    if (!(r2 > 0.0) || !std::isfinite(r2)) return false;
+    out.a[0] = c[0];
+    out.a[1] = c[1];
+    out.a[2] = c[2];
+    out.a[3] = std::sqrt(r2);
+    return true;
+}
+
+} // namespace
+
+std::vector<RansacDetector::Result> RansacDetector::detect(const Model& model, const Options& options) {
+    std::vector<Result> results;
+    QElapsedTimer timer;
+    timer.start();
+
+    const auto& vertices = model.getVertices();
+    const size_t n = vertices.size();
+    const Shape shape = options.shape;
+    const int sampleSize = minimalSampleSize(shape);
+    const float threshold = options.distanceThreshold;
+    if (n < static_cast<size_t>(sampleSize) || n > 0xffffffffu || threshold <= 0.0f) {
+        qDebug() << "RANSAC: 点数不足或参数无效";
+        return results;
+    }
+
+    // 坐标相对包围盒中心，避免大坐标下 float 评分与矩累加的精度损失
+    const AABB box = model.computeAABB();
+    const QVector3D reference = box.center();
+    // 过大的球面会在局部退化为平面，默认把半径限制在包围盒对角线的一半以内
+    const double minRadius = std::max(options.minRadius, threshold);
+    const double maxRadius = options.maxRadius > 0.0f ? options.maxRadius : 0.5 * box.size().length();
+    auto relative = [&](size_t i, double d[3]) {
+        const QVector3D& p = vertices[i].position;
+        d[0] = double(p.x()) - reference.x();
+        d[1] = double(p.y()) - reference.y();
+        d[2] = double(p.z()) - reference.z();
+    };
+
+    // 被过滤/裁切图层隐藏的点视为已占用，不参与采样与内点统计
+    std::vector<uint8_t> claimed(n, 0);
+    if (model.hasHiddenVertices()) {
+        const BitMask visible = model.visibleMask();
+        Parallel::forEach(0, n, [&](size_t i) { claimed[i] = visible.test(i) ? 0 : 1; });
+    }
+    const size_t chunks = Parallel::chunkCount(n);
+    for (int shapeIndex = 0; shapeIndex < std::max(1, options.maxShapes); ++shapeIndex) {
+        // 1. 未被已检测形状占用的点，等间隔采样为评分集（两遍：分块计数 -> 写入）
+        std::vector<size_t> chunkCounts(chunks, 0);
+        Parallel::forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) chunkCounts[c] += claimed[i] ? 0 : 1;
+        });
+        std::vector<size_t> chunkOffsets(chunks + 1, 0);
+        for (size_t c = 0; c < chunks; ++c) chunkOffsets[c + 1] = chunkOffsets[c] + chunkCounts[c];
+        const size_t remaining = chunkOffsets[chunks];
+        if (remaining < std::max<size_t>(options.minInliers, sampleSize)) break;
+
+        std::vector<uint32_t> candidates(remaining);
+        Parallel::forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+            size_t out = chunkOffsets[c];
+            for (size_t i = b; i < e; ++i) {
+                if (!claimed[i]) candidates[out++] = static_cast<uint32_t>(i);
+            }
+        });
+        const size_t scoreLimit = std::max<size_t>(options.scoreSampleCount, sampleSize);
+        const size_t stride = (remaining + scoreLimit - 1) / scoreLimit;
+        ScoreSet scoreSet;
+        const size_t m = remaining / stride;
+        if (m < static_cast<size_t>(sampleSize)) break;
+        // 评分集按 Morton 码排序，使下标相近的点在空间上也相近，供局部采样使用
+        std::vector<uint64_t> keys(m);
+        std::vector<uint32_t> order(m);
+        Parallel::forEach(0, m, [&](size_t k) {
+            order[k] = candidates[k * stride];
+            keys[k] = Morton::encode(vertices[order[k]].position, box);
+        });
+        Parallel::radixSortPairs(keys, order, 3 * Morton::kBitsPerAxis);
+        scoreSet.x.resize(m);
+        scoreSet.y.resize(m);
+        scoreSet.z.resize(m);
+        Parallel::forEach(0, m, [&](size_t k) {
+            double d[3];
+            relative(order[k], d);
+            scoreSet.x[k] = static_cast<float>(d[0]);
+            scoreSet.y[k] = static_cast<float>(d[1]);
+            scoreSet.z[k] = static_cast<float>(d[2]);
+        });
+
+        // 2. 按批并行评估假设；批间按内点率更新所需假设数 log(1-p) / log(1-w^s)。
+        // 偶数号假设全局均匀采样，奇数号假设在首点的 Morton 邻域窗口内取其余点，
+        // 使小形状（如占比很小的球面）也有较高的命中概率
+        const size_t window = std::min(m, std::max<size_t>(4 * sampleSize, m / 64));
+        std::atomic<size_t> bestScore(0);
+        ShapeParams best;
+        size_t bestCount = 0;
+        int evaluated = 0;
+        int required = std::max(1, options.maxIterations);
+        std::vector<ShapeParams> batchParams(kHypothesesPerBatch);
+        std::vector<size_t> batchScores(kHypothesesPerBatch);
+        while (evaluated < required) {
+            const int batch = std::min(kHypothesesPerBatch, required - evaluated);
+            Parallel::forEach(0, static_cast<size_t>(batch), [&](size_t h) {
+                SplitMix random{ (uint64_t(options.seed) << 40) ^ (uint64_t(shapeIndex) << 32) ^
+                                 uint64_t(evaluated + h) };
+                double sample[4][3];
+                size_t picked[4];
+                const bool local = (evaluated + h) % 2 == 1;
+                const size_t first = random.below(m);
+                const size_t windowBegin = local ? std::min(first - std::min(first, window / 2), m - window) : 0;
+                const size_t windowSize = local ? window : m;
+                for (int s = 0; s < sampleSize; ++s) {
+                    picked[s] = s == 0 ? first : windowBegin + random.below(windowSize);
+                    for (int t = 0; t < s; ++t) {
+                        if (picked[t] == picked[s]) {
+                            picked[s] = windowBegin + random.below(windowSize);
+                            t = -1;
+                        }
+                    }
+                    sample[s][0] = scoreSet.x[picked[s]];
+                    sample[s][1] = scoreSet.y[picked[s]];
+                    sample[s][2] = scoreSet.z[picked[s]];
+                }
+                batchScores[h] = 0;
+                if (!fitMinimal(shape, sample, minRadius, maxRadius, batchParams[h])) return;
+                batchScores[h] = scoreHypothesis(shape, batchParams[h], scoreSet, threshold, bestScore);
+                // 只单调增大，供其它线程剪枝
+                size_t current = bestScore.load(std::memory_order_relaxed);
+                while (batchScores[h] > current &&
+                       !bestScore.compare_exchange_weak(current, batchScores[h], std::memory_order_relaxed)) {
+                }
+            }, 1);
+
+            // 按编号顺序取严格更优者：被提前放弃的假设必然严格劣于最优，同分时取编号最小者，
+            // 因此结果与线程调度无关
+            for (int h = 0; h < batch; ++h) {
+                if (batchScores[h] > bestCount) {
+                    bestCount = batchScores[h];
+                    best = batchParams[h];
+                }
+            }
+            evaluated += batch;
+
+            const double inlierRatio = static_cast<double>(bestCount) / m;
+            if (inlierRatio > 0.0) {
+                const double all = std::pow(inlierRatio, sampleSize);
+                const double needed = all >= 1.0 ? 1.0
+                                                 : std::log(1.0 - options.confidence) / std::log(1.0 - all);
+                required = std::min(required, std::max(evaluated, static_cast<int>(std::ceil(needed))));
+            }
+        }
+        if (bestCount == 0) break;
+
+        // 3. 精化：评分集内点拟合 -> 全部剩余点的内点再拟合 -> 最终内点掩码
+        Moments sampleMoments;
+        for (size_t k = 0; k < m; ++k) {
+            const double d[3] = { scoreSet.x[k], scoreSet.y[k], scoreSet.z[k] };
+            if (std::fabs(shapeDistance(shape, best, d)) <= threshold) sampleMoments.add(d);
+        }
+        ShapeParams refined = best;
+        if (!fitMoments(shape, sampleMoments, refined)) refined = best;
+
+        auto collect = [&](const ShapeParams& params, bool writeMask, Result* result) {
+            std::vector<Moments> partials(chunks);
+            Parallel::forChunks(remaining, chunks, [&](size_t c, size_t b, size_t e) {
+                Moments& acc = partials[c];
+                for (size_t k = b; k < e; ++k) {
+                    const uint32_t i = candidates[k];
+                    double d[3];
+                    relative(i, d);
+                    const double distance = shapeDistance(shape, params, d);
+                    if (std::fabs(distance) > threshold) continue;
+                    acc.add(d);
+                    acc.residual2 += distance * distance;
+                    if (writeMask) result->inliers[i] = 1;
+                }
+            });
+            Moments total;
+            for (const Moments& acc : partials) total.merge(acc);
+            return total;
+        };
+        const Moments fullMoments = collect(refined, false, nullptr);
+        ShapeParams finalParams = refined;
+        if (!fitMoments(shape, fullMoments, finalParams)) finalParams = refined;
+
+        Result result;
+        result.shape = shape;
+        result.iterations = evaluated;
+        result.inliers.assign(n, 0);
+        const Moments finalMoments = collect(finalParams, true, &result);
+        result.inlierCount = static_cast<size_t>(finalMoments.count);
+        if (result.inlierCount < std::max<size_t>(options.minInliers, sampleSize)) break;
+
+        result.rms = static_cast<float>(std::sqrt(finalMoments.residual2 / finalMoments.count));
+        result.inlierCentroid = reference + QVector3D(static_cast<float>(finalMoments.sum[0] / finalMoments.count),
+                                                      static_cast<float>(finalMoments.sum[1] / finalMoments.count),
+                                                      static_cast<float>(finalMoments.sum[2] / finalMoments.count));
+        const QVector3D a(static_cast<float>(finalParams.a[0]), static_cast<float>(finalParams.a[1]),
+                          static_cast<float>(finalParams.a[2]));
+        if (shape == Plane) {
+            result.normal = a;
+            result.distance = static_cast<float>(finalParams.a[3]) - QVector3D::dotProduct(a, reference);
+        } else {
+            result.center = reference + a;
+            result.radius = static_cast<float>(finalParams.a[3]);
+        }
+        Parallel::forEach(0, n, [&](size_t i) {
+            if (result.inliers[i]) claimed[i] = 1;
+        });
+        result.elapsedMs = timer.elapsed();
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+QMatrix4x4 RansacDetector::levelingTransform(const Result& plane, const QVector3D& up) {
+    const QVector3D target = up.normalized();
+    QVector3D normal = plane.normal.normalized();
+    if (QVector3D::dotProduct(normal, target) < 0.0f) normal = -normal;
+
+    // Rodrigues：绕 normal × up 旋转两者夹角
+    const QVector3D axisRaw = QVector3D::crossProduct(normal, target);
+    const double s = axisRaw.length();
+    const double c = QVector3D::dotProduct(normal, target);
+    double r[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    if (s > 1e-9) {
+        const double x = axisRaw.x() / s, y = axisRaw.y() / s, z = axisRaw.z() / s;
+        const double C = 1.0 - c;
+        r[0][0] = c + x * x * C;     r[0][1] = x * y * C - z * s; r[0][2] = x * z * C + y * s;
+        r[1][0] = y * x * C + z * s; r[1][1] = c + y * y * C;     r[1][2] = y * z * C - x * s;
+        r[2][0] = z * x * C - y * s; r[2][1] = z * y * C + x * s; r[2][2] = c + z * z * C;
+    }
+
+    // p' = R (p - o) + o - up (up·o)，o 为内点重心（旋转后仍在平面上）
+    const QVector3D o = plane.inlierCentroid;
+    const QVector3D shift = o - target * QVector3D::dotProduct(target, o);
+    double t[3];
+    for (int i = 0; i < 3; ++i) {
+        t[i] = shift[i] - (r[i][0] * o.x() + r[i][1] * o.y() + r[i][2] * o.z());
+    }
+    return QMatrix4x4(float(r[0][0]), float(r[0][1]), float(r[0][2]), float(t[0]),
+                      float(r[1][0]), float(r[1][1]), float(r[1][2]), float(t[1]),
+                      float(r[2][0]), float(r[2][1]), float(r[2][2]), float(t[2]),
+                      0.0f, 0.0f, 0.0f, 1.0f);
+}
@@ -0,0 +1,244 @@
+#include "ScreenSelection.h"
+#include "Model.h"
+#include "PointCloud.h"
+#include "BitMask.h"
+#include "Parallel.h"
+#include <QDebug>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+constexpr size_t kGroup = BitMask::kWordBits;   // 每组点数，恰好对应一个掩码字
+constexpr size_t kRangePoints = 4096;           // 非点云模型的区间长度（64 的整数倍，无包围盒剔除）
+
+// 屏幕区域：像素包围盒；套索另有覆盖图，记录每个像素中心是否在多边形内（奇偶规则）
+struct Region {
+    float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+    bool rectangle = false;
+    int originX = 0, originY = 0, width = 0, height = 0;
+    std::vector<uint8_t> coverage;
+    std::vector<uint32_t> integral;   // 覆盖图的前缀和（(width+1) x (height+1)），O(1) 统计矩形内的覆盖像素数
+
+    bool contains(float x, float y) const {
+        if (!(x >= minX && x <= maxX && y >= minY && y <= maxY)) return false;
+        if (rectangle) return true;
+        const int cx = static_cast<int>(std::floor(x)) - originX;
+        const int cy = static_cast<int>(std::floor(y)) - originY;
+        if (cx < 0 || cy < 0 || cx >= width || cy >= height) return false;
+        return coverage[size_t(cy) * width + cx] != 0;
+    }
+
+    // 屏幕包围盒与区域的关系：0 部分相交，1 完全在区域外，2 完全在区域内
+    int classify(float x0, float y0, float x1, float y1) const {
+        if (x1 < minX || x0 > maxX || y1 < minY || y0 > maxY) return 1;
+        const bool inside = x0 >= minX && x1 <= maxX && y0 >= minY && y1 <= maxY;
+        if (rectangle) return inside ? 2 : 0;
+        const int cx0 = std::max(0, static_cast<int>(std::floor(x0)) - originX);
+        const int cy0 = std::max(0, static_cast<int>(std::floor(y0)) - originY);
+        const int cx1 = std::min(width - 1, static_cast<int>(std::floor(x1)) - originX);
+        const int cy1 = std::min(height - 1, static_cast<int>(std::floor(y1)) - originY);
+        if (cx0 > cx1 || cy0 > cy1) return 1;
+        const size_t stride = size_t(width) + 1;
+        const uint32_t covered = integral[(cy1 + 1) * stride + cx1 + 1] - integral[cy0 * stride + cx1 + 1] -
+                                 integral[(cy1 + 1) * stride + cx0] + integral[cy0 * stride + cx0];
+        if (covered == 0) return 1;
+        const size_t cells = size_t(cx1 - cx0 + 1) * size_t(cy1 - cy0 + 1);
+        return inside && covered == cells ? 2 : 0;
+    }
+};
+
+bool buildRegion(const std::vector<QPointF>& polygon, int viewportWidth, int viewportHeight, Region& region) {
+    if (polygon.size() < 3 || viewportWidth <= 0 || viewportHeight <= 0) return false;
+    float minX = float(polygon[0].x()), maxX = minX;
+    float minY = float(polygon[0].y()), maxY = minY;
+    for (const QPointF& p : polygon) {
+        minX = std::min(minX, float(p.x()));
+        maxX = std::max(maxX, float(p.x()));
+        minY = std::min(minY, float(p.y()));
+        maxY = std::max(maxY, float(p.y()));
+    }
+    region.minX = std::max(minX, 0.0f);
+    region.minY = std::max(minY, 0.0f);
+    region.maxX = std::min(maxX, float(viewportWidth));
+    region.maxY = std::min(maxY, float(viewportHeight));
+    if (region.minX >= region.maxX || region.minY >= region.maxY) return false;
+
+    // 4 个点且每条边水平或竖直：矩形，不需要覆盖图
+    if (polygon.size() == 4) {
+        bool axisAligned = true;
+        for (size_t k = 0; k < 4; ++k) {
+            const QPointF& a = polygon[k];
+            const QPointF& b = polygon[(k + 1) % 4];
+            if (a.x() != b.x() && a.y() != b.y()) axisAligned = false;
+        }
+        region.rectangle = axisAligned;
+        if (axisAligned) return true;
+    }
+
+    // 扫描线填充：每行取像素中心的纵坐标求与各边的交点，交点之间的像素中心在多边形内
+    region.originX = static_cast<int>(std::floor(region.minX));
+    region.originY = static_cast<int>(std::floor(region.minY));
+    region.width = static_cast<int>(std::ceil(region.maxX)) - region.originX;
+    region.height = static_cast<int>(std::ceil(region.maxY)) - region.originY;
+    region.coverage.assign(size_t(region.width) * region.height, 0);
+    Parallel::forEach(0, size_t(region.height), [&](size_t row) {
+        const double y = region.originY + double(row) + 0.5;
+        std::vector<double> crossings;
+        for (size_t k = 0; k < polygon.size(); ++k) {
+            const QPointF& a = polygon[k];
+            const QPointF& b = polygon[(k + 1) % polygon.size()];
+            if ((a.y() <= y) == (b.y() <= y)) continue;
+            crossings.push_back(a.x() + (y - a.y()) * (b.x() - a.x()) / (b.y() - a.y()));
+        }
+        std::sort(crossings.begin(), crossings.end());
+        uint8_t* line = &region.coverage[row * region.width];
+        for (size_t k = 0; k + 1 < crossings.size(); k += 2) {
+            const int first = std::max(0, static_cast<int>(std::ceil(crossings[k] - 0.5)) - region.originX);
+            const int last = std::min(region.width - 1, static_cast<int>(std::floor(crossings[k + 1] - 0.5)) - region.originX);
+            for (int x = first; x <= last; ++x) line[x] = 1;
+        }
+    }, 64);
+
+    const size_t stride = size_t(region.width) + 1;
+    region.integral.assign(stride * (size_t(region.height) + 1), 0);
+    for (int y = 0; y < region.height; ++y) {
+        uint32_t rowSum = 0;
+        for (int x = 0; x < region.width; ++x) {
+            rowSum += region.coverage[size_t(y) * region.width + x];
+            region.integral[(y + 1) * stride + x + 1] = region.integral[y * stride + x + 1] + rowSum;
+        }
+    }
+    return true;
+}
+
+// 模型坐标 -> 视口像素；点在相机后方或近/远裁剪面之外时返回 false
+struct Projector {
+    float m[4][4];
+    float width, height;
+
+    bool project(float x, float y, float z, float& sx, float& sy, bool& inDepth) const {
+        const float cx = m[0][0] * x + m[0][1] * y + m[0][2] * z + m[0][3];
+        const float cy = m[1][0] * x + m[1][1] * y + m[1][2] * z + m[1][3];
+        const float cz = m[2][0] * x + m[2][1] * y + m[2][2] * z + m[2][3];
+        const float cw = m[3][0] * x + m[3][1] * y + m[3][2] * z + m[3][3];
+        if (!(cw > 0.0f)) return false;
+        inDepth = cz >= -cw && cz <= cw;
+        sx = (cx / cw * 0.5f + 0.5f) * width;
+        sy = (0.5f - cy / cw * 0.5f) * height;
+        return true;
+    }
+};
+
+} // namespace
+
+size_t ScreenSelection::select(const Model& model, const QMatrix4x4& modelToClip, int viewportWidth,
+                               int viewportHeight, const std::vector<QPointF>& polygon, Mode mode, BitMask& mask) {
+    const auto& vertices = model.getVertices();
+    const size_t n = vertices.size();
+    if (mask.size() != n) {
+        qDebug() << "屏幕选择: 掩码长度与顶点数不一致" << mask.size() << "vs" << n;
+        return 0;
+    }
+    Region region;
+    if (!buildRegion(polygon, viewportWidth, viewportHeight, region)) {
+        // 区域为空：替换模式等于取消全部选择
+        if (mode == Replace) mask.fill(false);
+        return mask.count();
+    }
+
+    Projector projector;
+    for (int r = 0; r < 4; ++r) {
+        for (int c = 0; c < 4; ++c) projector.m[r][c] = modelToClip(r, c);
+    }
+    projector.width = static_cast<float>(viewportWidth);
+    projector.height = static_cast<float>(viewportHeight);
+
+    // 区间：点云使用缓存的 Morton 区间（带包围盒），其他模型按固定长度划分、不做剔除
+    std::vector<PointCloud::PointChunk> uniformRanges;
+    const std::vector<PointCloud::PointChunk>* ranges = nullptr;
+    if (const auto* cloud = dynamic_cast<const PointCloud*>(&model)) {
+        ranges = &cloud->getChunks();
+    } else {
+        uniformRanges.resize((n + kRangePoints - 1) / kRangePoints);
+        for (size_t c = 0; c < uniformRanges.size(); ++c) {
+            uniformRanges[c].begin = c * kRangePoints;
+            uniformRanges[c].end = std::min(n, (c + 1) * kRangePoints);
+        }
+        ranges = &uniformRanges;
+    }
+
+    uint64_t* words = mask.words();
+    Parallel::forEach(0, ranges->size(), [&](size_t c) {
+        const PointCloud::PointChunk& range = (*ranges)[c];
+        if (range.begin % kGroup != 0 || range.end > n) return;
+
+        // 整块判定：0 表示需要逐点判断，1 表示全在区域外，2 表示全在区域内
+        int wholeRange = 0;
+        if (range.bounds.isValid()) {
+            float minX = 0, minY = 0, maxX = 0, maxY = 0;
+            bool allProjected = true, allInDepth = true;
+            for (int corner = 0; corner < 8 && allProjected; ++corner) {
+                const float x = (corner & 1) ? range.bounds.max.x() : range.bounds.min.x();
+                const float y = (corner & 2) ? range.bounds.max.y() : range.bounds.min.y();
+                const float z = (corner & 4) ? range.bounds.max.z() : range.bounds.min.z();
+                float sx, sy;
+                bool inDepth = false;
+                if (!projector.project(x, y, z, sx, sy, inDepth)) {
+                    allProjected = false;
+                    break;
+                }
+                allInDepth = allInDepth && inDepth;
+                minX = corner == 0 ? sx : std::min(minX, sx);
+                maxX = corner == 0 ? sx : std::max(maxX, sx);
+                minY = corner == 0 ? sy : std::min(minY, sy);
+                maxY = corner == 0 ? sy : std::max(maxY, sy);
+            }
+            // 角点都在相机前方时，块内点的投影落在角点投影的包围盒内
+            if (allProjected) {
+                wholeRange = region.classify(minX, minY, maxX, maxY);
+                if (wholeRange == 2 && !allInDepth) wholeRange = 0;
+            }
+        }
+
+        for (size_t groupBegin = range.begin; groupBegin < range.end; groupBegin += kGroup) {
+            const size_t count = std::min(kGroup, range.end - groupBegin);
+            uint64_t bits = 0;
+            if (wholeRange == 2) {
+                bits = count == kGroup ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+            } else if (wholeRange == 0) {
+                // 结构数组：先收集坐标，再对整组做无分支的矩阵运算与透视除法，最后逐点查区域
+                float xs[kGroup], ys[kGroup], zs[kGroup];
+                for (size_t j = 0; j < count; ++j) {
+                    const QVector3D& p = vertices[groupBegin + j].position;
+                    xs[j] = p.x();
+                    ys[j] = p.y();
+                    zs[j] = p.z();
+                }
+                const auto& m = projector.m;
+                float sxs[kGroup], sys[kGroup];
+                uint8_t visible[kGroup];
+                for (size_t j = 0; j < count; ++j) {
+                    const float cx = m[0][0] * xs[j] + m[0][1] * ys[j] + m[0][2] * zs[j] + m[0][3];
+                    const float cy = m[1][0] * xs[j] + m[1][1] * ys[j] + m[1][2] * zs[j] + m[1][3];
+                    const float cz = m[2][0] * xs[j] + m[2][1] * ys[j] + m[2][2] * zs[j] + m[2][3];
+                    const float cw = m[3][0] * xs[j] + m[3][1] * ys[j] + m[3][2] * zs[j] + m[3][3];
+                    visible[j] = (cw > 0.0f) & (cz >= -cw) & (cz <= cw);
+                    const float inv = 1.0f / cw;
+                    sxs[j] = (cx * inv * 0.5f + 0.5f) * projector.width;
+                    sys[j] = (0.5f - cy * inv * 0.5f) * projector.height;
+                }
+                for (size_t j = 0; j < count; ++j) {
+                    if (visible[j] && region.contains(sxs[j], sys[j])) bits |= uint64_t(1) << j;
+                }
+            }
+            uint64_t& word = words[groupBegin / kGroup];
+            switch (mode) {
+            case Replace: word = bits; break;
+            case Add: word |= bits; break;
+            case Subtract: word &= ~bits; break;
+            }
+        }
+    }, 4);
+    return mask.count();
+}
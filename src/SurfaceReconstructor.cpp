@@ -0,0 +1,493 @@
+#include "SurfaceReconstructor.h"
+#include "Model.h"
+#include "Mesh.h"
+#include "KdTree.h"
+#include "Parallel.h"
+#include "SymmetricEigen.h"
+#include <QElapsedTimer>
+#include <QDebug>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace {
+
+constexpr int kBlockCells = 8;                    // 每块 8x8x8 个体素
+constexpr int kBlockSamples = kBlockCells + 1;    // 每块 9x9x9 个采样点（与相邻块共享一层面）
+constexpr int kCoordBits = 20;                    // 全局采样坐标每轴位数（棱键 3x20 位 + 2 位轴号）
+constexpr uint64_t kMaxCoord = (uint64_t(1) << kCoordBits) - 1;
+constexpr size_t kSpacingNeighbours = 8;          // 估计体素尺寸时使用的近邻序号
+
+// ---- Marching Cubes 查找表 ----
+// 立方体角点 i 的偏移为 (i&1, (i>>1)&1, (i>>2)&1)；棱 4a+k 沿轴 a，起点为较小编号的角点。
+// 每种角点内外组合的三角形由立方体 6 个面上的等值线段拼成闭环再扇形剖分：
+// 面上 4 条棱都有交点（二义性面）时总是切开两个内部角点，只取决于该面本身，
+// 因此共享面的两个体素选择一致，拼出的曲面没有裂缝。
+struct CubeCase {
+    uint8_t triangleCount = 0;
+    uint8_t edges[30] = {};       // 每个三角形 3 条棱，三角形法线指向场值为正的一侧
+};
+
+struct CubeTables {
+    uint8_t edgeCorners[12][2];
+    CubeCase cases[256];
+
+    CubeTables() {
+        for (int axis = 0; axis < 3; ++axis) {
+            const int u = (axis + 1) % 3, v = (axis + 2) % 3;
+            for (int k = 0; k < 4; ++k) {
+                const int a = ((k & 1) << std::min(u, v)) | ((k >> 1) << std::max(u, v));
+                edgeCorners[axis * 4 + k][0] = static_cast<uint8_t>(a);
+                edgeCorners[axis * 4 + k][1] = static_cast<uint8_t>(a | (1 << axis));
+            }
+        }
+        for (int mask = 0; mask < 256; ++mask) buildCase(mask);
+    }
+
+    int edgeBetween(int c0, int c1) const {
+        for (int e = 0; e < 12; ++e) {
+            if ((edgeCorners[e][0] == c0 && edgeCorners[e][1] == c1) ||
+                (edgeCorners[e][0] == c1 && edgeCorners[e][1] == c0)) return e;
+        }
+        return -1;
+    }
+
+    static void cornerPosition(int corner, double p[3]) {
+        p[0] = corner & 1;
+        p[1] = (corner >> 1) & 1;
+        p[2] = (corner >> 2) & 1;
+    }
+
+    void buildCase(int mask) {
+        auto inside = [mask](int corner) { return ((mask >> corner) & 1) != 0; };
+
+        // 面上的等值线段 -> 棱的邻接表（每条有交点的棱恰好属于两个面，度为 2）
+        int link[12][2];
+        int degree[12] = {};
+        auto connect = [&](int a, int b) {
+            link[a][degree[a]++] = b;
+            link[b][degree[b]++] = a;
+        };
+        for (int axis = 0; axis < 3; ++axis) {
+            const int u = (axis + 1) % 3, v = (axis + 2) % 3;
+            for (int side = 0; side < 2; ++side) {
+                const int q[4] = { (side << axis),
+                                   (side << axis) | (1 << u),
+                                   (side << axis) | (1 << u) | (1 << v),
+                                   (side << axis) | (1 << v) };
+                int active[4];
+                int activeCount = 0;
+                for (int k = 0; k < 4; ++k) {
+                    active[k] = inside(q[k]) != inside(q[(k + 1) % 4]) ? edgeBetween(q[k], q[(k + 1) % 4]) : -1;
+                    if (active[k] >= 0) ++activeCount;
+                }
+                if (activeCount == 2) {
+                    int pair[2], n = 0;
+                    for (int k = 0; k < 4; ++k) {
+                        if (active[k] >= 0) pair[n++] = active[k];
+                    }
+                    connect(pair[0], pair[1]);
+                } else if (activeCount == 4) {
+                    // 二义性面：每个内部角点与其两条邻棱构成一条线段
+                    for (int k = 0; k < 4; ++k) {
+                        if (inside(q[k])) connect(active[(k + 3) % 4], active[k]);
+                    }
+                }
+            }
+        }
+
+        // 沿邻接表走出闭环，按“内 -> 外”方向定向后扇形剖分
+        CubeCase& result = cases[mask];
+        bool visited[12] = {};
+        for (int start = 0; start < 12; ++start) {
+            if (degree[start] != 2 || visited[start]) continue;
+            int loop[12];
+            int length = 0;
+            for (int previous = -1, current = start;;) {
+                visited[current] = true;
+                loop[length++] = current;
+                const int next = link[current][0] != previous ? link[current][0] : link[current][1];
+                previous = current;
+                current = next;
+                if (current == start || length == 12) break;
+            }
+            if (length < 3) continue;
+
+            double newell[3] = { 0, 0, 0 };
+            double outward[3] = { 0, 0, 0 };
+            for (int k = 0; k < length; ++k) {
+                double a0[3], a1[3], b0[3], b1[3];
+                cornerPosition(edgeCorners[loop[k]][0], a0);
+                cornerPosition(edgeCorners[loop[k]][1], a1);
+                cornerPosition(edgeCorners[loop[(k + 1) % length]][0], b0);
+                cornerPosition(edgeCorners[loop[(k + 1) % length]][1], b1);
+                double p[3], q[3];
+                for (int i = 0; i < 3; ++i) {
+                    p[i] = 0.5 * (a0[i] + a1[i]);
+                    q[i] = 0.5 * (b0[i] + b1[i]);
+                }
+                newell[0] += (p[1] - q[1]) * (p[2] + q[2]);
+                newell[1] += (p[2] - q[2]) * (p[0] + q[0]);
+                newell[2] += (p[0] - q[0]) * (p[1] + q[1]);
+                const double sign = inside(edgeCorners[loop[k]][0]) ? 1.0 : -1.0;
+                for (int i = 0; i < 3; ++i) outward[i] += sign * (a1[i] - a0[i]);
+            }
+            if (newell[0] * outward[0] + newell[1] * outward[1] + newell[2] * outward[2] < 0.0) {
+                std::reverse(loop, loop + length);
+            }
+            for (int k = 1; k + 1 < length; ++k) {
+                uint8_t* tri = &result.edges[result.triangleCount * 3];
+                tri[0] = static_cast<uint8_t>(loop[0]);
+                tri[1] = static_cast<uint8_t>(loop[k]);
+                tri[2] = static_cast<uint8_t>(loop[k + 1]);
+                ++result.triangleCount;
+            }
+        }
+    }
+};
+
+const CubeTables& cubeTables() {
+    static const CubeTables tables;
+    return tables;
+}
+
+// 每块输出：三角形角点（按三角形顺序）所在棱的全局键与插值位置
+struct BlockOutput {
+    std::vector<uint64_t> edgeKeys;
+    std::vector<QVector3D> positions;
+};
+
+inline uint64_t packBlock(uint64_t x, uint64_t y, uint64_t z) {
+    return (x << (2 * kCoordBits)) | (y << kCoordBits) | z;
+}
+
+} // namespace
+
+std::vector<QVector3D> SurfaceReconstructor::estimateNormals(const Model& cloud, size_t neighbours) {
+    const auto& points = cloud.getVertices();
+    std::vector<QVector3D> normals(points.size(), QVector3D(0, 0, 0));
+    if (points.size() < 3) return normals;
+
+    double centroid[3] = { 0, 0, 0 };
+    for (const auto& p : points) {
+        centroid[0] += p.position.x();
+        centroid[1] += p.position.y();
+        centroid[2] += p.position.z();
+    }
+    for (double& c : centroid) c /= points.size();
+
+    KdTree tree;
+    tree.build(points);
+    Parallel::forRange(0, points.size(), [&](size_t b, size_t e) {
+        std::vector<uint32_t> indices;
+        std::vector<float> distances;
+        for (size_t i = b; i < e; ++i) {
+            const QVector3D& p = points[i].position;
+            tree.kNearest(p, std::max<size_t>(neighbours, 3), indices, distances);
+            if (indices.size() < 3) continue;
+            double sum[3] = { 0, 0, 0 };
+            double outer[3][3] = {};
+            for (uint32_t j : indices) {
+                const QVector3D d = points[j].position - p;
+                const double v[3] = { d.x(), d.y(), d.z() };
+                for (int r = 0; r < 3; ++r) {
+                    sum[r] += v[r];
+                    for (int c = 0; c < 3; ++c) outer[r][c] += v[r] * v[c];
+                }
+            }
+            const double inv = 1.0 / indices.size();
+            double cov[3][3];
+            for (int r = 0; r < 3; ++r)
+                for (int c = 0; c < 3; ++c) cov[r][c] = outer[r][c] * inv - sum[r] * sum[c] * inv * inv;
+            double values[3], vectors[3][3];
+            symmetricEigen3x3(cov, values, vectors);
+            QVector3D n(static_cast<float>(vectors[0][0]), static_cast<float>(vectors[0][1]), static_cast<float>(vectors[0][2]));
+            const QVector3D away(float(p.x() - centroid[0]), float(p.y() - centroid[1]), float(p.z() - centroid[2]));
+            if (QVector3D::dotProduct(n, away) < 0.0f) n = -n;
+            normals[i] = n;
+        }
+    }, 4096);
+    return normals;
+}
+
+float SurfaceReconstructor::suggestVoxelSize(const Model& cloud) {
+    const auto& points = cloud.getVertices();
+    if (points.size() < 2) return 0.01f;
+    KdTree tree;
+    tree.build(points);
+    const size_t samples = std::min<size_t>(points.size(), 2000);
+    const size_t stride = points.size() / samples;
+    std::vector<float> spacing(samples, 0.0f);
+    Parallel::forRange(0, samples, [&](size_t b, size_t e) {
+        std::vector<uint32_t> indices;
+        std::vector<float> distances;
+        for (size_t k = b; k < e; ++k) {
+            tree.kNearest(points[k * stride].position, kSpacingNeighbours + 1, indices, distances);
+            if (!distances.empty()) spacing[k] = std::sqrt(distances.back());
+        }
+    }, 64);
+    std::nth_element(spacing.begin(), spacing.begin() + samples / 2, spacing.end());
+    // 以第 8 近邻距离衡量局部密度（最近邻距离受随机采样波动影响太大）：
+    // 取其 3/4 时，距表面一个体素的采样点在核半径内期望约有 20 个点，出现无定义空洞的概率可以忽略
+    return std::max(spacing[samples / 2] * 0.75f, 1e-6f);
+}
+
+SurfaceReconstructor::Result SurfaceReconstructor::reconstruct(const Model& cloud, const Options& options) {
+    Result result;
+    QElapsedTimer timer;
+    timer.start();
+
+    const auto& points = cloud.getVertices();
+    const size_t n = points.size();
+    const double h = options.voxelSize;
+    const double t = std::max(1.0f, options.truncation);   // 采样坐标下的截断半径
+    if (n < 3 || n > 0xffffffffu || !(h > 0.0)) {
+        qDebug() << "表面重建: 点数不足或体素尺寸无效";
+        return result;
+    }
+
+    // 1. 法线
+    std::vector<QVector3D> normals;
+    if (options.normalSource == EstimateOutward) {
+        normals = estimateNormals(cloud, options.normalNeighbours);
+    } else {
+        normals.resize(n);
+        Parallel::forEach(0, n, [&](size_t i) {
+            const float length = points[i].normal.length();
+            normals[i] = length > 0.0f ? points[i].normal / length : QVector3D(0, 0, 0);
+        });
+    }
+
+    // 2. 采样坐标系：原点留出截断带，保证所有坐标为正
+    const AABB box = cloud.computeAABB();
+    const QVector3D origin = box.min - QVector3D(1, 1, 1) * static_cast<float>((t + 1.0) * h);
+    const QVector3D extent = box.size() / static_cast<float>(h) + QVector3D(1, 1, 1) * static_cast<float>(2.0 * t + 4.0);
+    if (extent.x() >= kMaxCoord || extent.y() >= kMaxCoord || extent.z() >= kMaxCoord) {
+        qDebug() << "表面重建: 体素过小，单轴采样数超出上限" << kMaxCoord;
+        return result;
+    }
+    auto toGrid = [&](const QVector3D& p, double u[3]) {
+        u[0] = (double(p.x()) - origin.x()) / h;
+        u[1] = (double(p.y()) - origin.y()) / h;
+        u[2] = (double(p.z()) - origin.z()) / h;
+    };
+    // 点的截断立方体 [u - t, u + t] 覆盖的块范围
+    auto blockRange = [&](const double u[3], int lo[3], int hi[3]) {
+        for (int a = 0; a < 3; ++a) {
+            lo[a] = static_cast<int>(std::ceil((u[a] - t - kBlockCells) / kBlockCells));
+            hi[a] = static_cast<int>(std::floor((u[a] + t) / kBlockCells));
+            lo[a] = std::max(lo[a], 0);
+        }
+    };
+
+    // 3. 稀疏块：每点生成其覆盖的块键（两遍：分块计数 -> 写入），并行基数排序后去重
+    const size_t chunks = Parallel::chunkCount(n);
+    std::vector<size_t> keyOffsets(chunks + 1, 0);
+    Parallel::forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+        size_t count = 0;
+        for (size_t i = b; i < e; ++i) {
+            if (normals[i].isNull()) continue;
+            double u[3];
+            int lo[3], hi[3];
+            toGrid(points[i].position, u);
+            blockRange(u, lo, hi);
+            count += size_t(hi[0] - lo[0] + 1) * size_t(hi[1] - lo[1] + 1) * size_t(hi[2] - lo[2] + 1);
+        }
+        keyOffsets[c + 1] = count;
+    });
+    for (size_t c = 0; c < chunks; ++c) keyOffsets[c + 1] += keyOffsets[c];
+    std::vector<uint64_t> blockKeys(keyOffsets[chunks]);
+    Parallel::forChunks(n, chunks, [&](size_t c, size_t b, size_t e) {
+        size_t out = keyOffsets[c];
+        for (size_t i = b; i < e; ++i) {
+            if (normals[i].isNull()) continue;
+            double u[3];
+            int lo[3], hi[3];
+            toGrid(points[i].position, u);
+            blockRange(u, lo, hi);
+            for (int z = lo[2]; z <= hi[2]; ++z)
+                for (int y = lo[1]; y <= hi[1]; ++y)
+                    for (int x = lo[0]; x <= hi[0]; ++x) blockKeys[out++] = packBlock(x, y, z);
+        }
+    });
+    if (blockKeys.empty()) {
+        qDebug() << "表面重建: 没有有效法线的点";
+        return result;
+    }
+    std::vector<uint32_t> unused(blockKeys.size(), 0);
+    Parallel::radixSortPairs(blockKeys, unused, 3 * kCoordBits);
+    std::vector<uint32_t>().swap(unused);
+    blockKeys.erase(std::unique(blockKeys.begin(), blockKeys.end()), blockKeys.end());
+    blockKeys.shrink_to_fit();
+    result.blockCount = blockKeys.size();
+    result.sampleCount = blockKeys.size() * kBlockSamples * kBlockSamples * kBlockSamples;
+
+    // 4. 按块并行：求场 -> Marching Cubes。候选点排序后按编号顺序累加，
+    // 相邻块对共享面上采样点的计算完全相同，保证结果逐位一致
+    KdTree tree;
+    tree.build(points);
+    const CubeTables& tables = cubeTables();
+    const double searchRadius = (t + 0.5 * std::sqrt(3.0) * kBlockCells) * h;
+    const double t2 = t * t;
+    const float minWeight = options.minWeight;
+    const uint64_t mask = kMaxCoord;
+
+    const size_t blockChunks = Parallel::chunkCount(blockKeys.size(), 16);
+    std::vector<BlockOutput> outputs(blockChunks);
+    Parallel::forChunks(blockKeys.size(), blockChunks, [&](size_t c, size_t b, size_t e) {
+        BlockOutput& out = outputs[c];
+        std::vector<uint32_t> candidates;
+        std::vector<float> sumWD(kBlockSamples * kBlockSamples * kBlockSamples);
+        std::vector<float> sumW(sumWD.size());
+        std::vector<float> field(sumWD.size());
+        for (size_t k = b; k < e; ++k) {
+            const int bx = static_cast<int>((blockKeys[k] >> (2 * kCoordBits)) & mask);
+            const int by = static_cast<int>((blockKeys[k] >> kCoordBits) & mask);
+            const int bz = static_cast<int>(blockKeys[k] & mask);
+            const int base[3] = { bx * kBlockCells, by * kBlockCells, bz * kBlockCells };
+            const QVector3D center = origin + QVector3D(base[0] + 0.5f * kBlockCells, base[1] + 0.5f * kBlockCells,
+                                                        base[2] + 0.5f * kBlockCells) * static_cast<float>(h);
+            tree.radiusSearch(center, static_cast<float>(searchRadius), candidates);
+            std::sort(candidates.begin(), candidates.end());
+
+            // 核加权切平面距离：w = (1 - r²/t²)²，d = n·(x - p)（以体素为单位）
+            std::fill(sumWD.begin(), sumWD.end(), 0.0f);
+            std::fill(sumW.begin(), sumW.end(), 0.0f);
+            for (uint32_t i : candidates) {
+                const QVector3D& normal = normals[i];
+                if (normal.isNull()) continue;
+                double u[3];
+                toGrid(points[i].position, u);
+                int lo[3], hi[3];
+                for (int a = 0; a < 3; ++a) {
+                    lo[a] = std::max(0, static_cast<int>(std::ceil(u[a] - t)) - base[a]);
+                    hi[a] = std::min(kBlockCells, static_cast<int>(std::floor(u[a] + t)) - base[a]);
+                }
+                for (int z = lo[2]; z <= hi[2]; ++z) {
+                    const double dz = base[2] + z - u[2];
+                    for (int y = lo[1]; y <= hi[1]; ++y) {
+                        const double dy = base[1] + y - u[1];
+                        for (int x = lo[0]; x <= hi[0]; ++x) {
+                            const double dx = base[0] + x - u[0];
+                            const double r2 = dx * dx + dy * dy + dz * dz;
+                            if (r2 >= t2) continue;
+                            const double falloff = 1.0 - r2 / t2;
+                            const float w = static_cast<float>(falloff * falloff);
+                            const float d = static_cast<float>(normal.x() * dx + normal.y() * dy + normal.z() * dz);
+                            const size_t s = (size_t(z) * kBlockSamples + y) * kBlockSamples + x;
+                            sumWD[s] += w * d;
+                            sumW[s] += w;
+                        }
+                    }
+                }
+            }
+            for (size_t s = 0; s < field.size(); ++s) {
+                field[s] = sumW[s] >= minWeight ? sumWD[s] / sumW[s] : std::numeric_limits<float>::quiet_NaN();
+            }
+
+            for (int z = 0; z < kBlockCells; ++z) {
+                for (int y = 0; y < kBlockCells; ++y) {
+                    for (int x = 0; x < kBlockCells; ++x) {
+                        float value[8];
+                        int cubeMask = 0;
+                        bool defined = true;
+                        for (int corner = 0; corner < 8 && defined; ++corner) {
+                            const int cx = x + (corner & 1), cy = y + ((corner >> 1) & 1), cz = z + ((corner >> 2) & 1);
+                            value[corner] = field[(size_t(cz) * kBlockSamples + cy) * kBlockSamples + cx];
+                            defined = !std::isnan(value[corner]);
+                            if (value[corner] < 0.0f) cubeMask |= 1 << corner;
+                        }
+                        if (!defined || cubeMask == 0 || cubeMask == 255) continue;
+
+                        const CubeCase& cubeCase = tables.cases[cubeMask];
+                        for (int j = 0; j < cubeCase.triangleCount * 3; ++j) {
+                            const int edge = cubeCase.edges[j];
+                            const int c0 = tables.edgeCorners[edge][0], c1 = tables.edgeCorners[edge][1];
+                            const uint64_t gx = base[0] + x + (c0 & 1);
+                            const uint64_t gy = base[1] + y + ((c0 >> 1) & 1);
+                            const uint64_t gz = base[2] + z + ((c0 >> 2) & 1);
+                            out.edgeKeys.push_back((packBlock(gx, gy, gz) << 2) | uint64_t(edge / 4));
+                            // 插值在 double 下进行：全局采样坐标可达 2^20，float 精度不足
+                            const double s = double(value[c0]) / (double(value[c0]) - value[c1]);
+                            double g[3] = { double(gx), double(gy), double(gz) };
+                            g[edge / 4] += s;
+                            out.positions.push_back(QVector3D(float(origin.x() + g[0] * h),
+                                                              float(origin.y() + g[1] * h),
+                                                              float(origin.z() + g[2] * h)));
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    // 5. 汇总角点，按棱键排序去重得到共享顶点（即焊接），法线取相邻三角形面积加权平均
+    std::vector<size_t> cornerOffsets(blockChunks + 1, 0);
+    for (size_t c = 0; c < blockChunks; ++c) cornerOffsets[c + 1] = cornerOffsets[c] + outputs[c].edgeKeys.size();
+    const size_t cornerCount = cornerOffsets[blockChunks];
+    if (cornerCount == 0 || cornerCount > 0xffffffffu) {
+        qDebug() << "表面重建: 未生成三角形";
+        return result;
+    }
+    std::vector<uint64_t> keys(cornerCount);
+    std::vector<QVector3D> positions(cornerCount);
+    std::vector<uint32_t> order(cornerCount);
+    Parallel::forEach(0, blockChunks, [&](size_t c) {
+        std::copy(outputs[c].edgeKeys.begin(), outputs[c].edgeKeys.end(), keys.begin() + cornerOffsets[c]);
+        std::copy(outputs[c].positions.begin(), outputs[c].positions.end(), positions.begin() + cornerOffsets[c]);
+        std::vector<uint64_t>().swap(outputs[c].edgeKeys);
+        std::vector<QVector3D>().swap(outputs[c].positions);
+    }, 1);
+    Parallel::forEach(0, cornerCount, [&](size_t i) { order[i] = static_cast<uint32_t>(i); });
+    Parallel::radixSortPairs(keys, order, 3 * kCoordBits + 2);
+
+    // 各块中每个键段的起点 -> 顶点编号（分块计数 + 前缀和）
+    const size_t sortChunks = Parallel::chunkCount(cornerCount);
+    std::vector<size_t> runOffsets(sortChunks + 1, 0);
+    Parallel::forChunks(cornerCount, sortChunks, [&](size_t c, size_t b, size_t e) {
+        size_t runs = 0;
+        for (size_t k = b; k < e; ++k) runs += (k == 0 || keys[k] != keys[k - 1]) ? 1 : 0;
+        runOffsets[c + 1] = runs;
+    });
+    for (size_t c = 0; c < sortChunks; ++c) runOffsets[c + 1] += runOffsets[c];
+    const size_t vertexCount = runOffsets[sortChunks];
+
+    std::vector<QVector3D> faceNormals(cornerCount / 3);
+    Parallel::forEach(0, faceNormals.size(), [&](size_t f) {
+        faceNormals[f] = QVector3D::crossProduct(positions[f * 3 + 1] - positions[f * 3],
+                                                 positions[f * 3 + 2] - positions[f * 3]);
+    });
+    std::vector<Vertex> vertices(vertexCount);
+    std::vector<unsigned int> triangles(cornerCount);
+    Parallel::forChunks(cornerCount, sortChunks, [&](size_t c, size_t b, size_t e) {
+        // runs 为 [0, k] 内的段起点数，第 runs 个段的顶点编号为 runs - 1
+        size_t runs = runOffsets[c];
+        for (size_t k = b; k < e; ++k) {
+            if (k == 0 || keys[k] != keys[k - 1]) ++runs;
+            triangles[order[k]] = static_cast<unsigned int>(runs - 1);
+        }
+    });
+    // 顶点属性：每个键段由唯一的块写入（段起点所在块），段可能跨块，须整段累加
+    Parallel::forChunks(cornerCount, sortChunks, [&](size_t c, size_t b, size_t e) {
+        size_t k = b;
+        while (k < e && k > 0 && keys[k] == keys[k - 1]) ++k;
+        while (k < e) {
+            size_t end = k + 1;
+            while (end < cornerCount && keys[end] == keys[k]) ++end;
+            QVector3D normal(0, 0, 0);
+            for (size_t j = k; j < end; ++j) normal += faceNormals[order[j] / 3];
+            Vertex& v = vertices[triangles[order[k]]];
+            v.position = positions[order[k]];
+            v.normal = normal.normalized();
+            k = end;
+        }
+    });
+
+    result.triangleCount = triangles.size() / 3;
+    // 模型构造会修改静态计数器，在调用线程创建
+    auto mesh = std::make_shared<Mesh>(QString("%1_重建").arg(cloud.getName()));
+    mesh->setGeometry(std::move(vertices), std::move(triangles));
+    result.mesh = mesh;
+    result.elapsedMs = timer.elapsed();
+    return result;
+}